@@ -0,0 +1,871 @@
+#ifndef HIOP_BENCHMARK_PROBLEMS
+#define HIOP_BENCHMARK_PROBLEMS
+
+#include "hiopInterface.hpp"
+
+#ifdef HIOP_USE_MPI
+#include "mpi.h"
+#else
+#define MPI_COMM_WORLD 0
+#define MPI_COMM_SELF 0
+#define MPI_Comm int
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <set>
+#include <random>
+#include <algorithm>
+
+/* Scalable synthetic problems used by the end-to-end benchmark driver (nlpBenchmark_driver.cpp).
+ *
+ * 1) AcopfLikeGrid - a randomly generated power network with the block structure of an AC optimal 
+ * power flow problem. The network has 'nb' buses connected by a ring of lines plus nb/4 random chords;
+ * 'ng' generators sit at equally spaced buses. Each bus i carries a voltage magnitude v_i, a voltage
+ * angle t_i and a reactive injection q_i; each generator k a real power output p_k.
+ *
+ *  min   sum_k (a_k p_k^2 + c_k p_k) + sum_i 0.5 (wq q_i^2 + wv (v_i-1)^2) + 0.5 t_0^2
+ *  s.t.  P_i := sum_{j~i} b_ij v_i v_j sin(t_i-t_j)            + pd_i - sum_{k at i} p_k = 0, all buses i
+ *        Q_i := sum_{j~i} b_ij (v_i^2 - v_i v_j cos(t_i-t_j)) + qd_i - q_i               = 0, all buses i
+ *        -0.6 <= t_i - t_j <= 0.6,  for all lines (i,j), i<j
+ *        0.9 <= v_i <= 1.1,  -pi <= t_i <= pi,  -1 <= q_i <= 1,  0 <= p_k <= pmax
+ *
+ * The power balance equations are the lossless polar-form AC equations, so the Jacobian and the 
+ * Hessian of the Lagrangian have the (bus x bus) sparsity of the network, as in ACOPF. The term 
+ * 0.5 t_0^2 plays the role of the reference bus. The variables are ordered [v_0,t_0,q_0, v_1,...,q_{nb-1},
+ * p_0,...,p_{ng-1}] and the constraints [P, Q, angle differences], that is, equalities first.
+ *
+ * The grid is used by two HiOp inputs: AcopfLikeMDS, in which the bus voltages are the dense
+ * variables, and AcopfLikeSparse, in which all variables are sparse.
+ *
+ * 2) DenseConsProblem - a large problem with dense constraints for the hiopInterfaceDenseConstraints
+ * input
+ *
+ *  min   sum_i 0.5 d_i (x_i - xt_i)^2 + 0.25 e x_i^4 
+ *  s.t.  A_eq x = A_eq x0 
+ *        A_ineq x + 0.5/n ||x||^2 <= u
+ *        -1 <= x <= 2
+ *
+ * with A_eq and A_ineq random dense matrices, x0 = 0.5, and u chosen such that x0 is strictly feasible.
+ */
+
+class AcopfLikeGrid
+{
+public:
+  AcopfLikeGrid(int nb_in, unsigned int seed=1)
+    : nb(nb_in<4 ? 4 : nb_in), wq(0.1), wv(1.)
+  {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> unif(0., 1.);
+
+    //lines: a ring and nb/4 random chords (no parallel lines)
+    std::set<std::pair<int,int> > lines;
+    for(int i=0; i<nb; i++) {
+      int j = (i+1)%nb;
+      lines.insert(std::make_pair(std::min(i,j), std::max(i,j)));
+    }
+    std::uniform_int_distribution<int> bus_dist(0, nb-1);
+    for(int c=0; c<nb/4; c++) {
+      int i = bus_dist(gen), j = bus_dist(gen);
+      if(i!=j) {
+        lines.insert(std::make_pair(std::min(i,j), std::max(i,j)));
+      }
+    }
+    for(auto& l : lines) {
+      from.push_back(l.first);
+      to.push_back(l.second);
+      b.push_back(5. + 10.*unif(gen));
+    }
+    ne = (int) from.size();
+
+    //adjacency, sorted by neighbor since 'lines' is ordered
+    adj.resize(nb);
+    for(int e=0; e<ne; e++) {
+      adj[from[e]].push_back(std::make_pair(to[e], e));
+      adj[to[e]].push_back(std::make_pair(from[e], e));
+    }
+    for(int i=0; i<nb; i++) {
+      std::sort(adj[i].begin(), adj[i].end());
+    }
+
+    pd.resize(nb);
+    qd.resize(nb);
+    double total_pd = 0.;
+    for(int i=0; i<nb; i++) {
+      pd[i] = 0.2*unif(gen);
+      qd[i] = 0.1*unif(gen);
+      total_pd += pd[i];
+    }
+
+    ng = std::max(2, nb/25);
+    gen_bus.resize(ng);
+    gens_at.resize(nb);
+    a.resize(ng);
+    c.resize(ng);
+    for(int k=0; k<ng; k++) {
+      gen_bus[k] = (int)(((long long)k*nb)/ng);
+      gens_at[gen_bus[k]].push_back(k);
+      a[k] = 0.5 + unif(gen);
+      c[k] = 1. + 2.*unif(gen);
+    }
+    pmax = 2.*total_pd/ng + 0.1;
+  }
+
+  inline int num_bus_vars() const { return 3*nb; }
+  inline int num_cons() const { return 2*nb+ne; }
+  inline int num_cons_eq() const { return 2*nb; }
+
+  /// number of nonzeros of the Jacobian of the P and Q equations
+  int nnz_jac_eq() const
+  {
+    int nnz=ng;
+    for(int i=0; i<nb; i++) {
+      nnz += 2*(1+(int)adj[i].size()) + 2*(1+(int)adj[i].size()) + 1;
+    }
+    return nnz;
+  }
+  inline int nnz_jac_ineq() const { return 2*ne; }
+  inline int nnz_jac() const { return nnz_jac_eq()+nnz_jac_ineq(); }
+  inline int nnz_hess_bus() const { return 4*nb + 4*ne; }
+
+  void get_vars_info(double* xlow, double* xupp) const
+  {
+    for(int i=0; i<nb; i++) {
+      xlow[3*i]   = 0.9;   xupp[3*i]   = 1.1;
+      xlow[3*i+1] = -M_PI; xupp[3*i+1] = M_PI;
+      xlow[3*i+2] = -1.;   xupp[3*i+2] = 1.;
+    }
+    for(int k=0; k<ng; k++) {
+      xlow[3*nb+k] = 0.; xupp[3*nb+k] = pmax;
+    }
+  }
+
+  void get_cons_info(double* clow, double* cupp) const
+  {
+    for(int i=0; i<2*nb; i++) {
+      clow[i] = cupp[i] = 0.;
+    }
+    for(int e=0; e<ne; e++) {
+      clow[2*nb+e] = -0.6;
+      cupp[2*nb+e] =  0.6;
+    }
+  }
+
+  void starting_point(double* x0) const
+  {
+    for(int i=0; i<nb; i++) {
+      x0[3*i] = 1.; x0[3*i+1] = 0.; x0[3*i+2] = qd[i];
+    }
+    for(int k=0; k<ng; k++) {
+      x0[3*nb+k] = 0.5*pmax;
+    }
+  }
+
+  double objective(const double* x) const
+  {
+    double obj = 0.5*x[1]*x[1];
+    for(int i=0; i<nb; i++) {
+      obj += 0.5*wq*x[3*i+2]*x[3*i+2] + 0.5*wv*(x[3*i]-1.)*(x[3*i]-1.);
+    }
+    for(int k=0; k<ng; k++) {
+      const double p = x[3*nb+k];
+      obj += a[k]*p*p + c[k]*p;
+    }
+    return obj;
+  }
+
+  void gradient(const double* x, double* g) const
+  {
+    for(int i=0; i<nb; i++) {
+      g[3*i]   = wv*(x[3*i]-1.);
+      g[3*i+1] = 0.;
+      g[3*i+2] = wq*x[3*i+2];
+    }
+    g[1] = x[1];
+    for(int k=0; k<ng; k++) {
+      g[3*nb+k] = 2*a[k]*x[3*nb+k] + c[k];
+    }
+  }
+
+  /// all constraints, including the generators' contributions
+  void constraints(const double* x, double* cons) const
+  {
+    for(int i=0; i<nb; i++) {
+      const double vi=x[3*i], ti=x[3*i+1];
+      double P = pd[i], Q = qd[i]-x[3*i+2];
+      for(auto& nbr : adj[i]) {
+        const int j = nbr.first;
+        const double bij = b[nbr.second], vj=x[3*j], tj=x[3*j+1];
+        P += bij*vi*vj*sin(ti-tj);
+        Q += bij*(vi*vi - vi*vj*cos(ti-tj));
+      }
+      for(int k : gens_at[i]) {
+        P -= x[3*nb+k];
+      }
+      cons[i] = P;
+      cons[nb+i] = Q;
+    }
+    for(int e=0; e<ne; e++) {
+      cons[2*nb+e] = x[3*from[e]+1] - x[3*to[e]+1];
+    }
+  }
+
+  /// Sparsity pattern of the Jacobian, rows sorted and columns sorted within each row
+  int jac_structure(int* iJ, int* jJ) const
+  {
+    int nnz=0;
+    std::vector<int> buses;
+    for(int i=0; i<nb; i++) {
+      row_buses(i, buses);
+      for(int bus : buses) {
+        iJ[nnz] = i; jJ[nnz] = 3*bus;   nnz++;
+        iJ[nnz] = i; jJ[nnz] = 3*bus+1; nnz++;
+      }
+      for(int k : gens_at[i]) {
+        iJ[nnz] = i; jJ[nnz] = 3*nb+k; nnz++;
+      }
+    }
+    for(int i=0; i<nb; i++) {
+      row_buses(i, buses);
+      for(int bus : buses) {
+        iJ[nnz] = nb+i; jJ[nnz] = 3*bus;   nnz++;
+        iJ[nnz] = nb+i; jJ[nnz] = 3*bus+1; nnz++;
+        if(bus==i) {
+          iJ[nnz] = nb+i; jJ[nnz] = 3*bus+2; nnz++;
+        }
+      }
+    }
+    for(int e=0; e<ne; e++) {
+      iJ[nnz] = 2*nb+e; jJ[nnz] = 3*from[e]+1; nnz++;
+      iJ[nnz] = 2*nb+e; jJ[nnz] = 3*to[e]+1;   nnz++;
+    }
+    return nnz;
+  }
+
+  /// Jacobian values in the order of 'jac_structure'
+  int jac_values(const double* x, double* MJ) const
+  {
+    int nnz=0;
+    std::vector<int> buses;
+    //P rows
+    for(int i=0; i<nb; i++) {
+      const double vi=x[3*i], ti=x[3*i+1];
+      double dvi=0., dti=0.;
+      for(auto& nbr : adj[i]) {
+        const int j = nbr.first;
+        const double bij = b[nbr.second], vj=x[3*j], tj=x[3*j+1];
+        dvi += bij*vj*sin(ti-tj);
+        dti += bij*vi*vj*cos(ti-tj);
+      }
+      bool self_done = false;
+      for(auto& nbr : adj[i]) {
+        const int j = nbr.first;
+        if(!self_done && j>i) {
+          MJ[nnz++] = dvi; MJ[nnz++] = dti;
+          self_done = true;
+        }
+        const double bij = b[nbr.second], vj=x[3*j], tj=x[3*j+1];
+        MJ[nnz++] =  bij*vi*sin(ti-tj);
+        MJ[nnz++] = -bij*vi*vj*cos(ti-tj);
+      }
+      if(!self_done) {
+        MJ[nnz++] = dvi; MJ[nnz++] = dti;
+      }
+      for(size_t k=0; k<gens_at[i].size(); k++) {
+        MJ[nnz++] = -1.;
+      }
+    }
+    //Q rows
+    for(int i=0; i<nb; i++) {
+      const double vi=x[3*i], ti=x[3*i+1];
+      double dvi=0., dti=0.;
+      for(auto& nbr : adj[i]) {
+        const int j = nbr.first;
+        const double bij = b[nbr.second], vj=x[3*j], tj=x[3*j+1];
+        dvi += bij*(2*vi - vj*cos(ti-tj));
+        dti += bij*vi*vj*sin(ti-tj);
+      }
+      bool self_done = false;
+      for(auto& nbr : adj[i]) {
+        const int j = nbr.first;
+        if(!self_done && j>i) {
+          MJ[nnz++] = dvi; MJ[nnz++] = dti; MJ[nnz++] = -1.;
+          self_done = true;
+        }
+        const double bij = b[nbr.second], vj=x[3*j], tj=x[3*j+1];
+        MJ[nnz++] = -bij*vi*cos(ti-tj);
+        MJ[nnz++] = -bij*vi*vj*sin(ti-tj);
+      }
+      if(!self_done) {
+        MJ[nnz++] = dvi; MJ[nnz++] = dti; MJ[nnz++] = -1.;
+      }
+    }
+    //angle differences
+    for(int e=0; e<ne; e++) {
+      MJ[nnz++] =  1.;
+      MJ[nnz++] = -1.;
+    }
+    return nnz;
+  }
+
+  /** 
+   * Upper triangle of the Hessian of the Lagrangian w.r.t. the bus variables: 4 entries per bus, 
+   * (v,v), (v,t), (t,t), (q,q), followed by 4 entries per line (p,q), (v_p,v_q), (v_p,t_q), (t_p,v_q), (t_p,t_q).
+   * The generators' block (diagonal with entries obj_factor*2*a_k) is returned by 'hess_gens'.
+   */
+  int hess_structure(int* iH, int* jH) const
+  {
+    int nnz=0;
+    for(int i=0; i<nb; i++) {
+      iH[nnz] = 3*i;   jH[nnz] = 3*i;   nnz++;
+      iH[nnz] = 3*i;   jH[nnz] = 3*i+1; nnz++;
+      iH[nnz] = 3*i+1; jH[nnz] = 3*i+1; nnz++;
+      iH[nnz] = 3*i+2; jH[nnz] = 3*i+2; nnz++;
+    }
+    for(int e=0; e<ne; e++) {
+      const int p=from[e], q=to[e];
+      iH[nnz] = 3*p;   jH[nnz] = 3*q;   nnz++;
+      iH[nnz] = 3*p;   jH[nnz] = 3*q+1; nnz++;
+      iH[nnz] = 3*p+1; jH[nnz] = 3*q;   nnz++;
+      iH[nnz] = 3*p+1; jH[nnz] = 3*q+1; nnz++;
+    }
+    return nnz;
+  }
+
+  /// values in the order of 'hess_structure'; @p lambda is ordered as the constraints
+  int hess_values(const double* x, const double& obj_factor, const double* lambda, double* MH) const
+  {
+    const double* lamP = lambda;
+    const double* lamQ = lambda+nb;
+    for(int i=0; i<nb; i++) {
+      MH[4*i]   = obj_factor*wv;
+      MH[4*i+1] = 0.;
+      MH[4*i+2] = 0.;
+      MH[4*i+3] = obj_factor*wq;
+    }
+    MH[2] += obj_factor;
+
+    double* MHe = MH+4*nb;
+    for(int e=0; e<ne; e++) {
+      const int p=from[e], q=to[e];
+      const double vp=x[3*p], vq=x[3*q];
+      const double s=sin(x[3*p+1]-x[3*q+1]), co=cos(x[3*p+1]-x[3*q+1]);
+      // P_p - P_q contribution b*vp*vq*sin(tp-tq) and Q contribution -b*(lamQ_p+lamQ_q)*vp*vq*cos(tp-tq)
+      const double aP =  b[e]*(lamP[p]-lamP[q]);
+      const double aQ = -b[e]*(lamQ[p]+lamQ[q]);
+      
+      //bus p: (v,v), (v,t), (t,t)
+      MH[4*p]   += 2*b[e]*lamQ[p];
+      MH[4*p+1] += aP*vq*co - aQ*vq*s;
+      MH[4*p+2] += -aP*vp*vq*s - aQ*vp*vq*co;
+      //bus q
+      MH[4*q]   += 2*b[e]*lamQ[q];
+      MH[4*q+1] += -aP*vp*co + aQ*vp*s;
+      MH[4*q+2] += -aP*vp*vq*s - aQ*vp*vq*co;
+
+      //line: (v_p,v_q), (v_p,t_q), (t_p,v_q), (t_p,t_q)
+      MHe[4*e]   = aP*s + aQ*co;
+      MHe[4*e+1] = -aP*vq*co + aQ*vq*s;
+      MHe[4*e+2] = aP*vp*co - aQ*vp*s;
+      MHe[4*e+3] = aP*vp*vq*s + aQ*vp*vq*co;
+    }
+    return 4*nb+4*ne;
+  }
+  
+  inline double hess_gen(int k, const double& obj_factor) const { return 2*a[k]*obj_factor; }
+  
+private:
+  /// buses appearing in the P and Q rows of bus i, sorted
+  void row_buses(int i, std::vector<int>& buses) const
+  {
+    buses.clear();
+    bool self_done = false;
+    for(auto& nbr : adj[i]) {
+      if(!self_done && nbr.first>i) {
+        buses.push_back(i);
+        self_done = true;
+      }
+      buses.push_back(nbr.first);
+    }
+    if(!self_done) {
+      buses.push_back(i);
+    }
+  }
+public:
+  int nb, ne, ng;
+  double wq, wv, pmax;
+  std::vector<int> from, to;
+  std::vector<double> b;
+  std::vector<std::vector<std::pair<int,int> > > adj;
+  std::vector<double> pd, qd;
+  std::vector<int> gen_bus;
+  std::vector<std::vector<int> > gens_at;
+  std::vector<double> a, c;
+};
+
+/** 
+ * ACOPF-like problem in the mixed dense-sparse input. As in ACOPF codes that use HiOp's MDS input,
+ * the voltages (v_i,t_i) of all buses are the dense variables and the reactive injections q_i and
+ * the generators' outputs p_k, which have a diagonal Hessian, are the sparse variables. The HiOp 
+ * variables are ordered [q_0,...,q_{nb-1}, p_0,...,p_{ng-1}, v_0,t_0, ..., v_{nb-1},t_{nb-1}] and
+ * are mapped to/from the grid's order internally.
+ */
+class AcopfLikeMDS : public hiop::hiopInterfaceMDS
+{
+public:
+  AcopfLikeMDS(int nb, unsigned int seed=1)
+    : grid(nb, seed)
+  {
+    ns = grid.nb+grid.ng;
+    nd = 2*grid.nb;
+    n = ns+nd;
+    xg.resize(n);
+    bufg.resize(n);
+    
+    //map of the grid's variables to HiOp's variables
+    idx.resize(n);
+    for(int i=0; i<grid.nb; i++) {
+      idx[3*i]   = ns+2*i;
+      idx[3*i+1] = ns+2*i+1;
+      idx[3*i+2] = i;
+    }
+    for(int k=0; k<grid.ng; k++) {
+      idx[3*grid.nb+k] = grid.nb+k;
+    }
+
+    //split the Jacobian in the sparse and dense blocks
+    const int nnzJ = grid.nnz_jac();
+    jac_i.resize(nnzJ);
+    jac_j.resize(nnzJ);
+    grid.jac_structure(jac_i.data(), jac_j.data());
+    nnz_jac_sp_eq = nnz_jac_sp_ineq = 0;
+    for(int k=0; k<nnzJ; k++) {
+      if(idx[jac_j[k]]<ns) {
+        if(jac_i[k]<grid.num_cons_eq()) nnz_jac_sp_eq++;
+        else nnz_jac_sp_ineq++;
+      }
+    }
+    jac_vals.resize(nnzJ);
+
+    const int nnzH = grid.nnz_hess_bus();
+    hess_i.resize(nnzH);
+    hess_j.resize(nnzH);
+    grid.hess_structure(hess_i.data(), hess_j.data());
+    hess_vals.resize(nnzH);
+  }
+  virtual ~AcopfLikeMDS()
+  {
+  }
+
+  bool get_prob_sizes(long long& n_out, long long& m)
+  {
+    n_out = n;
+    m = grid.num_cons();
+    return true;
+  }
+  bool get_vars_info(const long long& n_in, double *xlow, double* xupp, NonlinearityType* type)
+  {
+    std::vector<double> xlg(n), xug(n);
+    grid.get_vars_info(xlg.data(), xug.data());
+    for(int i=0; i<n; i++) {
+      xlow[idx[i]] = xlg[i];
+      xupp[idx[i]] = xug[i];
+      type[i] = hiopNonlinear;
+    }
+    return true;
+  }
+  bool get_cons_info(const long long& m, double* clow, double* cupp, NonlinearityType* type)
+  {
+    grid.get_cons_info(clow, cupp);
+    for(long long i=0; i<m; i++) type[i]=hiopNonlinear;
+    return true;
+  }
+  bool get_sparse_dense_blocks_info(int& nx_sparse, int& nx_dense,
+                                    int& nnz_sparse_Jace, int& nnz_sparse_Jaci,
+                                    int& nnz_sparse_Hess_Lagr_SS, int& nnz_sparse_Hess_Lagr_SD)
+  {
+    nx_sparse = ns;
+    nx_dense = nd;
+    nnz_sparse_Jace = nnz_jac_sp_eq;
+    nnz_sparse_Jaci = nnz_jac_sp_ineq;
+    nnz_sparse_Hess_Lagr_SS = ns;
+    nnz_sparse_Hess_Lagr_SD = 0;
+    return true;
+  }
+  bool eval_f(const long long& n_in, const double* x, bool new_x, double& obj_value)
+  {
+    obj_value = grid.objective(to_grid(x));
+    return true;
+  }
+  bool eval_grad_f(const long long& n_in, const double* x, bool new_x, double* gradf)
+  {
+    grid.gradient(to_grid(x), bufg.data());
+    for(int i=0; i<n; i++) {
+      gradf[idx[i]] = bufg[i];
+    }
+    return true;
+  }
+  bool eval_cons(const long long& n_in, const long long& m, 
+                 const long long& num_cons, const long long* idx_cons,  
+                 const double* x, bool new_x, double* cons)
+  {
+    //return false so that HiOp will rely on the one-call constraint evaluator defined below
+    return false;
+  }
+  bool eval_cons(const long long& n_in, const long long& m, 
+                 const double* x, bool new_x, double* cons)
+  {
+    grid.constraints(to_grid(x), cons);
+    return true;
+  }
+  bool eval_Jac_cons(const long long& n_in, const long long& m, 
+                     const long long& num_cons, const long long* idx_cons,
+                     const double* x, bool new_x,
+                     const long long& nsparse, const long long& ndense, 
+                     const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS, 
+                     double* JacD)
+  {
+    return false;
+  }
+  bool eval_Jac_cons(const long long& n_in, const long long& m, 
+                     const double* x, bool new_x,
+                     const long long& nsparse, const long long& ndense, 
+                     const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS, 
+                     double* JacD)
+  {
+    assert(nnzJacS==nnz_jac_sp_eq+nnz_jac_sp_ineq);
+    const int nnzJ = jac_i.size();
+    if(iJacS!=NULL && jJacS!=NULL) {
+      int nnz=0;
+      for(int k=0; k<nnzJ; k++) {
+        if(idx[jac_j[k]]<ns) {
+          iJacS[nnz] = jac_i[k];
+          jJacS[nnz] = idx[jac_j[k]];
+          nnz++;
+        }
+      }
+    }
+    if(MJacS!=NULL || JacD!=NULL) {
+      grid.jac_values(to_grid(x), jac_vals.data());
+      if(JacD!=NULL) {
+        for(long long i=0; i<m*nd; i++) JacD[i] = 0.;
+      }
+      int nnz=0;
+      for(int k=0; k<nnzJ; k++) {
+        const int col = idx[jac_j[k]];
+        if(col<ns) {
+          if(MJacS!=NULL) MJacS[nnz] = jac_vals[k];
+          nnz++;
+        } else if(JacD!=NULL) {
+          JacD[(long long)jac_i[k]*nd + col-ns] = jac_vals[k];
+        }
+      }
+    }
+    return true;
+  }
+  bool eval_Hess_Lagr(const long long& n_in, const long long& m, 
+                      const double* x, bool new_x, const double& obj_factor,
+                      const double* lambda, bool new_lambda,
+                      const long long& nsparse, const long long& ndense, 
+                      const int& nnzHSS, int* iHSS, int* jHSS, double* MHSS, 
+                      double* HDD,
+                      int& nnzHSD, int* iHSD, int* jHSD, double* MHSD)
+  {
+    assert(nnzHSD==0);
+    assert(nnzHSS==ns);
+    if(iHSS!=NULL && jHSS!=NULL) {
+      for(int i=0; i<ns; i++) iHSS[i] = jHSS[i] = i;
+    }
+    if(MHSS!=NULL || HDD!=NULL) {
+      grid.hess_values(to_grid(x), obj_factor, lambda, hess_vals.data());
+      if(HDD!=NULL) {
+        for(long long i=0; i<nd*nd; i++) HDD[i] = 0.;
+      }
+      for(size_t k=0; k<hess_vals.size(); k++) {
+        const int r = idx[hess_i[k]], c = idx[hess_j[k]];
+        if(r<ns) {
+          //the (q_i,q_i) entries are the only ones involving sparse variables
+          assert(r==c);
+          if(MHSS!=NULL) MHSS[r] = hess_vals[k];
+        } else if(HDD!=NULL) {
+          HDD[(r-ns)*nd + c-ns] += hess_vals[k];
+          if(r!=c) {
+            HDD[(c-ns)*nd + r-ns] += hess_vals[k];
+          }
+        }
+      }
+      if(MHSS!=NULL) {
+        for(int k=0; k<grid.ng; k++) {
+          MHSS[grid.nb+k] = grid.hess_gen(k, obj_factor);
+        }
+      }
+    }
+    return true;
+  }
+  bool get_starting_point(const long long& n_in, double* x0)
+  {
+    grid.starting_point(bufg.data());
+    for(int i=0; i<n; i++) {
+      x0[idx[i]] = bufg[i];
+    }
+    return true;
+  }
+  bool get_MPI_comm(MPI_Comm& comm_out) { comm_out=MPI_COMM_SELF; return true; }
+private:
+  /// permutes HiOp's x into the grid's order
+  const double* to_grid(const double* x)
+  {
+    for(int i=0; i<n; i++) {
+      xg[i] = x[idx[i]];
+    }
+    return xg.data();
+  }
+private:
+  AcopfLikeGrid grid;
+  int n, ns, nd;
+  int nnz_jac_sp_eq, nnz_jac_sp_ineq;
+  std::vector<int> idx;
+  std::vector<double> xg, bufg;
+  std::vector<int> jac_i, jac_j, hess_i, hess_j;
+  std::vector<double> jac_vals, hess_vals;
+};
+
+/** ACOPF-like problem in the sparse input */
+class AcopfLikeSparse : public hiop::hiopInterfaceSparse
+{
+public:
+  AcopfLikeSparse(int nb, unsigned int seed=1)
+    : grid(nb, seed)
+  {
+  }
+  virtual ~AcopfLikeSparse()
+  {
+  }
+
+  bool get_prob_sizes(long long& n, long long& m)
+  {
+    n = grid.num_bus_vars()+grid.ng;
+    m = grid.num_cons();
+    return true;
+  }
+  bool get_vars_info(const long long& n, double *xlow, double* xupp, NonlinearityType* type)
+  {
+    grid.get_vars_info(xlow, xupp);
+    for(long long i=0; i<n; i++) type[i]=hiopNonlinear;
+    return true;
+  }
+  bool get_cons_info(const long long& m, double* clow, double* cupp, NonlinearityType* type)
+  {
+    grid.get_cons_info(clow, cupp);
+    for(long long i=0; i<m; i++) type[i]=hiopNonlinear;
+    return true;
+  }
+  bool get_sparse_blocks_info(int& nx, int& nnz_sparse_Jaceq, int& nnz_sparse_Jacineq,
+                              int& nnz_sparse_Hess_Lagr)
+  {
+    nx = grid.num_bus_vars()+grid.ng;
+    nnz_sparse_Jaceq = grid.nnz_jac_eq();
+    nnz_sparse_Jacineq = grid.nnz_jac_ineq();
+    nnz_sparse_Hess_Lagr = grid.nnz_hess_bus()+grid.ng;
+    return true;
+  }
+  bool eval_f(const long long& n, const double* x, bool new_x, double& obj_value)
+  {
+    obj_value = grid.objective(x);
+    return true;
+  }
+  bool eval_grad_f(const long long& n, const double* x, bool new_x, double* gradf)
+  {
+    grid.gradient(x, gradf);
+    return true;
+  }
+  bool eval_cons(const long long& n, const long long& m, 
+                 const long long& num_cons, const long long* idx_cons,  
+                 const double* x, bool new_x, double* cons)
+  {
+    return false;
+  }
+  bool eval_cons(const long long& n, const long long& m, 
+                 const double* x, bool new_x, double* cons)
+  {
+    grid.constraints(x, cons);
+    return true;
+  }
+  bool eval_Jac_cons(const long long& n, const long long& m,
+                     const long long& num_cons, const long long* idx_cons,
+                     const double* x, bool new_x,
+                     const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS)
+  {
+    return false;
+  }
+  bool eval_Jac_cons(const long long& n, const long long& m,
+                     const double* x, bool new_x,
+                     const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS)
+  {
+    if(iJacS!=NULL && jJacS!=NULL) {
+      int nnz = grid.jac_structure(iJacS, jJacS);
+      assert(nnz==nnzJacS);
+    }
+    if(MJacS!=NULL) {
+      int nnz = grid.jac_values(x, MJacS);
+      assert(nnz==nnzJacS);
+    }
+    return true;
+  }
+  bool eval_Hess_Lagr(const long long& n, const long long& m,
+                      const double* x, bool new_x, const double& obj_factor,
+                      const double* lambda, bool new_lambda,
+                      const int& nnzHSS, int* iHSS, int* jHSS, double* MHSS)
+  {
+    const int nnz_bus = grid.nnz_hess_bus(), nvb = grid.num_bus_vars();
+    if(iHSS!=NULL && jHSS!=NULL) {
+      grid.hess_structure(iHSS, jHSS);
+      for(int k=0; k<grid.ng; k++) {
+        iHSS[nnz_bus+k] = jHSS[nnz_bus+k] = nvb+k;
+      }
+    }
+    if(MHSS!=NULL) {
+      grid.hess_values(x, obj_factor, lambda, MHSS);
+      for(int k=0; k<grid.ng; k++) {
+        MHSS[nnz_bus+k] = grid.hess_gen(k, obj_factor);
+      }
+    }
+    assert(nnzHSS==nnz_bus+grid.ng);
+    return true;
+  }
+  bool get_starting_point(const long long& n, double* x0)
+  {
+    grid.starting_point(x0);
+    return true;
+  }
+  bool get_MPI_comm(MPI_Comm& comm_out) { comm_out=MPI_COMM_SELF; return true; }
+private:
+  AcopfLikeGrid grid;
+};
+
+/** Large problem with dense constraints; see the description at the top of the file */
+class DenseConsProblem : public hiop::hiopInterfaceDenseConstraints
+{
+public:
+  DenseConsProblem(int n_in, int m_in, unsigned int seed=1)
+    : n(n_in), m(m_in), e(1e-2)
+  {
+    if(m<2) m = 2;
+    meq = m/2;
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> unif(-1., 1.);
+    A.resize((size_t)m*n);
+    for(auto& aij : A) aij = unif(gen);
+    d.resize(n);
+    xt.resize(n);
+    for(int i=0; i<n; i++) {
+      d[i] = 1.5+unif(gen);
+      xt[i] = unif(gen);
+    }
+    //right-hand sides such that x0=0.5 is feasible, strictly for the inequalities
+    rhs.resize(m);
+    std::vector<double> x0(n, 0.5);
+    eval_cons_all(x0.data(), rhs.data());
+    for(int k=meq; k<m; k++) {
+      rhs[k] += 0.1*n/100. + 0.1;
+    }
+  }
+  virtual ~DenseConsProblem()
+  {
+  }
+
+  bool get_prob_sizes(long long& n_out, long long& m_out)
+  {
+    n_out=n; m_out=m;
+    return true;
+  }
+  bool get_vars_info(const long long& n_in, double *xlow, double* xupp, NonlinearityType* type)
+  {
+    for(long long i=0; i<n_in; i++) {
+      xlow[i] = -1.; xupp[i] = 2.; type[i] = hiopNonlinear;
+    }
+    return true;
+  }
+  bool get_cons_info(const long long& m_in, double* clow, double* cupp, NonlinearityType* type)
+  {
+    for(int k=0; k<meq; k++) {
+      clow[k] = cupp[k] = rhs[k];
+      type[k] = hiopLinear;
+    }
+    for(int k=meq; k<m; k++) {
+      clow[k] = -1e20; cupp[k] = rhs[k];
+      type[k] = hiopNonlinear;
+    }
+    return true;
+  }
+  bool eval_f(const long long& n_in, const double* x, bool new_x, double& obj_value)
+  {
+    obj_value = 0.;
+    for(int i=0; i<n; i++) {
+      obj_value += 0.5*d[i]*(x[i]-xt[i])*(x[i]-xt[i]) + 0.25*e*x[i]*x[i]*x[i]*x[i];
+    }
+    return true;
+  }
+  bool eval_grad_f(const long long& n_in, const double* x, bool new_x, double* gradf)
+  {
+    for(int i=0; i<n; i++) {
+      gradf[i] = d[i]*(x[i]-xt[i]) + e*x[i]*x[i]*x[i];
+    }
+    return true;
+  }
+  bool eval_cons(const long long& n_in, const long long& m_in, 
+                 const long long& num_cons, const long long* idx_cons,  
+                 const double* x, bool new_x, double* cons)
+  {
+    return false;
+  }
+  bool eval_cons(const long long& n_in, const long long& m_in, 
+                 const double* x, bool new_x, double* cons)
+  {
+    eval_cons_all(x, cons);
+    return true;
+  }
+  bool eval_Jac_cons(const long long& n_in, const long long& m_in, 
+                     const long long& num_cons, const long long* idx_cons,
+                     const double* x, bool new_x, double* Jac)
+  {
+    return false;
+  }
+  bool eval_Jac_cons(const long long& n_in, const long long& m_in,
+                     const double* x, bool new_x, double* Jac)
+  {
+    std::copy(A.begin(), A.end(), Jac);
+    for(int k=meq; k<m; k++) {
+      double* Jk = Jac+(size_t)k*n;
+      for(int i=0; i<n; i++) {
+        Jk[i] += x[i]/n;
+      }
+    }
+    return true;
+  }
+  bool get_starting_point(const long long& n_in, double* x0)
+  {
+    for(int i=0; i<n; i++) x0[i] = 0.5;
+    return true;
+  }
+  bool get_MPI_comm(MPI_Comm& comm_out) { comm_out=MPI_COMM_SELF; return true; }
+private:
+  void eval_cons_all(const double* x, double* cons) const
+  {
+    double xx = 0.;
+    for(int i=0; i<n; i++) xx += x[i]*x[i];
+    for(int k=0; k<m; k++) {
+      const double* Ak = A.data()+(size_t)k*n;
+      double ck = 0.;
+      for(int i=0; i<n; i++) ck += Ak[i]*x[i];
+      cons[k] = k<meq ? ck : ck+0.5*xx/n;
+    }
+  }
+private:
+  int n, m, meq;
+  double e;
+  std::vector<double> A, d, xt, rhs;
+};
+
+#endif
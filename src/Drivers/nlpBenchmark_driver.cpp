@@ -0,0 +1,318 @@
+#include "nlpBenchmarkProblems.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+
+#ifdef HIOP_USE_MAGMA
+#include "magma_v2.h"
+#endif
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <chrono>
+
+using namespace hiop;
+
+/* End-to-end benchmark of HiOp on the scalable synthetic problems of nlpBenchmarkProblems.hpp.
+ *
+ * Each problem family is solved for each of the requested sizes, a number of times for each size. 
+ * After each solve, the breakdown of the time kept in hiopRunStats (function evaluations, KKT 
+ * updates, factorizations, triangular solves, ...) and the iteration and evaluation counts are 
+ * printed and, optionally, written as one JSON object per solve to a report file.
+ * 
+ * Families:
+ *  - 'dense'       : DenseConsProblem with n variables and n/10 dense constraints (quasi-Newton IPM)
+ *  - 'acopf'       : ACOPF-like problem with n buses in the mixed dense-sparse input (Newton IPM)
+ *  - 'acopf_sparse': ACOPF-like problem with n buses in the sparse input (Newton IPM), only 
+ *                    available when HiOp is built with HIOP_SPARSE
+ *
+ * HiOp options can be passed in the usual 'hiop.options' file.
+ */
+
+struct BenchmarkRecord
+{
+  std::string family;
+  long long size, n, m;
+  int run;
+  int status;
+  int iterations;
+  double objective;
+  double wall_time;
+  hiopRunStats stats;
+};
+
+static const char* default_sizes(const std::string& family, bool quick)
+{
+  if(family=="dense") {
+    return quick ? "200" : "1000,2000,4000";
+  }
+  if(family=="acopf") {
+    //the MDS input condenses the KKT system to a dense matrix of the size of the constraints
+    return quick ? "50" : "100,200,400";
+  }
+  return quick ? "100" : "1000,5000,20000";
+}
+
+static std::vector<std::string> split(const char* s)
+{
+  std::vector<std::string> items;
+  std::stringstream ss(s);
+  std::string item;
+  while(std::getline(ss, item, ',')) {
+    if(!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+static bool parse_arguments(int argc, char **argv,
+                            std::vector<std::string>& families,
+                            const char*& sizes,
+                            int& num_runs,
+                            const char*& json_file,
+                            bool& quick)
+{
+  families = split("dense,acopf");
+#ifdef HIOP_SPARSE
+  families.push_back("acopf_sparse");
+#endif
+  sizes = NULL;
+  num_runs = 3;
+  json_file = NULL;
+  quick = false;
+  for(int i=1; i<argc; i++) {
+    const bool has_val = i+1<argc;
+    if(0==strcmp(argv[i], "-families") && has_val) {
+      families = split(argv[++i]);
+    } else if(0==strcmp(argv[i], "-sizes") && has_val) {
+      sizes = argv[++i];
+    } else if(0==strcmp(argv[i], "-runs") && has_val) {
+      num_runs = atoi(argv[++i]);
+      if(num_runs<1) return false;
+    } else if(0==strcmp(argv[i], "-json") && has_val) {
+      json_file = argv[++i];
+    } else if(0==strcmp(argv[i], "-quick")) {
+      quick = true;
+      num_runs = 1;
+    } else {
+      return false;
+    }
+  }
+  for(auto& f : families) {
+    if(f!="dense" && f!="acopf" && f!="acopf_sparse") {
+      printf("[error] unknown problem family '%s'\n", f.c_str());
+      return false;
+    }
+#ifndef HIOP_SPARSE
+    if(f=="acopf_sparse") {
+      printf("[error] family 'acopf_sparse' requires HiOp to be built with HIOP_SPARSE\n");
+      return false;
+    }
+#endif
+  }
+  return true;
+}
+
+static void usage(const char* exeName)
+{
+  printf("HiOp driver %s that benchmarks the solver on scalable synthetic problems.\n", exeName);
+  printf("Usage: \n");
+  printf("  '$ %s [-families f1,f2,...] [-sizes n1,n2,...] [-runs r] [-json report.json] [-quick]'\n",
+         exeName);
+  printf("Arguments:\n");
+  printf("  '-families': comma separated list among 'dense' (n variables, n/10 dense constraints), "
+         "'acopf' (ACOPF-like, n buses, MDS input) and 'acopf_sparse' (ACOPF-like, n buses, sparse "
+         "input, requires HIOP_SPARSE) [default: all available]\n");
+  printf("  '-sizes': comma separated list of problem sizes n [default 1000,2000,4000 for 'dense', "
+         "100,200,400 for 'acopf' and 1000,5000,20000 for 'acopf_sparse']\n");
+  printf("  '-runs': number of solves of each problem [default 3]\n");
+  printf("  '-json': file to write the report to, one JSON object per solve [optional]\n");
+  printf("  '-quick': one small problem per family and one run (smoke test) [optional]\n");
+}
+
+template<class SOLVER, class NLP>
+static hiopSolveStatus solve(NLP& nlp, BenchmarkRecord& rec)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  SOLVER solver(&nlp);
+  hiopSolveStatus status = solver.run();
+  rec.objective = solver.getObjective();
+  rec.iterations = solver.getNumIterations();
+  rec.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+  rec.status = status;
+  rec.stats = nlp.runStats;
+  return status;
+}
+
+static void set_common_options(hiopNlpFormulation& nlp)
+{
+  nlp.options->SetIntegerValue("verbosity_level", 1);
+  nlp.options->SetNumericValue("tolerance", 1e-6);
+}
+
+static bool run_one(const std::string& family, long long size, int run, BenchmarkRecord& rec)
+{
+  rec.family = family;
+  rec.size = size;
+  rec.run = run;
+
+  hiopSolveStatus status;
+  if(family=="dense") {
+    DenseConsProblem problem(size, std::max(2LL, size/10));
+    problem.get_prob_sizes(rec.n, rec.m);
+    hiopNlpDenseConstraints nlp(problem);
+    set_common_options(nlp);
+    status = solve<hiopAlgFilterIPM>(nlp, rec);
+  } else if(family=="acopf") {
+    AcopfLikeMDS problem(size);
+    problem.get_prob_sizes(rec.n, rec.m);
+    hiopNlpMDS nlp(problem);
+    set_common_options(nlp);
+    nlp.options->SetStringValue("Hessian", "analytical_exact");
+    nlp.options->SetStringValue("KKTLinsys", "xdycyd");
+    nlp.options->SetStringValue("duals_update_type", "linear");
+    status = solve<hiopAlgFilterIPMNewton>(nlp, rec);
+  } else {
+    assert(family=="acopf_sparse");
+    AcopfLikeSparse problem(size);
+    problem.get_prob_sizes(rec.n, rec.m);
+    hiopNlpSparse nlp(problem);
+    set_common_options(nlp);
+    nlp.options->SetStringValue("Hessian", "analytical_exact");
+    nlp.options->SetStringValue("KKTLinsys", "xdycyd");
+    nlp.options->SetStringValue("duals_update_type", "linear");
+    nlp.options->SetStringValue("compute_mode", "cpu");
+    status = solve<hiopAlgFilterIPMNewton>(nlp, rec);
+  }
+  return status>=0;
+}
+
+static void print_header()
+{
+  printf("%-13s %8s %5s %6s %5s %10s %10s %10s %10s %10s %10s %10s\n",
+         "family", "size", "run", "status", "iter", "total(s)", "eval(s)", "kkt(s)", "updt(s)",
+         "fact(s)", "rhs(s)", "triu(s)");
+}
+
+static double eval_time(const hiopRunStats& s)
+{
+  return s.tmEvalObj.getElapsedTime() + s.tmEvalGrad_f.getElapsedTime() + s.tmEvalCons.getElapsedTime() +
+    s.tmEvalJac_con.getElapsedTime() + s.tmEvalHessL.getElapsedTime();
+}
+
+static void print_record(const BenchmarkRecord& r)
+{
+  const hiopRunKKTSolStats& k = r.stats.kkt;
+  printf("%-13s %8lld %5d %6d %5d %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+         r.family.c_str(), r.size, r.run, r.status, r.iterations, 
+         r.stats.tmOptimizTotal.getElapsedTime(), eval_time(r.stats), k.tmTotal,
+         k.tmTotalUpdateInit+k.tmTotalUpdateLinsys, k.tmTotalUpdateInnerFact,
+         k.tmTotalSolveRhsManip, k.tmTotalSolveTriangular);
+}
+
+static void write_record(FILE* f, const BenchmarkRecord& r, bool last)
+{
+  const hiopRunStats& s = r.stats;
+  const hiopRunKKTSolStats& k = s.kkt;
+  fprintf(f, "{\"family\": \"%s\", \"size\": %lld, \"n\": %lld, \"m\": %lld, \"run\": %d, "
+          "\"status\": %d, \"iterations\": %d, \"objective\": %.12e, \"wall_time\": %.6e, ",
+          r.family.c_str(), r.size, r.n, r.m, r.run, r.status, r.iterations, r.objective, r.wall_time);
+  fprintf(f, "\"time_total\": %.6e, \"time_solver_internal\": %.6e, \"time_starting_point\": %.6e, "
+          "\"time_search_dir\": %.6e, \"time_mult_update\": %.6e, \"time_comm\": %.6e, \"time_init\": %.6e, ",
+          s.tmOptimizTotal.getElapsedTime(), s.tmSolverInternal.getElapsedTime(),
+          s.tmStartingPoint.getElapsedTime(), s.tmSearchDir.getElapsedTime(),
+          s.tmMultUpdate.getElapsedTime(), s.tmComm.getElapsedTime(), s.tmInit.getElapsedTime());
+  fprintf(f, "\"time_eval_obj\": %.6e, \"time_eval_grad\": %.6e, \"time_eval_cons\": %.6e, "
+          "\"time_eval_jac\": %.6e, \"time_eval_hess\": %.6e, ",
+          s.tmEvalObj.getElapsedTime(), s.tmEvalGrad_f.getElapsedTime(), s.tmEvalCons.getElapsedTime(),
+          s.tmEvalJac_con.getElapsedTime(), s.tmEvalHessL.getElapsedTime());
+  fprintf(f, "\"time_kkt_total\": %.6e, \"time_kkt_update_init\": %.6e, \"time_kkt_update_linsys\": %.6e, "
+          "\"time_kkt_factorization\": %.6e, \"time_kkt_rhs_manip\": %.6e, \"time_kkt_triangular_solve\": %.6e, ",
+          k.tmTotal, k.tmTotalUpdateInit, k.tmTotalUpdateLinsys, k.tmTotalUpdateInnerFact,
+          k.tmTotalSolveRhsManip, k.tmTotalSolveTriangular);
+  fprintf(f, "\"num_eval_obj\": %d, \"num_eval_grad\": %d, \"num_eval_cons_eq\": %d, "
+          "\"num_eval_cons_ineq\": %d, \"num_eval_jac_eq\": %d, \"num_eval_jac_ineq\": %d, "
+          "\"num_eval_hess\": %d}%s\n",
+          s.nEvalObj, s.nEvalGrad_f, s.nEvalCons_eq, s.nEvalCons_ineq, s.nEvalJac_con_eq,
+          s.nEvalJac_con_ineq, s.nEvalHessL, last ? "" : ",");
+}
+
+int main(int argc, char **argv)
+{
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int comm_size;
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr);
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+           "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+#endif
+
+#ifdef HIOP_USE_MAGMA
+  magma_init();
+#endif
+
+  std::vector<std::string> families;
+  const char* sizes;
+  const char* json_file;
+  int num_runs;
+  bool quick;
+  if(!parse_arguments(argc, argv, families, sizes, num_runs, json_file, quick)) {
+    usage(argv[0]);
+#ifdef HIOP_USE_MPI
+    MPI_Finalize();
+#endif
+    return 1;
+  }
+
+  std::vector<BenchmarkRecord> records;
+  int num_failed = 0;
+  print_header();
+  for(auto& family : families) {
+    for(auto& size_str : split(sizes ? sizes : default_sizes(family, quick))) {
+      const long long size = atoll(size_str.c_str());
+      for(int run=0; run<num_runs; run++) {
+        BenchmarkRecord rec;
+        if(!run_one(family, size, run, rec)) {
+          num_failed++;
+        }
+        print_record(rec);
+        records.push_back(rec);
+      }
+    }
+  }
+
+  if(json_file) {
+    FILE* f = fopen(json_file, "w");
+    if(NULL==f) {
+      printf("[error] could not open '%s' for writing\n", json_file);
+      num_failed++;
+    } else {
+      fprintf(f, "{\n\"hiop_version\": \"%s\",\n\"solves\": [\n", HIOP_VERSION);
+      for(size_t i=0; i<records.size(); i++) {
+        write_record(f, records[i], i+1==records.size());
+      }
+      fprintf(f, "]\n}\n");
+      fclose(f);
+    }
+  }
+
+  if(num_failed) {
+    printf("%d solve(s) failed\n", num_failed);
+  }
+
+#ifdef HIOP_USE_MAGMA
+  magma_finalize();
+#endif
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return num_failed ? 1 : 0;
+}
@@ -11,9 +11,16 @@ using namespace hiop;
 
 static bool self_check(long long n, double obj_value);
 
-static bool parse_arguments(int argc, char **argv, long long& n, double& distortion_ratio, bool& self_check)
+static bool parse_arguments(int argc, char **argv, long long& n, double& distortion_ratio, bool& self_check,
+                            std::string& hessian)
 {
-  n = 20000; distortion_ratio=1.; self_check=false; //default options
+  n = 20000; distortion_ratio=1.; self_check=false; hessian=""; //default options
+
+  //the optional '-hessian=...' is the last argument
+  if(argc>1 && std::string(argv[argc-1]).compare(0, 9, "-hessian=")==0) {
+    hessian = std::string(argv[argc-1]).substr(9);
+    argc--;
+  }
 
   switch(argc) {
   case 1:
@@ -49,11 +56,12 @@ static void usage(const char* exeName)
 {
   printf("hiOp driver '%s' that solves a synthetic infinite dimensional problem of variable size. A 1D mesh is created by the example, and the size and the distortion of the mesh can be specified as options to this executable. The distortion of the mesh is the ratio of the smallest element and the largest element in the mesh.\n", exeName);
   printf("Usage: \n");
-  printf("  '$ %s problem_size mesh_distortion_ratio -selfcheck'\n", exeName);
+  printf("  '$ %s problem_size mesh_distortion_ratio -selfcheck -hessian=value'\n", exeName);
   printf("Arguments (specify in the order above): \n");
   printf("  'problem_size': number of decision variables [optional, default is 20k]\n");
   printf("  'dist_ratio': mesh distortion ratio, see above; a number in (0,1)  [optional, default 1.0]\n");
   printf("  '-selfcheck': compares the optimal objective with a previously saved value for the problem specified by 'problem_size'. [optional]\n");
+  printf("  '-hessian=value': value of the option 'Hessian', e.g., quasinewton_lsr1. [optional]\n");
 }
 
 
@@ -67,8 +75,8 @@ int main(int argc, char **argv)
   err = MPI_Comm_size(MPI_COMM_WORLD,&numRanks); assert(MPI_SUCCESS==err);
   if(0==rank) printf("Support for MPI is enabled\n");
 #endif
-  bool selfCheck; long long mesh_size; double ratio;
-  if(!parse_arguments(argc, argv, mesh_size, ratio, selfCheck)) { usage(argv[0]); return 1;}
+  bool selfCheck; long long mesh_size; double ratio; std::string hessian;
+  if(!parse_arguments(argc, argv, mesh_size, ratio, selfCheck, hessian)) { usage(argv[0]); return 1;}
   
   Ex1Interface problem(mesh_size, ratio);
   //if(rank==0) printf("interface created\n");
@@ -79,6 +87,9 @@ int main(int argc, char **argv)
   //nlp.options->SetNumericValue("tolerance", 1e-4);
   //nlp.options->SetStringValue("duals_init",  "zero");
   //nlp.options->SetIntegerValue("max_iter", 2);
+  if(!hessian.empty()) {
+    nlp.options->SetStringValue("Hessian", hessian.c_str());
+  }
   
   hiop::hiopAlgFilterIPM solver(&nlp);
   hiop::hiopSolveStatus status = solver.run();
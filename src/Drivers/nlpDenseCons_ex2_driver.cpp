@@ -9,12 +9,17 @@ using namespace hiop;
 
 static bool self_check(long long n, double obj_value);
 
-static bool parse_arguments(int argc, char **argv, long long& n, bool& self_check)
+static bool parse_arguments(int argc, char **argv, long long& n, bool& self_check, std::string& hessian)
 {
 
   //  printf("%s    %s \n", argv[1], argv[2]);
 
-  self_check=false; n = 50000;
+  self_check=false; n = 50000; hessian="";
+  //the optional '-hessian=...' is the last argument
+  if(argc>1 && std::string(argv[argc-1]).compare(0, 9, "-hessian=")==0) {
+    hessian = std::string(argv[argc-1]).substr(9);
+    argc--;
+  }
   switch(argc) {
   case 1:
     //no arguments
@@ -50,10 +55,11 @@ static void usage(const char* exeName)
 {
   printf("hiOp driver %s that solves a synthetic convex problem of variable size.\n", exeName);
   printf("Usage: \n");
-  printf("  '$ %s problem_size -selfcheck'\n", exeName);
+  printf("  '$ %s problem_size -selfcheck -hessian=value'\n", exeName);
   printf("Arguments:\n");
   printf("  'problem_size': number of decision variables [optional, default is 50k]\n");
   printf("  '-selfcheck': compares the optimal objective with a previously saved value for the problem specified by 'problem_size'. [optional]\n");
+  printf("  '-hessian=value': value of the option 'Hessian', e.g., quasinewton_lsr1. [optional]\n");
 }
 
 
@@ -66,13 +72,16 @@ int main(int argc, char **argv)
   assert(MPI_SUCCESS==ierr);
   //if(0==rank) printf("Support for MPI is enabled\n");
 #endif
-  bool selfCheck; long long n;
-  if(!parse_arguments(argc, argv, n, selfCheck)) { usage(argv[0]); return 1;}
+  bool selfCheck; long long n; std::string hessian;
+  if(!parse_arguments(argc, argv, n, selfCheck, hessian)) { usage(argv[0]); return 1;}
 
   Ex2 nlp_interface(n);
   //if(rank==0) printf("interface created\n");
   hiopNlpDenseConstraints nlp(nlp_interface);
   //if(rank==0) printf("nlp formulation created\n");
+  if(!hessian.empty()) {
+    nlp.options->SetStringValue("Hessian", hessian.c_str());
+  }
 
   hiopAlgFilterIPM solver(&nlp);
   hiopSolveStatus status = solver.run();
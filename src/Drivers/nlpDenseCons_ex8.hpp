@@ -0,0 +1,175 @@
+#ifndef HIOP_EXAMPLE_EX8
+#define  HIOP_EXAMPLE_EX8
+
+#include "hiopInterface.hpp"
+
+#ifdef HIOP_USE_MPI
+#include "mpi.h"
+#else
+#define MPI_COMM_WORLD 0
+#define MPI_Comm int
+#endif
+
+#include <cassert>
+#include <cstring> //for memcpy
+#include <cstdio>
+#include <cmath>
+
+/* Problem test with nonlinear constraints, whose Jacobians change from one iteration to
+ * the next.
+ *  min   sum 1/2* { (x_{i}-2)^2 : i=1,...,n}
+ *  s.t.
+ *        sum {x_i^2 : i=1,...,n} = n
+ *        sum {exp(x_i-1) : i=1,3,5,...} <= 0.8*ceil(n/2)
+ *        -3 <= x_i <= 3, i=1,...,n
+ */
+class Ex8 : public hiop::hiopInterfaceDenseConstraints
+{
+public:
+  Ex8(int n)
+    : n_vars(n), n_cons(2), comm(MPI_COMM_WORLD)
+  {
+    comm_size=1; my_rank=0;
+#ifdef HIOP_USE_MPI
+    int ierr = MPI_Comm_size(comm, &comm_size); assert(MPI_SUCCESS==ierr);
+    ierr = MPI_Comm_rank(comm, &my_rank); assert(MPI_SUCCESS==ierr);
+#endif
+
+    // set up vector distribution for primal variables - easier to store it as a member in this simple example
+    col_partition = new long long[comm_size+1];
+    long long quotient=n_vars/comm_size, remainder=n_vars-comm_size*quotient;
+    int i=0; col_partition[i]=0; i++;
+    while(i<=remainder) { col_partition[i] = col_partition[i-1]+quotient+1; i++; }
+    while(i<=comm_size) { col_partition[i] = col_partition[i-1]+quotient;   i++; }
+  };
+
+  virtual ~Ex8()
+  {
+    delete[] col_partition;
+  };
+
+  virtual bool get_prob_sizes(long long& n, long long& m)
+  { n=n_vars; m=n_cons; return true; }
+
+  virtual bool get_vars_info(const long long& n, double *xlow, double* xupp, NonlinearityType* type)
+  {
+    assert(n==n_vars);
+    long long n_local=col_partition[my_rank+1]-col_partition[my_rank];
+    for(int i=0; i<n_local; i++) {
+      xlow[i]=-3.; xupp[i]=3.; type[i]=hiopNonlinear;
+    }
+    return true;
+  }
+
+  virtual bool get_cons_info(const long long& m, double* clow, double* cupp, NonlinearityType* type)
+  {
+    assert(m==n_cons);
+    clow[0]= n_vars; cupp[0]= n_vars;                type[0]=hiopInterfaceBase::hiopNonlinear;
+    clow[1]= -1e20;  cupp[1]= 0.8*((n_vars+1)/2);    type[1]=hiopInterfaceBase::hiopNonlinear;
+    return true;
+  }
+
+  virtual bool eval_f(const long long& n, const double* x, bool new_x, double& obj_value)
+  {
+    long long n_local=col_partition[my_rank+1]-col_partition[my_rank];
+    obj_value=0.;
+    for(int i=0;i<n_local;i++) obj_value += 0.5*(x[i]-2.)*(x[i]-2.);
+#ifdef HIOP_USE_MPI
+    double obj_global;
+    int ierr=MPI_Allreduce(&obj_value, &obj_global, 1, MPI_DOUBLE, MPI_SUM, comm); assert(ierr==MPI_SUCCESS);
+    obj_value=obj_global;
+#endif
+    return true;
+  }
+
+  virtual bool eval_cons(const long long& n, const long long& m,
+			 const long long& num_cons, const long long* idx_cons,
+			 const double* x, bool new_x, double* cons)
+  {
+    assert(n==n_vars); assert(m==n_cons);
+    assert(num_cons<=m); assert(num_cons>=0);
+    long long n_local=col_partition[my_rank+1]-col_partition[my_rank];
+    for(int itcon=0; itcon<num_cons; itcon++) {
+      cons[itcon]=0.;
+      // --- constraint 1 body ---> sum x_i^2
+      if(idx_cons[itcon]==0) {
+	for(int i=0;i<n_local;i++) cons[itcon] += x[i]*x[i];
+	continue;
+      }
+      // --- constraint 2 body ---> sum {exp(x_i-1) : i=1,3,5,...} (even global indexes)
+      if(idx_cons[itcon]==1) {
+	for(int i=0;i<n_local;i++)
+	  if(idx_local2global(n,i)%2==0) cons[itcon] += exp(x[i]-1.);
+	continue;
+      }
+    }
+#ifdef HIOP_USE_MPI
+    double* cons_global=new double[num_cons];
+    int ierr=MPI_Allreduce(cons, cons_global, num_cons, MPI_DOUBLE, MPI_SUM, comm); assert(ierr==MPI_SUCCESS);
+    memcpy(cons, cons_global, num_cons*sizeof(double));
+    delete[] cons_global;
+#endif
+    return true;
+  }
+
+  virtual bool eval_grad_f(const long long& n, const double* x, bool new_x, double* gradf)
+  {
+    long long n_local=col_partition[my_rank+1]-col_partition[my_rank];
+    for(int i=0;i<n_local;i++) gradf[i] = x[i]-2.;
+    return true;
+  }
+
+  virtual bool eval_Jac_cons(const long long& n, const long long& m,
+                             const long long& num_cons, const long long* idx_cons,
+                             const double* x, bool new_x, double* Jac)
+  {
+    assert(n==n_vars); assert(m==n_cons);
+    long long n_local=col_partition[my_rank+1]-col_partition[my_rank];
+    for(int itcon=0; itcon<num_cons; itcon++) {
+      if(idx_cons[itcon]==0) {
+	for(int i=0; i<n_local; i++) Jac[itcon*n_local+i] = 2*x[i];
+	continue;
+      }
+      if(idx_cons[itcon]==1) {
+	for(int i=0; i<n_local; i++)
+	  Jac[itcon*n_local+i] = idx_local2global(n,i)%2==0 ? exp(x[i]-1.) : 0.;
+	continue;
+      }
+    }
+    return true;
+  };
+
+  virtual bool get_vecdistrib_info(long long global_n, long long* cols)
+  {
+    if(global_n==n_vars)
+      for(int i=0; i<=comm_size; i++) cols[i]=col_partition[i];
+    else
+      assert(false && "You shouldn't need distrib info for this size.");
+    return true;
+  }
+
+  virtual bool get_starting_point(const long long& global_n, double* x0)
+  {
+    assert(global_n==n_vars);
+    long long n_local=col_partition[my_rank+1]-col_partition[my_rank];
+    for(int i=0; i<n_local; i++)
+      x0[i]=0.5;
+    return true;
+  }
+
+private:
+  int n_vars, n_cons;
+  MPI_Comm comm;
+  int my_rank, comm_size;
+  long long* col_partition;
+public:
+  inline long long idx_local2global(long long global_n, int idx_local)
+  {
+    assert(idx_local + col_partition[my_rank]<col_partition[my_rank+1]);
+    if(global_n==n_vars)
+      return idx_local + col_partition[my_rank];
+    assert(false && "you shouldn't need global index for a vector of this size.");
+    return -1;
+  }
+};
+#endif
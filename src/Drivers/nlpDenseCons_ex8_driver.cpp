@@ -0,0 +1,258 @@
+#include "nlpDenseCons_ex8.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace hiop;
+
+static bool self_check(long long n, double obj_value);
+static bool self_check_double_buffering(long long n, int num_iter, double obj_value);
+static bool self_check_checkpoint(long long n, int num_iter, double obj_value, const double* x);
+
+static bool parse_arguments(int argc, char **argv, long long& n, bool& self_check)
+{
+  self_check=false; n = 500;
+  switch(argc) {
+  case 1:
+    //no arguments
+    return true;
+    break;
+  case 3: //2 arguments
+    {
+      if(std::string(argv[2]) == "-selfcheck")
+	self_check=true;
+      else {
+	n = std::atoi(argv[2]);
+	if(n<=0) return false;
+      }
+    }
+  case 2: //1 argument
+    {
+      if(std::string(argv[1]) == "-selfcheck")
+	self_check=true;
+      else {
+	n = std::atoi(argv[1]);
+	if(n<=0) return false;
+      }
+    }
+    break;
+  default:
+    return false; //3 or more arguments
+  }
+
+  return true;
+};
+
+static void usage(const char* exeName)
+{
+  printf("hiOp driver %s that solves a synthetic problem of variable size with nonlinear constraints.\n", exeName);
+  printf("Usage: \n");
+  printf("  '$ %s problem_size -selfcheck'\n", exeName);
+  printf("Arguments:\n");
+  printf("  'problem_size': number of decision variables [optional, default is 500]\n");
+  printf("  '-selfcheck': compares the optimal objective with a previously saved value for the problem "
+         "specified by 'problem_size' and checks that the solves below give the same solution. [optional]\n");
+}
+
+
+int main(int argc, char **argv)
+{
+  int rank=0;
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int ierr = MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+  assert(MPI_SUCCESS==ierr);
+#endif
+  bool selfCheck; long long n;
+  if(!parse_arguments(argc, argv, n, selfCheck)) { usage(argv[0]); return 1;}
+
+  Ex8 nlp_interface(n);
+  hiopNlpDenseConstraints nlp(nlp_interface);
+
+  hiopAlgFilterIPM solver(&nlp);
+  hiopSolveStatus status = solver.run();
+  double obj_value = solver.getObjective();
+
+  if(status<0) {
+    if(rank==0) printf("solver returned negative solve status: %d (with objective is %18.12e)\n", status, obj_value);
+    return -1;
+  }
+
+  //this is used for "regression" testing when the driver is called with -selfcheck
+  if(selfCheck) {
+    if(!self_check(n, obj_value))
+      return -1;
+    if(!self_check_double_buffering(n, solver.getNumIterations(), obj_value))
+      return -1;
+    std::vector<double> x(n, 0.);
+    solver.getSolution(x.data());
+    if(!self_check_checkpoint(n, solver.getNumIterations(), obj_value, x.data()))
+      return -1;
+
+    //re-solve the same problem: the KKT linear system and the scaling are reused by 'resolve'
+    const int num_iter = solver.getNumIterations();
+    status = solver.resolve();
+    if(status<0 || solver.getNumIterations()!=num_iter ||
+       fabs(solver.getObjective()-obj_value)>1e-6*(1+fabs(obj_value))) {
+      if(rank==0)
+        printf("selfcheck failure. Resolve returned status %d and objective %18.12e (in %d iterations); "
+               "expected objective %18.12e (in %d iterations)\n",
+               status, solver.getObjective(), solver.getNumIterations(), obj_value, num_iter);
+      return -1;
+    }
+    if(rank==0) printf("selfcheck success: same iterations (%d) and objective with resolve\n", num_iter);
+  } else {
+    if(rank==0) {
+      printf("Optimal objective: %22.14e. Solver status: %d\n", obj_value, status);
+    }
+  }
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+
+  return 0;
+}
+
+
+static bool self_check(long long n, double objval)
+{
+#define num_n_saved 2 //keep this is sync with n_saved and objval_saved
+  const long long n_saved[] = {500, 5000};
+  const double objval_saved[] = {2.70705025402e+02, 2.70705025401e+03};
+
+#define relerr 1e-6
+  bool found=false;
+  for(int it=0; it<num_n_saved; it++) {
+    if(n_saved[it]==n) {
+      found=true;
+      if(fabs( (objval_saved[it]-objval)/(1+objval_saved[it])) > relerr) {
+	printf("selfcheck failure. Objective (%18.12e) does not agree (%d digits) with the saved value (%18.12e) for n=%lld.\n",
+	       objval, -(int)log10(relerr), objval_saved[it], n);
+	return false;
+      } else {
+	printf("selfcheck success (%d digits)\n",  -(int)log10(relerr));
+      }
+      break;
+    }
+  }
+
+  if(!found) {
+    printf("selfcheck: driver does not have the objective for n=%lld saved. BTW, obj=%18.12e was obtained for this n.\n", n, objval);
+    return false;
+  }
+
+  return true;
+}
+
+/* Solves again with a memory budget too small for the Jacobians at the trial point, in which
+ * case the derivatives are evaluated in place instead of being double buffered. Both solves
+ * should take the same iterations to the same objective. */
+static bool self_check_double_buffering(long long n, int num_iter, double objval)
+{
+  Ex8 nlp_interface(n);
+  hiopNlpDenseConstraints nlp(nlp_interface);
+  nlp.options->SetNumericValue("memory_budget", 1e-6);
+
+  hiopAlgFilterIPM solver(&nlp);
+  hiopSolveStatus status = solver.run();
+  if(status<0) {
+    printf("selfcheck failure. Solve without double buffering returned status %d.\n", status);
+    return false;
+  }
+  if(solver.getNumIterations()!=num_iter ||
+     fabs(solver.getObjective()-objval) > relerr*(1+fabs(objval))) {
+    printf("selfcheck failure. Solve without double buffering took %d iterations to objective %18.12e "
+           "instead of %d iterations to %18.12e.\n",
+           solver.getNumIterations(), solver.getObjective(), num_iter, objval);
+    return false;
+  }
+  printf("selfcheck success: same iterations (%d) without double buffering\n", num_iter);
+  return true;
+}
+
+/* Counts the iterations done by a solve and records the first one, which is the iteration
+ * of the checkpoint when the solve is restarted. */
+class Ex8Counted : public Ex8
+{
+public:
+  Ex8Counted(int n) : Ex8(n), num_calls(0), first_iter(-1) {}
+  virtual bool iterate_callback(int iter, double obj_value, int n, const double* x,
+                                const double* z_L, const double* z_U, int m, const double* g,
+                                const double* lambda, double inf_pr, double inf_du, double mu,
+                                double alpha_du, double alpha_pr, int ls_trials)
+  {
+    if(0==num_calls) first_iter = iter;
+    num_calls++;
+    return true;
+  }
+  int num_calls, first_iter;
+};
+
+/* Stops a solve half way with a checkpoint saved at that iteration, then restarts from the
+ * checkpoint. The restarted solve should reach the same iterate and objective as the
+ * uninterrupted solve in the remaining iterations only. */
+static bool self_check_checkpoint(long long n, int num_iter, double objval, const double* x_ref)
+{
+  const char* ckpt_file = "nlpDenseCons_ex8.ckpt";
+  const int iter_save = num_iter>1 ? num_iter/2 : 1;
+  bool bret = true;
+  {
+    Ex8 nlp_interface(n);
+    hiopNlpDenseConstraints nlp(nlp_interface);
+    nlp.options->SetStringValue("checkpoint_save", "yes");
+    nlp.options->SetIntegerValue("checkpoint_save_N", iter_save);
+    nlp.options->SetStringValue("checkpoint_file", ckpt_file);
+    nlp.options->SetIntegerValue("max_iter", iter_save);
+
+    hiopAlgFilterIPM solver(&nlp);
+    hiopSolveStatus status = solver.run();
+    if(status!=Max_Iter_Exceeded) {
+      printf("selfcheck failure. Solve interrupted at iteration %d returned status %d.\n", iter_save, status);
+      bret = false;
+    }
+  }
+  if(bret) {
+    Ex8Counted nlp_interface(n);
+    hiopNlpDenseConstraints nlp(nlp_interface);
+    nlp.options->SetStringValue("checkpoint_load_on_start", "yes");
+    nlp.options->SetStringValue("checkpoint_file", ckpt_file);
+
+    hiopAlgFilterIPM solver(&nlp);
+    hiopSolveStatus status = solver.run();
+    std::vector<double> x(n, 0.);
+    solver.getSolution(x.data());
+    double diff = 0.;
+    for(long long i=0; i<n; i++) diff = fmax(diff, fabs(x[i]-x_ref[i])/(1+fabs(x_ref[i])));
+
+    if(status<0 || nlp_interface.first_iter!=iter_save ||
+       nlp_interface.num_calls>=num_iter+1 || solver.getNumIterations()!=num_iter) {
+      printf("selfcheck failure. Solve restarted from the checkpoint at iteration %d returned status %d "
+             "at iteration %d after %d iterations (restarted at iteration %d) instead of %d.\n",
+             iter_save, status, solver.getNumIterations(), nlp_interface.num_calls-1,
+             nlp_interface.first_iter, num_iter-iter_save);
+      bret = false;
+    } else if(fabs(solver.getObjective()-objval) > relerr*(1+fabs(objval)) || diff > relerr) {
+      printf("selfcheck failure. Solve restarted from the checkpoint reached objective %18.12e instead of "
+             "%18.12e and a solution that differs by %g.\n", solver.getObjective(), objval, diff);
+      bret = false;
+    } else {
+      printf("selfcheck success: restart from the checkpoint at iteration %d took %d iterations instead of %d\n",
+             iter_save, nlp_interface.num_calls-1, num_iter);
+    }
+  }
+  //each rank writes its own file when there is more than one rank
+  std::string ckpt_rank_file = ckpt_file;
+#ifdef HIOP_USE_MPI
+  int comm_size, rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if(comm_size>1) ckpt_rank_file += "." + std::to_string(rank);
+#endif
+  remove(ckpt_rank_file.c_str());
+  return bret;
+}
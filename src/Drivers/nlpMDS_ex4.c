@@ -13,6 +13,7 @@ typedef struct settings {
   int nnz_sparse_Hess_Lagr_SS; int nnz_sparse_Hess_Lagr_SD;
   double* xlow; double* xupp; double* clow; double* cupp;
   double* Q; double* Md; double* buf_y;
+  int num_iter;
 } settings;
 
 // y := alpha*A*x + beta*y
@@ -278,6 +279,18 @@ int eval_Hess_Lagr(long long n, long long m,
   return 0;
 }
 
+int iterate_callback(int iter, double obj_value,
+                     long long n, const double* x,
+                     const double* z_L, const double* z_U,
+                     long long m, const double* g, const double* lambda,
+                     double inf_pr, double inf_du, double mu,
+                     double alpha_du, double alpha_pr, int ls_trials,
+                     void* user_data_) {
+  settings* user_data = (settings*) user_data_;
+  user_data->num_iter = iter;
+  //zero means continue
+  return 0;
+}
 
 int main(int argc, char **argv) {
   int rank=0;
@@ -348,7 +361,7 @@ int main(int argc, char **argv) {
   settings user_data = {n, m, ns, nd, nx_sparse, nx_dense, nnz_sparse_Jaceq, nnz_sparse_Jacineq,
                         nnz_sparse_Hess_Lagr_SS, nnz_sparse_Hess_Lagr_SD,
                         xlow, xupp, clow, cupp,
-                        Q,  Md, buf_y};
+                        Q,  Md, buf_y, 0};
                         
   cHiopProblem problem;
   problem.user_data = &user_data;
@@ -366,7 +379,16 @@ int main(int argc, char **argv) {
   for(int i=0; i<n; i++) problem.solution[i] = 0.0;
   
   hiop_createProblem(&problem);
-  hiop_solveProblem(&problem);
+  hiop_setIterateCallback(&problem, iterate_callback);
+  int status = hiop_solveProblem(&problem);
+  if(status!=0) {
+    printf("solve failed with status %d for Ex4 MDS C interface problem\n", status);
+    return -1;
+  }
+  if(user_data.num_iter<=0) {
+    printf("iterate callback was not called for Ex4 MDS C interface problem\n");
+    return -1;
+  }
   if(fabs(problem.obj_value-(-4.999509728895e+01))>1e-6) {
     printf("objective mismatch for Ex4 MDS C interface problem with 400 sparse variables and 100 "
       "dense variables did. BTW, obj=%18.12e was returned by HiOp.\n", problem.obj_value);
@@ -17,12 +17,21 @@ static bool parse_arguments(int argc, char **argv,
 			    bool& self_check,
 			    long long& n_sp,
 			    long long& n_de,
-			    bool& one_call_cons)
+			    bool& one_call_cons,
+			    std::string& hessian)
 {
   self_check=false;
   n_sp = 1000;
   n_de = 1000;
   one_call_cons = false;
+  hessian = "";
+
+  //the optional '-hessian=...' is the last argument
+  if(argc>1 && std::string(argv[argc-1]).compare(0, 9, "-hessian=")==0) {
+    hessian = std::string(argv[argc-1]).substr(9);
+    argc--;
+  }
+
   switch(argc) {
   case 1:
     //no arguments
@@ -63,7 +72,7 @@ static void usage(const char* exeName)
   printf("HiOp driver %s that solves a synthetic problem of variable size in the "
 	 "mixed dense-sparse formulation.\n", exeName);
   printf("Usage: \n");
-  printf("  '$ %s sp_vars_size de_vars_size eq_ineq_combined_nlp -selfcheck'\n", exeName);
+  printf("  '$ %s sp_vars_size de_vars_size eq_ineq_combined_nlp -selfcheck -hessian=value'\n", exeName);
   printf("Arguments, all integers, excepting string '-selfcheck'\n");
   printf("  'sp_vars_size': # of sparse variables [default 400, optional]\n");
   printf("  'de_vars_size': # of dense variables [default 100, optional]\n");
@@ -71,6 +80,8 @@ static void usage(const char* exeName)
 	 "de_vars_size being 100 (these two exact values must be passed as arguments). [optional]\n");
   printf("  'eq_ineq_combined_nlp': 0 or 1, specifying whether the NLP formulation with split "
 	 "constraints should be used (0) or not (1) [default 0, optional]\n");
+  printf("  '-hessian=value': value of the option 'Hessian', e.g., quasinewton_approx; the quasi-Newton "
+	 "solves use the tolerance 1e-4 and the objective is checked within 5e-3 [optional]\n");
 }
 
 
@@ -96,7 +107,8 @@ int main(int argc, char **argv)
 
   bool selfCheck, one_call_cons;
   long long n_sp, n_de;
-  if(!parse_arguments(argc, argv, selfCheck, n_sp, n_de, one_call_cons)) {
+  std::string hessian;
+  if(!parse_arguments(argc, argv, selfCheck, n_sp, n_de, one_call_cons, hessian)) {
     usage(argv[0]);
     return 1;
   }
@@ -117,13 +129,19 @@ int main(int argc, char **argv)
   nlp.options->SetStringValue("duals_update_type", "linear");
   nlp.options->SetStringValue("duals_init", "zero");
 
-  nlp.options->SetStringValue("Hessian", "analytical_exact");
+  //the secant approximation converges linearly near the solution, hence the looser tolerance
+  const bool quasi_newton = !hessian.empty() && hessian!="analytical_exact";
+  const double tolerance = quasi_newton ? 1e-4 : 1e-5;
+  const double tolerance_warm_start = quasi_newton ? 1e-4 : 1e-8;
+  const double obj_check_tol = quasi_newton ? 5e-3 : 1e-6;
+
+  nlp.options->SetStringValue("Hessian", quasi_newton ? hessian.c_str() : "analytical_exact");
   nlp.options->SetStringValue("KKTLinsys", "xdycyd");
   nlp.options->SetStringValue("compute_mode", "hybrid");
 
   nlp.options->SetIntegerValue("verbosity_level", 3);
   nlp.options->SetNumericValue("mu0", 1e-1);
-  nlp.options->SetNumericValue("tolerance", 1e-5);
+  nlp.options->SetNumericValue("tolerance", tolerance);
 
   hiopAlgFilterIPMNewton solver(&nlp);
   status = solver.run();
@@ -135,13 +153,23 @@ int main(int argc, char **argv)
     return -1;
   }
 
-#if 0
+  if(selfCheck) {
+    //re-solve the same problem: allocations, KKT linear system and scaling are reused by 'resolve'
+    status = solver.resolve();
+    if(status<0 || fabs(solver.getObjective()-obj_value)>1e-6*fmax(1., fabs(obj_value))) {
+      if(rank==0)
+        printf("selfcheck: resolve returned status %d and objective %18.12e; expected objective %18.12e\n",
+               status, solver.getObjective(), obj_value);
+      return -1;
+    }
+  }
+
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   // Reoptimize
   // -----------
   // 1. get solution from previous solve
   // 2. give it to the (user's) nlp, which will provide HiOp a full primal-dual restart via
-  // 'get_starting_point' callback
+  // 'get_starting_point' callback, which is used to warm start the solver (option 'warm_start')
   // Normally, the user would also change her nlp between steps 1 and 2 above, for example, different
   // bounds on variables or on inequalities
   ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -164,14 +192,11 @@ int main(int argc, char **argv)
   // set options for solver re-optimization
   //
   
-  //less agressive log-barrier parameter is always a safe bet
-  nlp.options->SetNumericValue("mu0", 1e-6);
-  nlp.options->SetNumericValue("tolerance", 1e-8);
+  //initial log-barrier parameter and bounds push are chosen based on the primal-dual restart point
+  nlp.options->SetStringValue("warm_start", "yes");
+  nlp.options->SetNumericValue("tolerance", tolerance_warm_start);
 
   //nlp.options->SetIntegerValue("verbosity_level", 7);
-
-  //nlp.options->SetNumericValue("kappa1", 1e-15);
-  //nlp.options->SetNumericValue("kappa2", 1e-15);
   
   //solve
   status = solver.run();
@@ -184,7 +209,7 @@ int main(int argc, char **argv)
   }
 
   if(selfCheck) {
-    if(fabs(obj_value-(-4.999509728895e+01))>1e-6) {
+    if(fabs(obj_value-(-4.999509728895e+01))>obj_check_tol) {
       printf("selfcheck: objective mismatch for Ex4 MDS problem with 400 sparse variables and 100 "
 	     "dense variables did. BTW, obj=%18.12e was returned by HiOp.\n", obj_value);
       return -1;
@@ -195,8 +220,6 @@ int main(int argc, char **argv)
     }
   }
 
-#endif
-
   delete my_nlp;
   
 #ifdef HIOP_USE_MAGMA
@@ -17,12 +17,19 @@ static bool parse_arguments(int argc, char **argv,
 			    bool& self_check,
 			    long long& n_sp,
 			    long long& n_de,
-			    bool& rdJac)
+			    bool& rdJac,
+			    bool& early_term)
 {
-  self_check = rdJac = false;
+  self_check = rdJac = early_term = false;
   n_sp = 400;
   n_de = 100;
 
+  //the optional '-earlyterm' is the last argument
+  if(argc>1 && std::string(argv[argc-1]) == "-earlyterm") {
+    early_term = true;
+    argc--;
+  }
+
   switch(argc) {
   case 1:
     //no arguments
@@ -75,8 +82,8 @@ static void usage(const char* exeName)
 	 "solve additional problems that have rank-deficient Jacobian (use '-withrdJ' option)\n", 
 	 exeName);
   printf("Usage: \n");
-  printf("  '$ %s sp_vars_size de_vars_size -selfcheck -withrdJ'\n", exeName);
-  printf("Arguments, all integers, excepting strings '-selfcheck' and '-withrdJ', should be "
+  printf("  '$ %s sp_vars_size de_vars_size -selfcheck -withrdJ -earlyterm'\n", exeName);
+  printf("Arguments, all integers, excepting strings '-selfcheck', '-withrdJ' and '-earlyterm', should be "
 	 "specified in the order below.\n");
   printf("  'sp_vars_size': # of sparse variables [default 400, optional, nonnegative integer].\n");
   printf("  'de_vars_size': # of dense variables [default 100, optional, nonnegative integer].\n");
@@ -84,6 +91,8 @@ static void usage(const char* exeName)
 	 "de_vars_size being 100 (these two exact values must be passed as arguments). [optional]\n");
   printf("  '-withrdJ': solves additional problems with rank-deficient Jacobians; discards "
 	 "'-selfcheck' option. [optional]\n");
+  printf("  '-earlyterm': solves the nonconvex problem with 'max_iter' 30 and 'early_termination' on; with "
+	 "'-selfcheck', checks that the solve stops early with the best iterate instead of the objective. [optional]\n");
 }
 
 
@@ -107,9 +116,9 @@ int main(int argc, char **argv)
   magma_init();
 #endif
 
-  bool selfCheck, rdJac;
+  bool selfCheck, rdJac, earlyTerm;
   long long n_sp, n_de;
-  if(!parse_arguments(argc, argv, selfCheck, n_sp, n_de, rdJac)) {
+  if(!parse_arguments(argc, argv, selfCheck, n_sp, n_de, rdJac, earlyTerm)) {
     usage(argv[0]);
     return 1;
   }
@@ -212,9 +221,32 @@ int main(int argc, char **argv)
     
     nlp.options->SetIntegerValue("verbosity_level", 3);
     nlp.options->SetNumericValue("mu0", 1e-1);
+    if(earlyTerm) {
+      //the solve needs 70 iterations, which the convergence rate predicts well before the 30th
+      nlp.options->SetIntegerValue("max_iter", 30);
+      nlp.options->SetStringValue("early_termination", "yes");
+    }
     hiopAlgFilterIPMNewton solver(&nlp);
     status3 = solver.run();
     obj_value3 = solver.getObjective();
+
+    if(earlyTerm && selfCheck) {
+      //the best iterate, not the last one, is returned: its objective must match the one reported
+      long long n, m;
+      nlp_interface->get_prob_sizes(n, m);
+      double* x = new double[n];
+      double obj_x;
+      solver.getSolution(x);
+      nlp_interface->eval_f(n, x, true, obj_x);
+      delete[] x;
+      if(status3!=Slow_Convergence || solver.getNumIterations()>=30 ||
+         fabs(obj_x-obj_value3)>1e-8*fmax(1., fabs(obj_value3))) {
+	printf("selfcheck3: early termination returned status %d after %d iterations with objective "
+	       "%18.12e at the solution; expected status %d before 30 iterations and objective %18.12e\n",
+	       status3, solver.getNumIterations(), obj_x, Slow_Convergence, obj_value3);
+	return -1;
+      }
+    }
     
     delete nlp_interface;
     
@@ -272,7 +304,7 @@ int main(int argc, char **argv)
     // 	     "dense variables did. BTW, obj=%18.12e was returned by HiOp.\n", obj_value2);
     //   selfcheck_ok = false;
     // }
-    if((fabs(obj_value3-(-3.160999998751e+03))/3.160999998751e+03)>1e-6) {
+    if(!earlyTerm && (fabs(obj_value3-(-3.160999998751e+03))/3.160999998751e+03)>1e-6) {
       printf("selfcheck3: objective mismatch for Ex5 MDS problem with 400 sparse variables and 100 "
 	     "dense variables did. BTW, obj=%18.12e was returned by HiOp.\n", obj_value3);
       selfcheck_ok = false;
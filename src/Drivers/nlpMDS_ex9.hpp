@@ -0,0 +1,201 @@
+#ifndef HIOP_EXAMPLE_EX9
+#define HIOP_EXAMPLE_EX9
+
+#include "hiopInterface.hpp"
+
+#ifdef HIOP_USE_MPI
+#include "mpi.h"
+#else
+#define MPI_COMM_WORLD 0
+#define MPI_COMM_SELF 0
+#define MPI_Comm int
+#endif
+
+#include <cassert>
+#include <cstring> //for memset
+#include <cstdio>
+#include <cmath>
+
+/** Problem test for the feasibility restoration of the Filter IPM Newton of HiOp. It uses the
+ * mixed Dense-Sparse NLP formulation. The sparse part is the example of Wachter and Biegler
+ * ("Failure of global convergence for a class of interior point methods for nonlinear
+ * programming", Math. Prog. 88, 2000), for which the line search of interior point methods
+ * stalls from the starting point below. The dense part is a decoupled convex quadratic.
+ *
+ *  min   x_1 + 0.5 sum {(y_i-1)^2 : i=1,...,nd}
+ *  s.t.  x_1^2 - x_2 - 1   = 0
+ *        x_1   - x_3 - 2   = 0
+ *        x_2, x_3 >= 0, x_1 and y free
+ *
+ * with the starting point x=(-2, 3, 1), y=0. The solution is x=(2, 3, 0), y=1 with objective 2.
+ *
+ * Coding of the problem in MDS HiOp input: order of variables need to be [x,y] since x are
+ * the so-called sparse variables and y are the dense variables
+ */
+class Ex9 : public hiop::hiopInterfaceMDS
+{
+public:
+  Ex9(int nd)
+    : nd_(nd<0 ? 0 : nd)
+  {
+  }
+
+  virtual ~Ex9()
+  {
+  }
+
+  bool get_prob_sizes(long long& n, long long& m)
+  {
+    n = ns_ + nd_;
+    m = 2;
+    return true;
+  }
+
+  bool get_vars_info(const long long& n, double *xlow, double* xupp, NonlinearityType* type)
+  {
+    assert(n == ns_ + nd_);
+    xlow[0] = -1e+20; xupp[0] = 1e+20;
+    xlow[1] = 0.;     xupp[1] = 1e+20;
+    xlow[2] = 0.;     xupp[2] = 1e+20;
+    for(int i=ns_; i<n; ++i) {
+      xlow[i] = -1e+20; xupp[i] = 1e+20;
+    }
+    for(int i=0; i<n; ++i) type[i]=hiopNonlinear;
+    return true;
+  }
+
+  bool get_cons_info(const long long& m, double* clow, double* cupp, NonlinearityType* type)
+  {
+    assert(m == 2);
+    clow[0] = cupp[0] = 1.;
+    clow[1] = cupp[1] = 2.;
+    type[0] = hiopNonlinear; type[1] = hiopLinear;
+    return true;
+  }
+
+  bool get_sparse_dense_blocks_info(int& nx_sparse, int& nx_dense,
+				    int& nnz_sparse_Jace, int& nnz_sparse_Jaci,
+				    int& nnz_sparse_Hess_Lagr_SS, int& nnz_sparse_Hess_Lagr_SD)
+  {
+    nx_sparse = ns_;
+    nx_dense = nd_;
+    nnz_sparse_Jace = 4;
+    nnz_sparse_Jaci = 0;
+    nnz_sparse_Hess_Lagr_SS = ns_;
+    nnz_sparse_Hess_Lagr_SD = 0;
+    return true;
+  }
+
+  bool eval_f(const long long& n, const double* x, bool new_x, double& obj_value)
+  {
+    const double* y = x+ns_;
+    obj_value = x[0];
+    for(int i=0; i<nd_; i++) obj_value += 0.5*(y[i]-1.)*(y[i]-1.);
+    return true;
+  }
+
+  virtual bool eval_cons(const long long& n, const long long& m,
+			 const long long& num_cons, const long long* idx_cons,
+			 const double* x, bool new_x, double* cons)
+  {
+    //return false so that HiOp will rely on the on-call constraint evaluator defined below
+    return false;
+  }
+  bool eval_cons(const long long& n, const long long& m,
+		 const double* x, bool new_x, double* cons)
+  {
+    assert(n == ns_+nd_); assert(m == 2);
+    cons[0] = x[0]*x[0] - x[1];
+    cons[1] = x[0] - x[2];
+    return true;
+  }
+
+  bool eval_grad_f(const long long& n, const double* x, bool new_x, double* gradf)
+  {
+    const double* y = x+ns_;
+    gradf[0] = 1.; gradf[1] = gradf[2] = 0.;
+    for(int i=0; i<nd_; i++) gradf[ns_+i] = y[i]-1.;
+    return true;
+  }
+
+  virtual bool
+  eval_Jac_cons(const long long& n, const long long& m,
+		const long long& num_cons, const long long* idx_cons,
+		const double* x, bool new_x,
+		const long long& nsparse, const long long& ndense,
+		const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS,
+		double* JacD)
+  {
+    //return false so that HiOp will rely on the on-call constraint evaluator defined below
+    return false;
+  }
+
+  virtual bool
+  eval_Jac_cons(const long long& n, const long long& m,
+		const double* x, bool new_x,
+		const long long& nsparse, const long long& ndense,
+		const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS,
+		double* JacD)
+  {
+    assert(m == 2); assert(nnzJacS == 4);
+    if(iJacS!=NULL && jJacS!=NULL) {
+      iJacS[0] = 0; jJacS[0] = 0;
+      iJacS[1] = 0; jJacS[1] = 1;
+      iJacS[2] = 1; jJacS[2] = 0;
+      iJacS[3] = 1; jJacS[3] = 2;
+    }
+    if(MJacS!=NULL) {
+      MJacS[0] = 2*x[0];
+      MJacS[1] = -1.;
+      MJacS[2] = 1.;
+      MJacS[3] = -1.;
+    }
+    //the constraints do not depend on y
+    if(JacD!=NULL) {
+      memset(JacD, 0, m*nd_*sizeof(double));
+    }
+    return true;
+  }
+
+  bool eval_Hess_Lagr(const long long& n, const long long& m,
+                      const double* x, bool new_x, const double& obj_factor,
+                      const double* lambda, bool new_lambda,
+                      const long long& nsparse, const long long& ndense,
+                      const int& nnzHSS, int* iHSS, int* jHSS, double* MHSS,
+                      double* HDD,
+                      int& nnzHSD, int* iHSD, int* jHSD, double* MHSD)
+  {
+    assert(nnzHSS==ns_);
+    assert(nnzHSD==0);
+
+    if(iHSS!=NULL && jHSS!=NULL) {
+      for(int i=0; i<ns_; i++) iHSS[i] = jHSS[i] = i;
+    }
+    //only the first constraint is nonlinear
+    if(MHSS!=NULL) {
+      MHSS[0] = 2*lambda[0];
+      MHSS[1] = MHSS[2] = 0.;
+    }
+    if(HDD!=NULL) {
+      for(int i=0; i<nd_*nd_; i++) HDD[i] = 0.;
+      for(int i=0; i<nd_; i++) HDD[i*nd_+i] = obj_factor;
+    }
+    return true;
+  }
+
+  bool get_starting_point(const long long& global_n, double* x0)
+  {
+    assert(global_n==ns_+nd_);
+    x0[0] = -2.; x0[1] = 3.; x0[2] = 1.;
+    for(int i=ns_; i<global_n; i++) x0[i] = 0.;
+    return true;
+  }
+
+  /** pass the COMM_SELF communicator since this example is only intended to run inside 1 MPI process */
+  virtual bool get_MPI_comm(MPI_Comm& comm_out) { comm_out=MPI_COMM_SELF; return true;}
+
+private:
+  static const int ns_ = 3;
+  int nd_;
+};
+#endif
@@ -0,0 +1,126 @@
+#include "nlpMDS_ex9.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+
+#include <cstdlib>
+#include <string>
+
+using namespace hiop;
+
+static bool parse_arguments(int argc, char **argv, long long& n_de, bool& self_check)
+{
+  self_check = false;
+  n_de = 10;
+  switch(argc) {
+  case 1:
+    //no arguments
+    return true;
+    break;
+  case 3: //2 arguments
+    {
+      if(std::string(argv[2]) == "-selfcheck")
+	self_check=true;
+      else
+	return false;
+    }
+  case 2: //1 argument
+    {
+      if(std::string(argv[1]) == "-selfcheck")
+	self_check=true;
+      else {
+	n_de = std::atoi(argv[1]);
+	if(n_de<0) return false;
+      }
+    }
+    break;
+  default:
+    return false; //3 or more arguments
+  }
+  return true;
+};
+
+static void usage(const char* exeName)
+{
+  printf("HiOp driver %s that solves, in the mixed dense-sparse formulation, a problem on which the "
+	 "line search stalls and that needs the feasibility restoration to be solved.\n", exeName);
+  printf("Usage: \n");
+  printf("  '$ %s de_vars_size -selfcheck'\n", exeName);
+  printf("Arguments:\n");
+  printf("  'de_vars_size': # of dense variables [default 10, optional, nonnegative integer].\n");
+  printf("  '-selfcheck': checks that the solve fails without the feasibility restoration and "
+	 "that it recovers to the known optimal objective with the restoration. [optional]\n");
+}
+
+static hiopSolveStatus solve(long long n_de, const char* feas_restoration, double& obj_value)
+{
+  Ex9 nlp_interface(n_de);
+  hiopNlpMDS nlp(nlp_interface);
+
+  nlp.options->SetStringValue("Hessian", "analytical_exact");
+  nlp.options->SetStringValue("feasibility_restoration", feas_restoration);
+  nlp.options->SetIntegerValue("verbosity_level", 3);
+
+  hiopAlgFilterIPMNewton solver(&nlp);
+  hiopSolveStatus status = solver.run();
+  obj_value = solver.getObjective();
+  return status;
+}
+
+int main(int argc, char **argv)
+{
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int comm_size;
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr);
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+	   "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+#endif
+
+  bool selfCheck;
+  long long n_de;
+  if(!parse_arguments(argc, argv, n_de, selfCheck)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  double obj_value;
+  int ret = 0;
+
+  //without the restoration the line search is expected to stall
+  if(selfCheck) {
+    hiopSolveStatus status = solve(n_de, "no", obj_value);
+    if(status==Solve_Success) {
+      printf("selfcheck failure. The solve without feasibility restoration did not fail as expected.\n");
+      ret = -1;
+    }
+  }
+
+  if(0==ret) {
+    hiopSolveStatus status = solve(n_de, "yes", obj_value);
+    if(status!=Solve_Success) {
+      printf("solver with feasibility restoration returned status %d (with objective %18.12e)\n",
+	     status, obj_value);
+      ret = -1;
+    } else if(selfCheck) {
+      //optimal objective is 2 regardless of the number of dense variables
+      if(fabs(obj_value-2.) > 1e-6*3.) {
+	printf("selfcheck failure. Objective (%18.12e) does not agree (6 digits) with the saved value (2).\n",
+	       obj_value);
+	ret = -1;
+      } else {
+	printf("selfcheck success (6 digits): the feasibility restoration recovered the solve\n");
+      }
+    } else {
+      printf("Optimal objective: %22.14e. Solver status: %d\n", obj_value, status);
+    }
+  }
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return ret;
+}
@@ -0,0 +1,224 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "hiopInterface.h"
+#include <math.h>
+
+/* C version of the sparse Ex6 (nlpSparse_ex6.cpp), solved through the C interface:
+ *  min   sum 1/4* { (x_{i}-1)^4 : i=1,...,n}
+ *  s.t.
+ *            4*x_1 + 2*x_2                     == 10
+ *        5<= 2*x_1         + x_3
+ *        1<= 2*x_1                 + 0.5*x_i   <= 2*n, for i=4,...,n
+ *        x_1 free
+ *        0.0 <= x_2
+ *        1.5 <= x_3 <= 10
+ *        x_i >=0.5, i=4,...,n
+ */
+typedef struct settings {
+  long long n; long long m;
+  int nnz_sparse_Jaceq; int nnz_sparse_Jacineq; int nnz_sparse_Hess_Lagr;
+  int num_iter;
+} settings;
+
+int get_starting_point(long long n, double* x0, void* user_data_) {
+  long long i = 0;
+  for(i=0; i<n; i=i+1) x0[i]=0.0;
+  return 0;
+}
+
+int get_prob_sizes(long long* n_, long long* m_, void* user_data_) {
+  settings* user_data = (settings*) user_data_;
+  *n_ = user_data->n;
+  *m_ = user_data->m;
+  return 0;
+}
+
+int get_vars_info(long long n, double *xlow_, double* xupp_, void* user_data_) {
+  long long i = 0;
+  xlow_[0] = -1e20; xupp_[0] = 1e20;
+  xlow_[1] = 0.0;   xupp_[1] = 1e20;
+  xlow_[2] = 1.5;   xupp_[2] = 10.0;
+  //this is for x_4, x_5, ... , x_n (i>=3), which are bounded only from below
+  for(i=3; i<n; i=i+1) {
+    xlow_[i] = 0.5; xupp_[i] = 1e20;
+  }
+  return 0;
+}
+
+int get_cons_info(long long m, double *clow_, double* cupp_, void* user_data_) {
+  settings* user_data = (settings*) user_data_;
+  long long i = 0;
+  clow_[0] = 10.0; cupp_[0] = 10.0;
+  clow_[1] = 5.0;  cupp_[1] = 1e20;
+  for(i=2; i<m; i=i+1) {
+    clow_[i] = 1.0; cupp_[i] = 2.0*user_data->n;
+  }
+  return 0;
+}
+
+int eval_f(long long n, double* x, int new_x, double* obj, void* user_data_) {
+  long long i = 0;
+  *obj = 0.;
+  for(i=0; i<n; i=i+1) *obj += 0.25*pow(x[i]-1., 4);
+  return 0;
+}
+
+int eval_grad_f(long long n, double* x, int new_x, double* gradf, void* user_data_) {
+  long long i = 0;
+  for(i=0; i<n; i=i+1) gradf[i] = pow(x[i]-1., 3);
+  return 0;
+}
+
+int eval_cons(long long n, long long m,
+              double* x, int new_x,
+              double* cons, void* user_data_) {
+  long long i = 0;
+  assert(m==n-1);
+  // --- constraint 1 body --->  4*x_1 + 2*x_2 == 10
+  cons[0] = 4*x[0] + 2*x[1];
+  // --- constraint 2 body ---> 2*x_1 + x_3
+  cons[1] = 2*x[0] + 1*x[2];
+  // --- constraint 3 body --->   2*x_1 + 0.5*x_i, for i>=4
+  for(i=3; i<n; i=i+1) cons[i-1] = 2*x[0] + 0.5*x[i];
+  return 0;
+}
+
+int get_sparse_blocks_info(int* nx,
+                           int* nnz_sparse_Jaceq, int* nnz_sparse_Jacineq,
+                           int* nnz_sparse_Hess_Lagr, void* user_data_) {
+  settings* user_data = (settings*) user_data_;
+  *nx = user_data->n;
+  *nnz_sparse_Jaceq = user_data->nnz_sparse_Jaceq;
+  *nnz_sparse_Jacineq = user_data->nnz_sparse_Jacineq;
+  *nnz_sparse_Hess_Lagr = user_data->nnz_sparse_Hess_Lagr;
+  return 0;
+}
+
+int eval_Jac_cons(long long n, long long m,
+                  double* x, int new_x,
+                  int nnzJacS, int* iJacS, int* jJacS, double* MJacS, void* user_data_) {
+  long long i = 0;
+  int nnzit = 0;
+  assert(nnzJacS == 4 + 2*(n-3));
+
+  if(iJacS!=NULL && jJacS!=NULL) {
+    // --- constraint 1 body --->  4*x_1 + 2*x_2 == 10
+    iJacS[nnzit] = 0; jJacS[nnzit] = 0; nnzit=nnzit+1;
+    iJacS[nnzit] = 0; jJacS[nnzit] = 1; nnzit=nnzit+1;
+    // --- constraint 2 body ---> 2*x_1 + x_3
+    iJacS[nnzit] = 1; jJacS[nnzit] = 0; nnzit=nnzit+1;
+    iJacS[nnzit] = 1; jJacS[nnzit] = 2; nnzit=nnzit+1;
+    // --- constraint 3 body --->   2*x_1 + 0.5*x_i, for i>=4
+    for(i=3; i<n; i=i+1) {
+      iJacS[nnzit] = i-1; jJacS[nnzit] = 0; nnzit=nnzit+1;
+      iJacS[nnzit] = i-1; jJacS[nnzit] = i; nnzit=nnzit+1;
+    }
+    assert(nnzit==nnzJacS);
+  }
+  //values for sparse Jacobian if requested by the solver
+  if(MJacS!=NULL) {
+    nnzit = 0;
+    MJacS[nnzit] = 4.; nnzit=nnzit+1;
+    MJacS[nnzit] = 2.; nnzit=nnzit+1;
+    MJacS[nnzit] = 2.; nnzit=nnzit+1;
+    MJacS[nnzit] = 1.; nnzit=nnzit+1;
+    for(i=3; i<n; i=i+1) {
+      MJacS[nnzit] = 2.;  nnzit=nnzit+1;
+      MJacS[nnzit] = 0.5; nnzit=nnzit+1;
+    }
+    assert(nnzit==nnzJacS);
+  }
+  return 0;
+}
+
+int eval_Hess_Lagr(long long n, long long m,
+                   double* x, int new_x, double obj_factor,
+                   double* lambda, int new_lambda,
+                   int nnzHSS, int* iHSS, int* jHSS, double* MHSS, void* user_data_) {
+  //Note: lambda is not used since all the constraints are linear and, therefore, do
+  //not contribute to the Hessian of the Lagrangian
+  long long i = 0;
+  assert(nnzHSS==n);
+
+  if(iHSS!=NULL && jHSS!=NULL) {
+    for(i=0; i<n; i=i+1) iHSS[i] = jHSS[i] = i;
+  }
+  if(MHSS!=NULL) {
+    for(i=0; i<n; i=i+1) MHSS[i] = obj_factor * 3*pow(x[i]-1., 2);
+  }
+  return 0;
+}
+
+int iterate_callback(int iter, double obj_value,
+                     long long n, const double* x,
+                     const double* z_L, const double* z_U,
+                     long long m, const double* g, const double* lambda,
+                     double inf_pr, double inf_du, double mu,
+                     double alpha_du, double alpha_pr, int ls_trials,
+                     void* user_data_) {
+  settings* user_data = (settings*) user_data_;
+  user_data->num_iter = iter;
+  //zero means continue
+  return 0;
+}
+
+int main(int argc, char **argv) {
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int comm_size;
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr);
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+	   "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+#endif
+
+  long long n = 500;
+  long long m = n-1;
+  int i;
+
+  settings user_data = {n, m, 2, 2 + 2*(n-3), n, 0};
+
+  cHiopSparseProblem problem;
+  problem.user_data = &user_data;
+  problem.get_starting_point = get_starting_point;
+  problem.get_prob_sizes = get_prob_sizes;
+  problem.get_vars_info = get_vars_info;
+  problem.get_cons_info = get_cons_info;
+  problem.eval_f = eval_f;
+  problem.eval_grad_f = eval_grad_f;
+  problem.eval_cons = eval_cons;
+  problem.get_sparse_blocks_info = get_sparse_blocks_info;
+  problem.eval_Jac_cons = eval_Jac_cons;
+  problem.eval_Hess_Lagr = eval_Hess_Lagr;
+  problem.solution = malloc(n * sizeof(double));
+  for(i=0; i<n; i++) problem.solution[i] = 0.0;
+
+  hiop_createSparseProblem(&problem);
+  hiop_setSparseIterateCallback(&problem, iterate_callback);
+  int status = hiop_solveSparseProblem(&problem);
+  if(status!=0) {
+    printf("solve failed with status %d for Ex6 sparse C interface problem\n", status);
+    return -1;
+  }
+  if(user_data.num_iter<=0) {
+    printf("iterate callback was not called for Ex6 sparse C interface problem\n");
+    return -1;
+  }
+  if(fabs(problem.obj_value-1.10351566513480e-01)>1e-6) {
+    printf("objective mismatch for Ex6 sparse C interface problem with 500 variables. "
+      "BTW, obj=%18.12e was returned by HiOp.\n", problem.obj_value);
+      return -1;
+  }
+  hiop_destroySparseProblem(&problem);
+  free(problem.solution);
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return 0;
+}
@@ -27,7 +27,7 @@ int hiop_solveProblem(cHiopProblem *prob) {
   status = solver.run();
   prob->obj_value = solver.getObjective();
   solver.getSolution(prob->solution);
-  return 0;
+  return (int)status;
 }
 
 int hiop_destroyProblem(cHiopProblem *prob) {
@@ -35,4 +35,54 @@ int hiop_destroyProblem(cHiopProblem *prob) {
   delete prob->hiopinterface;
   return 0;
 }
+
+int hiop_setSolutionCallback(cHiopProblem *prob, hiopSolutionCallback_t cb) {
+  prob->hiopinterface->callbacks.solution_cb = cb;
+  return 0;
+}
+
+int hiop_setIterateCallback(cHiopProblem *prob, hiopIterateCallback_t cb) {
+  prob->hiopinterface->callbacks.iterate_cb = cb;
+  return 0;
+}
+
+int hiop_createSparseProblem(cHiopSparseProblem *prob) {
+  cppUserProblemSparse * cppproblem = new cppUserProblemSparse(prob);
+  hiopNlpSparse *nlp = new hiopNlpSparse(*cppproblem);
+  nlp->options->SetStringValue("duals_update_type", "linear");
+  nlp->options->SetStringValue("duals_init", "zero");
+
+  nlp->options->SetStringValue("Hessian", "analytical_exact");
+  nlp->options->SetStringValue("KKTLinsys", "xdycyd");
+  nlp->options->SetStringValue("compute_mode", "cpu");
+
+  nlp->options->SetIntegerValue("verbosity_level", 3);
+  prob->refcppHiop = nlp;
+  prob->hiopinterface = cppproblem;
+  return 0;
+}
+
+int hiop_solveSparseProblem(cHiopSparseProblem *prob) {
+  hiopAlgFilterIPMNewton solver(prob->refcppHiop);
+  hiopSolveStatus status = solver.run();
+  prob->obj_value = solver.getObjective();
+  solver.getSolution(prob->solution);
+  return (int)status;
+}
+
+int hiop_destroySparseProblem(cHiopSparseProblem *prob) {
+  delete prob->refcppHiop;
+  delete prob->hiopinterface;
+  return 0;
+}
+
+int hiop_setSparseSolutionCallback(cHiopSparseProblem *prob, hiopSolutionCallback_t cb) {
+  prob->hiopinterface->callbacks.solution_cb = cb;
+  return 0;
+}
+
+int hiop_setSparseIterateCallback(cHiopSparseProblem *prob, hiopIterateCallback_t cb) {
+  prob->hiopinterface->callbacks.iterate_cb = cb;
+  return 0;
+}
 } // extern C
@@ -11,7 +11,23 @@
 
 using namespace hiop;
 class cppUserProblem;
+class cppUserProblemSparse;
 extern "C" {
+  // Optional callbacks, set via hiop_setXXXCallback. A nonzero return of the iterate callback stops
+  // the solver with hiop::User_Stopped status.
+  typedef void (*hiopSolutionCallback_t)(int status,
+                                         long long n, const double* x,
+                                         const double* z_L, const double* z_U,
+                                         long long m, const double* g, const double* lambda,
+                                         double obj_value, void* user_data);
+  typedef int (*hiopIterateCallback_t)(int iter, double obj_value,
+                                       long long n, const double* x,
+                                       const double* z_L, const double* z_U,
+                                       long long m, const double* g, const double* lambda,
+                                       double inf_pr, double inf_du, double mu,
+                                       double alpha_du, double alpha_pr, int ls_trials,
+                                       void* user_data);
+
   // C struct with HiOp function callbacks
   typedef struct cHiopProblem {
     hiopNlpMDS *refcppHiop;
@@ -48,8 +64,74 @@ extern "C" {
       double* HDD,
       int nnzHSD, int* iHSD, int* jHSD, double* MHSD, void* user_data);
   } cHiopProblem;
+
+  // C struct with HiOp function callbacks for sparse problems (wraps hiopInterfaceSparse)
+  typedef struct cHiopSparseProblem {
+    hiopNlpSparse *refcppHiop;
+    cppUserProblemSparse *hiopinterface;
+    void *user_data;
+    double *solution;
+    double obj_value;
+    int (*get_starting_point)(long long n_, double* x0, void* user_data); 
+    int (*get_prob_sizes)(long long* n_, long long* m_, void* user_data); 
+    int (*get_vars_info)(long long n, double *xlow_, double* xupp_, void* user_data);
+    int (*get_cons_info)(long long m, double *clow_, double* cupp_, void* user_data);
+    int (*eval_f)(long long n, double* x, int new_x, double* obj, void* user_data);
+    int (*eval_grad_f)(long long n, double* x, int new_x, double* gradf, void* user_data);
+    int (*eval_cons)(long long n, long long m,
+      double* x, int new_x, 
+      double* cons, void* user_data);
+    int (*get_sparse_blocks_info)(int* nx,
+      int* nnz_sparse_Jaceq, int* nnz_sparse_Jacineq,
+      int* nnz_sparse_Hess_Lagr, void* user_data);
+    int (*eval_Jac_cons)(long long n, long long m,
+      double* x, int new_x,
+      int nnzJacS, int* iJacS, int* jJacS, double* MJacS, void *user_data);
+    int (*eval_Hess_Lagr)(long long n, long long m,
+      double* x, int new_x, double obj_factor,
+      double* lambda, int new_lambda,
+      int nnzHSS, int* iHSS, int* jHSS, double* MHSS, void* user_data);
+  } cHiopSparseProblem;
 }
 
+/** Optional callbacks shared by the C++ objects of the C interface */
+class cppUserCallbacks
+{
+public:
+  cppUserCallbacks()
+    : solution_cb(NULL), iterate_cb(NULL)
+  {
+  }
+
+  void solution_callback(hiopSolveStatus status,
+                         int n, const double* x,
+                         const double* z_L, const double* z_U,
+                         int m, const double* g, const double* lambda,
+                         double obj_value, void* user_data)
+  {
+    if(solution_cb) {
+      solution_cb((int)status, n, x, z_L, z_U, m, g, lambda, obj_value, user_data);
+    }
+  }
+
+  bool iterate_callback(int iter, double obj_value,
+                        int n, const double* x,
+                        const double* z_L, const double* z_U,
+                        int m, const double* g, const double* lambda,
+                        double inf_pr, double inf_du, double mu,
+                        double alpha_du, double alpha_pr, int ls_trials, void* user_data)
+  {
+    if(iterate_cb) {
+      return 0 == iterate_cb(iter, obj_value, n, x, z_L, z_U, m, g, lambda,
+                             inf_pr, inf_du, mu, alpha_du, alpha_pr, ls_trials, user_data);
+    }
+    return true;
+  }
+
+  hiopSolutionCallback_t solution_cb;
+  hiopIterateCallback_t iterate_cb;
+};
+
 
 // The cpp object used in the C interface
 class cppUserProblem : public hiopInterfaceMDS
@@ -88,13 +170,13 @@ class cppUserProblem : public hiopInterfaceMDS
     };
     bool eval_f(const long long& n, const double* x, bool new_x, double& obj_value)
     {
-      cprob->eval_f(n, (double *) x, 0, &obj_value, cprob->user_data);
+      cprob->eval_f(n, (double *) x, new_x, &obj_value, cprob->user_data);
       return true;
     };
 
     bool eval_grad_f(const long long& n, const double* x, bool new_x, double* gradf)
     {
-      cprob->eval_grad_f(n, (double *) x, 0, gradf, cprob->user_data);
+      cprob->eval_grad_f(n, (double *) x, new_x, gradf, cprob->user_data);
 
       return true;
     };
@@ -158,15 +240,168 @@ class cppUserProblem : public hiopInterfaceMDS
                             cprob->user_data);
       return true;
     };
+    void solution_callback(hiopSolveStatus status,
+                           int n, const double* x,
+                           const double* z_L, const double* z_U,
+                           int m, const double* g, const double* lambda,
+                           double obj_value)
+    {
+      callbacks.solution_callback(status, n, x, z_L, z_U, m, g, lambda, obj_value, cprob->user_data);
+    };
+    bool iterate_callback(int iter, double obj_value,
+                          int n, const double* x,
+                          const double* z_L, const double* z_U,
+                          int m, const double* g, const double* lambda,
+                          double inf_pr, double inf_du, double mu,
+                          double alpha_du, double alpha_pr, int ls_trials)
+    {
+      return callbacks.iterate_callback(iter, obj_value, n, x, z_L, z_U, m, g, lambda,
+                                        inf_pr, inf_du, mu, alpha_du, alpha_pr, ls_trials,
+                                        cprob->user_data);
+    };
+    cppUserCallbacks callbacks;
 private:
   // Storing the C struct in the CPP object
   cHiopProblem *cprob;
 };
 
+// The cpp object used in the C interface for sparse problems
+class cppUserProblemSparse : public hiopInterfaceSparse
+{
+  public:
+    cppUserProblemSparse(cHiopSparseProblem *cprob_)
+      : cprob(cprob_) 
+    {
+    }
+
+    virtual ~cppUserProblemSparse()
+    {
+    }
+    // HiOp callbacks calling the C wrappers
+    bool get_prob_sizes(long long& n_, long long& m_) 
+    {
+      cprob->get_prob_sizes(&n_, &m_, cprob->user_data);
+      return true;
+    };
+    bool get_starting_point(const long long& n, double *x0)
+    {
+      cprob->get_starting_point(n, x0, cprob->user_data);
+      return true;
+    };
+    bool get_vars_info(const long long& n, double *xlow_, double* xupp_, NonlinearityType* type)
+    {
+      for(long long i=0; i<n; ++i) type[i]=hiopNonlinear;
+      cprob->get_vars_info(n, xlow_, xupp_, cprob->user_data);
+      return true;
+    };
+    bool get_cons_info(const long long& m, double* clow, double* cupp, NonlinearityType* type)
+    {
+      for(long long i=0; i<m; ++i) type[i]=hiopNonlinear;
+      cprob->get_cons_info(m, clow, cupp, cprob->user_data);
+      return true;
+    };
+    bool eval_f(const long long& n, const double* x, bool new_x, double& obj_value)
+    {
+      cprob->eval_f(n, (double *) x, new_x, &obj_value, cprob->user_data);
+      return true;
+    };
+    bool eval_grad_f(const long long& n, const double* x, bool new_x, double* gradf)
+    {
+      cprob->eval_grad_f(n, (double *) x, new_x, gradf, cprob->user_data);
+      return true;
+    };
+    bool eval_cons(const long long& n, const long long& m,
+      const long long& num_cons, const long long* idx_cons,  
+      const double* x, bool new_x, 
+      double* cons)
+    {
+      //return false so that HiOp relies on the one-call evaluator below, which writes directly
+      //into HiOp's storage
+      return false;
+    };
+    bool eval_cons(const long long& n, const long long& m, 
+      const double* x, bool new_x, double* cons)
+    {
+      cprob->eval_cons(n, m, (double *) x, new_x, cons, cprob->user_data);
+      return true;
+    };
+    bool get_sparse_blocks_info(int& nx,
+                                int& nnz_sparse_Jaceq, int& nnz_sparse_Jacineq,
+                                int& nnz_sparse_Hess_Lagr)
+    {
+      cprob->get_sparse_blocks_info(&nx, &nnz_sparse_Jaceq, &nnz_sparse_Jacineq,
+                                    &nnz_sparse_Hess_Lagr, cprob->user_data);
+      return true;
+    };
+    bool eval_Jac_cons(const long long& n, const long long& m,
+      const long long& num_cons, const long long* idx_cons,
+      const double* x, bool new_x,
+      const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS)
+    {
+      //same as above for the Jacobian
+      return false;
+    };
+    bool eval_Jac_cons(const long long& n, const long long& m,
+      const double* x, bool new_x,
+      const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS)
+    {
+      cprob->eval_Jac_cons(n, m, (double *) x, new_x,
+                           nnzJacS, iJacS, jJacS, MJacS, cprob->user_data);
+      return true;
+    };
+    bool eval_Hess_Lagr(const long long& n, const long long& m,
+      const double* x, bool new_x, const double& obj_factor,
+      const double* lambda, bool new_lambda,
+      const int& nnzHSS, int* iHSS, int* jHSS, double* MHSS)
+    {
+      cprob->eval_Hess_Lagr(n, m, (double *) x, new_x, obj_factor,
+                            (double *) lambda, new_lambda,
+                            nnzHSS, iHSS, jHSS, MHSS, cprob->user_data);
+      return true;
+    };
+    void solution_callback(hiopSolveStatus status,
+                           int n, const double* x,
+                           const double* z_L, const double* z_U,
+                           int m, const double* g, const double* lambda,
+                           double obj_value)
+    {
+      callbacks.solution_callback(status, n, x, z_L, z_U, m, g, lambda, obj_value, cprob->user_data);
+    };
+    bool iterate_callback(int iter, double obj_value,
+                          int n, const double* x,
+                          const double* z_L, const double* z_U,
+                          int m, const double* g, const double* lambda,
+                          double inf_pr, double inf_du, double mu,
+                          double alpha_du, double alpha_pr, int ls_trials)
+    {
+      return callbacks.iterate_callback(iter, obj_value, n, x, z_L, z_U, m, g, lambda,
+                                        inf_pr, inf_du, mu, alpha_du, alpha_pr, ls_trials,
+                                        cprob->user_data);
+    };
+    cppUserCallbacks callbacks;
+private:
+  // Storing the C struct in the CPP object
+  cHiopSparseProblem *cprob;
+};
+
 /** The 3 essential function calls to create and destroy a problem object in addition to solve a problem.
- * Some option setters will be added in the future.
+ * The solve returns the hiopSolveStatus of the solver (0 is Solve_Success). Some option setters will be
+ * added in the future.
  */
 extern "C" int hiop_createProblem(cHiopProblem *problem);
 extern "C" int hiop_solveProblem(cHiopProblem *problem);
 extern "C" int hiop_destroyProblem(cHiopProblem *problem);
+
+/** Same as above for sparse problems. */
+extern "C" int hiop_createSparseProblem(cHiopSparseProblem *problem);
+extern "C" int hiop_solveSparseProblem(cHiopSparseProblem *problem);
+extern "C" int hiop_destroySparseProblem(cHiopSparseProblem *problem);
+
+/** Optional callbacks; to be called after hiop_createXXXProblem. Passing NULL unsets a callback.
+ * The solution callback receives the multipliers and the constraint values at the end of the solve.
+ */
+extern "C" int hiop_setSolutionCallback(cHiopProblem *problem, hiopSolutionCallback_t cb);
+extern "C" int hiop_setIterateCallback(cHiopProblem *problem, hiopIterateCallback_t cb);
+extern "C" int hiop_setSparseSolutionCallback(cHiopSparseProblem *problem, hiopSolutionCallback_t cb);
+extern "C" int hiop_setSparseIterateCallback(cHiopSparseProblem *problem, hiopIterateCallback_t cb);
 #endif
@@ -1,5 +1,20 @@
 // The C interface header used by the user. This needs a detailed user documentation.
 
+// Optional callbacks, set via hiop_setXXXCallback. A nonzero return of the iterate callback stops
+// the solver.
+typedef void (*hiopSolutionCallback_t)(int status,
+                                       long long n, const double* x,
+                                       const double* z_L, const double* z_U,
+                                       long long m, const double* g, const double* lambda,
+                                       double obj_value, void* user_data);
+typedef int (*hiopIterateCallback_t)(int iter, double obj_value,
+                                     long long n, const double* x,
+                                     const double* z_L, const double* z_U,
+                                     long long m, const double* g, const double* lambda,
+                                     double inf_pr, double inf_du, double mu,
+                                     double alpha_du, double alpha_pr, int ls_trials,
+                                     void* user_data);
+
 typedef struct cHiopProblem {
   void *refcppHiop; // Pointer to the cpp object
   void *hiopinterface;
@@ -34,5 +49,44 @@ typedef struct cHiopProblem {
     int nnzHSD, int* iHSD, int* jHSD, double* MHSD, void* jprob);
 } cHiopProblem;
 extern int hiop_createProblem(cHiopProblem *problem);
+// returns the status of the solve (see hiopSolveStatus); 0 means success
 extern int hiop_solveProblem(cHiopProblem *problem);
-extern int hiop_destroyProblem(cHiopProblem *problem);
\ No newline at end of file
+extern int hiop_destroyProblem(cHiopProblem *problem);
+
+typedef struct cHiopSparseProblem {
+  void *refcppHiop; // Pointer to the cpp object
+  void *hiopinterface;
+  void *user_data; 
+  double *solution;
+  double obj_value;
+  int (*get_starting_point)(long long n_, double* x0, void* jprob); 
+  int (*get_prob_sizes)(long long* n_, long long* m_, void* jprob); 
+  int (*get_vars_info)(long long n, double *xlow_, double* xupp_, void* jprob);
+  int (*get_cons_info)(long long m, double *clow_, double* cupp_, void* jprob);
+  int (*eval_f)(long long n, double* x, int new_x, double* obj, void* jprob);
+  int (*eval_grad_f)(long long n, double* x, int new_x, double* gradf, void* jprob);
+  int (*eval_cons)(long long n, long long m,
+    double* x, int new_x, 
+    double* cons, void* jprob);
+  int (*get_sparse_blocks_info)(int* nx,
+    int* nnz_sparse_Jaceq, int* nnz_sparse_Jacineq,
+    int* nnz_sparse_Hess_Lagr, void* jprob);
+  int (*eval_Jac_cons)(long long n, long long m,
+    double* x, int new_x,
+    int nnzJacS, int* iJacS, int* jJacS, double* MJacS, void *jprob);
+  int (*eval_Hess_Lagr)(long long n, long long m,
+    double* x, int new_x, double obj_factor,
+    double* lambda, int new_lambda,
+    int nnzHSS, int* iHSS, int* jHSS, double* MHSS, void* jprob);
+} cHiopSparseProblem;
+extern int hiop_createSparseProblem(cHiopSparseProblem *problem);
+// returns the status of the solve, same as hiop_solveProblem
+extern int hiop_solveSparseProblem(cHiopSparseProblem *problem);
+extern int hiop_destroySparseProblem(cHiopSparseProblem *problem);
+
+// Optional callbacks; to be called after hiop_createXXXProblem. The solution callback receives the
+// multipliers of the bounds and of the constraints, and the constraints body, at the end of the solve.
+extern int hiop_setSolutionCallback(cHiopProblem *problem, hiopSolutionCallback_t cb);
+extern int hiop_setIterateCallback(cHiopProblem *problem, hiopIterateCallback_t cb);
+extern int hiop_setSparseSolutionCallback(cHiopSparseProblem *problem, hiopSolutionCallback_t cb);
+extern int hiop_setSparseIterateCallback(cHiopSparseProblem *problem, hiopIterateCallback_t cb);
\ No newline at end of file
@@ -79,6 +79,8 @@ enum hiopSolveStatus {
   Max_Iter_Exceeded=10,
   Max_CpuTime_Exceeded=11,
   User_Stopped=12,
+  //the convergence rate over the last iterations predicts that 'max_iter' is reached first
+  Slow_Convergence=13,
 
   //NLP algorithm/solver reports issues in solving the problem and stops without being certain 
   //that is solved the problem to optimality or that the problem is infeasible.
@@ -280,6 +282,11 @@ public:
    * If user does not have high-quality (primal or primal-dual) starting points, the method should 
    * return false (see note below).
    *
+   * When option 'warm_start' is 'yes' and duals are provided, the point is used to warm start
+   * HiOp: the initial log-barrier parameter and the push of the primals away from the bounds are 
+   * chosen based on the complementarity of the primal-dual point, instead of 'mu0', 'kappa1', and
+   * 'kappa2'. This is recommended when the point is the solution of a slightly different problem.
+   *
    * @note When this method returns false, HiOp will call the overload 
    * get_starting_point(). This behaviour is for backward compatibility and 
    * will be removed in a future release.
@@ -439,6 +446,11 @@ public:
    * 4) 'iJacS' and 'jJacS' are both either non-null or null during a call.
    * 5) Both 'iJacS'/'jJacS' and 'MJacS' can be non-null during the same call or only one of them 
    * non-null; but they will not be both null.
+   * 6) HiOp requests the (i,j) indexes once per solve, during the first call and possibly together
+   * with the values; all subsequent calls pass null 'iJacS' and 'jJacS'. The sparsity pattern 
+   * should not change. The indexes need not be ordered; HiOp sorts them internally and permutes
+   * the values accordingly. Duplicate (i,j) entries are not summed by HiOp and count as separate
+   * nonzeros. When the option 'mem_space' is not 'default', the indexes are requested at each call.
    * 
    */
   virtual bool eval_Jac_cons(const long long& n, const long long& m, 
@@ -475,6 +487,11 @@ public:
    * 4) 'iJacS' and 'jJacS' are both either non-null or null during a call.
    * 5) Both 'iJacS'/'jJacS' and 'MJacS' can be non-null during the same call or only one of them 
    * non-null; but they will not be both null.
+   * 6) HiOp requests the (i,j) indexes once per solve, during the first call and possibly together
+   * with the values; all subsequent calls pass null 'iJacS' and 'jJacS'. The sparsity pattern 
+   * should not change. The indexes need not be ordered; HiOp sorts them internally and permutes
+   * the values accordingly. Duplicate (i,j) entries are not summed by HiOp and count as separate
+   * nonzeros. When the option 'mem_space' is not 'default', the indexes are requested at each call.
    * 
    * HiOp will call this method whenever the implementer/user returns false from the 'eval_Jac_cons'
    * (which is called for equalities and inequalities separately) above.
@@ -499,8 +516,8 @@ public:
    * triplet arrays for HSD set to NULL and the implementer (obviously) should not use them.
    *
    * Notes 
-   * 1)-5) from 'eval_Jac_cons' applies to xxxHSS and HDD arrays
-   * 6) The order is multipliers is: lambda=[lambda_eq, lambda_ineq]
+   * 1)-6) from 'eval_Jac_cons' applies to xxxHSS and HDD arrays
+   * 7) The order is multipliers is: lambda=[lambda_eq, lambda_ineq]
    */
   virtual bool eval_Hess_Lagr(const long long& n, const long long& m, 
 			      const double* x, bool new_x, const double& obj_factor,
@@ -551,6 +568,7 @@ public:
    *  - nnzJacS, iJacS, jJacS, MJacS: number of nonzeros, (i,j) indexes, and values of
    * the sparse Jacobian.
    *
+   * @note Notes 1)-5) of the overloaded method apply.
    */
   virtual bool eval_Jac_cons(const long long& n, const long long& m,
                              const long long& num_cons, const long long* idx_cons,
@@ -578,6 +596,11 @@ public:
    * 3) 'iJacS' and 'jJacS' are both either non-null or null during a call.
    * 4) Both 'iJacS'/'jJacS' and 'MJacS' can be non-null during the same call or only one of them
    * non-null; but they will not be both null.
+   * 5) HiOp requests the (i,j) indexes once per solve, during the first call and possibly together
+   * with the values; all subsequent calls pass null 'iJacS' and 'jJacS'. The sparsity pattern 
+   * should not change. The indexes need not be ordered; HiOp sorts them internally and permutes
+   * the values accordingly. Duplicate (i,j) entries are not summed by HiOp and count as separate
+   * nonzeros. When the option 'mem_space' is not 'default', the indexes are requested at each call.
    *
    * HiOp will call this method whenever the implementer/user returns false from the 'eval_Jac_cons'
    * (which is called for equalities and inequalities separately) above.
@@ -588,8 +611,8 @@ public:
 
   /** Evaluates the sparse Hessian of the Lagrangian function.
    *
-   * @note 1)-4) from 'eval_Jac_cons' applies to xxxHSS
-   * @note 5) The order of multipliers is: lambda=[lambda_eq, lambda_ineq]
+   * @note 1)-5) from 'eval_Jac_cons' applies to xxxHSS
+   * @note 6) The order of multipliers is: lambda=[lambda_eq, lambda_ineq]
    */
   virtual bool eval_Hess_Lagr(const long long& n, const long long& m,
                               const double* x, bool new_x, const double& obj_factor,
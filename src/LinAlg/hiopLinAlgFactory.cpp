@@ -251,4 +251,61 @@ void LinearAlgebraFactory::set_mem_space(const std::string mem_space)
   transform(mem_space_.begin(), mem_space_.end(), mem_space_.begin(), ::toupper);
 }
 
+/// Raises 'peak' to 'value' if the latter is larger
+static inline void update_peak(std::atomic<size_t>& peak, size_t value)
+{
+  size_t prev = peak.load();
+  while(prev < value && !peak.compare_exchange_weak(prev, value)) {
+  }
+}
+
+hiopMemStats::Category LinearAlgebraFactory::track_alloc(size_t bytes)
+{
+  hiopMemStats::Category c = mem_category_.load();
+  track_alloc(bytes, c);
+  return c;
+}
+
+void LinearAlgebraFactory::track_alloc(size_t bytes, hiopMemStats::Category c)
+{
+  update_peak(mem_peak_[c], mem_in_use_[c].fetch_add(bytes) + bytes);
+  update_peak(mem_total_peak_, mem_total_in_use_.fetch_add(bytes) + bytes);
+}
+
+void LinearAlgebraFactory::track_free(size_t bytes, hiopMemStats::Category c)
+{
+  mem_in_use_[c].fetch_sub(bytes);
+  mem_total_in_use_.fetch_sub(bytes);
+}
+
+hiopMemStats::Category LinearAlgebraFactory::set_mem_category(hiopMemStats::Category c)
+{
+  return mem_category_.exchange(c);
+}
+
+hiopMemStats LinearAlgebraFactory::get_mem_stats()
+{
+  hiopMemStats stats;
+  for(int c=0; c<hiopMemStats::mcNumCategories; c++) {
+    stats.in_use[c] = mem_in_use_[c].load();
+    stats.peak[c] = mem_peak_[c].load();
+  }
+  stats.total_in_use = mem_total_in_use_.load();
+  stats.total_peak = mem_total_peak_.load();
+  return stats;
+}
+
+void LinearAlgebraFactory::reset_mem_peaks()
+{
+  for(int c=0; c<hiopMemStats::mcNumCategories; c++) {
+    mem_peak_[c] = mem_in_use_[c].load();
+  }
+  mem_total_peak_ = mem_total_in_use_.load();
+}
+
 std::string LinearAlgebraFactory::mem_space_ = "DEFAULT";
+std::atomic<size_t> LinearAlgebraFactory::mem_in_use_[hiopMemStats::mcNumCategories];
+std::atomic<size_t> LinearAlgebraFactory::mem_peak_[hiopMemStats::mcNumCategories];
+std::atomic<size_t> LinearAlgebraFactory::mem_total_in_use_(0);
+std::atomic<size_t> LinearAlgebraFactory::mem_total_peak_(0);
+std::atomic<hiopMemStats::Category> LinearAlgebraFactory::mem_category_(hiopMemStats::mcOther);
@@ -49,11 +49,13 @@
 
 #include <string>
 #include <iostream>
+#include <atomic>
 #include <hiopMPI.hpp>
 #include <hiopVector.hpp>
 #include <hiopMatrixDense.hpp>
 #include <hiopMatrixSparse.hpp>
 #include <hiopVectorInt.hpp>
+#include <hiopMemStats.hpp>
 
 namespace hiop {
 
@@ -125,8 +127,54 @@ public:
     return mem_space_;
   }
 
+  /**
+   * @brief Records the allocation of 'bytes' bytes, which are attributed to the current memory 
+   * category. Returns the category, which the owner of the memory keeps for 'track_free'.
+   *
+   * The counters are atomic and no per-block state is kept, so the owners pass the same size 
+   * and category when the memory is released.
+   */
+  static hiopMemStats::Category track_alloc(size_t bytes);
+
+  /// Records the allocation of 'bytes' bytes, which are attributed to category 'c'
+  static void track_alloc(size_t bytes, hiopMemStats::Category c);
+
+  /// Records the deallocation of 'bytes' bytes recorded earlier with 'track_alloc' in category 'c'
+  static void track_free(size_t bytes, hiopMemStats::Category c);
+
+  /// Sets the category of the subsequent allocations and returns the previous category
+  static hiopMemStats::Category set_mem_category(hiopMemStats::Category c);
+
+  /// Snapshot of the memory tracked on this rank
+  static hiopMemStats get_mem_stats();
+
+  /// Restarts the peaks of the memory tracked on this rank from the memory currently in use
+  static void reset_mem_peaks();
+
 private:
   static std::string mem_space_;
+  static std::atomic<size_t> mem_in_use_[hiopMemStats::mcNumCategories];
+  static std::atomic<size_t> mem_peak_[hiopMemStats::mcNumCategories];
+  static std::atomic<size_t> mem_total_in_use_, mem_total_peak_;
+  static std::atomic<hiopMemStats::Category> mem_category_;
+};
+
+/**
+ * Attributes the allocations made during its lifetime to a given memory category, after which 
+ * the previous category is restored.
+ */
+class hiopMemCategoryScope
+{
+public:
+  hiopMemCategoryScope(hiopMemStats::Category c)
+    : prev_(LinearAlgebraFactory::set_mem_category(c))
+  {}
+  ~hiopMemCategoryScope()
+  {
+    LinearAlgebraFactory::set_mem_category(prev_);
+  }
+private:
+  hiopMemStats::Category prev_;
 };
 
 } // namespace hiop
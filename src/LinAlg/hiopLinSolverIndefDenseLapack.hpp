@@ -50,6 +50,7 @@
 #define HIOP_LINSOLVER_LAPACK
 
 #include "hiopLinSolver.hpp"
+#include "hiopProfiler.hpp"
 
 namespace hiop {
 
@@ -73,6 +74,7 @@ public:
    * Overload from base class. */
   int matrixChanged()
   {
+    HIOP_PROFILE_SCOPE("linsol_factorize");
     assert(M_->n() == M_->m());
     int N=M_->n(), lda = N, info;
     if(N==0) return 0;
@@ -173,6 +175,7 @@ public:
    * exit is contains the solution(s).  */
   bool solve ( hiopVector& x )
   {
+    HIOP_PROFILE_SCOPE("linsol_solve");
     assert(M_->n() == M_->m());
     assert(x.get_size()==M_->n());
     int N=M_->n(), LDA = N, info;
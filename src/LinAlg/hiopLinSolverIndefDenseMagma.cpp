@@ -1,4 +1,5 @@
 #include "hiopLinSolverIndefDenseMagma.hpp"
+#include "hiopProfiler.hpp"
 
 namespace hiop
 {
@@ -17,6 +18,7 @@ namespace hiop
   /** Triggers a refactorization of the matrix, if necessary. */
   int hiopLinSolverIndefDenseMagmaBuKa::matrixChanged()
   {
+    HIOP_PROFILE_SCOPE("linsol_factorize");
     assert(M_->n() == M_->m());
     int N=M_->n(), lda = N, info;
     if(N==0) return 0;
@@ -160,6 +162,7 @@ namespace hiop
 
   bool hiopLinSolverIndefDenseMagmaBuKa::solve(hiopVector& x)
   {
+    HIOP_PROFILE_SCOPE("linsol_solve");
     assert(M_->n() == M_->m());
     assert(x.get_size() == M_->n());
     int N = M_->n();
@@ -241,6 +244,7 @@ namespace hiop
   /** Triggers a refactorization of the matrix, if necessary. */
   int hiopLinSolverIndefDenseMagmaNopiv::matrixChanged()
   {
+    HIOP_PROFILE_SCOPE("linsol_factorize");
     assert(M_->n() == M_->m());
     int N=M_->n(), LDA = N, LDB=N;
     if(N==0) return true;
@@ -342,6 +346,7 @@ namespace hiop
 
   bool hiopLinSolverIndefDenseMagmaNopiv::solve( hiopVector& x )
   {
+    HIOP_PROFILE_SCOPE("linsol_solve");
     assert(M_->n() == M_->m());
     assert(x.get_size()==M_->n());
     int N=M_->n(), LDA = N, LDB=N;
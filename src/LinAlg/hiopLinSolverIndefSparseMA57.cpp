@@ -1,4 +1,6 @@
 #include "hiopLinSolverIndefSparseMA57.hpp"
+#include "hiopProfiler.hpp"
+#include "hiopLinAlgFactory.hpp"
 
 #include "hiop_blasdefs.hpp"
 
@@ -47,10 +49,14 @@ namespace hiop
     if(m_jcolM)
       delete [] m_jcolM;
 
-    if(m_ifact)
+    if(m_ifact) {
+      LinearAlgebraFactory::track_free(m_lifact*sizeof(int), hiopMemStats::mcFactors);
       delete [] m_ifact;
-    if(m_fact)
+    }
+    if(m_fact) {
+      LinearAlgebraFactory::track_free(m_lfact*sizeof(double), hiopMemStats::mcFactors);
       delete [] m_fact;
+    }
     if(m_keep)
       delete [] m_keep;
     if(m_iwork)
@@ -84,15 +90,18 @@ namespace hiop
         
     m_lfact = (int) (m_rpessimism * m_info[8]);
     m_fact  = new double[m_lfact];
+    LinearAlgebraFactory::track_alloc(m_lfact*sizeof(double), hiopMemStats::mcFactors);
 
     m_lifact = (int) (m_ipessimism * m_info[9]);
     m_ifact  = new int[m_lifact];
+    LinearAlgebraFactory::track_alloc(m_lifact*sizeof(int), hiopMemStats::mcFactors);
 
   }
 
 
   int hiopLinSolverIndefSparseMA57::matrixChanged()
   {
+    HIOP_PROFILE_SCOPE("linsol_factorize");
     assert(m_n==M.n() && M.n()==M.m());
     assert(m_nnz==M.numberOfNonzeros());
     assert(m_n>0);
@@ -123,8 +132,10 @@ namespace hiop
                 m_ifact, &m_info[1], &intTemp, &m_lifact,
                 m_info );
 
+          LinearAlgebraFactory::track_free(m_lfact*sizeof(double), hiopMemStats::mcFactors);
           delete [] m_fact;
           m_fact = newfact;
+          LinearAlgebraFactory::track_alloc(lnfact*sizeof(double), hiopMemStats::mcFactors);
           m_lfact = lnfact;
           m_rpessimism *= 1.1;
           };
@@ -136,8 +147,10 @@ namespace hiop
           int * nifact = new int[ lnifact ];
           FNAME(ma57ed)( &m_n, &ic, m_keep, m_fact, &m_lfact, m_fact, &m_lfact,
                m_ifact, &m_lifact, nifact, &lnifact, m_info );
+          LinearAlgebraFactory::track_free(m_lifact*sizeof(int), hiopMemStats::mcFactors);
           delete [] m_ifact;
           m_ifact = nifact;
+          LinearAlgebraFactory::track_alloc(lnifact*sizeof(int), hiopMemStats::mcFactors);
           m_lifact = lnifact;
           m_ipessimism *= 1.1;
           };
@@ -170,6 +183,7 @@ namespace hiop
 
   bool hiopLinSolverIndefSparseMA57::solve ( hiopVector& x_ )
   {
+    HIOP_PROFILE_SCOPE("linsol_solve");
     assert(m_n==M.n() && M.n()==M.m());
     assert(m_nnz==M.numberOfNonzeros());
     assert(m_n>0);
@@ -183,8 +197,11 @@ namespace hiop
 
     hiopVectorPar* x = dynamic_cast<hiopVectorPar*>(&x_);
     assert(x != NULL);
-    hiopVectorPar* rhs = dynamic_cast<hiopVectorPar*>(x->new_copy());
-    hiopVectorPar* resid = dynamic_cast<hiopVectorPar*>(x->new_copy());
+    hiopWorkspaceScope scope(nlp_->workspace());
+    hiopVectorPar* rhs = dynamic_cast<hiopVectorPar*>(&nlp_->workspace().vector(*x));
+    hiopVectorPar* resid = dynamic_cast<hiopVectorPar*>(&nlp_->workspace().vector(*x));
+    rhs->copyFrom(*x);
+    resid->copyFrom(*x);
     double* dx = x->local_data();
     double* drhs = rhs->local_data();
     double* dresid = resid->local_data();
@@ -204,8 +221,6 @@ namespace hiop
 
     nlp_->runStats.linsolv.tmTriuSolves.stop();
 
-    delete rhs; rhs=nullptr;
-    delete resid; resid=nullptr;
     return m_info[0]==0;
   }
 
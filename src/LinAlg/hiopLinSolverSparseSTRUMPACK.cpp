@@ -1,4 +1,5 @@
 #include "hiopLinSolverSparseSTRUMPACK.hpp"
+#include "hiopProfiler.hpp"
 
 #include "hiop_blasdefs.hpp"
 
@@ -147,6 +148,7 @@ namespace hiop
 
   int hiopLinSolverIndefSparseSTRUMPACK::matrixChanged()
   {
+    HIOP_PROFILE_SCOPE("linsol_factorize");
     assert(n_==M.n() && M.n()==M.m());
     assert(n_>0);
 
@@ -178,6 +180,7 @@ namespace hiop
 
   bool hiopLinSolverIndefSparseSTRUMPACK::solve ( hiopVector& x_ )
   {
+    HIOP_PROFILE_SCOPE("linsol_solve");
     assert(n_==M.n() && M.n()==M.m());
     assert(n_>0);
     assert(x_.get_size()==M.n());
@@ -249,6 +252,7 @@ namespace hiop
 
   int hiopLinSolverNonSymSparseSTRUMPACK::matrixChanged()
   {
+    HIOP_PROFILE_SCOPE("linsol_factorize");
     assert(n_==M.n() && M.n()==M.m());
     assert(n_>0);
 
@@ -279,6 +283,7 @@ namespace hiop
 
   bool hiopLinSolverNonSymSparseSTRUMPACK::solve ( hiopVector& x_ )
   {
+    HIOP_PROFILE_SCOPE("linsol_solve");
     assert(n_==M.n() && M.n()==M.m());
     assert(n_>0);
     assert(x_.get_size()==M.n());
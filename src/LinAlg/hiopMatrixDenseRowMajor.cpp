@@ -57,6 +57,7 @@
 #include "hiop_blasdefs.hpp"
 
 #include "hiopVectorPar.hpp"
+#include "hiopLinAlgFactory.hpp"
 
 namespace hiop
 {
@@ -86,6 +87,7 @@ hiopMatrixDenseRowMajor::hiopMatrixDenseRowMajor(const long long& m,
 
   M_=new double*[max_rows_==0?1:max_rows_];
   M_[0] = max_rows_==0?NULL:new double[max_rows_*n_local_];
+  mem_category_ = LinearAlgebraFactory::track_alloc(max_rows_*n_local_*sizeof(double));
   for(int i=1; i<max_rows_; i++)
     M_[i]=M_[0]+i*n_local_;
 
@@ -99,6 +101,7 @@ hiopMatrixDenseRowMajor::~hiopMatrixDenseRowMajor()
 {
   if(buff_mxnlocal_) delete[] buff_mxnlocal_;
   if(M_) {
+    LinearAlgebraFactory::track_free(max_rows_*n_local_*sizeof(double), mem_category_);
     if(M_[0]) delete[] M_[0];
     delete[] M_;
   }
@@ -116,6 +119,7 @@ hiopMatrixDenseRowMajor::hiopMatrixDenseRowMajor(const hiopMatrixDenseRowMajor&
   M_=new double*[max_rows_==0?1:max_rows_];
   //M[0] = m_local_==0?NULL:new double[m_local_*n_local_];
   M_[0] = max_rows_==0?NULL:new double[max_rows_*n_local_];
+  mem_category_ = LinearAlgebraFactory::track_alloc(max_rows_*n_local_*sizeof(double));
   //for(int i=1; i<m_local_; i++)
   for(int i=1; i<max_rows_; i++)
     M_[i]=M_[0]+i*n_local_;
@@ -55,6 +55,7 @@
 
 #pragma once
 #include "hiopMatrixDense.hpp"
+#include "hiopMemStats.hpp"
 #include <cstddef>
 #include <cstdio>
 
@@ -239,6 +240,8 @@ private:
 
   //this is very private do not touch :)
   long long max_rows_;
+  //memory category to which the storage was attributed when allocated
+  hiopMemStats::Category mem_category_;
 private:
   hiopMatrixDenseRowMajor() {};
   /** copy constructor, for internal/private use only (it doesn't copy the values) */
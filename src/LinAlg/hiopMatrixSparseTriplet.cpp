@@ -1,5 +1,6 @@
 #include "hiopMatrixSparseTriplet.hpp"
 #include "hiopVectorPar.hpp"
+#include "hiopLinAlgFactory.hpp"
 
 #include "hiop_blasdefs.hpp"
 
@@ -26,10 +27,12 @@ hiopMatrixSparseTriplet::hiopMatrixSparseTriplet(int rows, int cols, int nnz)
   iRow_ = new  int[nnz_];
   jCol_ = new int[nnz_];
   values_ = new double[nnz_];
+  mem_category_ = LinearAlgebraFactory::track_alloc(nnz_*(sizeof(double)+2*sizeof(int)));
 }
 
 hiopMatrixSparseTriplet::~hiopMatrixSparseTriplet()
 {
+  LinearAlgebraFactory::track_free(nnz_*(sizeof(double)+2*sizeof(int)), mem_category_);
   delete [] iRow_;
   delete [] jCol_;
   delete [] values_;
@@ -327,9 +330,14 @@ hiopMatrixSparse* hiopMatrixSparseTriplet::new_copy() const
   memcpy(copy->values_, values_, nnz_*sizeof(double));
   return copy;
 }
+/// @brief copies the structure and values of a triplet matrix with the same dimensions and nnz
 void hiopMatrixSparseTriplet::copyFrom(const hiopMatrixSparse& dm)
 {
-  assert(false && "this is to be implemented - method def too vague for now");
+  const hiopMatrixSparseTriplet& src = dynamic_cast<const hiopMatrixSparseTriplet&>(dm);
+  assert(nrows_==src.nrows_ && ncols_==src.ncols_ && nnz_==src.nnz_);
+  memcpy(iRow_, src.iRow_, nnz_*sizeof(int));
+  memcpy(jCol_, src.jCol_, nnz_*sizeof(int));
+  memcpy(values_, src.values_, nnz_*sizeof(double));
 }
 
 #ifdef HIOP_DEEPCHECKS
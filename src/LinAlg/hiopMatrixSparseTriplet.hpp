@@ -4,6 +4,7 @@
 #include "hiopVector.hpp"
 #include "hiopMatrixDense.hpp"
 #include "hiopMatrixSparse.hpp"
+#include "hiopMemStats.hpp"
 
 #include <cassert>
 #include <unordered_map>
@@ -214,6 +215,7 @@ protected:
   int* iRow_; ///< row indices of the nonzero entries
   int* jCol_; ///< column indices of the nonzero entries
   double* values_; ///< values_ of the nonzero entries
+  hiopMemStats::Category mem_category_; ///< memory category to which the storage was attributed
 
 protected:
   struct RowStartsInfo
@@ -236,11 +238,11 @@ private:
   RowStartsInfo* allocAndBuildRowStarts() const;
 private:
   hiopMatrixSparseTriplet()
-    : hiopMatrixSparse(0, 0, 0), iRow_(NULL), jCol_(NULL), values_(NULL)
+    : hiopMatrixSparse(0, 0, 0), iRow_(NULL), jCol_(NULL), values_(NULL), mem_category_(hiopMemStats::mcOther)
   {
   }
   hiopMatrixSparseTriplet(const hiopMatrixSparseTriplet&)
-    : hiopMatrixSparse(0, 0, 0), iRow_(NULL), jCol_(NULL), values_(NULL)
+    : hiopMatrixSparse(0, 0, 0), iRow_(NULL), jCol_(NULL), values_(NULL), mem_category_(hiopMemStats::mcOther)
   {
     assert(false);
   }
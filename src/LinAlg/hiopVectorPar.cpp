@@ -46,6 +46,7 @@
 // product endorsement purposes.
 
 #include "hiopVectorPar.hpp"
+#include "hiopLinAlgFactory.hpp"
 
 #include <cmath>
 #include <cstring> //for memcpy
@@ -84,6 +85,7 @@ hiopVectorPar::hiopVectorPar(const long long& glob_n, long long* col_part/*=NULL
   n_local_=glob_iu_-glob_il_;
 
   data_ = new double[n_local_];
+  mem_category_ = LinearAlgebraFactory::track_alloc(n_local_*sizeof(double));
 }
 hiopVectorPar::hiopVectorPar(const hiopVectorPar& v)
 {
@@ -91,9 +93,11 @@ hiopVectorPar::hiopVectorPar(const hiopVectorPar& v)
   glob_il_=v.glob_il_; glob_iu_=v.glob_iu_;
   comm_=v.comm_;
   data_=new double[n_local_];  
+  mem_category_ = LinearAlgebraFactory::track_alloc(n_local_*sizeof(double));
 }
 hiopVectorPar::~hiopVectorPar()
 {
+  LinearAlgebraFactory::track_free(n_local_*sizeof(double), mem_category_);
   delete[] data_; data_=NULL;
 }
 
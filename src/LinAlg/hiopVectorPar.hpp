@@ -51,6 +51,7 @@
 #include <string>
 #include <hiopMPI.hpp>
 #include "hiopVector.hpp"
+#include "hiopMemStats.hpp"
 
 #include <cstdio>
 
@@ -210,6 +211,8 @@ protected:
   double* data_;
   long long glob_il_, glob_iu_;
   long long n_local_;
+  /// memory category to which 'data_' was attributed when allocated
+  hiopMemStats::Category mem_category_;
 private:
   /// @brief copy constructor, for internal/private use only (it doesn't copy the elements.)
   hiopVectorPar(const hiopVectorPar&);
@@ -0,0 +1,157 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+/**
+ * @file hiopWorkspace.cpp
+ *
+ * Workspace arena for the temporary vectors and dense matrices of the solver.
+ *
+ */
+
+#include "hiopWorkspace.hpp"
+#include "hiopLinAlgFactory.hpp"
+
+#include <typeinfo>
+#include <utility>
+#include <cassert>
+
+namespace hiop
+{
+
+hiopWorkspace::hiopWorkspace()
+  : top_(0), bytes_in_use_(0), bytes_peak_(0), bytes_allocated_(0)
+{
+}
+
+hiopWorkspace::~hiopWorkspace()
+{
+  for(Slot& s : slots_) {
+    delete s.vec;
+    delete s.mat;
+  }
+}
+
+hiopVector& hiopWorkspace::vector(const hiopVector& like)
+{
+  return *acquire(&like, NULL, 0, 0).vec;
+}
+
+hiopMatrixDense& hiopWorkspace::matrix_dense(const hiopMatrixDense& like)
+{
+  return *acquire(NULL, &like, 0, 0).mat;
+}
+
+hiopMatrixDense& hiopWorkspace::matrix_dense(int m, int n)
+{
+  return *acquire(NULL, NULL, m, n).mat;
+}
+
+hiopWorkspace::Slot& hiopWorkspace::
+acquire(const hiopVector* vec_like, const hiopMatrixDense* mat_like, int m, int n)
+{
+  auto matches = [&](const Slot& s) -> bool
+  {
+    if(vec_like) {
+      return s.vec && typeid(*s.vec)==typeid(*vec_like) &&
+        s.vec->get_size()==vec_like->get_size() && 
+        s.vec->get_local_size()==vec_like->get_local_size();
+    }
+    if(mat_like) {
+      return s.mat && typeid(*s.mat)==typeid(*mat_like) &&
+        s.mat->m()==mat_like->m() && s.mat->n()==mat_like->n() && 
+        s.mat->get_local_size_n()==mat_like->get_local_size_n();
+    }
+    return s.mat && s.mat->m()==m && s.mat->n()==n && s.mat->get_local_size_n()==n;
+  };
+
+  //the object at the bump pointer is, usually, the one handed out by the same request in the 
+  //previous iteration
+  bool found = false;
+  for(size_t k=top_; k<slots_.size(); k++) {
+    if(matches(slots_[k])) {
+      std::swap(slots_[top_], slots_[k]);
+      found = true;
+      break;
+    }
+  }
+  if(!found) {
+    hiopMemCategoryScope mem_scope(hiopMemStats::mcWorkspace);
+    Slot s{NULL, NULL, 0};
+    if(vec_like) {
+      s.vec = vec_like->alloc_clone();
+      s.bytes = s.vec->get_local_size()*sizeof(double);
+    } else {
+      s.mat = mat_like ? mat_like->alloc_clone() : LinearAlgebraFactory::createMatrixDense(m, n);
+      s.bytes = s.mat->m()*s.mat->get_local_size_n()*sizeof(double);
+    }
+    slots_.insert(slots_.begin()+top_, s);
+    bytes_allocated_ += s.bytes;
+  }
+
+  bytes_in_use_ += slots_[top_].bytes;
+  if(bytes_in_use_ > bytes_peak_) {
+    bytes_peak_ = bytes_in_use_;
+  }
+  return slots_[top_++];
+}
+
+void hiopWorkspace::release(size_t mark)
+{
+  assert(mark<=top_ && "temporaries must be released in the reverse order of their requests");
+  for(size_t k=mark; k<top_; k++) {
+    bytes_in_use_ -= slots_[k].bytes;
+  }
+  top_ = mark;
+}
+
+void hiopWorkspace::reset()
+{
+  release(0);
+}
+
+} //end of namespace
@@ -0,0 +1,159 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+/**
+ * @file hiopWorkspace.hpp
+ *
+ * Workspace arena for the temporary vectors and dense matrices of the solver.
+ *
+ */
+
+#ifndef HIOP_WORKSPACE
+#define HIOP_WORKSPACE
+
+#include "hiopVector.hpp"
+#include "hiopMatrixDense.hpp"
+
+#include <vector>
+#include <cstddef>
+
+namespace hiop
+{
+
+/* *************************************************************************
+ * Arena of temporary hiopVector and hiopMatrixDense objects, handed out by a
+ * bump (stack) pointer instead of being allocated and freed by each call.
+ *
+ * A temporary is requested with the size, distribution, and memory space of
+ * an existing object ('like') or, for dense matrices, with given dimensions.
+ * The arena keeps all the objects it ever created in the order in which they
+ * were handed out. A request reuses the object at the bump pointer when its
+ * shape matches, or an object of matching shape further up the stack; only
+ * otherwise a new object is created. Since the sequence of requests of an 
+ * optimization iteration repeats itself, the arena stops allocating after
+ * the first iterations.
+ *
+ * The temporaries are returned to the arena in a LIFO fashion with 'release'
+ * (usually by hiopWorkspaceScope) or all at once with 'reset', which is 
+ * called at iteration boundaries. The entries of the temporaries are not 
+ * initialized.
+ * *************************************************************************
+ */
+class hiopWorkspace
+{
+public:
+  hiopWorkspace();
+  ~hiopWorkspace();
+
+  /// Temporary vector of the same type, size, and distribution as 'like'
+  hiopVector& vector(const hiopVector& like);
+
+  /// Temporary dense matrix of the same type, dimensions, and distribution as 'like'
+  hiopMatrixDense& matrix_dense(const hiopMatrixDense& like);
+
+  /// Temporary (local) dense matrix of size m x n
+  hiopMatrixDense& matrix_dense(int m, int n);
+
+  /// Position of the bump pointer, to be passed to 'release'
+  inline size_t mark() const { return top_; }
+
+  /// Returns the temporaries handed out after 'mark' was taken
+  void release(size_t mark);
+
+  /// Returns all the temporaries
+  void reset();
+
+  /// Memory (in bytes) of the temporaries currently handed out
+  inline size_t bytes_in_use() const { return bytes_in_use_; }
+  /// Largest value of 'bytes_in_use' since the creation of the arena
+  inline size_t bytes_peak() const { return bytes_peak_; }
+  /// Memory (in bytes) of all the objects owned by the arena
+  inline size_t bytes_allocated() const { return bytes_allocated_; }
+  /// Number of objects owned by the arena
+  inline size_t num_objects() const { return slots_.size(); }
+private:
+  struct Slot
+  {
+    hiopVector* vec;
+    hiopMatrixDense* mat;
+    size_t bytes;
+  };
+
+  //moves a slot matching the request to the bump pointer or creates one there
+  Slot& acquire(const hiopVector* vec_like, const hiopMatrixDense* mat_like, int m, int n);
+
+  std::vector<Slot> slots_;
+  size_t top_;
+  size_t bytes_in_use_;
+  size_t bytes_peak_;
+  size_t bytes_allocated_;
+private:
+  hiopWorkspace(const hiopWorkspace&) = delete;
+  hiopWorkspace& operator=(const hiopWorkspace&) = delete;
+};
+
+/**
+ * Returns to the arena, upon destruction, the temporaries handed out during its lifetime.
+ */
+class hiopWorkspaceScope
+{
+public:
+  hiopWorkspaceScope(hiopWorkspace& ws)
+    : ws_(ws), mark_(ws.mark())
+  {}
+  ~hiopWorkspaceScope()
+  {
+    ws_.release(mark_);
+  }
+private:
+  hiopWorkspace& ws_;
+  size_t mark_;
+};
+
+} //end of namespace
+#endif
@@ -51,11 +51,17 @@
 #include "hiopKKTLinSysDense.hpp"
 #include "hiopKKTLinSysMDS.hpp"
 #include "hiopKKTLinSysSparse.hpp"
+#include "hiopFRProb.hpp"
+#include "hiopLinAlgFactory.hpp"
 
 #include "hiopCppStdUtils.hpp"
+#include "hiopProfiler.hpp"
 
 #include <cmath>
 #include <cstring>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
 #include <cassert>
 #include <stdio.h>
 #include <ctype.h>
@@ -64,22 +70,30 @@ namespace hiop
 {
 
 hiopAlgFilterIPMBase::hiopAlgFilterIPMBase(hiopNlpFormulation* nlp_)
- : c_soc(nullptr), d_soc(nullptr), soc_dir(nullptr)
+ : c_soc(nullptr), d_soc(nullptr), soc_dir(nullptr), resid_soc(nullptr),
+   it_best_(nullptr), c_best_(nullptr), d_best_(nullptr), ckpt_(nullptr), trace_(nullptr)
 {
   nlp = nlp_;
   //force completion of the nlp's initialization
   nlp->finalizeInitialization();
   reloadOptions();
 
+  hiopMemCategoryScope mem_scope(hiopMemStats::mcIterates);
   it_curr = new hiopIterate(nlp);
   it_trial= it_curr->alloc_clone();
   dir     = it_curr->alloc_clone();
 
+  //second-order correction workspace
+  c_soc = nlp->alloc_dual_eq_vec();
+  d_soc = nlp->alloc_dual_ineq_vec();
+  soc_dir = it_curr->alloc_clone();
+
   if(nlp->options->GetString("KKTLinsys")=="full")
   {
     it_curr->selectPattern();
     it_trial->selectPattern(); 
     dir->selectPattern();
+    soc_dir->selectPattern();
   }
 
   logbar = new hiopLogBarProblem(nlp);
@@ -88,22 +102,15 @@ hiopAlgFilterIPMBase::hiopAlgFilterIPMBase(hiopNlpFormulation* nlp_)
   _c = nlp->alloc_dual_eq_vec();
   _d = nlp->alloc_dual_ineq_vec();
 
-  _grad_f  = nlp->alloc_primal_vec();
-  _Jac_c   = nlp->alloc_Jac_c();
-  _Jac_d   = nlp->alloc_Jac_d();
-
   _f_nlp_trial = _f_log_trial = 0;
   _c_trial = nlp->alloc_dual_eq_vec();
   _d_trial = nlp->alloc_dual_ineq_vec();
 
-  _grad_f_trial  = nlp->alloc_primal_vec();
-  _Jac_c_trial   = nlp->alloc_Jac_c();
-  _Jac_d_trial   = nlp->alloc_Jac_d();
-
-  _Hess_Lagr = nlp->alloc_Hess_Lagr();
+  allocDerivatives();
 
   resid = new hiopResidual(nlp);
   resid_trial = new hiopResidual(nlp);
+  resid_soc = new hiopResidual(nlp);
 
   //parameter based initialization
   if(duals_update_type==0) {
@@ -116,6 +123,44 @@ hiopAlgFilterIPMBase::hiopAlgFilterIPMBase(hiopNlpFormulation* nlp_)
 
   resetSolverStatus();
 }
+void hiopAlgFilterIPMBase::allocDerivatives()
+{
+  hiopMemCategoryScope mem_scope(hiopMemStats::mcDerivatives);
+  _grad_f  = nlp->alloc_primal_vec();
+  _grad_f_trial  = nlp->alloc_primal_vec();
+
+  //the memory of the Jacobians and of the Hessian is measured as they are allocated
+  const size_t bytes_before = LinearAlgebraFactory::get_mem_stats().total_in_use;
+  _Jac_c   = nlp->alloc_Jac_c();
+  _Jac_d   = nlp->alloc_Jac_d();
+  const size_t jac_bytes = LinearAlgebraFactory::get_mem_stats().total_in_use - bytes_before;
+
+  _Hess_Lagr = nlp->alloc_Hess_Lagr();
+  deriv_bytes_ = LinearAlgebraFactory::get_mem_stats().total_in_use - bytes_before;
+
+  //the Jacobians at the trial point are the first to go when the memory is short
+  trial_jacobians_ = !exceedsMemoryBudget(jac_bytes);
+  if(!trial_jacobians_) {
+    nlp->log->printf(hovSummary,
+                     "memory_budget: the Jacobians at the trial point are not stored (%.3f MB saved)\n",
+                     jac_bytes/(1024.*1024.));
+  }
+  //the trial Jacobians are created by 'evalNlp_derivOnly_trial' as copies of the evaluated current
+  //ones, since the sparsity pattern is passed by the NLP only at the first evaluation
+  _Jac_c_trial = NULL;
+  _Jac_d_trial = NULL;
+}
+
+bool hiopAlgFilterIPMBase::exceedsMemoryBudget(size_t extra_bytes) const
+{
+  const double budget = nlp->options->GetNumeric("memory_budget");
+  if(budget<=0.) {
+    return false;
+  }
+  const size_t bytes = LinearAlgebraFactory::get_mem_stats().total_in_use + extra_bytes;
+  return bytes > budget*1024.*1024.;
+}
+
 void hiopAlgFilterIPMBase::destructorPart()
 {
   if(it_curr)  delete it_curr;
@@ -153,6 +198,16 @@ void hiopAlgFilterIPMBase::destructorPart()
   if(soc_dir) {
     delete soc_dir;
   }
+  if(resid_soc) {
+    delete resid_soc;
+  }
+  if(it_best_) {
+    delete it_best_;
+    delete c_best_;
+    delete d_best_;
+    it_best_ = nullptr;
+    c_best_ = d_best_ = nullptr;
+  }
 }
 hiopAlgFilterIPMBase::~hiopAlgFilterIPMBase()
 {
@@ -191,12 +246,23 @@ hiopAlgFilterIPMBase::~hiopAlgFilterIPMBase()
   if(soc_dir) {
     delete soc_dir;
   }
+  if(resid_soc) {
+    delete resid_soc;
+  }
+  if(it_best_) {
+    delete it_best_;
+    delete c_best_;
+    delete d_best_;
+  }
+  delete ckpt_;
+  delete trace_;
 }
 
 void hiopAlgFilterIPMBase::reInitializeNlpObjects()
 {
   destructorPart();
 
+  hiopMemCategoryScope mem_scope(hiopMemStats::mcIterates);
   it_curr = new hiopIterate(nlp);
   it_trial= it_curr->alloc_clone();
   dir     = it_curr->alloc_clone();
@@ -207,19 +273,11 @@ void hiopAlgFilterIPMBase::reInitializeNlpObjects()
   _c = nlp->alloc_dual_eq_vec();
   _d = nlp->alloc_dual_ineq_vec();
 
-  _grad_f  = nlp->alloc_primal_vec();
-  _Jac_c   = nlp->alloc_Jac_c();
-  _Jac_d   = nlp->alloc_Jac_d();
-
   _f_nlp_trial = _f_log_trial = 0;
   _c_trial = nlp->alloc_dual_eq_vec();
   _d_trial = nlp->alloc_dual_ineq_vec();
 
-  _grad_f_trial  = nlp->alloc_primal_vec();
-  _Jac_c_trial   = nlp->alloc_Jac_c();
-  _Jac_d_trial   = nlp->alloc_Jac_d();
-
-  _Hess_Lagr = nlp->alloc_Hess_Lagr();
+  allocDerivatives();
 
   resid = new hiopResidual(nlp);
   resid_trial = new hiopResidual(nlp);
@@ -227,6 +285,10 @@ void hiopAlgFilterIPMBase::reInitializeNlpObjects()
   c_soc = nlp->alloc_dual_eq_vec();
   d_soc = nlp->alloc_dual_ineq_vec();
   soc_dir = it_curr->alloc_clone();
+  if(nlp->options->GetString("KKTLinsys")=="full") {
+    soc_dir->selectPattern();
+  }
+  resid_soc = new hiopResidual(nlp);
 
   //0 LSQ (default), 1 linear update (more stable)
   duals_update_type = nlp->options->GetString("duals_update_type")=="lsq"?0:1;
@@ -276,6 +338,39 @@ void hiopAlgFilterIPMBase::reloadOptions()
   accep_n_it    = nlp->options->GetInteger("acceptable_iterations");
   eps_tol_accep = nlp->options->GetNumeric("acceptable_tolerance");
 
+  early_term_        = nlp->options->GetString("early_termination")=="yes";
+  early_term_window_ = nlp->options->GetInteger("early_termination_window");
+
+  profile_ = nlp->options->GetString("profile")=="yes";
+
+  ckpt_save_n_ = nlp->options->GetString("checkpoint_save")=="yes" ? 
+    nlp->options->GetInteger("checkpoint_save_N") : 0;
+  ckpt_load_ = nlp->options->GetString("checkpoint_load_on_start")=="yes";
+  delete ckpt_;
+  ckpt_ = nullptr;
+  if(ckpt_save_n_>0 || ckpt_load_) {
+    ckpt_ = new hiopCheckpoint(nlp, nlp->options->GetString("checkpoint_file"));
+  }
+
+  //the trace is written by the master rank only
+  delete trace_;
+  trace_ = nullptr;
+  const std::string trace_type = nlp->options->GetString("trace");
+  int rank = 0;
+#ifdef HIOP_USE_MPI
+  rank = nlp->get_rank();
+#endif
+  if(trace_type!="no" && 0==rank) {
+    const bool bin = trace_type=="binary";
+    const std::string file_name = nlp->options->GetString("trace_file") + (bin ? ".bin" : ".csv");
+    trace_ = new hiopTraceWriter(file_name, bin ? hiopTraceWriter::binary : hiopTraceWriter::csv);
+    if(!trace_->is_open()) {
+      nlp->log->printf(hovWarning, "could not open trace file '%s'\n", file_name.c_str());
+      delete trace_;
+      trace_ = nullptr;
+    }
+  }
+
   //0 LSQ (default), 1 linear update (more stable)
   duals_update_type = nlp->options->GetString("duals_update_type")=="lsq"?0:1;
   //0 LSQ (default), 1 set to zero
@@ -310,9 +405,22 @@ void hiopAlgFilterIPMBase::reloadOptions()
   hiop::LinearAlgebraFactory::set_mem_space(nlp->options->GetString("mem_space"));
 }
 
+hiopSolveStatus hiopAlgFilterIPMBase::resolve()
+{
+  //if the structure changed, 'run' performs a full re-initialization of the NLP and of 'this'
+  nlp->reload_bounds_data();
+  return run();
+}
+
 void hiopAlgFilterIPMBase::resetSolverStatus()
 {
   n_accep_iters_ = 0;
+  if(early_term_) {
+    hist_log_err_.assign(early_term_window_+1, 0.);
+    hist_log_mu_.assign(early_term_window_+1, 0.);
+  }
+  n_hist_ = 0;
+  err_best_ = 1e+300;
   solver_status_ = NlpSolve_IncompleteInit;
   filter.clear();
 }
@@ -322,6 +430,7 @@ startingProcedure(hiopIterate& it_ini,
 		  double &f, hiopVector& c, hiopVector& d,
 		  hiopVector& gradf,  hiopMatrix& Jac_c,  hiopMatrix& Jac_d)
 {
+  HIOP_PROFILE_SCOPE("ipm_starting_procedure");
   bool duals_avail = false;
   if(!nlp->get_starting_point(*it_ini.get_x(),
 			      duals_avail,
@@ -337,7 +446,19 @@ startingProcedure(hiopIterate& it_ini,
   nlp->runStats.tmSolverInternal.start();
   nlp->runStats.tmStartingPoint.start();
 
-  it_ini.projectPrimalsXIntoBounds(kappa1, kappa2);
+  //warm start from the primal-dual point provided by the user: the bound push and mu are based on
+  //the complementarity of this point instead of 'kappa1', 'kappa2', and 'mu0'
+  const bool warm_start = duals_avail && "yes"==nlp->options->GetString("warm_start");
+  double mu_ws = mu0, push1 = kappa1, push2 = kappa2;
+  if(warm_start) {
+    //only the slacks of x are meaningful at this point since 'd' is not yet computed
+    it_ini.determineSlacks();
+    mu_ws = fmax(eps_tol/10, fmin(mu0, it_ini.avgComplementarity(false)));
+    push1 = fmin(kappa1, mu_ws);
+    push2 = fmin(kappa2, mu_ws);
+  }
+
+  it_ini.projectPrimalsXIntoBounds(push1, push2);
 
   nlp->runStats.tmStartingPoint.stop();
   nlp->runStats.tmSolverInternal.stop();
@@ -375,13 +496,20 @@ startingProcedure(hiopIterate& it_ini,
 
   it_ini.get_d()->copyFrom(d);
 
-  it_ini.projectPrimalsDIntoBounds(kappa1, kappa2);
+  it_ini.projectPrimalsDIntoBounds(push1, push2);
 
   it_ini.determineSlacks();
 
+  _mu = mu0;
   if(!duals_avail) {
     // initialization for zl, zu, vl, vu
     it_ini.setBoundsDualsToConstant(1.);
+  } else if(warm_start) {
+    // zl, zu, yc, and yd were provided by the user; vl and vu are obtained from yd
+    it_ini.pushDualsForWarmStart(mu_ws);
+
+    _mu = fmax(eps_tol/10, fmin(mu0, it_ini.avgComplementarity(true)));
+    nlp->log->printf(hovSummary, "Warm start: initial mu=%.3e  bound push=%.3e\n", _mu, push1);
   } else {
     // zl and zu were provided by the user
 
@@ -402,6 +530,7 @@ startingProcedure(hiopIterate& it_ini,
 	//updater = new hiopDualsLsqUpdate(nlp);
         updater = nlp->alloc_duals_lsq_updater();
 	deleteUpdater = true;
+        updater->set_kkt_linsys(get_kkt_linsys(), _Hess_Lagr);
       }
 
       //this will update yc and yd in it_ini
@@ -422,6 +551,8 @@ startingProcedure(hiopIterate& it_ini,
     return false;
   }
 
+  _tau = fmax(tau_min, 1.0-_mu);
+
   nlp->log->write("Using initial point:", it_ini, hovIteration);
   nlp->runStats.tmStartingPoint.stop();
   nlp->runStats.tmSolverInternal.stop();
@@ -556,6 +687,65 @@ updateLogBarrierParameters(const hiopIterate& it, const double& mu_curr, const d
   return true;
 }
 
+bool hiopAlgFilterIPMBase::updateLogBarAndErrors()
+{
+  //update only logbar problem and residual (the NLP didn't change)
+  logbar->updateWithNlpInfo(*it_curr, _mu, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
+  resid->update(*it_curr,_f_nlp, *_c, *_d,*_grad_f,*_Jac_c,*_Jac_d, *logbar);
+
+  if(!evalNlpAndLogErrors(*it_curr, *resid, _mu,
+                          _err_nlp_optim, _err_nlp_feas, _err_nlp_complem, _err_nlp,
+                          _err_log_optim, _err_log_feas, _err_log_complem, _err_log)) {
+    return false;
+  }
+  nlp->log->printf(hovScalars,
+                   "  LogBar errs: pr-infeas:%23.17e   dual-infeas:%23.17e  comp:%23.17e  overall:%23.17e\n",
+                   _err_log_feas, _err_log_optim, _err_log_complem, _err_log);
+  filter.reinitialize(theta_max);
+  return true;
+}
+
+bool hiopAlgFilterIPMBase::
+updateLogBarrierParametersProbing(hiopKKTLinSys* kkt, const double& mu_curr, const double& tau_curr,
+                                  double& mu_new, double& tau_new)
+{
+  //residual of the affine-scaling system (mu=0)
+  logbar->updateWithNlpInfo(*it_curr, 0., _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
+  resid_trial->update(*it_curr, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d, *logbar);
+  logbar->updateWithNlpInfo(*it_curr, mu_curr, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
+
+  //the KKT matrix does not depend on mu, only a solve with the existing factors is needed
+  if(!kkt->computeDirections(resid_trial, dir)) {
+    nlp->log->printf(hovWarning, "Iter[%d] affine-scaling direction failed; mu is not updated\n", iter_num);
+    return false;
+  }
+
+  nlp->runStats.tmSolverInternal.start();
+  //maximum step to the boundary along the affine-scaling direction
+  double alpha_aff_pr, alpha_aff_du;
+  bool bret = it_curr->fractionToTheBdry(*dir, 1.0, alpha_aff_pr, alpha_aff_du); assert(bret);
+  alpha_aff_pr = fmin(1., alpha_aff_pr);
+  alpha_aff_du = fmin(1., alpha_aff_du);
+
+  bret = it_trial->takeStep_primals(*it_curr, *dir, alpha_aff_pr, alpha_aff_du); assert(bret);
+  bret = it_trial->takeStep_duals(*it_curr, *dir, alpha_aff_pr, alpha_aff_du); assert(bret);
+
+  const double mu_c = it_curr->avgComplementarity(true);
+  const double mu_a = fmax(0., it_trial->avgComplementarity(true));
+  nlp->runStats.tmSolverInternal.stop();
+  if(mu_c<=0.) {
+    return false;
+  }
+  const double sigma = pow(fmin(1., mu_a/mu_c), 3);
+
+  //mu is not allowed to increase above 'mu0'
+  mu_new = fmax(eps_tol/10, fmin(mu0, sigma*mu_c));
+  tau_new = fmax(tau_min, 1.0-mu_new);
+  nlp->log->printf(hovScalars, "Iter[%d] probing: alpha_aff=(%g,%g) compl=%g compl_aff=%g sigma=%g mu=%g\n",
+                   iter_num, alpha_aff_pr, alpha_aff_du, mu_c, mu_a, sigma, mu_new);
+  return true;
+}
+
 double hiopAlgFilterIPMBase::thetaLogBarrier(const hiopIterate& it, const hiopResidual& resid, const double& mu)
 {
   //actual nlp errors
@@ -646,6 +836,33 @@ bool hiopAlgFilterIPMBase::evalNlp_funcOnly(hiopIterate& iter,
   return true;
 }
 
+bool hiopAlgFilterIPMBase::evalNlp_consOnly(hiopIterate& iter, hiopVector& c, hiopVector& d,
+                                            bool allow_partial, bool& rejected)
+{
+  rejected = false;
+  hiopVector& x = *iter.get_x();
+  if(allow_partial && nlp->cons_eval_separately()) {
+    if(!nlp->eval_c(x, true, c)) {
+      nlp->log->printf(hovError, "Error occured in user constraint(s) function evaluation\n");
+      return false;
+    }
+    if(filter.contains_theta(resid->compute_nlp_infeasib_eq_onenorm(c))) {
+      rejected = true;
+      return true;
+    }
+    if(!nlp->eval_d(x, false, d)) {
+      nlp->log->printf(hovError, "Error occured in user constraint(s) function evaluation\n");
+      return false;
+    }
+  } else {
+    if(!nlp->eval_c_d(x, true, c, d)) {
+      nlp->log->printf(hovError, "Error occured in user constraint(s) function evaluation\n");
+      return false;
+    }
+  }
+  return true;
+}
+
 bool hiopAlgFilterIPMBase::evalNlp_derivOnly(hiopIterate& iter,
 					     hiopVector& gradf,
 					     hiopMatrix& Jac_c,
@@ -677,6 +894,25 @@ bool hiopAlgFilterIPMBase::evalNlp_derivOnly(hiopIterate& iter,
   return true;
 }
 
+bool hiopAlgFilterIPMBase::evalNlp_derivOnly_trial(hiopIterate& iter)
+{
+  if(!trial_jacobians_) {
+    return evalNlp_derivOnly(iter, *_grad_f, *_Jac_c, *_Jac_d, *_Hess_Lagr);
+  }
+  if(NULL==_Jac_c_trial) {
+    hiopMemCategoryScope mem_scope(hiopMemStats::mcDerivatives);
+    _Jac_c_trial = _Jac_c->new_copy();
+    _Jac_d_trial = _Jac_d->new_copy();
+  }
+  if(!evalNlp_derivOnly(iter, *_grad_f_trial, *_Jac_c_trial, *_Jac_d_trial, *_Hess_Lagr)) {
+    return false;
+  }
+  std::swap(_grad_f, _grad_f_trial);
+  std::swap(_Jac_c, _Jac_c_trial);
+  std::swap(_Jac_d, _Jac_d_trial);
+  return true;
+}
+
 /* returns the objective value; valid only after 'run' method has been called */
 double hiopAlgFilterIPMBase::getObjective() const
 {
@@ -756,12 +992,275 @@ checkTermination(const double& err_nlp, const int& iter_num, hiopSolveStatus& st
 
   if(n_accep_iters_>=accep_n_it) { solver_status_ = Solve_Acceptable_Level; return true; }
 
+  if(early_term_) {
+    if(err_nlp<err_best_) {
+      if(NULL==it_best_) {
+        it_best_ = it_curr->alloc_clone();
+        c_best_ = _c->alloc_clone();
+        d_best_ = _d->alloc_clone();
+      }
+      it_best_->copyFrom(*it_curr);
+      c_best_->copyFrom(*_c);
+      d_best_->copyFrom(*_d);
+      f_best_ = _f_nlp;
+      err_best_ = err_nlp;
+    }
+    if(predictsSlowConvergence(err_nlp, iter_num)) {
+      //return the best iterate rather than the last one
+      if(err_best_<err_nlp) {
+        nlp->log->printf(hovSummary, "Returning the best iterate found (NLP error %g)\n", err_best_);
+        std::swap(it_curr, it_best_);
+        std::swap(_c, c_best_);
+        std::swap(_d, d_best_);
+        _f_nlp = f_best_;
+        _err_nlp = err_best_;
+      }
+      solver_status_ = Slow_Convergence;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool hiopAlgFilterIPMBase::predictsSlowConvergence(const double& err_nlp, const int& iter_num)
+{
+  const int len = early_term_window_+1;
+  assert((int)hist_log_err_.size()==len && (int)hist_log_mu_.size()==len);
+
+  const int pos = n_hist_ % len;
+  //the running minimum of the error is used since the error of the IPM is not monotone
+  hist_log_err_[pos] = log10(fmax(fmin(err_nlp, err_best_), 1e-300));
+  hist_log_mu_[pos] = log10(_mu);
+  n_hist_++;
+  if(n_hist_<len) {
+    return false;
+  }
+  //after the increment above, n_hist_ % len is the position of the oldest entry in the window
+  const int pos_old = n_hist_ % len;
+  const double log_tol = log10(eps_tol);
+  const double rate_err = (hist_log_err_[pos]-hist_log_err_[pos_old]) / early_term_window_;
+  const double rate_mu  = (hist_log_mu_[pos] -hist_log_mu_[pos_old])  / early_term_window_;
+
+  //iterations needed by the faster of the two; mu does not need to decrease once at the tolerance
+  double n_pred = 1e+20;
+  if(rate_err<0) {
+    n_pred = (log_tol-hist_log_err_[pos]) / rate_err;
+  }
+  if(_mu>eps_tol && rate_mu<0) {
+    n_pred = fmin(n_pred, (log_tol-hist_log_mu_[pos]) / rate_mu);
+  }
+  const int n_left = max_n_it - iter_num;
+  nlp->log->printf(hovScalars,
+                   "Iter[%d] convergence rate (log10 per iteration): err=%g mu=%g -> predicted %g "
+                   "iterations to tolerance, %d left\n",
+                   iter_num, rate_err, rate_mu, n_pred, n_left);
+  if(n_pred>n_left) {
+    nlp->log->printf(hovWarning,
+                     "Iter[%d] %g iterations predicted to reach the tolerance, more than the %d left\n",
+                     iter_num, n_pred, n_left);
+    return true;
+  }
   return false;
 }
 /***** Termination message *****/
+bool hiopAlgFilterIPMBase::checkpoint_save()
+{
+  assert(ckpt_);
+  hiopCheckpoint& ckpt = *ckpt_;
+  ckpt.begin();
+
+  //scaling factors, so that the restored iterate is in the same (scaled) space
+  hiopVector* scale_c = _c->alloc_clone();
+  hiopVector* scale_d = _d->alloc_clone();
+  double scale_obj = 1.;
+  const bool scaled = nlp->get_scaling_factors(scale_obj, *scale_c, *scale_d);
+  ckpt.append(static_cast<int>(scaled));
+  if(scaled) {
+    ckpt.append(scale_obj);
+    ckpt.append(*scale_c);
+    ckpt.append(*scale_d);
+  }
+  delete scale_c;
+  delete scale_d;
+
+  ckpt.append(iter_num);
+  const double scalars[9] = {_mu, _tau, theta_max, theta_min, _alpha_primal, _alpha_dual,
+                             _err_nlp_optim0, _err_nlp_feas0, _err_nlp_complem0};
+  ckpt.append(scalars, 9);
+
+  //primal-dual iterate
+  ckpt.append(*it_curr->get_x());
+  ckpt.append(*it_curr->get_d());
+  ckpt.append(*it_curr->get_sxl());
+  ckpt.append(*it_curr->get_sxu());
+  ckpt.append(*it_curr->get_sdl());
+  ckpt.append(*it_curr->get_sdu());
+  ckpt.append(*it_curr->get_yc());
+  ckpt.append(*it_curr->get_yd());
+  ckpt.append(*it_curr->get_zl());
+  ckpt.append(*it_curr->get_zu());
+  ckpt.append(*it_curr->get_vl());
+  ckpt.append(*it_curr->get_vu());
+
+  //filter entries
+  ckpt.append(static_cast<int>(filter.size()));
+  std::vector<double> entries(2*filter.size());
+  for(size_t i=0; i<filter.size(); i++) {
+    filter.get_entry(i, entries[2*i], entries[2*i+1]);
+  }
+  ckpt.append(entries.data(), static_cast<long long>(entries.size()));
+
+  //quasi-Newton memory
+  hiopHessianLowRank* Hess = dynamic_cast<hiopHessianLowRank*>(_Hess_Lagr);
+  ckpt.append(static_cast<int>(Hess!=NULL));
+  if(Hess) {
+    Hess->save_state(ckpt);
+  }
+  checkpoint_save_extra(ckpt);
+
+  if(!ckpt.commit()) {
+    nlp->log->printf(hovWarning, "could not write checkpoint file '%s'\n", ckpt.file_name().c_str());
+    return false;
+  }
+  nlp->log->printf(hovScalars, "Iter[%d] checkpoint saved\n", iter_num);
+  return true;
+}
+
+bool hiopAlgFilterIPMBase::checkpoint_load_scaling()
+{
+  assert(ckpt_);
+  hiopCheckpoint& ckpt = *ckpt_;
+  if(!ckpt.load()) {
+    nlp->log->printf(hovError, "could not load checkpoint file '%s'\n", ckpt.file_name().c_str());
+    return false;
+  }
+  int scaled;
+  if(!ckpt.extract(scaled)) {
+    return false;
+  }
+  if(scaled) {
+    hiopVector* scale_c = _c->alloc_clone();
+    hiopVector* scale_d = _d->alloc_clone();
+    double scale_obj;
+    const bool bret = ckpt.extract(scale_obj) && ckpt.extract(*scale_c) && ckpt.extract(*scale_d);
+    if(bret) {
+      nlp->set_scaling_factors(scale_obj, *scale_c, *scale_d);
+    }
+    delete scale_c;
+    delete scale_d;
+    if(!bret) {
+      nlp->log->printf(hovError, "checkpoint file '%s' is corrupted or does not match the problem\n",
+                       ckpt.file_name().c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+bool hiopAlgFilterIPMBase::checkpoint_load_state()
+{
+  assert(ckpt_);
+  hiopCheckpoint& ckpt = *ckpt_;
+
+  double scalars[9];
+  bool bret = ckpt.extract(iter_num) && ckpt.extract(scalars, 9);
+
+  hiopVector* vecs[12] = {it_curr->get_x(), it_curr->get_d(), 
+                          it_curr->get_sxl(), it_curr->get_sxu(), it_curr->get_sdl(), it_curr->get_sdu(),
+                          it_curr->get_yc(), it_curr->get_yd(), 
+                          it_curr->get_zl(), it_curr->get_zu(), it_curr->get_vl(), it_curr->get_vu()};
+  for(int i=0; i<12 && bret; i++) {
+    bret = ckpt.extract(*vecs[i]);
+  }
+
+  int n_entries = 0;
+  std::vector<double> entries;
+  if(bret) {
+    bret = ckpt.extract(n_entries) && n_entries>=0;
+  }
+  if(bret) {
+    entries.resize(2*n_entries);
+    bret = ckpt.extract(entries.data(), 2*static_cast<long long>(n_entries));
+  }
+
+  int has_lowrank = 0;
+  if(bret) {
+    bret = ckpt.extract(has_lowrank);
+  }
+  hiopHessianLowRank* Hess = dynamic_cast<hiopHessianLowRank*>(_Hess_Lagr);
+  if(bret && has_lowrank!=static_cast<int>(Hess!=NULL)) {
+    bret = false;
+  }
+  if(bret && Hess) {
+    bret = Hess->load_state(ckpt, *it_curr, *_grad_f, *_Jac_c, *_Jac_d);
+  }
+  if(bret) {
+    bret = checkpoint_load_extra(ckpt);
+  }
+  if(!bret) {
+    nlp->log->printf(hovError, "checkpoint file '%s' is corrupted or does not match the problem\n",
+                     ckpt.file_name().c_str());
+    return false;
+  }
+
+  _mu = scalars[0]; _tau = scalars[1];
+  theta_max = scalars[2]; theta_min = scalars[3];
+  _alpha_primal = scalars[4]; _alpha_dual = scalars[5];
+  _err_nlp_optim0 = scalars[6]; _err_nlp_feas0 = scalars[7]; _err_nlp_complem0 = scalars[8];
+
+  filter.clear();
+  for(int i=0; i<n_entries; i++) {
+    filter.add(entries[2*i], entries[2*i+1]);
+  }
+
+  //evaluate the NLP and update the log-barrier problem and the residuals at the restored iterate
+  if(!evalNlp_noHess(*it_curr, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d)) {
+    return false;
+  }
+  if(!evalNlp_HessOnly(*it_curr, *_Hess_Lagr)) {
+    return false;
+  }
+  logbar->updateWithNlpInfo(*it_curr, _mu, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
+  resid->update(*it_curr,_f_nlp, *_c, *_d,*_grad_f,*_Jac_c,*_Jac_d, *logbar);
+
+  nlp->runStats.nIter = iter_num;
+  nlp->log->printf(hovSummary, "Restarting from the checkpoint saved at iteration %d\n", iter_num);
+  return true;
+}
+
+void hiopAlgFilterIPMBase::profile_report()
+{
+  hiopProfiler::stop();
+  nlp->log->write(hiopProfiler::get_summary().c_str(), hovSummary);
+
+  //each rank writes its own file, with the rank as the process id of the trace
+  int rank = 0;
+  std::stringstream ss;
+  ss << nlp->options->GetString("profile_file");
+#ifdef HIOP_USE_MPI
+  rank = nlp->get_rank();
+  if(nlp->get_num_ranks()>1) {
+    ss << "." << rank;
+  }
+#endif
+  if(!hiopProfiler::write_chrome_trace(ss.str(), rank)) {
+    nlp->log->printf(hovWarning, "could not write profile file '%s'\n", ss.str().c_str());
+  }
+}
+
 void hiopAlgFilterIPMBase::displayTerminationMsg()
 {
+  nlp->runStats.mem = LinearAlgebraFactory::get_mem_stats();
   std::string strStatsReport = nlp->runStats.get_summary() + nlp->runStats.kkt.get_summary_total();
+  {
+    const hiopWorkspace& ws = nlp->workspace();
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3)
+       << "Workspace: peak " << ws.bytes_peak()/1048576. << " MB in use, "
+       << ws.num_objects() << " temporaries totaling " << ws.bytes_allocated()/1048576. << " MB" << std::endl;
+    strStatsReport += ss.str();
+  }
   switch(solver_status_) {
   case Solve_Success:
     {
@@ -797,6 +1296,30 @@ void hiopAlgFilterIPMBase::displayTerminationMsg()
       nlp->log->printf(hovSummary, "%s\n", strStatsReport.c_str());
       break;
     }
+  case Infeasible_Problem:
+    {
+      nlp->log->printf(hovSummary, "Couldn't solve the problem.\n");
+      nlp->log->printf(hovSummary, "Feasibility restoration converged to a point of local infeasibility. "
+                       "The problem may be infeasible.\n");
+      nlp->log->printf(hovSummary, "%s\n", strStatsReport.c_str());
+      break;
+    }
+  case Slow_Convergence:
+    {
+      nlp->log->printf(hovSummary, "Couldn't solve the problem.\n");
+      nlp->log->printf(hovSummary, "Stopped early since the convergence rate over the last %d iterations "
+                       "predicts that the tolerance is not reached within the maximum number of "
+                       "iterations.\n", early_term_window_);
+      nlp->log->printf(hovSummary, "%s\n", strStatsReport.c_str());
+      break;
+    }
+  case Err_Step_Computation:
+    {
+      nlp->log->printf(hovSummary, "Couldn't solve the problem.\n");
+      nlp->log->printf(hovSummary, "Unrecoverable error in the computation of the search direction.\n");
+      nlp->log->printf(hovSummary, "%s\n", strStatsReport.c_str());
+      break;
+    }
   case User_Stopped:
     {
       nlp->log->printf(hovSummary,
@@ -822,7 +1345,9 @@ void hiopAlgFilterIPMBase::displayTerminationMsg()
 
 
 hiopAlgFilterIPMQuasiNewton::hiopAlgFilterIPMQuasiNewton(hiopNlpDenseConstraints* nlp_)
-  : hiopAlgFilterIPMBase(nlp_)
+  : hiopAlgFilterIPMBase(nlp_),
+    kkt_{nullptr},
+    reuse_kkt_{false}
 {
   nlpdc = nlp_;
   //_Hess = new hiopHessianLowRank(nlpdc, nlpdc->options->GetInteger("secant_memory_len"));
@@ -830,6 +1355,8 @@ hiopAlgFilterIPMQuasiNewton::hiopAlgFilterIPMQuasiNewton(hiopNlpDenseConstraints
 
 hiopAlgFilterIPMQuasiNewton::~hiopAlgFilterIPMQuasiNewton()
 {
+  delete kkt_;
+  kkt_ = nullptr;
   //if(_Hess) delete _Hess;
 }
 
@@ -850,12 +1377,22 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
   }
   resetSolverStatus();
 
-  //types of linear algebra objects are known now
-  hiopMatrixDense* Jac_c = dynamic_cast<hiopMatrixDense*>(_Jac_c);
-  hiopMatrixDense* Jac_d = dynamic_cast<hiopMatrixDense*>(_Jac_d);
+  //types of linear algebra objects are known now; the Jacobians are not cast here since their 
+  //buffers are swapped when a step is accepted (see 'evalNlp_derivOnly_trial')
   hiopHessianLowRank* Hess = dynamic_cast<hiopHessianLowRank*>(_Hess_Lagr);
+  //the secant memory is not kept across calls to 'run' and 'resolve'
+  Hess->reset();
 
   nlp->runStats.initialize();
+  LinearAlgebraFactory::reset_mem_peaks();
+  if(profile_) {
+    hiopProfiler::start();
+  }
+  nlp->runStats.kkt.initialize();
+
+  if(!pd_perturb_.initialize(nlp)) {
+    return SolveInitializationError;
+  }
   ////////////////////////////////////////////////////////////////////////////////////
   // run baby run
   ////////////////////////////////////////////////////////////////////////////////////
@@ -868,10 +1405,15 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
 #endif
   nlp->log->write("---------------\nProblem Summary\n---------------", *nlp, hovSummary);
 
+  //the scaling of the checkpointed run is used by the starting procedure
+  if(ckpt_load_ && !checkpoint_load_scaling()) {
+    return SolveInitializationError;
+  }
+
   nlp->runStats.tmOptimizTotal.start();
 
-  startingProcedure(*it_curr, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d); //this also evaluates the nlp
-  _mu=mu0;
+  //this also evaluates the nlp and sets the initial mu
+  startingProcedure(*it_curr, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
 
   //update log bar
   logbar->updateWithNlpInfo(*it_curr, _mu, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
@@ -886,12 +1428,24 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
   theta_max=1e+4*fmax(1.0,resid->get_theta());
   theta_min=1e-4*fmax(1.0,resid->get_theta());
 
-  hiopKKTLinSysLowRank* kkt=new hiopKKTLinSysLowRank(nlp);
+  //the KKT linear system is kept across calls to 'resolve' and is recreated by 'run'
+  if(!reuse_kkt_ || NULL==kkt_) {
+    hiopMemCategoryScope mem_scope(hiopMemStats::mcKKT);
+    delete kkt_;
+    kkt_ = new hiopKKTLinSysLowRank(nlp);
+  }
+  hiopKKTLinSysLowRank* kkt = kkt_;
+  kkt->set_PD_perturb_calc(&pd_perturb_);
 
   _alpha_primal = _alpha_dual = 0;
 
   _err_nlp_optim0=-1.; _err_nlp_feas0=-1.; _err_nlp_complem0=-1;
 
+  if(ckpt_load_ && !checkpoint_load_state()) {
+    nlp->runStats.tmOptimizTotal.stop();
+    return SolveInitializationError;
+  }
+
   // --- Algorithm status 'algStatus ----
   //-1 couldn't solve the problem (most likely because small search step. Restauration phase likely needed)
   // 0 stopped due to tolerances, including acceptable tolerance, or relative tolerance
@@ -904,6 +1458,9 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
   int num_adjusted_bounds = 0;
   solver_status_ = NlpSolve_Pending;
   while(true) {
+    HIOP_PROFILE_SCOPE("ipm_iteration");
+    //the temporaries of the previous iteration are returned to the arena
+    nlp->workspace().reset();
 
     bret = evalNlpAndLogErrors(*it_curr, *resid, _mu,
 			       _err_nlp_optim, _err_nlp_feas, _err_nlp_complem, _err_nlp,
@@ -985,9 +1542,29 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
      * Search direction calculation
      ***************************************************/
     //first update the Hessian and kkt system
-    Hess->update(*it_curr,*_grad_f,*_Jac_c,*_Jac_d);
-    kkt->update(it_curr, _grad_f, Jac_c, Jac_d, Hess);
+    nlp->runStats.kkt.start_optimiz_iteration();
+    pd_perturb_.set_mu(_mu);
+    bool kkt_updated;
+    {
+      hiopMemCategoryScope mem_scope(hiopMemStats::mcQuasiNewton);
+      Hess->update(*it_curr,*_grad_f,*_Jac_c,*_Jac_d);
+    }
+    {
+      hiopMemCategoryScope mem_scope(hiopMemStats::mcKKT);
+      kkt_updated = kkt->update(it_curr, _grad_f,
+                                dynamic_cast<hiopMatrixDense*>(_Jac_c),
+                                dynamic_cast<hiopMatrixDense*>(_Jac_d),
+                                Hess);
+    }
+    if(!kkt_updated) {
+      nlp->runStats.kkt.end_optimiz_iteration();
+      nlp->log->write("Unrecoverable error in step computation (factorization). Will exit here.",
+                      hovError);
+      solver_status_ = Err_Step_Computation;
+      break;
+    }
     bret = kkt->computeDirections(resid,dir); assert(bret==true);
+    nlp->runStats.kkt.end_optimiz_iteration();
 
     nlp->log->printf(hovIteration, "Iter[%d] full search direction -------------\n", iter_num);
     nlp->log->write("", *dir, hovIteration);
@@ -1020,6 +1597,7 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
     //this is the linesearch loop
     //
     while(true) {
+      HIOP_PROFILE_SCOPE("ipm_line_search_trial");
       nlp->runStats.tmSolverInternal.start(); //---
 
       // check the step against the minimum step size, but accept small
@@ -1118,8 +1696,8 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
 
     nlp->log->printf(hovScalars, "Iter[%d] -> accepted step primal=[%17.11e] dual=[%17.11e]\n", iter_num, _alpha_primal, _alpha_dual);
     iter_num++; nlp->runStats.nIter=iter_num;
-    //evaluate derivatives at the trial (and to be accepted) trial point
-    if(!this->evalNlp_derivOnly(*it_trial, *_grad_f, *_Jac_c, *_Jac_d, *_Hess_Lagr)){
+    //evaluate derivatives at the trial (and to be accepted) trial point; these become current
+    if(!this->evalNlp_derivOnly_trial(*it_trial)){
 	solver_status_ = Error_In_User_Function;
 	return Error_In_User_Function;
       }
@@ -1148,6 +1726,19 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
     resid->update(*it_curr,_f_nlp, *_c, *_d,*_grad_f,*_Jac_c,*_Jac_d, *logbar);
     nlp->log->printf(hovIteration, "Iter[%d] full residual:-------------\n", iter_num);
     nlp->log->write("", *resid, hovIteration);
+
+    if(ckpt_save_n_>0 && 0==iter_num%ckpt_save_n_) {
+      checkpoint_save();
+    }
+  }
+  if(ckpt_save_n_>0) {
+    ckpt_->wait();
+  }
+  if(trace_ && !trace_->flush()) {
+    nlp->log->printf(hovWarning, "could not write trace file '%s'\n", trace_->file_name().c_str());
+  }
+  if(profile_) {
+    profile_report();
   }
 
   nlp->runStats.tmOptimizTotal.stop();
@@ -1163,13 +1754,24 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
 			      *_c,*_d,
 			      *it_curr->get_yc(),  *it_curr->get_yd(),
 			      _f_nlp);
-  delete kkt;
 
   return solver_status_;
 }
 
+hiopSolveStatus hiopAlgFilterIPMQuasiNewton::resolve()
+{
+  reuse_kkt_ = nlp->reload_bounds_data();
+  hiopSolveStatus status = run();
+  reuse_kkt_ = false;
+  return status;
+}
+
 void hiopAlgFilterIPMQuasiNewton::outputIteration(int lsStatus, int lsNum, int use_soc)
 {
+  if(trace_) {
+    trace_->record(iter_num, _f_nlp/nlp->get_obj_scale(), _err_nlp_feas, _err_nlp_optim, _mu,
+                   _alpha_dual, _alpha_primal, lsNum, lsStatus, use_soc, nlp->runStats);
+  }
   if(iter_num/10*10==iter_num)
     nlp->log->printf(hovSummary, "iter    objective     inf_pr     inf_du   lg(mu)  alpha_du   alpha_pr linesrch\n");
 
@@ -1200,12 +1802,20 @@ void hiopAlgFilterIPMQuasiNewton::outputIteration(int lsStatus, int lsNum, int u
  *****************************************************************************************************/
 hiopAlgFilterIPMNewton::hiopAlgFilterIPMNewton(hiopNlpFormulation* nlp_)
   : hiopAlgFilterIPMBase(nlp_),
-    fact_acceptor_{nullptr}
+    fact_acceptor_{nullptr},
+    kkt_{nullptr},
+    reuse_kkt_{false},
+    hess_lowrank_{nullptr},
+    nested_{false}
 {
 }
 
 hiopAlgFilterIPMNewton::~hiopAlgFilterIPMNewton()
 {
+  delete kkt_;
+  kkt_ = nullptr;
+  delete hess_lowrank_;
+  hess_lowrank_ = nullptr;
   if(fact_acceptor_){
     delete fact_acceptor_;
   }
@@ -1233,6 +1843,18 @@ decideAndCreateLinearSystem(hiopNlpFormulation* nlp)
 #ifdef HIOP_SPARSE
       // this is Sparse linear system
       std::string strKKT = nlp->options->GetString("KKTLinsys");
+      if(nlp->quasi_newton_hessian()) {
+        //only the compressed XYcYd system applies the quasi-Newton correction
+        return new hiopKKTLinSysCompressedSparseXYcYd(nlp);
+      }
+      //the larger systems hold a copy of the derivatives in the KKT matrix and the factors are 
+      //at least as large; 'XYcYd' is used instead when these do not fit in the budget
+      if((strKKT == "full" || strKKT == "xdycyd") && exceedsMemoryBudget(2*deriv_bytes_)) {
+        nlp->log->printf(hovWarning,
+                         "memory_budget: 'KKTLinsys=%s' does not fit in the budget; will use 'XYcYd'\n",
+                         strKKT.c_str());
+        strKKT = "xycyd";
+      }
       if(strKKT == "full")
         return new hiopKKTLinSysSparseFull(nlp);
       else if(strKKT == "xdycyd")
@@ -1283,7 +1905,20 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
   }
   resetSolverStatus();
 
+  //the sparsity pattern is requested again by the first evaluation of this run; the Jacobians at
+  //the trial point are copied again from the evaluated ones (see 'evalNlp_derivOnly_trial')
+  delete _Jac_c_trial;
+  _Jac_c_trial = NULL;
+  delete _Jac_d_trial;
+  _Jac_d_trial = NULL;
+
   nlp->runStats.initialize();
+  if(!nested_) {
+    LinearAlgebraFactory::reset_mem_peaks();
+  }
+  if(profile_) {
+    hiopProfiler::start();
+  }
   nlp->runStats.kkt.initialize();
 
   if(!pd_perturb_.initialize(nlp)) {
@@ -1302,10 +1937,30 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
 #endif
   nlp->log->write("---------------\nProblem Summary\n---------------", *nlp, hovSummary);
 
+  //the scaling of the checkpointed run is used by the starting procedure
+  if(ckpt_load_ && !checkpoint_load_scaling()) {
+    return SolveInitializationError;
+  }
+
   nlp->runStats.tmOptimizTotal.start();
 
-  startingProcedure(*it_curr, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d); //this also evaluates the nlp
-  _mu=mu0;
+  //the KKT linear system (and the symbolic data of the underlying linear solver) is kept across
+  //calls to 'resolve' and is recreated by 'run' since the options may have changed. It is created
+  //before the starting procedure since the LSQ duals initialization may use its linear solver
+  if(!reuse_kkt_ || NULL==kkt_) {
+    hiopMemCategoryScope mem_scope(hiopMemStats::mcKKT);
+    delete kkt_;
+    kkt_ = decideAndCreateLinearSystem(nlp);
+  }
+  hiopKKTLinSys* kkt = kkt_;
+  assert(kkt != NULL);
+  hiopDualsLsqUpdate* lsq_updater = dynamic_cast<hiopDualsLsqUpdate*>(dualsUpdate);
+  if(lsq_updater) {
+    lsq_updater->set_kkt_linsys(kkt, _Hess_Lagr);
+  }
+
+  //this also evaluates the nlp and sets the initial mu
+  startingProcedure(*it_curr, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
 
   //update log bar
   logbar->updateWithNlpInfo(*it_curr, _mu, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
@@ -1319,14 +1974,43 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
 
   iter_num=0; nlp->runStats.nIter=iter_num;
   bool disableLS = nlp->options->GetString("accept_every_trial_step")=="yes";
+  //the restoration problem needs the user's Hessian and is not available with quasi-Newton
+  bool use_restoration = nlp->options->GetString("feasibility_restoration")=="yes" &&
+    !nlp->quasi_newton_hessian();
+  //the restoration problem is implemented only for MDS problems
+  if(use_restoration && NULL==dynamic_cast<hiopNlpMDS*>(nlp)) {
+    if(nlp->options->is_user_defined("feasibility_restoration")) {
+      nlp->log->printf(hovWarning,
+                       "Option 'feasibility_restoration' is available only for MDS problems and is ignored.\n");
+    }
+    use_restoration = false;
+  }
 
   theta_max=1e+4*fmax(1.0,resid->get_theta());
   theta_min=1e-4*fmax(1.0,resid->get_theta());
 
-  hiopKKTLinSys* kkt = decideAndCreateLinearSystem(nlp);
-  assert(kkt != NULL);
   kkt->set_PD_perturb_calc(&pd_perturb_);
 
+  //the secant memory is not kept across calls to 'resolve'
+  delete hess_lowrank_;
+  hess_lowrank_ = nullptr;
+  if(nlp->quasi_newton_hessian() && NULL==dynamic_cast<hiopNlpDenseConstraints*>(nlp)) {
+    hiopKKTLinSysCompressedXYcYd* kkt_xycyd = dynamic_cast<hiopKKTLinSysCompressedXYcYd*>(kkt);
+    if(NULL==kkt_xycyd) {
+      nlp->log->printf(hovError, "quasi-Newton Hessian is supported only by XYcYd KKT linear systems\n");
+      nlp->runStats.tmOptimizTotal.stop();
+      return SolveInitializationError;
+    }
+    hiopMemCategoryScope mem_scope(hiopMemStats::mcQuasiNewton);
+    hess_lowrank_ = new hiopHessianLowRank(nlp, nlp->options->GetInteger("secant_memory_len"));
+    kkt_xycyd->set_hess_lowrank(hess_lowrank_);
+  } else {
+    hiopKKTLinSysCompressedXYcYd* kkt_xycyd = dynamic_cast<hiopKKTLinSysCompressedXYcYd*>(kkt);
+    if(kkt_xycyd) {
+      kkt_xycyd->set_hess_lowrank(NULL);
+    }
+  }
+
   if(fact_acceptor_)
   {
     delete fact_acceptor_;
@@ -1339,6 +2023,11 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
 
   _err_nlp_optim0=-1.; _err_nlp_feas0=-1.; _err_nlp_complem0=-1;
 
+  if(ckpt_load_ && !checkpoint_load_state()) {
+    nlp->runStats.tmOptimizTotal.stop();
+    return SolveInitializationError;
+  }
+
   // --- Algorithm status 'algStatus ----
   //-1 couldn't solve the problem (most likely because small search step. Restauration phase likely needed)
   // 0 stopped due to tolerances, including acceptable tolerance, or relative tolerance
@@ -1353,9 +2042,19 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
   int linsol_safe_mode_lastiter = -1;
   bool linsol_safe_mode_on = "stable"==hiop::tolower(nlp->options->GetString("linsol_mode"));
   bool linsol_forcequick = "forcequick"==hiop::tolower(nlp->options->GetString("linsol_mode"));
+  const bool mu_adaptive = "adaptive"==nlp->options->GetString("mu_strategy");
+  //for 'mu_strategy' 'adaptive': whether mu is currently chosen by probing ("free" mode) or by the
+  //monotone update (safeguard) and the NLP errors at the last iterations in free mode
+  bool mu_free_mode = mu_adaptive;
+  const int max_err_refs = 4;
+  double err_refs[max_err_refs];
+  int num_err_refs = 0;
 
   solver_status_ = NlpSolve_Pending;
   while(true) {
+    HIOP_PROFILE_SCOPE("ipm_iteration");
+    //the temporaries of the previous iteration are returned to the arena
+    nlp->workspace().reset();
 
     bret = evalNlpAndLogErrors(*it_curr, *resid, _mu,
 			       _err_nlp_optim, _err_nlp_feas, _err_nlp_complem, _err_nlp,
@@ -1401,9 +2100,28 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
     if(NlpSolve_Pending!=solver_status_) break; //failure of the line search or user stopped.
 
     /************************************************
-     * update mu and other parameters
+     * update mu and other parameters (in the free mode of 'mu_strategy' 'adaptive' this is done 
+     * after the factorization of the KKT system)
      ************************************************/
-    while(_err_log<=kappa_eps * _mu) {
+    if(mu_free_mode) {
+      //safeguard: switch to the monotone update if the NLP error did not decrease sufficiently 
+      //over the last iterations; the free mode is resumed after the next decrease of mu
+      if(num_err_refs==max_err_refs &&
+         _err_nlp > 0.9999 * (*std::max_element(err_refs, err_refs+max_err_refs))) {
+        mu_free_mode = false;
+        _mu = fmax(eps_tol/10, fmin(mu0, 0.8*it_curr->avgComplementarity(true)));
+        _tau = fmax(tau_min, 1.0-_mu);
+        nlp->log->printf(hovScalars, "Iter[%d] switching to monotone mu update: mu=%g\n", iter_num, _mu);
+        if(!updateLogBarAndErrors()) {
+          solver_status_ = Error_In_User_Function;
+          return Error_In_User_Function;
+        }
+      } else {
+        err_refs[iter_num % max_err_refs] = _err_nlp;
+        num_err_refs = std::min(num_err_refs+1, max_err_refs);
+      }
+    }
+    while(!mu_free_mode && _err_log<=kappa_eps * _mu) {
       //update mu and tau (fraction-to-boundary)
       bret = updateLogBarrierParameters(*it_curr, _mu, _tau, _mu, _tau);
       if(!bret) break; //no update is necessary
@@ -1436,12 +2154,23 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
       //if(iter_num==0) {
       //	continue;
       //}
+
+      if(mu_adaptive) {
+        //resume choosing mu by probing
+        mu_free_mode = true;
+        num_err_refs = 0;
+        break;
+      }
     }
     nlp->log->printf(hovScalars, "Iter[%d] logbarObj=%23.17e (mu=%12.5e)\n", iter_num, logbar->f_logbar,_mu);
     /****************************************************
      * Search direction calculation
      ***************************************************/
     pd_perturb_.set_mu(_mu);
+    if(hess_lowrank_) {
+      hiopMemCategoryScope mem_scope(hiopMemStats::mcQuasiNewton);
+      hess_lowrank_->update(*it_curr, *_grad_f, *_Jac_c, *_Jac_d);
+    }
 
     //this will cache the primal infeasibility norm for (re)use in the dual updating
     double infeas_nrm_trial;
@@ -1471,6 +2200,8 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
     }
 
     for(int linsolve=1; linsolve<=2; ++linsolve) {
+      //the KKT matrices and the linear solvers are (re)allocated by the update below
+      hiopMemCategoryScope mem_scope(hiopMemStats::mcKKT);
 
       nlp->runStats.kkt.start_optimiz_iteration();
 
@@ -1509,6 +2240,13 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
         }
       } // end of if(!kkt->update(it_curr, _grad_f, _Jac_c, _Jac_d, _Hess_Lagr))
 
+      if(mu_free_mode && updateLogBarrierParametersProbing(kkt, _mu, _tau, _mu, _tau)) {
+        if(!updateLogBarAndErrors()) {
+          solver_status_ = Error_In_User_Function;
+          return Error_In_User_Function;
+        }
+      }
+
       //
       // solve for search directions
       //
@@ -1567,6 +2305,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
       //1 "sufficient decrease" when far away from solution (theta_trial>theta_min)
       //2 close to solution but switching condition does not hold; trial accepted based on "sufficient decrease"
       //3 close to solution and switching condition is true; trial accepted based on Armijo
+      //4 trial obtained by the feasibility restoration phase
       lsStatus=0; lsNum=0;
       use_soc = 0;
 
@@ -1578,6 +2317,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
       // linesearch loop
       //
       while(true) {
+        HIOP_PROFILE_SCOPE("ipm_line_search_trial");
         nlp->runStats.tmSolverInternal.start(); //---
 
         // check the step against the minimum step size, but accept small
@@ -1585,6 +2325,14 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
         if(!iniStep && _alpha_primal<1e-16) {
 
           if(linsol_safe_mode_on) {
+            if(use_restoration) {
+              if(apply_feasibility_restoration(theta, theta_trial)) {
+                infeas_nrm_trial = theta_trial;
+                lsStatus = 4;
+                break;
+              }
+              if(NlpSolve_Pending!=solver_status_) break;
+            }
             nlp->log->write("Panic: minimum step size reached. The problem may be infeasible or the "
                             "gradient inaccurate. Will exit here.", hovError);
             solver_status_ = Steplength_Too_Small;
@@ -1598,32 +2346,52 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
         num_adjusted_bounds = it_trial->adjust_small_slacks(*it_curr, _mu);
         nlp->runStats.tmSolverInternal.stop(); //---
 
-        //evaluate the problem at the trial iterate (functions only)
-        if(!this->evalNlp_funcOnly(*it_trial, _f_nlp_trial, *_c_trial, *_d_trial)) {
+        //evaluate the constraints at the trial iterate first; the objective is evaluated only when
+        //the trial is not rejected by the filter based on its infeasibility alone. The inequalities 
+        //are needed by the second order correction and are always evaluated at the first trial
+        bool rejected_by_theta = false;
+        if(!this->evalNlp_consOnly(*it_trial, *_c_trial, *_d_trial, !iniStep && !disableLS, rejected_by_theta)) {
           solver_status_ = Error_In_User_Function;
           return Error_In_User_Function;
         }
 
-        logbar->updateWithNlpInfo_trial_funcOnly(*it_trial, _f_nlp_trial, *_c_trial, *_d_trial);
-
         nlp->runStats.tmSolverInternal.start(); //---
-        //compute infeasibility theta at trial point.
-        infeas_nrm_trial = theta_trial = resid->compute_nlp_infeasib_onenorm(*it_trial, *_c_trial, *_d_trial);
-
+        if(!rejected_by_theta) {
+          //compute infeasibility theta at trial point.
+          infeas_nrm_trial = theta_trial = resid->compute_nlp_infeasib_onenorm(*it_trial, *_c_trial, *_d_trial);
+          rejected_by_theta = !disableLS && filter.contains_theta(theta_trial);
+        }
         lsNum++;
 
-        nlp->log->printf(hovLinesearch, "  trial point %d: alphaPrimal=%14.8e barier:(%22.16e)>%15.9e "
-                         "theta:(%22.16e)>%22.16e\n",
-                         lsNum, _alpha_primal, logbar->f_logbar, logbar->f_logbar_trial, theta, theta_trial);
+        if(rejected_by_theta) {
+          nlp->log->printf(hovLinesearch, "  trial point %d: alphaPrimal=%14.8e rejected by the filter based on "
+                           "infeasibility (objective not evaluated)\n", lsNum, _alpha_primal);
+          trial_is_rejected_by_filter = true;
+          lsStatus = 0;
+        } else {
+          nlp->runStats.tmSolverInternal.stop(); //---
+          //x did not change since the constraints evaluation
+          if(!nlp->eval_f(*it_trial->get_x(), false, _f_nlp_trial)) {
+            nlp->log->printf(hovError, "Error occured in user objective evaluation\n");
+            solver_status_ = Error_In_User_Function;
+            return Error_In_User_Function;
+          }
+          logbar->updateWithNlpInfo_trial_funcOnly(*it_trial, _f_nlp_trial, *_c_trial, *_d_trial);
+          nlp->runStats.tmSolverInternal.start(); //---
 
-        if(disableLS) break;
+          nlp->log->printf(hovLinesearch, "  trial point %d: alphaPrimal=%14.8e barier:(%22.16e)>%15.9e "
+                           "theta:(%22.16e)>%22.16e\n",
+                           lsNum, _alpha_primal, logbar->f_logbar, logbar->f_logbar_trial, theta, theta_trial);
 
-        nlp->log->write("Filter IPM: ", filter, hovLinesearch);
+          if(disableLS) break;
 
-        lsStatus = accept_line_search_conditions(theta, theta_trial, _alpha_primal, grad_phi_dx_computed, grad_phi_dx);
+          nlp->log->write("Filter IPM: ", filter, hovLinesearch);
 
-        if(lsStatus>0) {
-          break;
+          lsStatus = accept_line_search_conditions(theta, theta_trial, _alpha_primal, grad_phi_dx_computed, grad_phi_dx);
+
+          if(lsStatus>0) {
+            break;
+          }
         }
 
         // second order correction
@@ -1687,6 +2455,11 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
 
         break; //from the linear solve (computeDirections) loop
 
+      } else if(lsStatus==4) {
+        //the filter was augmented by the restoration phase
+
+        break; //from the linear solve (computeDirections) loop
+
       } else if(lsStatus==0) {
 
         //
@@ -1742,12 +2515,15 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
     // this needs to be done before evalNlp_derivOnly so that the user's NLP functions
     // get the updated duals
     assert(infeas_nrm_trial>=0 && "this should not happen");
-    bret = dualsUpdate->go(*it_curr, *it_trial,
-			   _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d, *dir,
-			   _alpha_primal, _alpha_dual, _mu, kappa_Sigma, infeas_nrm_trial); assert(bret);
+    //the duals of the restoration point were set by the restoration phase
+    if(lsStatus!=4) {
+      bret = dualsUpdate->go(*it_curr, *it_trial,
+                             _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d, *dir,
+                             _alpha_primal, _alpha_dual, _mu, kappa_Sigma, infeas_nrm_trial); assert(bret);
+    }
 
-    //evaluate derivatives at the trial (and to be accepted) trial point
-    if(!this->evalNlp_derivOnly(*it_trial, *_grad_f, *_Jac_c, *_Jac_d, *_Hess_Lagr)) {
+    //evaluate derivatives at the trial (and to be accepted) trial point; these become current
+    if(!this->evalNlp_derivOnly_trial(*it_trial)) {
       solver_status_ = Error_In_User_Function;
       return Error_In_User_Function;
     }
@@ -1776,6 +2552,19 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
 
     nlp->log->printf(hovIteration, "Iter[%d] full residual:-------------\n", iter_num);
     nlp->log->write("", *resid, hovIteration);
+
+    if(ckpt_save_n_>0 && 0==iter_num%ckpt_save_n_) {
+      checkpoint_save();
+    }
+  }
+  if(ckpt_save_n_>0) {
+    ckpt_->wait();
+  }
+  if(trace_ && !trace_->flush()) {
+    nlp->log->printf(hovWarning, "could not write trace file '%s'\n", trace_->file_name().c_str());
+  }
+  if(profile_) {
+    profile_report();
   }
 
   nlp->runStats.tmOptimizTotal.stop();
@@ -1791,13 +2580,132 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
 			      *_c,*_d,
 			      *it_curr->get_yc(), *it_curr->get_yd(),
 			      _f_nlp);
-  delete kkt;
 
   return solver_status_;
 }
 
+hiopSolveStatus hiopAlgFilterIPMNewton::resolve()
+{
+  reuse_kkt_ = nlp->reload_bounds_data();
+  hiopSolveStatus status = run();
+  reuse_kkt_ = false;
+  return status;
+}
+
+bool hiopAlgFilterIPMNewton::apply_feasibility_restoration(const double& theta, double& theta_trial)
+{
+  hiopNlpMDS* nlpMDS = dynamic_cast<hiopNlpMDS*>(nlp);
+  if(NULL==nlpMDS) {
+    nlp->log->printf(hovWarning, "Feasibility restoration is available only for MDS problems.\n");
+    return false;
+  }
+  nlp->log->printf(hovScalars, "Iter[%d] entering feasibility restoration: theta=%12.5e\n", iter_num, theta);
+
+  hiopFRProbMDS fr_prob(*nlpMDS, *it_curr, *_c, *_d, *_Jac_c, *_Jac_d, *_Hess_Lagr, theta, _mu);
+  hiopNlpMDS fr_nlp(fr_prob);
+
+  //the restoration problem inherits the options that decide the linear algebra; the bounds are 
+  //not relaxed and the problem is not rescaled since these transformations were already applied
+  //to the original NLP
+  const char* str_opts[] = {"KKTLinsys", "linsol_mode", "fact_acceptor", "compute_mode", "mem_space",
+                            "mu_strategy", "fixed_var"};
+  for(const char* opt : str_opts) {
+    fr_nlp.options->SetStringValue(opt, nlp->options->GetString(opt).c_str(), true);
+  }
+  fr_nlp.options->SetStringValue("Hessian", "analytical_exact", true);
+  fr_nlp.options->SetStringValue("scaling_type", "none", true);
+  fr_nlp.options->SetNumericValue("bound_relax_perturb", 0., true);
+  fr_nlp.options->SetStringValue("warm_start", "no", true);
+  fr_nlp.options->SetStringValue("feasibility_restoration", "no", true);
+  fr_nlp.options->SetNumericValue("mu0", _mu, true);
+  fr_nlp.options->SetIntegerValue("max_iter", std::max(1, max_n_it-iter_num), true);
+  const int verbosity = nlp->options->GetInteger("verbosity_level");
+  fr_nlp.options->SetIntegerValue("verbosity_level", verbosity>=hovLinesearch ? verbosity : hovWarning, true);
+
+  hiopAlgFilterIPMNewton fr_solver(&fr_nlp);
+  fr_solver.nested_ = true;
+  const hiopSolveStatus fr_status = fr_solver.run();
+
+  nlp->log->printf(hovScalars,
+                   "Iter[%d] feasibility restoration: %d iterations, status %d, theta=%12.5e\n",
+                   iter_num, fr_solver.getNumIterations(), fr_status, fr_prob.theta_last());
+
+  if(!fr_prob.target_reached()) {
+    if(fr_status==Solve_Success || fr_status==Solve_Success_RelTol || fr_status==Solve_Acceptable_Level) {
+      nlp->log->printf(hovWarning, "Feasibility restoration converged to a point of local infeasibility.\n");
+      solver_status_ = Infeasible_Problem;
+    } else {
+      nlp->log->printf(hovWarning, "Feasibility restoration failed.\n");
+    }
+    return false;
+  }
+
+  //primals and bounds duals from the restoration point; as in Ipopt, the multipliers of the 
+  //constraints are reset to zero and the bounds multipliers are reset to one when large
+  const hiopIterate& it_fr = *fr_solver.get_it_curr();
+  fr_prob.get_base_primal(*it_fr.get_x(), *it_trial->get_x());
+  it_trial->get_d()->copyFrom(*it_fr.get_d());
+  fr_prob.get_base_primal(*it_fr.get_zl(), *it_trial->get_zl());
+  fr_prob.get_base_primal(*it_fr.get_zu(), *it_trial->get_zu());
+  it_trial->get_vl()->copyFrom(*it_fr.get_vl());
+  it_trial->get_vu()->copyFrom(*it_fr.get_vu());
+  it_trial->setEqualityDualsToConstant(0.);
+  const double bnd_duals_max = std::max(std::max(it_trial->get_zl()->infnorm(), it_trial->get_zu()->infnorm()),
+                                        std::max(it_trial->get_vl()->infnorm(), it_trial->get_vu()->infnorm()));
+  if(bnd_duals_max>1e3) {
+    it_trial->setBoundsDualsToConstant(1.);
+  }
+  it_trial->determineSlacks();
+  it_trial->adjustDuals_primalLogHessian(_mu, kappa_Sigma);
+
+  if(!this->evalNlp_funcOnly(*it_trial, _f_nlp_trial, *_c_trial, *_d_trial)) {
+    solver_status_ = Error_In_User_Function;
+    return false;
+  }
+  logbar->updateWithNlpInfo_trial_funcOnly(*it_trial, _f_nlp_trial, *_c_trial, *_d_trial);
+  theta_trial = resid->compute_nlp_infeasib_onenorm(*it_trial, *_c_trial, *_d_trial);
+  if(theta_trial>=theta) {
+    nlp->log->printf(hovWarning, "Feasibility restoration did not reduce the infeasibility.\n");
+    return false;
+  }
+
+  //the restoration point should be acceptable to the filter augmented with the current iterate;
+  //otherwise the filter is reset
+  filter.add(theta, logbar->f_logbar);
+  if(filter.contains(theta_trial, logbar->f_logbar_trial)) {
+    filter.reinitialize(theta_max);
+    filter.add(theta, logbar->f_logbar);
+  }
+  _alpha_primal = _alpha_dual = 1.;
+  return true;
+}
+
+void hiopAlgFilterIPMQuasiNewton::checkpoint_save_extra(hiopCheckpoint& ckpt) const
+{
+  pd_perturb_.save_state(ckpt);
+}
+
+bool hiopAlgFilterIPMQuasiNewton::checkpoint_load_extra(hiopCheckpoint& ckpt)
+{
+  return pd_perturb_.load_state(ckpt);
+}
+
+void hiopAlgFilterIPMNewton::checkpoint_save_extra(hiopCheckpoint& ckpt) const
+{
+  pd_perturb_.save_state(ckpt);
+}
+
+bool hiopAlgFilterIPMNewton::checkpoint_load_extra(hiopCheckpoint& ckpt)
+{
+  return pd_perturb_.load_state(ckpt);
+}
+
 void hiopAlgFilterIPMNewton::outputIteration(int lsStatus, int lsNum, int use_soc)
 {
+  if(trace_) {
+    trace_->record(iter_num, _f_nlp/nlp->get_obj_scale(), _err_nlp_feas, _err_nlp_optim, _mu,
+                   _alpha_dual, _alpha_primal, lsNum, lsStatus, use_soc, nlp->runStats);
+  }
   if(iter_num/10*10==iter_num)
     nlp->log->printf(hovSummary, "iter    objective     inf_pr     inf_du   lg(mu)  alpha_du   alpha_pr linesrch\n");
 
@@ -1810,6 +2718,7 @@ void hiopAlgFilterIPMNewton::outputIteration(int lsStatus, int lsNum, int use_so
     if(lsStatus==1) strcpy(stepType, "s");
     else if(lsStatus==2) strcpy(stepType, "h");
     else if(lsStatus==3) strcpy(stepType, "f");
+    else if(lsStatus==4) strcpy(stepType, "r");
     else strcpy(stepType, "?");
 
     if(use_soc && lsStatus >= 1 && lsStatus <= 3) {
@@ -1928,20 +2837,12 @@ int hiopAlgFilterIPMBase::apply_second_order_correction(hiopKKTLinSys* kkt,
                                                         int &num_adjusted_bounds)
 {
   int max_soc_iter = nlp->options->GetNumeric("max_soc_iter");
-  int kappa_soc = nlp->options->GetNumeric("kappa_soc");
+  double kappa_soc = nlp->options->GetNumeric("kappa_soc");
 
   if(max_soc_iter == 0) {
     return false;
   }
-
-  if(!soc_dir) {
-    soc_dir = dir->alloc_clone();
-    if(nlp->options->GetString("KKTLinsys")=="full") {
-      soc_dir->selectPattern();
-    }      
-    c_soc = nlp->alloc_dual_eq_vec();
-    d_soc = nlp->alloc_dual_ineq_vec();        
-  }
+  assert(soc_dir && c_soc && d_soc && resid_soc);
 
   double theta_trial_last = 0.;
   double theta_trial = theta_trial0;
@@ -1970,11 +2871,16 @@ int hiopAlgFilterIPMBase::apply_second_order_correction(hiopKKTLinSys* kkt,
     d_soc->axpy(1.0, *it_trial->get_d());
     d_soc->axpy(-1.0, *_d_trial);
     
-    // compute rhs for soc. Use resid_trial since it hasn't been used
-    resid_trial->update_soc(*it_curr, *c_soc, *d_soc, *_grad_f,*_Jac_c,*_Jac_d, *logbar);
+    // compute rhs for soc. Only ryc and ryd change between soc iterations since it_curr
+    // is not modified
+    if(0==num_soc) {
+      resid_soc->update_soc(*it_curr, *c_soc, *d_soc, *_grad_f,*_Jac_c,*_Jac_d, *logbar);
+    } else {
+      resid_soc->update_soc_feasib(*c_soc, *d_soc);
+    }
 
-    // solve for search directions
-    bret = kkt->computeDirections(resid_trial, soc_dir); 
+    // solve for search directions with the factors of the KKT from the current iteration
+    bret = kkt->computeDirectionsSolveOnly(resid_soc, soc_dir); 
     assert(bret);
 
     // Compute step size
@@ -2001,8 +2907,9 @@ int hiopAlgFilterIPMBase::apply_second_order_correction(hiopKKTLinSys* kkt,
 
     if(ls_status>0) {
       _alpha_primal = alpha_primal_soc;
-      dir->copyFrom(*soc_dir);
-      resid->copyFrom(*resid_trial);
+      //the SOC direction and its residual become the current ones
+      std::swap(dir, soc_dir);
+      std::swap(resid, resid_soc);
       break;
     } else {
       num_soc++;
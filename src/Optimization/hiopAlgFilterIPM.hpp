@@ -58,10 +58,14 @@
 #include "hiopLogBarProblem.hpp"
 #include "hiopDualsUpdater.hpp"
 #include "hiopPDPerturbation.hpp"
+#include "hiopCheckpoint.hpp"
+#include "hiopTrace.hpp"
 #include "hiopFactAcceptor.hpp"
 
 #include "hiopTimer.hpp"
 
+#include <vector>
+
 namespace hiop
 {
 
@@ -73,7 +77,17 @@ public:
   /** numerical optimization */
   virtual hiopSolveStatus run() = 0;
 
-  /** computes primal-dual point and returns the evaluation of the problem at this point */
+  /** 
+   * Re-solves the NLP after the user changed the variables bounds, the constraints bounds or 
+   * right-hand side, or the objective data, but not the structure (sizes, sparsity, finite/infinite
+   * bounds pattern). The allocations and the scaling of the previous solve are kept and only the 
+   * algorithmic state (solver status, filter, and mu) is reset. Falls back to a full 
+   * re-initialization if the structure changed.
+   */
+  virtual hiopSolveStatus resolve();
+
+  /** computes primal-dual point and returns the evaluation of the problem at this point; also sets the 
+   * initial mu (which depends on this point when warm starting) */
   virtual int startingProcedure(hiopIterate& it_ini,
 	       double &f, hiopVector& c_, hiopVector& d_,
 	       hiopVector& grad_,  hiopMatrix& Jac_c,  hiopMatrix& Jac_d);
@@ -87,16 +101,35 @@ public:
   inline hiopSolveStatus getSolveStatus() const { return solver_status_; }
   /* returns the number of iterations */
   int getNumIterations() const;
+  /* returns the current iterate; valid only after 'run' method has been called */
+  inline const hiopIterate* get_it_curr() const { return it_curr; }
 protected:
+  /* returns the KKT linear system whose linear solver is shared with the LSQ duals updater 
+   * (see hiopDualsLsqUpdate::set_kkt_linsys); NULL if it does not exist (yet) */
+  virtual hiopKKTLinSys* get_kkt_linsys() { return NULL; }
+
   bool evalNlp(hiopIterate& iter,
 	       double &f, hiopVector& c_, hiopVector& d_,
 	       hiopVector& grad_,  hiopMatrix& Jac_c,  hiopMatrix& Jac_d,
 	       hiopMatrix& Hess_L);
   bool evalNlp_funcOnly(hiopIterate& iter,
 			double& f, hiopVector& c_, hiopVector& d_);
+  /* Evaluates the constraints only (used to screen line-search trial points before evaluating the
+   * objective). When @p allow_partial is true and the equalities and inequalities are evaluated
+   * separately, the inequalities are not evaluated if the infeasibility of the equalities alone 
+   * causes the filter to reject the point, in which case @p rejected is set to true.
+   */
+  bool evalNlp_consOnly(hiopIterate& iter, hiopVector& c_, hiopVector& d_,
+                        bool allow_partial, bool& rejected);
   bool evalNlp_derivOnly(hiopIterate& iter,
 			 hiopVector& gradf_,  hiopMatrix& Jac_c,  hiopMatrix& Jac_d,
 			 hiopMatrix& Hess_L);
+  /* Evaluates the derivatives at the accepted trial iterate @p iter in the trial buffers of the 
+   * gradient and of the Jacobians and makes them current by swapping the pointers; the current 
+   * derivatives remain untouched if the evaluation fails. Without trial Jacobians (see the option
+   * 'memory_budget') the current derivatives are overwritten. The Hessian is always overwritten.
+   */
+  bool evalNlp_derivOnly_trial(hiopIterate& iter);
 
   /* Evaluates all the functions and derivatives, excepting the Hessian, which is supposed
    * to be evaluated at a later time.
@@ -129,6 +162,21 @@ protected:
   bool updateLogBarrierParameters(const hiopIterate& it, const double& mu_curr, const double& tau_curr,
 				  double& mu_new, double& tau_new);
 
+  /**
+   * Adaptive update of mu by Mehrotra probing: the affine-scaling (mu=0) direction is computed with 
+   * the current factorization of @p kkt (only a back-solve is performed) and mu is set to 
+   * sigma*mu_c, where mu_c is the average complementarity at the current iterate, sigma=(mu_a/mu_c)^3,
+   * and mu_a is the average complementarity after the maximum step along the affine-scaling 
+   * direction. Uses 'dir', 'it_trial', and 'resid_trial' as work space. Returns false if the
+   * affine-scaling direction could not be computed, in which case mu is not changed.
+   */
+  bool updateLogBarrierParametersProbing(hiopKKTLinSys* kkt, const double& mu_curr, const double& tau_curr,
+                                         double& mu_new, double& tau_new);
+
+  /* Updates the log-barrier problem, the residuals, and the errors after a change in mu and 
+   * reinitializes the filter. Returns false if the errors could not be computed. */
+  bool updateLogBarAndErrors();
+
   // second order correction
   virtual int apply_second_order_correction(hiopKKTLinSys* kkt,
                                             const double theta_curr,
@@ -148,11 +196,37 @@ protected:
 
   //returns whether the algorithm should stop and set an appropriate solve status
   bool checkTermination(const double& _err_nlp, const int& iter_num, hiopSolveStatus& status);
+
+  /* Records log10 of the smallest NLP error so far and of mu and returns true when the linear
+   * rate of decrease of either over the last 'early_termination_window' iterations predicts 
+   * that 'tolerance' is not reached within the remaining iterations. */
+  bool predictsSlowConvergence(const double& err_nlp, const int& iter_num);
   void displayTerminationMsg();
+  /* stops the profiler, logs the call trees, and writes the Chrome trace to 'profile_file' */
+  void profile_report();
+
+  /* Serializes the state of the algorithm (scaling, iterate, barrier and filter state, and 
+   * quasi-Newton memory) and hands it to the checkpoint's background writer. */
+  bool checkpoint_save();
+  /* Reads the checkpoint file and sets the scaling factors saved in it; to be called before 
+   * the starting procedure. */
+  bool checkpoint_load_scaling();
+  /* Restores the rest of the state saved by 'checkpoint_save' and evaluates the NLP at the 
+   * restored iterate; to be called after the initialization done by 'run'. */
+  bool checkpoint_load_state();
+  /* state specific to the derived algorithms, appended at the end of the checkpoint */
+  virtual void checkpoint_save_extra(hiopCheckpoint& ckpt) const {}
+  virtual bool checkpoint_load_extra(hiopCheckpoint& ckpt) { return true; }
 
   void resetSolverStatus();
   virtual void reInitializeNlpObjects();
   virtual void reloadOptions();
+  /* Allocates the gradient, the Jacobians, and the Hessian, as well as their copies at the trial 
+   * point; the trial Jacobians are not allocated when they do not fit in 'memory_budget'. */
+  void allocDerivatives();
+  /* true when the memory tracked by LinearAlgebraFactory plus 'extra_bytes' exceeds the 
+   * 'memory_budget' option */
+  bool exceedsMemoryBudget(size_t extra_bytes) const;
 private:
   void destructorPart();
 protected:
@@ -168,6 +242,8 @@ protected:
   hiopIterate* soc_dir;
 
   hiopResidual* resid, *resid_trial;
+  /* workspace for the second-order correction, allocated with the other iterate objects */
+  hiopResidual* resid_soc;
 
   int iter_num;
   double _err_nlp_optim, _err_nlp_feas, _err_nlp_complem;//not scaled by sd, sc, and sc
@@ -191,6 +267,8 @@ protected:
   hiopMatrix* _Jac_c, *_Jac_c_trial; //Jacobian of c(x), the equality part
   hiopMatrix* _Jac_d, *_Jac_d_trial; //Jacobian of d(x), the inequality part
   hiopMatrix* _Hess_Lagr;
+  size_t deriv_bytes_; //memory of the Jacobians and of the Hessian, measured at allocation
+  bool trial_jacobians_; //whether the Jacobians are double buffered (see 'memory_budget')
 
   /** Algorithms's working quantities */
   double _mu, _tau, _alpha_primal, _alpha_dual;
@@ -227,10 +305,31 @@ protected:
   //internal flags related to the state of the solver
   hiopSolveStatus solver_status_;
   int n_accep_iters_;
+
+  /* State for the early termination based on the convergence rate prediction */
+  bool early_term_;                 //option 'early_termination'
+  int early_term_window_;           //option 'early_termination_window'
+  std::vector<double> hist_log_err_;//circular buffers with log10 of the best NLP error and of mu
+  std::vector<double> hist_log_mu_; //for the last early_term_window_+1 iterations
+  int n_hist_;                      //number of entries recorded in the buffers
+  hiopIterate* it_best_;            //iterate with the smallest NLP error and its function values
+  hiopVector* c_best_, *d_best_;
+  double f_best_, err_best_;
   bool trial_is_rejected_by_filter;
 
   /* Flag for timing and timing breakdown report for the KKT solve */
   bool perf_report_kkt_;
+
+  /* Checkpointing: the checkpoint is saved every 'checkpoint_save_N' iterations when 
+   * 'checkpoint_save' is on and loaded by 'run' when 'checkpoint_load_on_start' is on */
+  hiopCheckpoint* ckpt_;
+  int ckpt_save_n_;  //0 if the checkpoint is not saved
+  bool ckpt_load_;
+
+  /* per-iteration trace (option 'trace'); NULL if not requested or not on the master rank */
+  hiopTraceWriter* trace_;
+  /* option 'profile' */
+  bool profile_;
 };
 
 class hiopAlgFilterIPMQuasiNewton : public hiopAlgFilterIPMBase
@@ -240,10 +339,21 @@ public:
   virtual ~hiopAlgFilterIPMQuasiNewton();
 
   virtual hiopSolveStatus run();
+
+  /** Same as the base class method, but also keeps the KKT linear system and its buffers. */
+  virtual hiopSolveStatus resolve();
 private:
   virtual void outputIteration(int lsStatus, int lsNum, int use_soc);
+  virtual void checkpoint_save_extra(hiopCheckpoint& ckpt) const;
+  virtual bool checkpoint_load_extra(hiopCheckpoint& ckpt);
 private:
   hiopNlpDenseConstraints* nlpdc;
+  /* inertia correction; used only by the quasi-Newton updates that may be indefinite (L-SR1) */
+  hiopPDPerturbation pd_perturb_;
+
+  //KKT linear system of the last run and whether it is reused by the next run (see 'resolve')
+  hiopKKTLinSysLowRank* kkt_;
+  bool reuse_kkt_;
 private:
   hiopAlgFilterIPMQuasiNewton() : hiopAlgFilterIPMBase(NULL) {};
   hiopAlgFilterIPMQuasiNewton(const hiopAlgFilterIPMQuasiNewton& ) : hiopAlgFilterIPMBase(NULL){};
@@ -262,14 +372,44 @@ public:
 
   virtual hiopSolveStatus run();
 
+  /** Same as the base class method, but also keeps the KKT linear system, including the 
+   * symbolic factorization of the underlying sparse linear solver. */
+  virtual hiopSolveStatus resolve();
+
 private:
   virtual void outputIteration(int lsStatus, int lsNum, int use_soc);
+  virtual void checkpoint_save_extra(hiopCheckpoint& ckpt) const;
+  virtual bool checkpoint_load_extra(hiopCheckpoint& ckpt);
   virtual hiopKKTLinSys* decideAndCreateLinearSystem(hiopNlpFormulation* nlp);
+  virtual hiopKKTLinSys* get_kkt_linsys() { return kkt_; }
   /// @brief get the method to decide if a factorization is acceptable or not
   virtual hiopFactAcceptor* decideAndCreateFactAcceptor(hiopPDPerturbation* p, hiopNlpFormulation* nlp);
+
+  /**
+   * Feasibility restoration phase, invoked when the line search fails: solves the restoration 
+   * problem (see hiopFRProbMDS) started at the current iterate with a nested instance of this
+   * algorithm and, on success, sets the trial iterate (primals, bounds duals, and functions) to 
+   * the restoration point, whose infeasibility is returned in @p theta_trial. The filter is 
+   * augmented with the current iterate. Returns false if the restoration failed, in which case 
+   * the solver status is set to 'Infeasible_Problem' when the restoration converged to a point
+   * that is not feasible for the NLP.
+   */
+  bool apply_feasibility_restoration(const double& theta, double& theta_trial);
   
   hiopPDPerturbation pd_perturb_;
   hiopFactAcceptor* fact_acceptor_;
+
+  //KKT linear system of the last run and whether it is reused by the next run (see 'resolve')
+  hiopKKTLinSys* kkt_;
+  bool reuse_kkt_;
+
+  //limited-memory secant approximation of the Hessian for MDS and sparse NLPs whose Hessian
+  //option requests a quasi-Newton update; NULL when the user's Hessian is used
+  hiopHessianLowRank* hess_lowrank_;
+
+  //true for the nested solver of the feasibility restoration, which does not reset the memory 
+  //peaks of the linear algebra since these are accounted to the outer solve
+  bool nested_;
 private:
   hiopAlgFilterIPMNewton() : hiopAlgFilterIPMBase(NULL) {};
   hiopAlgFilterIPMNewton(const hiopAlgFilterIPMNewton& ) : hiopAlgFilterIPMBase(NULL){};
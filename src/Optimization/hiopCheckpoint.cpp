@@ -0,0 +1,306 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+
+/**
+ * @file hiopCheckpoint.cpp
+ *
+ * Binary checkpoint of the state of the filter IPM, written in the background.
+ *
+ */
+
+#include "hiopCheckpoint.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+#include <sstream>
+
+namespace hiop
+{
+
+/* identifies the format of the checkpoint files; increase the version when the content changes */
+static const char ckpt_magic[8] = {'H','I','O','P','C','K','P','T'};
+static const int ckpt_version = 1;
+
+hiopCheckpoint::hiopCheckpoint(hiopNlpFormulation* nlp, const std::string& file_name)
+  : nlp_(nlp), rank_(0), num_ranks_(1), curr_(0), writer_ok_(true), pos_(0)
+{
+#ifdef HIOP_USE_MPI
+  rank_ = nlp_->get_rank();
+  num_ranks_ = nlp_->get_num_ranks();
+#endif
+  std::stringstream ss;
+  ss << file_name;
+  if(num_ranks_>1) {
+    ss << "." << rank_;
+  }
+  file_name_ = ss.str();
+}
+
+hiopCheckpoint::~hiopCheckpoint()
+{
+  wait();
+}
+
+template<class T> void hiopCheckpoint::append_pod(const T& v)
+{
+  const char* p = reinterpret_cast<const char*>(&v);
+  buffers_[curr_].insert(buffers_[curr_].end(), p, p+sizeof(T));
+}
+
+template<class T> bool hiopCheckpoint::extract_pod(T& v)
+{
+  if(pos_+sizeof(T)>loaded_.size()) {
+    nlp_->log->printf(hovError, "checkpoint '%s' is truncated\n", file_name_.c_str());
+    return false;
+  }
+  memcpy(&v, loaded_.data()+pos_, sizeof(T));
+  pos_ += sizeof(T);
+  return true;
+}
+
+void hiopCheckpoint::begin()
+{
+  std::vector<char>& buff = buffers_[curr_];
+  buff.clear();
+  buff.insert(buff.end(), ckpt_magic, ckpt_magic+sizeof(ckpt_magic));
+  append(ckpt_version);
+  append(num_ranks_);
+  append(rank_);
+}
+
+void hiopCheckpoint::append(const int& v)
+{
+  append_pod(v);
+}
+
+void hiopCheckpoint::append(const double& v)
+{
+  append_pod(v);
+}
+
+void hiopCheckpoint::append(const double* v, const long long& n)
+{
+  append_pod(n);
+  if(n>0) {
+    const char* p = reinterpret_cast<const char*>(v);
+    buffers_[curr_].insert(buffers_[curr_].end(), p, p+n*sizeof(double));
+  }
+}
+
+void hiopCheckpoint::append(const hiopVector& v)
+{
+  v.copyFromDev();
+  append(v.local_data_host_const(), v.get_local_size());
+}
+
+void hiopCheckpoint::append(const hiopMatrixDense& M)
+{
+  const long long m = M.get_local_size_m(), n = M.get_local_size_n();
+  append_pod(m);
+  append_pod(n);
+  if(m*n>0) {
+    const char* p = reinterpret_cast<const char*>(M.local_data_const());
+    buffers_[curr_].insert(buffers_[curr_].end(), p, p+m*n*sizeof(double));
+  }
+}
+
+void hiopCheckpoint::write_to_file(const std::vector<char>* buffer, const std::string* file_name, bool* ok)
+{
+  const std::string tmp_name = *file_name + ".tmp";
+  FILE* f = fopen(tmp_name.c_str(), "wb");
+  if(NULL==f) {
+    *ok = false;
+    return;
+  }
+  *ok = buffer->size()==fwrite(buffer->data(), 1, buffer->size(), f);
+  *ok = (0==fclose(f)) && *ok;
+  //the previous checkpoint is replaced only by a complete file
+  if(*ok) {
+    *ok = 0==std::rename(tmp_name.c_str(), file_name->c_str());
+  }
+}
+
+bool hiopCheckpoint::wait()
+{
+  if(writer_.joinable()) {
+    writer_.join();
+  }
+  return writer_ok_;
+}
+
+bool hiopCheckpoint::commit()
+{
+  //the previous write uses the other buffer and 'writer_ok_'
+  if(!wait()) {
+    nlp_->log->printf(hovWarning, "could not write checkpoint file '%s'\n", file_name_.c_str());
+  }
+  const bool prev_ok = writer_ok_;
+  writer_ = std::thread(write_to_file, &buffers_[curr_], &file_name_, &writer_ok_);
+  curr_ = 1-curr_;
+  return prev_ok;
+}
+
+bool hiopCheckpoint::load()
+{
+  wait();
+  loaded_.clear();
+  pos_ = 0;
+
+  FILE* f = fopen(file_name_.c_str(), "rb");
+  if(NULL==f) {
+    nlp_->log->printf(hovError, "could not open checkpoint file '%s'\n", file_name_.c_str());
+    return false;
+  }
+  fseek(f, 0, SEEK_END);
+  const long len = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  if(len>0) {
+    loaded_.resize(len);
+  }
+  const bool read_ok = len>0 && (size_t)len==fread(loaded_.data(), 1, len, f);
+  fclose(f);
+
+  if(!read_ok || loaded_.size()<sizeof(ckpt_magic) ||
+     0!=memcmp(loaded_.data(), ckpt_magic, sizeof(ckpt_magic))) {
+    nlp_->log->printf(hovError, "'%s' is not a HiOp checkpoint file\n", file_name_.c_str());
+    return false;
+  }
+  pos_ = sizeof(ckpt_magic);
+
+  int version, num_ranks, rank;
+  if(!extract(version) || !extract(num_ranks) || !extract(rank)) {
+    return false;
+  }
+  if(version!=ckpt_version) {
+    nlp_->log->printf(hovError, "checkpoint '%s' has version %d; version %d is supported\n",
+                      file_name_.c_str(), version, ckpt_version);
+    return false;
+  }
+  if(num_ranks!=num_ranks_ || rank!=rank_) {
+    nlp_->log->printf(hovError, "checkpoint '%s' was written by rank %d of %d, while this is rank %d of %d\n",
+                      file_name_.c_str(), rank, num_ranks, rank_, num_ranks_);
+    return false;
+  }
+  return true;
+}
+
+bool hiopCheckpoint::extract(int& v)
+{
+  return extract_pod(v);
+}
+
+bool hiopCheckpoint::extract(double& v)
+{
+  return extract_pod(v);
+}
+
+bool hiopCheckpoint::extract(double* v, const long long& n)
+{
+  long long n_saved;
+  if(!extract_pod(n_saved)) {
+    return false;
+  }
+  if(n_saved!=n) {
+    nlp_->log->printf(hovError, "checkpoint '%s' has an array of size %lld where size %lld is expected\n",
+                      file_name_.c_str(), n_saved, n);
+    return false;
+  }
+  if(pos_+n*sizeof(double)>loaded_.size()) {
+    nlp_->log->printf(hovError, "checkpoint '%s' is truncated\n", file_name_.c_str());
+    return false;
+  }
+  if(n>0) {
+    memcpy(v, loaded_.data()+pos_, n*sizeof(double));
+  }
+  pos_ += n*sizeof(double);
+  return true;
+}
+
+bool hiopCheckpoint::extract(hiopVector& v)
+{
+  if(!extract(v.local_data_host(), v.get_local_size())) {
+    return false;
+  }
+  v.copyToDev();
+  return true;
+}
+
+bool hiopCheckpoint::peek_sizes(long long& m, long long& n)
+{
+  const size_t pos = pos_;
+  const bool bret = extract_pod(m) && extract_pod(n);
+  pos_ = pos;
+  return bret;
+}
+
+bool hiopCheckpoint::extract(hiopMatrixDense& M)
+{
+  long long m, n;
+  if(!extract_pod(m) || !extract_pod(n)) {
+    return false;
+  }
+  if(m!=M.get_local_size_m() || n!=M.get_local_size_n()) {
+    nlp_->log->printf(hovError, "checkpoint '%s' has a %lldx%lld matrix where %lldx%lld is expected\n",
+                      file_name_.c_str(), m, n, M.get_local_size_m(), M.get_local_size_n());
+    return false;
+  }
+  if(pos_+m*n*sizeof(double)>loaded_.size()) {
+    nlp_->log->printf(hovError, "checkpoint '%s' is truncated\n", file_name_.c_str());
+    return false;
+  }
+  if(m*n>0) {
+    M.copyFrom(reinterpret_cast<const double*>(loaded_.data()+pos_));
+  }
+  pos_ += m*n*sizeof(double);
+  return true;
+}
+
+} //end namespace
@@ -0,0 +1,144 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+
+/**
+ * @file hiopCheckpoint.hpp
+ *
+ * Binary checkpoint of the state of the filter IPM, written in the background.
+ *
+ */
+
+#ifndef HIOP_CHECKPOINT
+#define HIOP_CHECKPOINT
+
+#include "hiopNlpFormulation.hpp"
+#include "hiopVector.hpp"
+#include "hiopMatrixDense.hpp"
+
+#include <string>
+#include <vector>
+#include <thread>
+
+namespace hiop
+{
+
+/* *************************************************************************
+ * Compact binary checkpoint file of the algorithm's state. Each MPI rank writes
+ * its own file, containing the local parts of the distributed vectors and
+ * matrices and a copy of the replicated data. The file of rank r (when more 
+ * than one rank is used) is named 'file_name.r'.
+ *
+ * Saving: the state is appended to an in-memory buffer (methods 'append'), after 
+ * which 'commit' hands the buffer to a background thread that writes it to a 
+ * temporary file and renames it over the checkpoint file, so that a preemption 
+ * during the write leaves the previous checkpoint intact. Two buffers are used
+ * in turns so that the next state can be serialized while the previous one is 
+ * written; 'commit' waits only if the previous write did not finish yet.
+ *
+ * Loading: 'load' reads the file in memory and the state is retrieved, in the 
+ * order it was appended, by the methods 'extract', which check the sizes.
+ * *************************************************************************
+ */
+class hiopCheckpoint
+{
+public:
+  hiopCheckpoint(hiopNlpFormulation* nlp, const std::string& file_name);
+  virtual ~hiopCheckpoint();
+
+  /* starts a new checkpoint in the buffer that is not being written */
+  void begin();
+  void append(const int& v);
+  void append(const double& v);
+  /* the local entries of the vector, preceded by their number */
+  void append(const hiopVector& v);
+  /* the local rows and columns of the matrix, preceded by their numbers */
+  void append(const hiopMatrixDense& M);
+  void append(const double* v, const long long& n);
+  /* writes the buffer to file on a background thread; returns false if the previous 
+   * write failed */
+  bool commit();
+  /* waits for the background write, if any, to complete; returns false if it failed */
+  bool wait();
+
+  /* reads the checkpoint file; returns false if the file is missing or was not written by 
+   * a run with the same number of ranks */
+  bool load();
+  bool extract(int& v);
+  bool extract(double& v);
+  /* the vector must have the same local size as the one saved */
+  bool extract(hiopVector& v);
+  /* the matrix must have the local sizes of the one saved */
+  bool extract(hiopMatrixDense& M);
+  bool extract(double* v, const long long& n);
+  /* number of local rows and columns of the next matrix, without extracting it */
+  bool peek_sizes(long long& m, long long& n);
+
+  inline const std::string& file_name() const { return file_name_; }
+private:
+  static void write_to_file(const std::vector<char>* buffer, const std::string* file_name, bool* ok);
+  template<class T> void append_pod(const T& v);
+  template<class T> bool extract_pod(T& v);
+private:
+  hiopNlpFormulation* nlp_;
+  std::string file_name_;
+  /* rank of this process and number of ranks; 0 and 1 without MPI */
+  int rank_, num_ranks_;
+  /* two buffers used in turns; 'curr_' is the one being filled */
+  std::vector<char> buffers_[2];
+  int curr_;
+  std::thread writer_;
+  bool writer_ok_;
+  /* the content of the loaded file and the position of the next 'extract' */
+  std::vector<char> loaded_;
+  size_t pos_;
+};
+
+} //end namespace
+#endif
@@ -54,6 +54,7 @@
  */
  
 #include "hiopDualsUpdater.hpp"
+#include "hiopKKTLinSys.hpp"
 #include "hiopLinAlgFactory.hpp"
 
 #include "hiopLinSolverIndefDenseLapack.hpp"
@@ -305,7 +306,9 @@ bool hiopDualsLsqUpdateLinsysRedDense::do_lsq_update(hiopIterate& iter,
 
 hiopDualsLsqUpdateLinsysAugSparse::hiopDualsLsqUpdateLinsysAugSparse(hiopNlpFormulation* nlp)
   : hiopDualsLsqUpdate(nlp),
-    lin_sys_(nullptr)
+    lin_sys_(nullptr),
+    kkt_(nullptr),
+    Hess_(nullptr)
 {
 #ifndef HIOP_SPARSE
   assert(0 && "should not reach here!");
@@ -329,6 +332,34 @@ bool hiopDualsLsqUpdateLinsysAugSparse::do_lsq_update(hiopIterate& iter,
   const hiopMatrixSparse& Jac_cSp = dynamic_cast<const hiopMatrixSparse&>(jac_c);
   const hiopMatrixSparse& Jac_dSp = dynamic_cast<const hiopMatrixSparse&>(jac_d);
 
+  if(kkt_ && kkt_->supportsLsqDuals()) {
+    assert(Hess_);
+    // rhsx = - [ \nabla f(xk) - zk_l + zk_u  ] and rhss = - [ -vk_l + vk_u ]
+    hiopVector& rhsx = *vec_n_;
+    rhsx.copyFrom(grad_f);
+    rhsx.negate();
+    rhsx.axpy( 1.0, *iter.get_zl());
+    rhsx.axpy(-1.0, *iter.get_zu());
+
+    hiopVector& rhss = *vec_mi_;
+    rhss.copyFrom(*iter.get_vl());
+    rhss.axpy(-1.0, *iter.get_vu());
+
+    //the pattern of the Hessian is part of the KKT's pattern and may not be available yet
+    if(!nlpsp->eval_Hess_Lagr_struct(*iter.get_x(), *Hess_)) {
+      nlp_->log->printf(hovError, "dual lsq update: error in the evaluation of the Hessian's structure.\n");
+      return false;
+    }
+    //the KKT matrix and the linear solver may be allocated by the first solve
+    hiopMemCategoryScope mem_scope(hiopMemStats::mcKKT);
+    if(!kkt_->solveLsqDuals(rhsx, rhss, jac_c, jac_d, *Hess_, *iter.get_yc(), *iter.get_yd())) {
+      nlp_->log->printf(hovWarning, "dual lsq update: error in the solution process (sparse KKT).\n");
+      iter.get_yc()->setToZero();
+      iter.get_yd()->setToZero();
+    }
+    return true;
+  }
+
   int nx = Jac_cSp.n(), nd=Jac_dSp.m(), neq=Jac_cSp.m(), nineq=Jac_dSp.m();
   int n = nx + nineq + neq + nineq; 
 
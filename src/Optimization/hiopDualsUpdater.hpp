@@ -65,6 +65,8 @@
 namespace hiop
 {
 
+class hiopKKTLinSys;
+
 class hiopDualsUpdater
 {
 public:
@@ -148,6 +150,13 @@ public:
     //nlp_->log->write("yd ini", *iter.get_yd(), hovSummary);
     return bret;
   }
+
+  /** 
+   * Lets the LSQ linear system be solved with the linear solver of the KKT system 'kkt' (see
+   * hiopKKTLinSys::solveLsqDuals), whose pattern includes the pattern of the Hessian 'Hess'.
+   * Ignored by the updaters that do not solve a sparse augmented system. 
+   */
+  virtual void set_kkt_linsys(hiopKKTLinSys* kkt, hiopMatrix* Hess) {}
 protected:
   //method called by both 'go' and 'computeInitialDualsEq'
   virtual bool do_lsq_update(hiopIterate& it,
@@ -306,6 +315,17 @@ class hiopDualsLsqUpdateLinsysAugSparse : public hiopDualsLsqUpdate
 public:
   hiopDualsLsqUpdateLinsysAugSparse(hiopNlpFormulation* nlp);
   virtual ~hiopDualsLsqUpdateLinsysAugSparse();
+
+  /** 
+   * When the KKT system supports it, the LSQ system is solved with the KKT's linear solver, 
+   * which then performs a single ordering and symbolic analysis for both systems. Otherwise,
+   * the augmented system above is solved with a linear solver of this class.
+   */
+  virtual void set_kkt_linsys(hiopKKTLinSys* kkt, hiopMatrix* Hess)
+  {
+    kkt_ = kkt;
+    Hess_ = Hess;
+  }
 private:
   virtual bool do_lsq_update(hiopIterate& iter,
                              const hiopVector& grad_f,
@@ -313,6 +333,10 @@ private:
                              const hiopMatrix& jac_d);
 private:
   hiopLinSolver* lin_sys_;
+
+  //not owned; NULL when the LSQ system is solved with 'lin_sys_'
+  hiopKKTLinSys* kkt_;
+  hiopMatrix* Hess_;
 };
 
   
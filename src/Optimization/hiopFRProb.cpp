@@ -0,0 +1,448 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+/**
+ * @file hiopFRProb.cpp
+ *
+ * Feasibility restoration problem used by the filter IPM when the line search fails.
+ *
+ */
+
+#include "hiopFRProb.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <cassert>
+
+namespace hiop
+{
+
+hiopFRProbMDS::hiopFRProbMDS(hiopNlpMDS& nlp_base,
+                             const hiopIterate& it_ref,
+                             const hiopVector& c_ref, const hiopVector& d_ref,
+                             const hiopMatrix& Jac_c, const hiopMatrix& Jac_d, const hiopMatrix& Hess,
+                             const double& theta_ref,
+                             const double& mu)
+  : nlp_base_(nlp_base),
+    rho_(nlp_base.options->GetNumeric("resto_penalty_parameter")), kappa_resto_(0.9),
+    zeta_(sqrt(mu)), theta_ref_(theta_ref), theta_last_(theta_ref),
+    target_reached_(false),
+    mu_(mu),
+    cons_valid_(false), Jac_valid_(false)
+{
+  nxs_ = nlp_base_.nx_sp();
+  nxd_ = nlp_base_.nx_de();
+  m_eq_ = nlp_base_.m_eq();
+  m_ineq_ = nlp_base_.m_ineq();
+  assert(nxs_+nxd_ == nlp_base_.n());
+
+  off_pc_ = nxs_;
+  off_nc_ = off_pc_ + m_eq_;
+  off_pd_ = off_nc_ + m_eq_;
+  off_nd_ = off_pd_ + m_ineq_;
+  off_xd_ = off_nd_ + m_ineq_;
+
+  x_ref_ = it_ref.get_x()->new_copy();
+  DR2_ = nlp_base_.alloc_primal_vec();
+  const double* xr = x_ref_->local_data_const();
+  double* dr2 = DR2_->local_data();
+  for(long long i=0; i<nxs_+nxd_; i++) {
+    const double dr = fmin(1., 1./fabs(xr[i]));
+    dr2[i] = dr*dr;
+  }
+
+  //residuals c(x_R)-crhs and d(x_R)-d_R
+  rc_ref_ = c_ref.new_copy();
+  rc_ref_->axpy(-1., nlp_base_.get_crhs());
+  rd_ref_ = d_ref.new_copy();
+  rd_ref_->axpy(-1., *it_ref.get_d());
+
+  x_cons_ = nlp_base_.alloc_primal_vec();
+  x_Jac_  = nlp_base_.alloc_primal_vec();
+  x_Hess_ = nlp_base_.alloc_primal_vec();
+  c_base_ = nlp_base_.alloc_dual_eq_vec();
+  d_base_ = nlp_base_.alloc_dual_ineq_vec();
+  lambda_eq_   = nlp_base_.alloc_dual_eq_vec();
+  lambda_ineq_ = nlp_base_.alloc_dual_ineq_vec();
+
+  //copies of the derivatives of the original NLP; these carry the sparsity structure, which is
+  //requested from the user only once
+  Jac_c_base_ = dynamic_cast<hiopMatrixMDS*>(Jac_c.new_copy());
+  Jac_d_base_ = dynamic_cast<hiopMatrixMDS*>(Jac_d.new_copy());
+  Hess_base_  = dynamic_cast<hiopMatrixSymBlockDiagMDS*>(Hess.new_copy());
+  assert(Jac_c_base_ && Jac_d_base_ && Hess_base_);
+}
+
+hiopFRProbMDS::~hiopFRProbMDS()
+{
+  delete x_ref_;
+  delete DR2_;
+  delete rc_ref_;
+  delete rd_ref_;
+  delete x_cons_;
+  delete x_Jac_;
+  delete x_Hess_;
+  delete c_base_;
+  delete d_base_;
+  delete lambda_eq_;
+  delete lambda_ineq_;
+  delete Jac_c_base_;
+  delete Jac_d_base_;
+  delete Hess_base_;
+}
+
+bool hiopFRProbMDS::get_prob_sizes(long long& n, long long& m)
+{
+  n = off_xd_ + nxd_;
+  m = m_eq_ + m_ineq_;
+  return true;
+}
+
+bool hiopFRProbMDS::get_vars_info(const long long& n, double *xlow, double* xupp, NonlinearityType* type)
+{
+  assert(n == off_xd_+nxd_);
+  const double* xl = nlp_base_.get_xl().local_data_const();
+  const double* xu = nlp_base_.get_xu().local_data_const();
+  memcpy(xlow, xl, nxs_*sizeof(double));
+  memcpy(xupp, xu, nxs_*sizeof(double));
+  for(long long i=off_pc_; i<off_xd_; i++) {
+    xlow[i] = 0.;
+    xupp[i] = 1e20;
+  }
+  memcpy(xlow+off_xd_, xl+nxs_, nxd_*sizeof(double));
+  memcpy(xupp+off_xd_, xu+nxs_, nxd_*sizeof(double));
+  for(long long i=0; i<n; i++) type[i] = hiopNonlinear;
+  return true;
+}
+
+bool hiopFRProbMDS::get_cons_info(const long long& m, double* clow, double* cupp, NonlinearityType* type)
+{
+  assert(m == m_eq_+m_ineq_);
+  const double* crhs = nlp_base_.get_crhs().local_data_const();
+  memcpy(clow, crhs, m_eq_*sizeof(double));
+  memcpy(cupp, crhs, m_eq_*sizeof(double));
+  memcpy(clow+m_eq_, nlp_base_.get_dl().local_data_const(), m_ineq_*sizeof(double));
+  memcpy(cupp+m_eq_, nlp_base_.get_du().local_data_const(), m_ineq_*sizeof(double));
+  for(long long i=0; i<m; i++) type[i] = hiopNonlinear;
+  return true;
+}
+
+bool hiopFRProbMDS::get_sparse_dense_blocks_info(int& nx_sparse, int& nx_dense,
+                                                 int& nnz_sparse_Jaceq, int& nnz_sparse_Jacineq,
+                                                 int& nnz_sparse_Hess_Lagr_SS, 
+                                                 int& nnz_sparse_Hess_Lagr_SD)
+{
+  nx_sparse = off_xd_;
+  nx_dense = nxd_;
+  //two entries (-1 for p and +1 for n) are added in each row
+  nnz_sparse_Jaceq = Jac_c_base_->sp_nnz() + 2*m_eq_;
+  nnz_sparse_Jacineq = Jac_d_base_->sp_nnz() + 2*m_ineq_;
+  //the diagonal of the proximity term is appended to the Hessian of the original NLP
+  nnz_sparse_Hess_Lagr_SS = Hess_base_->sp_nnz() + nxs_;
+  nnz_sparse_Hess_Lagr_SD = 0;
+  return true;
+}
+
+bool hiopFRProbMDS::eval_f(const long long& n, const double* x, bool new_x, double& obj_value)
+{
+  double penalty = 0.;
+  for(long long i=off_pc_; i<off_xd_; i++) {
+    penalty += x[i];
+  }
+
+  const double* xr = x_ref_->local_data_const();
+  const double* dr2 = DR2_->local_data_const();
+  double prox = 0., aux;
+  for(long long i=0; i<nxs_; i++) {
+    aux = x[i]-xr[i];
+    prox += dr2[i]*aux*aux;
+  }
+  for(long long i=0; i<nxd_; i++) {
+    aux = x[off_xd_+i]-xr[nxs_+i];
+    prox += dr2[nxs_+i]*aux*aux;
+  }
+  obj_value = rho_*penalty + 0.5*zeta_*prox;
+  return true;
+}
+
+bool hiopFRProbMDS::eval_grad_f(const long long& n, const double* x, bool new_x, double* gradf)
+{
+  const double* xr = x_ref_->local_data_const();
+  const double* dr2 = DR2_->local_data_const();
+  for(long long i=0; i<nxs_; i++) {
+    gradf[i] = zeta_*dr2[i]*(x[i]-xr[i]);
+  }
+  for(long long i=off_pc_; i<off_xd_; i++) {
+    gradf[i] = rho_;
+  }
+  for(long long i=0; i<nxd_; i++) {
+    gradf[off_xd_+i] = zeta_*dr2[nxs_+i]*(x[off_xd_+i]-xr[nxs_+i]);
+  }
+  return true;
+}
+
+bool hiopFRProbMDS::eval_cons(const long long& n, const long long& m, 
+                              const long long& num_cons, const long long* idx_cons,  
+                              const double* x, bool new_x, 
+                              double* cons)
+{
+  if(0==num_cons) return true;
+  if(!update_base_cons(x)) return false;
+
+  const double* c = c_base_->local_data_const();
+  const double* d = d_base_->local_data_const();
+  for(long long i=0; i<num_cons; i++) {
+    const long long k = idx_cons[i];
+    if(k<m_eq_) {
+      cons[i] = c[k] - x[off_pc_+k] + x[off_nc_+k];
+    } else {
+      assert(k-m_eq_<m_ineq_);
+      cons[i] = d[k-m_eq_] - x[off_pd_+k-m_eq_] + x[off_nd_+k-m_eq_];
+    }
+  }
+  return true;
+}
+
+bool hiopFRProbMDS::eval_Jac_cons(const long long& n, const long long& m, 
+                                  const long long& num_cons, const long long* idx_cons,
+                                  const double* x, bool new_x,
+                                  const long long& nsparse, const long long& ndense, 
+                                  const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS, 
+                                  double* JacD)
+{
+  if(0==num_cons) return true;
+
+  //the equalities and inequalities are requested separately and in the order given by get_cons_info
+  const bool is_eq = idx_cons[0]<m_eq_;
+  hiopMatrixMDS& J = is_eq ? *Jac_c_base_ : *Jac_d_base_;
+  const long long off_p = is_eq ? off_pc_ : off_pd_;
+  const long long off_n = is_eq ? off_nc_ : off_nd_;
+  assert(num_cons == (is_eq ? m_eq_ : m_ineq_));
+  assert(idx_cons[num_cons-1] == (is_eq ? 0 : m_eq_) + num_cons-1);
+
+  const int nnz_base = J.sp_nnz();
+  assert(nnzJacS == nnz_base + 2*num_cons);
+
+  if(NULL!=iJacS && NULL!=jJacS) {
+    memcpy(iJacS, J.sp_irow(), nnz_base*sizeof(int));
+    memcpy(jJacS, J.sp_jcol(), nnz_base*sizeof(int));
+    for(long long i=0, k=nnz_base; i<num_cons; i++) {
+      iJacS[k] = i; jJacS[k] = off_p+i; k++;
+      iJacS[k] = i; jJacS[k] = off_n+i; k++;
+    }
+  }
+
+  if(NULL==iJacS || NULL!=MJacS) {
+    if(!update_base_Jac(x)) return false;
+    if(NULL!=MJacS) {
+      memcpy(MJacS, J.sp_M(), nnz_base*sizeof(double));
+      for(long long i=0, k=nnz_base; i<num_cons; i++) {
+        MJacS[k++] = -1.;
+        MJacS[k++] = 1.;
+      }
+    }
+    memcpy(JacD, J.de_local_data(), num_cons*nxd_*sizeof(double));
+  }
+  return true;
+}
+
+bool hiopFRProbMDS::eval_Hess_Lagr(const long long& n, const long long& m, 
+                                   const double* x, bool new_x, const double& obj_factor,
+                                   const double* lambda, bool new_lambda,
+                                   const long long& nsparse, const long long& ndense, 
+                                   const int& nnzHSS, int* iHSS, int* jHSS, double* MHSS, 
+                                   double* HDD,
+                                   int& nnzHSD, int* iHSD, int* jHSD, double* MHSD)
+{
+  nnzHSD = 0;
+  const int nnz_base = Hess_base_->sp_nnz();
+  assert(nnzHSS == nnz_base + nxs_);
+
+  if(NULL!=iHSS && NULL!=jHSS) {
+    memcpy(iHSS, Hess_base_->sp_irow(), nnz_base*sizeof(int));
+    memcpy(jHSS, Hess_base_->sp_jcol(), nnz_base*sizeof(int));
+    for(long long i=0; i<nxs_; i++) {
+      iHSS[nnz_base+i] = jHSS[nnz_base+i] = i;
+    }
+  }
+
+  if(NULL==iHSS || NULL!=MHSS) {
+    //the objective of the original NLP does not enter the restoration problem; the original NLP
+    //may have been evaluated at other points since the last evaluation at x, hence new_x=true
+    get_x_base(x, *x_Hess_);
+    lambda_eq_->copyFrom(lambda);
+    lambda_ineq_->copyFrom(lambda+m_eq_);
+    if(!nlp_base_.eval_Hess_Lagr(*x_Hess_, true, 0., *lambda_eq_, *lambda_ineq_, new_lambda, *Hess_base_)) {
+      return false;
+    }
+
+    const double* dr2 = DR2_->local_data_const();
+    if(NULL!=MHSS) {
+      memcpy(MHSS, Hess_base_->sp_M(), nnz_base*sizeof(double));
+      for(long long i=0; i<nxs_; i++) {
+        MHSS[nnz_base+i] = obj_factor*zeta_*dr2[i];
+      }
+    }
+    memcpy(HDD, Hess_base_->de_local_data(), nxd_*nxd_*sizeof(double));
+    for(long long i=0; i<nxd_; i++) {
+      HDD[i*nxd_+i] += obj_factor*zeta_*dr2[nxs_+i];
+    }
+  }
+  return true;
+}
+
+bool hiopFRProbMDS::get_MPI_comm(MPI_Comm& comm_out)
+{
+#ifdef HIOP_USE_MPI
+  comm_out = nlp_base_.get_comm();
+#else
+  comm_out = MPI_COMM_SELF;
+#endif
+  return true;
+}
+
+/* the elastic variables are the minimizers of rho*(p+n)-mu*ln(p)-mu*ln(n) subject to p-n=r */
+static void elastic_starting_point(const double& rho, const double& mu, const double* r, const long long& m,
+                                   double* p, double* n)
+{
+  for(long long i=0; i<m; i++) {
+    const double a = (mu-rho*r[i])/(2*rho);
+    n[i] = a + sqrt(a*a + mu*r[i]/(2*rho));
+    p[i] = r[i] + n[i];
+  }
+}
+
+bool hiopFRProbMDS::get_starting_point(const long long& n, double* x0)
+{
+  assert(n == off_xd_+nxd_);
+  const double* xr = x_ref_->local_data_const();
+  memcpy(x0, xr, nxs_*sizeof(double));
+  memcpy(x0+off_xd_, xr+nxs_, nxd_*sizeof(double));
+  elastic_starting_point(rho_, mu_, rc_ref_->local_data_const(), m_eq_, x0+off_pc_, x0+off_nc_);
+  elastic_starting_point(rho_, mu_, rd_ref_->local_data_const(), m_ineq_, x0+off_pd_, x0+off_nd_);
+  return true;
+}
+
+bool hiopFRProbMDS::iterate_callback(int iter, double obj_value,
+                                     int n, const double* x,
+                                     const double* z_L,
+                                     const double* z_U,
+                                     int m, const double* g,
+                                     const double* lambda,
+                                     double inf_pr, double inf_du,
+                                     double mu,
+                                     double alpha_du, double alpha_pr,
+                                     int ls_trials)
+{
+  //an evaluation error will be caught by the next evaluation of the restoration problem
+  if(!update_base_cons(x)) return true;
+
+  //infeasibility of the original NLP at x, with the slacks d taken as the projection of the
+  //inequalities of the restoration problem onto [dl,du]
+  const double* c = c_base_->local_data_const();
+  const double* crhs = nlp_base_.get_crhs().local_data_const();
+  const double* d = d_base_->local_data_const();
+  const double* dl = nlp_base_.get_dl().local_data_const();
+  const double* du = nlp_base_.get_du().local_data_const();
+  double theta = 0.;
+  for(long long i=0; i<m_eq_; i++) {
+    theta += fabs(c[i]-crhs[i]);
+  }
+  for(long long i=0; i<m_ineq_; i++) {
+    theta += fabs(d[i] - fmax(dl[i], fmin(du[i], g[m_eq_+i])));
+  }
+  theta_last_ = theta;
+
+  if(theta <= kappa_resto_*theta_ref_) {
+    target_reached_ = true;
+    return false;
+  }
+  return true;
+}
+
+void hiopFRProbMDS::get_base_primal(const hiopVector& v_fr, hiopVector& v_base) const
+{
+  assert(v_fr.get_size() == off_xd_+nxd_);
+  get_x_base(v_fr.local_data_const(), v_base);
+}
+
+void hiopFRProbMDS::get_x_base(const double* x, hiopVector& x_base) const
+{
+  double* xb = x_base.local_data();
+  memcpy(xb, x, nxs_*sizeof(double));
+  memcpy(xb+nxs_, x+off_xd_, nxd_*sizeof(double));
+}
+
+bool hiopFRProbMDS::is_x_base(const double* x, const hiopVector& x_base) const
+{
+  const double* xb = x_base.local_data_const();
+  return 0==memcmp(xb, x, nxs_*sizeof(double)) && 0==memcmp(xb+nxs_, x+off_xd_, nxd_*sizeof(double));
+}
+
+bool hiopFRProbMDS::update_base_cons(const double* x)
+{
+  if(cons_valid_ && is_x_base(x, *x_cons_)) {
+    return true;
+  }
+  get_x_base(x, *x_cons_);
+  cons_valid_ = nlp_base_.eval_c_d(*x_cons_, true, *c_base_, *d_base_);
+  return cons_valid_;
+}
+
+bool hiopFRProbMDS::update_base_Jac(const double* x)
+{
+  if(Jac_valid_ && is_x_base(x, *x_Jac_)) {
+    return true;
+  }
+  get_x_base(x, *x_Jac_);
+  Jac_valid_ = nlp_base_.eval_Jac_c_d(*x_Jac_, true, *Jac_c_base_, *Jac_d_base_);
+  return Jac_valid_;
+}
+
+} //end of namespace
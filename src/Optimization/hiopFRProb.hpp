@@ -0,0 +1,197 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+/**
+ * @file hiopFRProb.hpp
+ *
+ * Feasibility restoration problem used by the filter IPM when the line search fails.
+ *
+ */
+
+#ifndef HIOP_FR_PROB
+#define HIOP_FR_PROB
+
+#include "hiopInterface.hpp"
+#include "hiopNlpFormulation.hpp"
+#include "hiopIterate.hpp"
+
+namespace hiop
+{
+
+/* *************************************************************************
+ * Feasibility restoration problem for NLPs with mixed sparse-dense (MDS)
+ * derivatives. For the NLP
+ *   min f(x) s.t. c(x)=crhs, dl<=d(x)<=du, xl<=x<=xu
+ * as seen by the algorithm, i.e., after the internal transformations (scaling,
+ * bounds relaxation) of the formulation, the restoration problem is
+ *   min  rho*e^T(pc+nc+pd+nd) + zeta/2*||D_R(x-x_R)||^2
+ *   s.t. c(x)-pc+nc=crhs, dl<=d(x)-pd+nd<=du, xl<=x<=xu, pc,nc,pd,nd>=0,
+ * where x_R is the iterate at which the restoration is started, zeta=sqrt(mu),
+ * D_R=diag(min(1,1/|x_R|)), and rho is given by the option 'resto_penalty_parameter'.
+ *
+ * The problem is exposed through the MDS interface so that it is solved by
+ * hiopAlgFilterIPMNewton with the same formulation, KKT linear system, and
+ * linear solver classes as the original NLP. The elastic variables are
+ * appended to the sparse variables, namely the variables of the restoration
+ * problem are [xs,pc,nc,pd,nd,xd]. The constraints and their derivatives are
+ * evaluated through the formulation of the original NLP.
+ *
+ * The restoration is stopped through the iterate callback as soon as the
+ * infeasibility of the original NLP is reduced by the factor kappa_resto=0.9 
+ * relative to the infeasibility at x_R.
+ * *************************************************************************
+ */
+class hiopFRProbMDS : public hiopInterfaceMDS
+{
+public:
+  /** 
+   * @param nlp_base formulation of the original NLP
+   * @param it_ref iterate at which the restoration is started
+   * @param c_ref, d_ref the (bodies of) equalities and inequalities at @p it_ref
+   * @param Jac_c, Jac_d, Hess derivatives of the original NLP whose sparsity structure is used 
+   * by the restoration problem; these are not modified
+   * @param theta_ref infeasibility at @p it_ref
+   * @param mu log-barrier parameter at @p it_ref
+   */
+  hiopFRProbMDS(hiopNlpMDS& nlp_base,
+                const hiopIterate& it_ref,
+                const hiopVector& c_ref, const hiopVector& d_ref,
+                const hiopMatrix& Jac_c, const hiopMatrix& Jac_d, const hiopMatrix& Hess,
+                const double& theta_ref,
+                const double& mu);
+  virtual ~hiopFRProbMDS();
+
+  bool get_prob_sizes(long long& n, long long& m);
+  bool get_vars_info(const long long& n, double *xlow, double* xupp, NonlinearityType* type);
+  bool get_cons_info(const long long& m, double* clow, double* cupp, NonlinearityType* type);
+  bool get_sparse_dense_blocks_info(int& nx_sparse, int& nx_dense,
+                                    int& nnz_sparse_Jaceq, int& nnz_sparse_Jacineq,
+                                    int& nnz_sparse_Hess_Lagr_SS, 
+                                    int& nnz_sparse_Hess_Lagr_SD);
+
+  bool eval_f(const long long& n, const double* x, bool new_x, double& obj_value);
+  bool eval_grad_f(const long long& n, const double* x, bool new_x, double* gradf);
+  bool eval_cons(const long long& n, const long long& m, 
+                 const long long& num_cons, const long long* idx_cons,  
+                 const double* x, bool new_x, 
+                 double* cons);
+  //the one-call constraints evaluation is not provided
+  using hiopInterfaceMDS::eval_cons;
+  bool eval_Jac_cons(const long long& n, const long long& m, 
+                     const long long& num_cons, const long long* idx_cons,
+                     const double* x, bool new_x,
+                     const long long& nsparse, const long long& ndense, 
+                     const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS, 
+                     double* JacD);
+  using hiopInterfaceMDS::eval_Jac_cons;
+  bool eval_Hess_Lagr(const long long& n, const long long& m, 
+                      const double* x, bool new_x, const double& obj_factor,
+                      const double* lambda, bool new_lambda,
+                      const long long& nsparse, const long long& ndense, 
+                      const int& nnzHSS, int* iHSS, int* jHSS, double* MHSS, 
+                      double* HDD,
+                      int& nnzHSD, int* iHSD, int* jHSD, double* MHSD);
+
+  bool get_MPI_comm(MPI_Comm& comm_out);
+  bool get_starting_point(const long long& n, double* x0);
+
+  /* stops the restoration (returns false) once the infeasibility of the original NLP is 
+   * sufficiently reduced */
+  bool iterate_callback(int iter, double obj_value,
+                        int n, const double* x,
+                        const double* z_L,
+                        const double* z_U,
+                        int m, const double* g,
+                        const double* lambda,
+                        double inf_pr, double inf_du,
+                        double mu,
+                        double alpha_du, double alpha_pr,
+                        int ls_trials);
+
+  /* true if the restoration was stopped at a point with sufficiently reduced infeasibility */
+  inline bool target_reached() const { return target_reached_; }
+  /* infeasibility of the original NLP at the last iterate of the restoration */
+  inline double theta_last() const { return theta_last_; }
+
+  /* copies the entries of a restoration primal vector (or of the duals of its bounds) that 
+   * correspond to the variables of the original NLP into @p v_base */
+  void get_base_primal(const hiopVector& v_fr, hiopVector& v_base) const;
+private:
+  //copies the xs and xd parts of the restoration variables @p x into @p x_base
+  void get_x_base(const double* x, hiopVector& x_base) const;
+  bool is_x_base(const double* x, const hiopVector& x_base) const;
+  //evaluate the constraints and the Jacobian of the original NLP at @p x when not already done
+  bool update_base_cons(const double* x);
+  bool update_base_Jac(const double* x);
+private:
+  hiopNlpMDS& nlp_base_;
+  long long nxs_, nxd_, m_eq_, m_ineq_;
+  //offsets of the elastic variables pc, nc, pd, nd and of xd within the restoration variables
+  long long off_pc_, off_nc_, off_pd_, off_nd_, off_xd_;
+
+  //penalty for the elastic variables and infeasibility reduction factor required from the restoration
+  double rho_, kappa_resto_;
+  double zeta_, theta_ref_, theta_last_;
+  bool target_reached_;
+  //x_R and the diagonal of D_R^2
+  hiopVector *x_ref_, *DR2_;
+  //residuals of the constraints at x_R, used for the starting point of the elastic variables
+  hiopVector *rc_ref_, *rd_ref_;
+  double mu_;
+
+  //evaluations of the original NLP and the points at which they were done
+  hiopVector *x_cons_, *x_Jac_, *x_Hess_;
+  bool cons_valid_, Jac_valid_;
+  hiopVector *c_base_, *d_base_, *lambda_eq_, *lambda_ineq_;
+  hiopMatrixMDS *Jac_c_base_, *Jac_d_base_;
+  hiopMatrixSymBlockDiagMDS* Hess_base_;
+};
+
+} //end of namespace
+#endif
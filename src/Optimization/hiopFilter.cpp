@@ -48,6 +48,8 @@
 
 #include "hiopFilter.hpp"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace hiop
@@ -55,16 +57,38 @@ namespace hiop
 
 bool hiopFilter::contains(const double& theta, const double& phi) const
 {
-  list<FilterEntry>::const_iterator it = entries.begin();
-  bool bFound=false;
-  while(it!=entries.end()) {
-    if(theta>=it->theta && phi>=it->phi) { 
-      bFound=true;
-      break;
-    }
-    ++it;
+  //first entry with theta strictly larger than the queried one
+  vector<FilterEntry>::const_iterator it = 
+    upper_bound(entries.begin(), entries.end(), theta,
+		[](const double& t, const FilterEntry& e) { return t < e.theta; });
+  if(it==entries.begin()) return false;
+  //the preceding entry has the smallest phi among the entries with theta not larger than @theta
+  --it;
+  assert(theta>=it->theta);
+  return phi>=it->phi;
+}
+
+void hiopFilter::add(const double& theta, const double& phi)
+{
+  if(contains(theta, phi)) return;
+
+  //first entry with theta not smaller than the new one; since phi decreases along the entries, 
+  //the entries dominated by the new one form a contiguous range starting at this position
+  vector<FilterEntry>::iterator first = 
+    lower_bound(entries.begin(), entries.end(), theta,
+		[](const FilterEntry& e, const double& t) { return e.theta < t; });
+  vector<FilterEntry>::iterator last = first;
+  while(last!=entries.end() && last->phi>=phi) {
+    assert(last->theta>=theta);
+    ++last;
+  }
+  if(first==last) {
+    entries.insert(first, FilterEntry(theta,phi));
+  } else {
+    //reuse the slot of the first dominated entry
+    first->theta=theta; first->phi=phi;
+    entries.erase(first+1, last);
   }
-  return bFound;
 }
 
 void hiopFilter::print(FILE* file, const char* msg) const
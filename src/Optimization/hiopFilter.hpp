@@ -50,7 +50,7 @@
 #define HIOP_FILTER
 
 #include <cstdio>
-#include <list>
+#include <vector>
 #include <cassert>
 
 namespace hiop
@@ -61,18 +61,31 @@ class hiopFilter
 public:
   hiopFilter()  { };
   ~hiopFilter() { };
-  inline void initialize  (const double& theta_max) { entries.clear(); entries.push_front(FilterEntry(theta_max,-1e20)); }
+  inline void initialize  (const double& theta_max) { entries.clear(); entries.push_back(FilterEntry(theta_max,-1e20)); }
   inline void reinitialize(const double& theta_max) { initialize(theta_max); }
 
   inline void clear() { entries.clear(); }
   
-  //entries are pushed at the front since these are most likely to reject new iterates
-  inline void add(const double& theta, const double& phi)
+  /* adds (theta,phi) to the filter and removes the entries it dominates; nothing is added if 
+   * (theta,phi) is itself dominated, since it would not change the region rejected by the filter */
+  void add(const double& theta, const double& phi);
+
+  /* binary search over the entries, which are kept sorted increasingly by theta (and hence
+   * decreasingly by phi) */
+  bool contains(const double& theta, const double& phi) const;
+
+  inline size_t size() const { return entries.size(); }
+  /* the i-th entry, in the order of increasing theta */
+  inline void get_entry(const size_t& i, double& theta, double& phi) const
   {
-    entries.push_front(FilterEntry(theta,phi));
+    assert(i<entries.size());
+    theta = entries[i].theta;
+    phi = entries[i].phi;
   }
-  
-  bool contains(const double& theta, const double& phi) const;
+
+  /* returns true if the filter contains any point with infeasibility @theta, irrespective of its 
+   * objective; this is the case when @theta is above the upper limit given to 'initialize' */
+  inline bool contains_theta(const double& theta) const { return contains(theta, -1e20); }
 
   void print(FILE* file, const char* msg) const;
 private:
@@ -83,7 +96,8 @@ private:
     FilterEntry() : theta(0.), phi(0.) { assert(true); }
 #endif
   };
-  std::list<FilterEntry> entries;
+  //Pareto-minimal (theta,phi) pairs: theta strictly increasing, phi strictly decreasing
+  std::vector<FilterEntry> entries;
 };
 
 }
@@ -49,6 +49,7 @@
 #include "hiopHessianLowRank.hpp"
 #include "hiopLinAlgFactory.hpp"
 #include "hiopVectorPar.hpp"
+#include "hiopProfiler.hpp"
 
 #include "hiop_blasdefs.hpp"
 
@@ -72,45 +73,133 @@ using namespace std;
 #define SIGMA_STRATEGY4 4
 #define SIGMA_CONSTANT  5
 
+#define QN_UPDATE_BFGS        1
+#define QN_UPDATE_DAMPED_BFGS 2
+#define QN_UPDATE_SR1         3
+
 namespace hiop
 {
 
-hiopHessianLowRank::hiopHessianLowRank(hiopNlpDenseConstraints* nlp_, int max_mem_len)
-  : l_max(max_mem_len), l_curr(-1), sigma(1.), sigma0(1.), nlp(nlp_), matrixChanged(false)
+/* Number of positive eigenvalues of a symmetric NxN matrix from its DSYTRF factors (uplo='L', 
+ * Fortran storage), by Sylvester's law of inertia applied to the block diagonal factor; -1 if 
+ * the matrix is singular.
+ */
+static int countPositivePivots(const double* A, int N, const int* ipiv)
 {
-  DhInv = dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
+  int npos=0;
+  for(int k=0; k<N; k++) {
+    if(ipiv[k]>0) {
+      const double d=A[k+k*N];
+      if(0.==d) return -1;
+      if(d>0.) npos++;
+    } else {
+      //2x2 block in rows/columns k and k+1
+      assert(k+1<N);
+      const double a=A[k+k*N], b=A[k+1+k*N], c=A[k+1+(k+1)*N];
+      const double det=a*c-b*b;
+      if(0.==det) return -1;
+      if(det<0.) npos++;
+      else if(a>0.) npos+=2;
+      k++;
+    }
+  }
+  return npos;
+}
+
+/* copies the values of 'src' into 'dest', a Jacobian of the same type and sparsity structure */
+static void copyJacobian(hiopMatrix& dest, const hiopMatrix& src)
+{
+  hiopMatrixDense* dest_de = dynamic_cast<hiopMatrixDense*>(&dest);
+  if(dest_de) {
+    dest_de->copyFrom(dynamic_cast<const hiopMatrixDense&>(src));
+    return;
+  }
+  hiopMatrixMDS* dest_mds = dynamic_cast<hiopMatrixMDS*>(&dest);
+  if(dest_mds) {
+    dest_mds->copyFrom(dynamic_cast<const hiopMatrixMDS&>(src));
+    return;
+  }
+  hiopMatrixSparse* dest_sp = dynamic_cast<hiopMatrixSparse*>(&dest);
+  if(dest_sp) {
+    dest_sp->copyFrom(dynamic_cast<const hiopMatrixSparse&>(src));
+    return;
+  }
+  assert(false && "unsupported Jacobian type");
+}
+
+hiopHessianLowRank::hiopHessianLowRank(hiopNlpFormulation* nlp_, int max_mem_len)
+  : l_max(max_mem_len), l_curr(-1), l_oldest(0), sigma(1.), sigma0(1.), update_type(QN_UPDATE_BFGS),
+    nlp(nlp_), matrixChanged(false), _V_npos(0), _M_npos(0)
+{
+  string hess_type = nlp->options->GetString("Hessian");
+  if(hess_type=="quasinewton_damped_bfgs")
+    update_type=QN_UPDATE_DAMPED_BFGS;
+  else if(hess_type=="quasinewton_lsr1")
+    update_type=QN_UPDATE_SR1;
+
+  //the solves with Hk are used only with the dense formulation; the other formulations use the
+  //Sherman-Morrison-Woodbury interface, which needs the middle matrix for all updates
+  const bool dense_nlp = NULL!=dynamic_cast<hiopNlpDenseConstraints*>(nlp);
+
+  DhInv = nlp->alloc_primal_vec();
+  //St and Yt have room for l_max rows; they are used as circular buffers
   St = nlp->alloc_multivector_primal(0,l_max);
   Yt = St->alloc_clone(); //faster than nlp->alloc_multivector_primal(...);
-  //these are local
-  L  = LinearAlgebraFactory::createMatrixDense(0,0);
-  D  = LinearAlgebraFactory::createVector(0);
-  V  = LinearAlgebraFactory::createMatrixDense(0,0);
+  //these are local and have the max memory size
+  L  = LinearAlgebraFactory::createMatrixDense(l_max,l_max);
+  D  = LinearAlgebraFactory::createVector(l_max);
+  if(l_max>0) {
+    L->setToZero();
+    D->setToZero();
+  }
+  V  = new double[4*l_max*l_max];
+  //S'*S and the middle matrix are only needed to compute B*s_new in the damped BFGS and SR1 updates
+  StS = NULL; _Mmid = NULL; _Mmid_ipiv = NULL;
+  if(QN_UPDATE_BFGS!=update_type || !dense_nlp) {
+    StS = LinearAlgebraFactory::createMatrixDense(l_max,l_max);
+    if(l_max>0) StS->setToZero();
+    _Mmid = new double[4*l_max*l_max];
+    _Mmid_ipiv = new int[2*l_max];
+  }
 
   //the previous iteration's objects are set to NULL
   _it_prev=NULL; _grad_f_prev=NULL; _Jac_c_prev=NULL; _Jac_d_prev=NULL;
 
   //internal buffers for memory pool (none of them should be in n)
-#ifdef HIOP_USE_MPI
-  _buff_kxk    = new double[nlp->m() * nlp->m()];
-  _buff_2lxk   = new double[nlp->m() * 2*l_max];
+  const long long k = dense_nlp ? nlp->m() : 2*l_max;
   _buff1_lxlx3 = new double[3*l_max*l_max];
+  _buff1_2l    = new double[2*l_max];
+#ifdef HIOP_USE_MPI
+  //[S1 Y1] and the kxk W are reduced together, see symMatTimesInverseTimesMatTrans
+  _buff1_kx2l  = new double[k*2*l_max + k*k];
+  _buff2_kx2l  = new double[k*2*l_max + k*k];
   _buff2_lxlx3 = new double[3*l_max*l_max];
+  _buff2_2l    = new double[2*l_max];
 #else
+  _buff1_kx2l  = new double[k*2*l_max];
+  _buff2_kx2l  = new double[k*2*l_max];
    //not needed in non-MPI mode
-  _buff_kxk  = NULL;
-  _buff_2lxk = NULL;
-  _buff1_lxlx3 = _buff2_lxlx3 = NULL;
+  _buff2_lxlx3 = NULL;
+  _buff2_2l = NULL;
 #endif
 
   //auxiliary objects/buffers
-  _S1=_Y1=NULL;
-  _lxl_mat1=_kxl_mat1=_kx2l_mat1=NULL;
-  _l_vec1 = _l_vec2 = _2l_vec1 = NULL;
   _n_vec1 = DhInv->alloc_clone();
   _n_vec2 = DhInv->alloc_clone();
-
-  _V_work_vec=LinearAlgebraFactory::createVector(0);
-  _V_ipiv_vec=NULL; _V_ipiv_size=-1;
+  _n_vec3 = QN_UPDATE_SR1==update_type ? DhInv->alloc_clone() : NULL;
+
+  //the factorization workspace is queried once for the largest V
+  _V_ipiv_vec = new int[2*l_max];
+  _V_lwork = 1;
+  if(l_max>0) {
+    char uplo='L';
+    int N=2*l_max, lwork=-1, info;
+    double Vwork_tmp;
+    DSYTRF(&uplo, &N, V, &N, _V_ipiv_vec, &Vwork_tmp, &lwork, &info);
+    assert(info==0);
+    _V_lwork = std::max(1, (int)Vwork_tmp);
+  }
+  _V_work = new double[_V_lwork];
 
   
   sigma0 = nlp->options->GetNumeric("sigma0");
@@ -135,10 +224,11 @@ hiopHessianLowRank::hiopHessianLowRank(hiopNlpDenseConstraints* nlp_, int max_me
   sigma_safe_max=1e+8;
   nlp->log->printf(hovScalars, "Hessian Low Rank: initial sigma is %g\n", sigma);
   nlp->log->printf(hovScalars, "Hessian Low Rank: sigma update strategy is %d [%s]\n", sigma_update_strategy, sigma_strategy.c_str());
+  nlp->log->printf(hovScalars, "Hessian Low Rank: secant update is %d [%s]\n", update_type, hess_type.c_str());
 
 #ifdef HIOP_DEEPCHECKS
   _Dx   = DhInv->alloc_clone();
-  _Vmat = V->alloc_clone();
+  _Vmat = LinearAlgebraFactory::createMatrixDense(0,0);
 #endif
 
 }  
@@ -154,7 +244,10 @@ hiopHessianLowRank::~hiopHessianLowRank()
   if(Yt) delete Yt;
   if(L)  delete L;
   if(D)  delete D;
-  if(V)  delete V;
+  if(V)  delete[] V;
+  if(StS) delete StS;
+  if(_Mmid) delete[] _Mmid;
+  if(_Mmid_ipiv) delete[] _Mmid_ipiv;
 #ifdef HIOP_DEEPCHECKS
   delete _Vmat;
 #endif
@@ -165,34 +258,30 @@ hiopHessianLowRank::~hiopHessianLowRank()
   if(_Jac_c_prev) delete _Jac_c_prev;
   if(_Jac_d_prev) delete _Jac_d_prev;
 
-  if(_buff_kxk)    delete[] _buff_kxk;
-  if(_buff_2lxk)   delete[] _buff_2lxk;
+  if(_buff1_kx2l)  delete[] _buff1_kx2l;
+  if(_buff2_kx2l)  delete[] _buff2_kx2l;
   if(_buff1_lxlx3) delete[] _buff1_lxlx3;
   if(_buff2_lxlx3) delete[] _buff2_lxlx3;
+  if(_buff1_2l)    delete[] _buff1_2l;
+  if(_buff2_2l)    delete[] _buff2_2l;
 
-  if(_S1) delete _S1;
-  if(_Y1) delete _Y1;
-  if(_lxl_mat1)    delete _lxl_mat1;
-  if(_kxl_mat1)    delete _kxl_mat1; 
-  if(_kx2l_mat1)   delete _kx2l_mat1;
-
-  if(_l_vec1) delete _l_vec1;
-  if(_l_vec2) delete _l_vec2;
   if(_n_vec1) delete _n_vec1;
   if(_n_vec2) delete _n_vec2;
-  if(_2l_vec1) delete _2l_vec1;
+  if(_n_vec3) delete _n_vec3;
   if(_V_ipiv_vec) delete[] _V_ipiv_vec;
-  if(_V_work_vec) delete _V_work_vec;
+  if(_V_work) delete[] _V_work;
 }
 
 
-bool hiopHessianLowRank::updateLogBarrierDiagonal(const hiopVector& Dx)
+bool hiopHessianLowRank::updateLogBarrierDiagonal(const hiopVector& Dx, const double& delta_wx)
 {
-  DhInv->setToConstant(sigma);
+  DhInv->setToConstant(sigma+delta_wx);
   DhInv->axpy(1.0,Dx);
 #ifdef HIOP_DEEPCHECKS
   assert(DhInv->allPositive());
+  //the perturbation is accounted as part of the diagonal in timesVec
   _Dx->copyFrom(Dx);
+  _Dx->addConstant(delta_wx);
 #endif
   DhInv->invert();
   nlp->log->write("hiopHessianLowRank: inverse diag DhInv:", *DhInv, hovMatrices);
@@ -200,6 +289,86 @@ bool hiopHessianLowRank::updateLogBarrierDiagonal(const hiopVector& Dx)
   return true;
 }
 
+void hiopHessianLowRank::save_state(hiopCheckpoint& ckpt) const
+{
+  ckpt.append(l_curr);
+  ckpt.append(sigma);
+  //on the first update only the iterate is saved; before it, nothing is stored
+  if(l_curr<0) {
+    return;
+  }
+  //only the dense formulation is checkpointed
+  assert(dynamic_cast<const hiopMatrixDense*>(_Jac_c_prev) && dynamic_cast<const hiopMatrixDense*>(_Jac_d_prev));
+  ckpt.append(*_it_prev->get_x());
+  ckpt.append(*_grad_f_prev);
+  ckpt.append(*dynamic_cast<const hiopMatrixDense*>(_Jac_c_prev));
+  ckpt.append(*dynamic_cast<const hiopMatrixDense*>(_Jac_d_prev));
+  ckpt.append(l_oldest);
+  ckpt.append(*St);
+  ckpt.append(*Yt);
+  ckpt.append(*L);
+  ckpt.append(*D);
+  if(StS) {
+    ckpt.append(*StS);
+  }
+}
+
+bool hiopHessianLowRank::load_state(hiopCheckpoint& ckpt,
+                                    const hiopIterate& it, const hiopVector& grad_f,
+                                    const hiopMatrix& Jac_c, const hiopMatrix& Jac_d)
+{
+  int l;
+  if(!ckpt.extract(l) || !ckpt.extract(sigma)) {
+    return false;
+  }
+  if(l>l_max) {
+    nlp->log->printf(hovError, "hiopHessianLowRank: checkpoint has %d secant pairs, while the "
+                     "memory length is %d\n", l, l_max);
+    return false;
+  }
+  l_curr = l;
+  l_oldest = 0;
+  matrixChanged = true;
+  if(l_curr<0) {
+    return true;
+  }
+
+  if(NULL==_it_prev)     _it_prev     = it.new_copy();
+  if(NULL==_grad_f_prev) _grad_f_prev = grad_f.new_copy();
+  if(NULL==_Jac_c_prev)  _Jac_c_prev  = Jac_c.new_copy();
+  if(NULL==_Jac_d_prev)  _Jac_d_prev  = Jac_d.new_copy();
+  hiopMatrixDense* Jac_c_prev = dynamic_cast<hiopMatrixDense*>(_Jac_c_prev);
+  hiopMatrixDense* Jac_d_prev = dynamic_cast<hiopMatrixDense*>(_Jac_d_prev);
+  if(NULL==Jac_c_prev || NULL==Jac_d_prev) {
+    nlp->log->printf(hovError, "hiopHessianLowRank: only dense Jacobians can be checkpointed\n");
+    return false;
+  }
+
+  //S and Y have l_curr rows out of l_max; L and D are preallocated with the max memory size
+  delete St;
+  delete Yt;
+  St = nlp->alloc_multivector_primal(l_curr, l_max);
+  Yt = St->alloc_clone();
+
+  if(!ckpt.extract(*_it_prev->get_x()) ||
+     !ckpt.extract(*_grad_f_prev) ||
+     !ckpt.extract(*Jac_c_prev) ||
+     !ckpt.extract(*Jac_d_prev) ||
+     !ckpt.extract(l_oldest)) {
+    return false;
+  }
+  if(l_oldest<0 || (l_oldest>0 && l_oldest>=l_curr)) {
+    nlp->log->printf(hovError, "hiopHessianLowRank: checkpoint has an invalid oldest secant slot %d\n",
+                     l_oldest);
+    return false;
+  }
+  return ckpt.extract(*St) &&
+    ckpt.extract(*Yt) &&
+    ckpt.extract(*L) &&
+    ckpt.extract(*D) &&
+    (NULL==StS || ckpt.extract(*StS));
+}
+
 #ifdef HIOP_DEEPCHECKS
 void hiopHessianLowRank::print(FILE* f, hiopOutVerbosity v, const char* msg) const
 {
@@ -209,7 +378,7 @@ void hiopHessianLowRank::print(FILE* f, hiopOutVerbosity v, const char* msg) con
 #else
   fprintf(f, "Dx is not stored in this class, but it can be computed from Dx=DhInv^(1)-sigma");
 #endif
-  nlp->log->printf(v, "sigma=%22.16f;\n", sigma);
+  nlp->log->printf(v, "sigma=%22.16f; oldest pair in slot %d\n", sigma, l_oldest);
   nlp->log->write("DhInv", *DhInv, v);
   nlp->log->write("S_trans", *St, v);
   nlp->log->write("Y_trans", *Yt, v);
@@ -230,11 +399,12 @@ void hiopHessianLowRank::print(FILE* f, hiopOutVerbosity v, const char* msg) con
 bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& grad_f_curr_,
 				const hiopMatrix& Jac_c_curr_, const hiopMatrix& Jac_d_curr_)
 {
+  HIOP_PROFILE_SCOPE("hess_lowrank_update");
   nlp->runStats.tmSolverInternal.start();
 
-  const hiopVectorPar&   grad_f_curr= dynamic_cast<const hiopVectorPar&>(grad_f_curr_);
-  const hiopMatrixDense& Jac_c_curr = dynamic_cast<const hiopMatrixDense&>(Jac_c_curr_);
-  const hiopMatrixDense& Jac_d_curr = dynamic_cast<const hiopMatrixDense&>(Jac_d_curr_);
+  const hiopVector& grad_f_curr= grad_f_curr_;
+  const hiopMatrix& Jac_c_curr = Jac_c_curr_;
+  const hiopMatrix& Jac_d_curr = Jac_d_curr_;
 
 #ifdef HIOP_DEEPCHECKS
   assert(it_curr.zl->matchesPattern(nlp->get_ixl()));
@@ -267,29 +437,56 @@ bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& gr
       nlp->log->write("hiopHessianLowRank s_new",s_new, hovIteration);
       nlp->log->write("hiopHessianLowRank y_new",y_new, hovIteration);
 #endif
-      if(sTy>s_nrm2*y_nrm2*std::numeric_limits<double>::epsilon()) { //sTy far away from zero
+      //the damped BFGS and SR1 updates need B*s_new, computed from [Y^T*s_new; S^T*s_new]; the 
+      //products are reduced at once and are also used for the new rows of L and S^T*S
+      double *YTs = _buff1_2l, *STs = _buff1_2l+l_curr;
+      bool take_pair;
+      if(NULL!=StS && l_max>0) {
+	matTimesVec_local(YTs, 1.0, *Yt, s_new);
+	matTimesVec_local(STs, 1.0, *St, s_new);
+#ifdef HIOP_USE_MPI
+	int ierr = MPI_Allreduce(_buff1_2l, _buff2_2l, 2*l_curr, MPI_DOUBLE, MPI_SUM, nlp->get_comm());
+	assert(ierr==MPI_SUCCESS);
+	memcpy(_buff1_2l, _buff2_2l, 2*l_curr*sizeof(double));
+#endif
+      }
+      if(QN_UPDATE_SR1==update_type) {
+	take_pair = isSR1PairAcceptable(s_new, y_new, YTs, STs, s_nrm2*s_nrm2, sTy);
+      } else {
+	if(QN_UPDATE_DAMPED_BFGS==update_type) {
+	  dampSecantPair(s_new, y_new, YTs, STs, s_nrm2*s_nrm2, sTy, y_nrm2);
+	}
+	take_pair = sTy>s_nrm2*y_nrm2*std::numeric_limits<double>::epsilon(); //sTy far away from zero
+      }
+      if(take_pair) {
 
 	if(l_max>0) {
-	  //compute the new row in L, update S and Y (either augment them or shift cols and add s_new and y_new)
-	  hiopVector& YTs = new_l_vec1(l_curr);
-	  Yt->timesVec(0.0, YTs, 1.0, s_new);
-	  //update representation
+	  if(NULL==StS) {
+	    //compute the new row in L (in slot order) before S and Y are updated
+	    matTimesVec_local(YTs, 1.0, *Yt, s_new);
+#ifdef HIOP_USE_MPI
+	    int ierr = MPI_Allreduce(YTs, _buff2_2l, l_curr, MPI_DOUBLE, MPI_SUM, nlp->get_comm());
+	    assert(ierr==MPI_SUCCESS);
+	    memcpy(YTs, _buff2_2l, l_curr*sizeof(double));
+#endif
+	  }
+	  //update representation: append s_new and y_new while the memory is not full, otherwise
+	  //overwrite the oldest pair, whose slot becomes the newest one
+	  int slot;
 	  if(l_curr<l_max) {
-	    //just grow/augment the matrices
+	    slot = l_curr;
 	    St->appendRow(s_new);
 	    Yt->appendRow(y_new);
-	    growL(l_curr, l_max, YTs);
-	    growD(l_curr, l_max, sTy);
 	    l_curr++;
 	  } else {
-	    //shift
-	    St->shiftRows(-1);
-	    Yt->shiftRows(-1);
-	    St->replaceRow(l_max-1, s_new);
-	    Yt->replaceRow(l_max-1, y_new);
-	    updateL(YTs,sTy);
-	    updateD(sTy);
-	    l_curr=l_max;
+	    slot = l_oldest;
+	    St->replaceRow(slot, s_new);
+	    Yt->replaceRow(slot, y_new);
+	    l_oldest = (l_oldest+1) % l_max;
+	  }
+	  updateLD(slot, YTs, sTy);
+	  if(StS) {
+	    updateStS(slot, STs, s_nrm2*s_nrm2);
 	  }
 	} //end of l_max>0
 #ifdef HIOP_DEEPCHECKS
@@ -298,30 +495,48 @@ bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& gr
 	nlp->log->write("D", *D, hovMatrices);
 	nlp->log->printf(hovMatrices, "\n");
 #endif
-	//update B0 (i.e., sigma)
-	switch (sigma_update_strategy ) {
-	case SIGMA_STRATEGY1:
-	  sigma=sTy/(s_nrm2*s_nrm2);
-	  break;
-	case SIGMA_STRATEGY2:
-	  sigma=y_nrm2*y_nrm2/sTy;
-	  break;
-	case SIGMA_STRATEGY3:
-	  sigma=sqrt(s_nrm2*s_nrm2 / y_nrm2 / y_nrm2);
-	  break;
-	case SIGMA_STRATEGY4:
-	  sigma=0.5*(sTy/(s_nrm2*s_nrm2)+y_nrm2*y_nrm2/sTy);
-	  break;
-	case SIGMA_CONSTANT:
-	  sigma=sigma0;
-	  break;
-	default:
-	  assert(false && "Option value for sigma_update_strategy was not recognized.");
-	  break;
-	} // else of the switch
-	//safe guard it
-	sigma=fmax(fmin(sigma_safe_max, sigma), sigma_safe_min);
-	nlp->log->printf(hovLinAlgScalars, "hiopHessianLowRank: sigma was updated to %22.16e\n", sigma);
+	//update B0 (i.e., sigma); the SR1 pairs may have negative curvature, in which case sigma is kept
+	const double sigma_prev = sigma;
+	if(QN_UPDATE_SR1!=update_type || sTy>0) {
+	  switch (sigma_update_strategy ) {
+	  case SIGMA_STRATEGY1:
+	    sigma=sTy/(s_nrm2*s_nrm2);
+	    break;
+	  case SIGMA_STRATEGY2:
+	    sigma=y_nrm2*y_nrm2/sTy;
+	    break;
+	  case SIGMA_STRATEGY3:
+	    sigma=sqrt(s_nrm2*s_nrm2 / y_nrm2 / y_nrm2);
+	    break;
+	  case SIGMA_STRATEGY4:
+	    sigma=0.5*(sTy/(s_nrm2*s_nrm2)+y_nrm2*y_nrm2/sTy);
+	    break;
+	  case SIGMA_CONSTANT:
+	    sigma=sigma0;
+	    break;
+	  default:
+	    assert(false && "Option value for sigma_update_strategy was not recognized.");
+	    break;
+	  } // else of the switch
+	  //safe guard it
+	  sigma=fmax(fmin(sigma_safe_max, sigma), sigma_safe_min);
+	  nlp->log->printf(hovLinAlgScalars, "hiopHessianLowRank: sigma was updated to %22.16e\n", sigma);
+	}
+	//M depends on sigma: the new sigma may make M singular (for example, when y=sigma*s), in which 
+	//case the previous sigma, for which the new pair was accepted, is used. A singular M invalidates
+	//the SR1 representation, in which case the memory is restarted
+	if(QN_UPDATE_SR1==update_type && l_curr>0 && !factorizeMiddleMatrix()) {
+	  sigma = sigma_prev;
+	  if(!factorizeMiddleMatrix()) {
+	    nlp->log->printf(hovWarning, "hiopHessianLowRank: the SR1 middle matrix is singular... "
+			     "dropping the %d secant pairs\n", l_curr);
+	    resetMemory();
+	  } else {
+	    nlp->log->printf(hovLinAlgScalars, "hiopHessianLowRank: sigma was kept at %22.16e\n", sigma);
+	  }
+	}
+      } else if(QN_UPDATE_SR1==update_type) {
+	nlp->log->printf(hovLinAlgScalars, "hiopHessianLowRank: SR1 denominator too small... skipping the Hessian update\n");
       } else { //sTy is too small or negative -> skip
 	 nlp->log->printf(hovLinAlgScalars, "hiopHessianLowRank: s^T*y=%12.6e not positive enough... skipping the Hessian update\n", sTy);
       }
@@ -331,7 +546,7 @@ bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& gr
 
     //save this stuff for next update
     _it_prev->copyFrom(it_curr);  _grad_f_prev->copyFrom(grad_f_curr); 
-    _Jac_c_prev->copyFrom(Jac_c_curr); _Jac_d_prev->copyFrom(Jac_d_curr);
+    copyJacobian(*_Jac_c_prev, Jac_c_curr); copyJacobian(*_Jac_d_prev, Jac_d_curr);
     nlp->log->printf(hovLinAlgScalarsVerb, "hiopHessianLowRank: storing the iteration info as 'previous'\n", s_infnorm);
 
   } else {
@@ -358,76 +573,79 @@ bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& gr
  *  V =  [S'*B0*(DhInv*B0-I)*S    -L+S'*B0*DhInv*Y ]
  *       [-L'+Y'*Dhinv*B0*S       +D+Y'*Dhinv*Y    ]
  * In this function V is factorized and it will hold the factors at the end of the function
- * Note that L, D, S, and Y are from the BFGS secant representation and are updated/computed in 'update'
+ * Note that L, D, S, and Y are from the BFGS secant representation and are updated/computed in 'update'.
+ * All of them are in slot order, hence so is V.
  */
 void hiopHessianLowRank::updateInternalBFGSRepresentation()
 {
-  long long n=St->n(), l=St->m();
+  long long n=St->n();
+  const int l=St->m(), ll=l*l, ldv=2*l;
 
-  //grow L,D, andV if needed
-  if(L->m()!=l) { delete L; L=LinearAlgebraFactory::createMatrixDense(l,l);}
-  if(D->get_size()!=l) { delete D; D=LinearAlgebraFactory::createVector(l); }
-  if(V->m()!=2*l) {delete V; V=LinearAlgebraFactory::createMatrixDense(2*l,2*l); }
+  //the three lxl blocks Y'*DhInv*Y, S'*B0*DhInv*Y, and S'*B0*(DhInv*B0-I)*S are computed
+  //in one buffer and reduced together
+  double* blocks = _buff1_lxlx3;
 
   //-- block (2,2)
-  hiopMatrixDense& DpYtDhInvY = new_lxl_mat1(l);
-  symmMatTimesDiagTimesMatTrans_local(0.0, DpYtDhInvY, 1.0,*Yt,*DhInv);
-#ifdef HIOP_USE_MPI
-  const size_t buffsize=l*l*sizeof(double);
-  memcpy(_buff1_lxlx3, DpYtDhInvY.local_data(), buffsize);
-#else
-  DpYtDhInvY.addDiagonal(1., *D);
-  V->copyBlockFromMatrix(l,l,DpYtDhInvY);
-#endif
+  symmMatTimesDiagTimesMatTrans_local(0.0, blocks, l, 1.0, *Yt, *DhInv);
 
   //-- block (1,2)
-  hiopMatrixDense& StB0DhInvYmL = DpYtDhInvY; //just a rename
   hiopVector& B0DhInv = new_n_vec1(n);
   B0DhInv.copyFrom(*DhInv); B0DhInv.scale(sigma);
-  matTimesDiagTimesMatTrans_local(StB0DhInvYmL, *St, B0DhInv, *Yt);
-#ifdef HIOP_USE_MPI
-  memcpy(_buff1_lxlx3+l*l, StB0DhInvYmL.local_data(), buffsize);
-#else
-  //substract L
-  StB0DhInvYmL.addMatrix(-1.0, *L);
-  // (1,2) block in V
-  V->copyBlockFromMatrix(0,l,StB0DhInvYmL);
-#endif
+  matTimesDiagTimesMatTrans_local(blocks+ll, l, *St, B0DhInv, *Yt);
 
-  //-- block (2,2)
+  //-- block (1,1)
   hiopVector& theDiag = B0DhInv; //just a rename, also reuses values
-  theDiag.addConstant(-1.0); //at this point theDiag=DhInv*B0-I
+  //for SR1, the -S'*B0*S term is part of M and this block is S'*B0*DhInv*B0*S
+  if(QN_UPDATE_SR1!=update_type) theDiag.addConstant(-1.0); //at this point theDiag=DhInv*B0-I
   theDiag.scale(sigma);
-  hiopMatrixDense& StDS = DpYtDhInvY; //a rename
-  symmMatTimesDiagTimesMatTrans_local(0.0, StDS, 1.0, *St, theDiag);
-#ifdef HIOP_USE_MPI
-  memcpy(_buff1_lxlx3+2*l*l, DpYtDhInvY.local_data(), buffsize);
-#else
-  V->copyBlockFromMatrix(0,0,StDS);
-#endif
-
+  symmMatTimesDiagTimesMatTrans_local(0.0, blocks+2*ll, l, 1.0, *St, theDiag);
 
 #ifdef HIOP_USE_MPI
   int ierr;
-  ierr = MPI_Allreduce(_buff1_lxlx3, _buff2_lxlx3, 3*l*l, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
-
-  // - block (2,2)
-  DpYtDhInvY.copyFrom(_buff2_lxlx3);
-  DpYtDhInvY.addDiagonal(1., *D);
-  V->copyBlockFromMatrix(l,l,DpYtDhInvY);
-
-  // - block (1,2)
-  StB0DhInvYmL.copyFrom(_buff2_lxlx3+l*l);
-  StB0DhInvYmL.addMatrix(-1.0, *L);
-  V->copyBlockFromMatrix(0,l,StB0DhInvYmL);
+  ierr = MPI_Allreduce(_buff1_lxlx3, _buff2_lxlx3, 3*ll, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
+  blocks = _buff2_lxlx3;
+#endif
 
-  // - block (1,1)
-  StDS.copyFrom(_buff2_lxlx3+2*l*l);
-  V->copyBlockFromMatrix(0,0,StDS);
+  //assemble the upper triangle of V (the lower triangle in Fortran) and add D and -L
+  const double* L_mat = L->local_data_const();
+  const double* D_vec = D->local_data_const();
+  if(QN_UPDATE_SR1==update_type) {
+    //for SR1, V=M+Psi'*DhInv*Psi is lxl, with M=D+L+L'-S'*B0*S and Psi=Y-B0*S, namely
+    // V = M + S'*B0*DhInv*B0*S + Y'*DhInv*Y - S'*B0*DhInv*Y - Y'*DhInv*B0*S
+    //M is added with the same entries as in factorizeMiddleMatrix, so that the two inertias, 
+    //whose difference is the inertia of the Hessian, are consistent when V is close to M
+    for(int i=0; i<l; i++) {
+      for(int j=i; j<l; j++) {
+	V[i*l+j] = middleSR1Entry(i,j) +
+	  (blocks[2*ll+i*l+j] + blocks[i*l+j] - blocks[ll+i*l+j] - blocks[ll+j*l+i]);
+      }
+    }
+#ifdef HIOP_DEEPCHECKS
+    delete _Vmat;
+    _Vmat = LinearAlgebraFactory::createMatrixDense(l,l);
+    _Vmat->copyFrom(V);
+    _Vmat->overwriteLowerTriangleWithUpper();
 #endif
+    factorizeV();
+    //the inertia of Dk+Bk is obtained from the inertia of V and M
+    _M_npos = factorizeMiddleMatrix() ? countPositivePivots(_Mmid, l, _Mmid_ipiv) : -1;
+    matrixChanged=false;
+    return;
+  }
+  for(int i=0; i<l; i++) {
+    for(int j=i; j<l; j++) {
+      V[i*ldv+j]       = blocks[2*ll+i*l+j];
+      V[(l+i)*ldv+l+j] = blocks[i*l+j];
+    }
+    V[(l+i)*ldv+l+i] += D_vec[i];
+    for(int j=0; j<l; j++) {
+      V[i*ldv+l+j] = blocks[ll+i*l+j] - L_mat[i*l_max+j];
+    }
+  }
 #ifdef HIOP_DEEPCHECKS
   delete _Vmat;
-  _Vmat = V->new_copy();
+  _Vmat = LinearAlgebraFactory::createMatrixDense(ldv,ldv);
+  _Vmat->copyFrom(V);
   _Vmat->overwriteLowerTriangleWithUpper();
 #endif
 
@@ -464,26 +682,30 @@ void hiopHessianLowRank::solve(const hiopVector& rhs_, hiopVector& x_)
   x.copyFrom(rhsx);
   x.componentMult(*DhInv);
 
-  //2. stx= S^T*B0*DhInv*res and ytx=Y^T*DhInv*res
-  hiopVector&stx=new_l_vec1(l), &ytx=new_l_vec2(l);
-  stx.setToZero(); ytx.setToZero();
-  Yt->timesVec(0.0,ytx,1.0,x);
+  //2. [stx;ytx] = [S^T*B0*DhInv*res; Y^T*DhInv*res]
+  double* stytx = _buff1_2l;
+  matTimesVec_local(stytx+l, 1.0, *Yt, x);
 
   hiopVector& B0DhInvx = new_n_vec1(n);
   B0DhInvx.copyFrom(x); //it contains DhInv*res
   B0DhInvx.scale(sigma); //B0*(DhInv*res) 
-  St->timesVec(0.0,stx,1.0,B0DhInvx);
+  matTimesVec_local(stytx, 1.0, *St, B0DhInvx);
+#ifdef HIOP_USE_MPI
+  int ierr = MPI_Allreduce(_buff1_2l, _buff2_2l, 2*l, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); 
+  assert(ierr==MPI_SUCCESS);
+  memcpy(_buff1_2l, _buff2_2l, 2*l*sizeof(double));
+#endif
 
   //3. solve with V
-  hiopVector& spart=stx; hiopVector& ypart=ytx;
-  solveWithV(spart,ypart);
+  solveWithV(stytx, 1);
+  const double *spart=stytx, *ypart=stytx+l;
 
   //4. multiply with  DhInv*[B0*S Y], namely
   // result = DhInv*(B0*S*spart + Y*ypart)
   hiopVector&  result = new_n_vec1(n);
-  St->transTimesVec(0.0, result, 1.0, spart);
+  transMatTimesVec_local(0.0, result, 1.0, *St, spart);
   result.scale(sigma);
-  Yt->transTimesVec(1.0, result, 1.0, ypart);
+  transMatTimesVec_local(1.0, result, 1.0, *Yt, ypart);
   result.componentMult(*DhInv);
 
   //5. x = first term - second term = x_computed_in_1 - result 
@@ -507,73 +729,66 @@ symMatTimesInverseTimesMatTrans(double beta, hiopMatrixDense& W,
 {
   if(matrixChanged) updateInternalBFGSRepresentation();
 
-  long long n=St->n(), l=St->m();
-  long long k=W.m(); 
+  long long n=St->n();
+  int l=St->m(), k=W.m(); 
   assert(X.m()==k);
   assert(X.n()==n);
+  assert(k<=nlp->m());
 
 #ifdef HIOP_DEEPCHECKS
    nlp->log->write("symMatTimesInverseTimesMatTrans: X is: ", X, hovMatrices);
 #endif 
 
-  //1. compute W=beta*W + alpha*X*DhInv*X'
+  //1. compute [S1 Y1] = [X*DhInv*B0*S  X*DhInv*Y], kx2l row-major
+  double *S1Y1=_buff1_kx2l, *S2Y2=_buff2_kx2l;
+  hiopVector& B0DhInv = new_n_vec1(n);
+  B0DhInv.copyFrom(*DhInv); B0DhInv.scale(sigma);
+  matTimesDiagTimesMatTrans_local(S1Y1,   2*l, X, B0DhInv, *St);
+  matTimesDiagTimesMatTrans_local(S1Y1+l, 2*l, X, *DhInv,  *Yt);
+
+  //2. compute W=beta*W + alpha*X*DhInv*X'
 #ifdef HIOP_USE_MPI
-  if(0==nlp->get_rank())
-    symmMatTimesDiagTimesMatTrans_local(beta,W,alpha,X,*DhInv);
-  else
-    symmMatTimesDiagTimesMatTrans_local(0.0, W,alpha,X,*DhInv);
-  //W will be MPI_All_reduced later
+  //the local X*DhInv*X' is placed right after [S1 Y1] so that both are reduced by a single
+  //collective; all the work after the reduction needs the reduced S1 and Y1, hence there is no 
+  //local work left to overlap with a non-blocking reduction
+  double* XDXt = S1Y1+2*l*k;
+  symmMatTimesDiagTimesMatTrans_local(0.0, XDXt, k, alpha, X, *DhInv);
 #else
-  symmMatTimesDiagTimesMatTrans_local(beta,W,alpha,X,*DhInv);
+  symmMatTimesDiagTimesMatTrans_local(beta, W.local_data(), k, alpha, X, *DhInv);
 #endif
-  //2. compute S1=X*DhInv*B0*S and Y1=X*DhInv*Y
-  hiopMatrixDense &S1=new_S1(X,*St), &Y1=new_Y1(X,*Yt); //both are kxl
-  hiopVector& B0DhInv = new_n_vec1(n);
-  B0DhInv.copyFrom(*DhInv); B0DhInv.scale(sigma);
-  matTimesDiagTimesMatTrans_local(S1, X, B0DhInv, *St);
-  matTimesDiagTimesMatTrans_local(Y1, X, *DhInv,  *Yt);
 
-  //3. reduce W, S1, and Y1 (dimensions: kxk, kxl, kxl)
-  hiopMatrixDense& S2Y2 = new_kx2l_mat1(k,l);  //Initialy S2Y2 = [Y1 S1]
-  S2Y2.copyBlockFromMatrix(0,0,S1);
-  S2Y2.copyBlockFromMatrix(0,l,Y1);
+  //3. reduce W, S1, and Y1 (dimensions: kxk, kxl, kxl); S2Y2 gets a copy of [S1 Y1]
 #ifdef HIOP_USE_MPI
   int ierr;
-  ierr = MPI_Allreduce(S2Y2.local_data(), _buff_2lxk, 2*l*k, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
-  ierr = MPI_Allreduce(W.local_data(),    _buff_kxk,  k*k,   MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
-  S2Y2.copyFrom(_buff_2lxk);
-  W.copyFrom(_buff_kxk);
-  //also copy S1 and Y1
-  S1.copyFromMatrixBlock(S2Y2, 0,0);
-  Y1.copyFromMatrixBlock(S2Y2, 0,l);
+  ierr = MPI_Allreduce(S1Y1, S2Y2, 2*l*k+k*k, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
+  memcpy(S1Y1, S2Y2, 2*l*k*sizeof(double));
+  //W = beta*W + reduced alpha*X*DhInv*X'
+  double* Wdata = W.local_data();
+  const double* XDXt_red = S2Y2+2*l*k;
+  for(int i=0; i<k*k; i++) {
+    Wdata[i] = (0.0==beta ? 0.0 : beta*Wdata[i]) + XDXt_red[i];
+  }
+#else
+  memcpy(S2Y2, S1Y1, 2*l*k*sizeof(double));
 #endif
 #ifdef HIOP_DEEPCHECKS
   nlp->log->write("symMatTimesInverseTimesMatTrans: W first term is: ", W, hovMatrices);
 #endif 
+  if(0==l || 0==k) return;
+
   //4. [S2] = V \ [S1^T]
   //   [Y2]       [Y1^T]
   //S2Y2 is exactly [S1^T] when Fortran Lapack looks at it
   //                [Y1^T]
-  hiopMatrixDense& RHS_fortran = S2Y2; 
-  solveWithV(RHS_fortran);
+  solveWithV(S2Y2, k);
 
   //5. W = W-alpha*[S1 Y1]*[S2^T] 
   //                       [Y2^T]
-  S2Y2 = RHS_fortran;
-  alpha = 0-alpha;
-  hiopMatrixDense& S2=new_kxl_mat1(k,l);
-  S2.copyFromMatrixBlock(S2Y2, 0, 0);
-  S1.timesMatTrans_local(1.0, W, alpha, S2);
-
-  hiopMatrixDense& Y2=S2;
-  Y2.copyFromMatrixBlock(S2Y2, 0, l);
-  Y1.timesMatTrans_local(1.0, W, alpha, Y2);
-
-  //nlp->log->write("symMatTimesInverseTimesMatTrans: Y1 is : ", Y1, hovMatrices);
-  //nlp->log->write("symMatTimesInverseTimesMatTrans: Y2 is : ", Y2, hovMatrices);
-  //nlp->log->write("symMatTimesInverseTimesMatTrans: W is : ", W, hovMatrices);
-
-  //we're done here
+  //in Fortran's column-major view this is W^T = W^T - alpha*[S2^T Y2^T]^T*[S1^T Y1^T]
+  char transA='T', transB='N';
+  int K=2*l;
+  double minus_alpha=-alpha, one=1.0;
+  DGEMM(&transA, &transB, &k, &k, &K, &minus_alpha, S2Y2, &K, S1Y1, &K, &one, W.local_data(), &k);
 
 #ifdef HIOP_DEEPCHECKS
   nlp->log->write("symMatTimesInverseTimesMatTrans: final matrix is : ", W, hovMatrices);
@@ -584,323 +799,460 @@ symMatTimesInverseTimesMatTrans(double beta, hiopMatrixDense& W,
 
 void hiopHessianLowRank::factorizeV()
 {
-  int N=V->n(), lda=N, info;
+  int N = QN_UPDATE_SR1==update_type ? St->m() : 2*St->m();
+  int lda=N, info;
+  _V_npos = 0;
   if(N==0) return;
 
 #ifdef HIOP_DEEPCHECKS
-    nlp->log->write("factorizeV:  V is ", *V, hovMatrices);
+    nlp->log->write("factorizeV:  V is ", *_Vmat, hovMatrices);
 #endif
 
   char uplo='L'; //V is upper in C++ so it's lower in fortran
 
-  if(_V_ipiv_vec==NULL) _V_ipiv_vec=new int[N];
-  else if(_V_ipiv_size!=N) { delete[] _V_ipiv_vec; _V_ipiv_vec=new int[N]; _V_ipiv_size=N; }
-
-  int lwork=-1;//inquire sizes
-  double Vwork_tmp;
-  DSYTRF(&uplo, &N, V->local_data(), &lda, _V_ipiv_vec, &Vwork_tmp, &lwork, &info);
-  assert(info==0);
-
-  lwork=(int)Vwork_tmp;
-  if(lwork != _V_work_vec->get_size()) {
-    if(_V_work_vec!=NULL) delete _V_work_vec;  
-    _V_work_vec=LinearAlgebraFactory::createVector(lwork);
-  } else assert(_V_work_vec);
-
-  DSYTRF(&uplo, &N, V->local_data(), &lda, _V_ipiv_vec, _V_work_vec->local_data(), &lwork, &info);
+  //the workspace and pivots were allocated for the max memory size in the constructor
+  assert(N<=2*l_max);
+  DSYTRF(&uplo, &N, V, &lda, _V_ipiv_vec, _V_work, &_V_lwork, &info);
   
   if(info<0)
     nlp->log->printf(hovError, "hiopHessianLowRank::factorizeV error: %d argument to dsytrf has an illegal value\n", -info);
-  else if(info>0)
+  else if(info>0 && QN_UPDATE_SR1==update_type) {
+    //Dk+Bk is singular; reported by num_neg_eigenvalues so that the Hessian is perturbed
+    nlp->log->printf(hovWarning, "hiopHessianLowRank::factorizeV: V is singular (zero pivot %d)\n", info);
+  } else if(info>0)
     nlp->log->printf(hovError, "hiopHessianLowRank::factorizeV error: %d entry in the factorization's diagonal is exactly zero. Division by zero will occur if it a solve is attempted.\n", info);
-  assert(info==0);
-#ifdef HIOP_DEEPCHECKS
-  nlp->log->write("factorizeV:  factors of V: ", *V, hovMatrices);
-#endif
+  assert(info==0 || (info>0 && QN_UPDATE_SR1==update_type));
+  if(QN_UPDATE_SR1==update_type) {
+    _V_npos = 0==info ? countPositivePivots(V, N, _V_ipiv_vec) : -1;
+  }
+}
 
+bool hiopHessianLowRank::may_be_indefinite() const
+{
+  return QN_UPDATE_SR1==update_type;
 }
 
-void hiopHessianLowRank::solveWithV(hiopVector& rhs_s, hiopVector& rhs_y)
+/* For SR1, Dk+Bk = Dh + Psi*M^{-1}*Psi', with Dh=Dk+B0 positive definite. By Haynsworth's inertia 
+ * additivity applied to the two Schur complements of [Dh Psi; Psi' -M], the number of negative 
+ * eigenvalues of Dk+Bk is n_pos(V)-n_pos(M), where V=M+Psi'*Dh^{-1}*Psi.
+ */
+int hiopHessianLowRank::num_neg_eigenvalues()
 {
-  int N=V->n();
-  if(N==0) return;
+  if(QN_UPDATE_SR1!=update_type) return 0;
+  if(matrixChanged) updateInternalBFGSRepresentation();
+  if(_V_npos<0 || _M_npos<0) return -1;
+  return _V_npos-_M_npos;
+}
 
-  int l=rhs_s.get_size();
+int hiopHessianLowRank::compact_rank() const
+{
+  return QN_UPDATE_SR1==update_type ? St->m() : 2*St->m();
+}
 
-#ifdef HIOP_DEEPCHECKS
-  nlp->log->write("hiopHessianLowRank::solveWithV: RHS IN 's' part: ", rhs_s, hovMatrices);
-  nlp->log->write("hiopHessianLowRank::solveWithV: RHS IN 'y' part: ", rhs_y, hovMatrices);
-  hiopVector* rhs_saved= LinearAlgebraFactory::createVector(rhs_s.get_size()+rhs_y.get_size());
-  rhs_saved->copyFromStarting(0, rhs_s);
-  rhs_saved->copyFromStarting(l, rhs_y);
-#endif
+/* U(:,j) is B0*s_j (j<l) or y_{j-l} (j>=l) for BFGS and psi_j=y_j-B0*s_j for SR1; j is in slot order */
+void hiopHessianLowRank::compact_column(const int& j, hiopVector& u)
+{
+  const int l=St->m();
+  assert(j>=0 && j<compact_rank());
+  if(QN_UPDATE_SR1==update_type) {
+    Yt->getRow(j, u);
+    St->getRow(j, *_n_vec1);
+    u.axpy(-sigma, *_n_vec1);
+  } else if(j<l) {
+    St->getRow(j, u);
+    u.scale(sigma);
+  } else {
+    Yt->getRow(j-l, u);
+  }
+}
 
-  int lda=N, one=1, info;
-  char uplo='L'; 
-#ifdef HIOP_DEEPCHECKS
-  assert(N==rhs_s.get_size()+rhs_y.get_size());
+/* C = W^{-1} + U'*Z is formed in V (rxr) and factorized in place. The entries of W^{-1} are
+ *  -N = [-S'*B0*S  -L]  for BFGS  and  M = D+L+L'-S'*B0*S  for SR1,
+ *       [   -L'     D] 
+ * while U'*Z is computed from S'*Z and Y'*Z and symmetrized. The inertia of W^{-1} is obtained 
+ * from the factorization of the middle matrix.
+ */
+bool hiopHessianLowRank::factorizeCapacitance(const hiopMatrixDense& Zt, int& n_neg_shift)
+{
+  int l=St->m(), r=compact_rank();
+  assert(Zt.m()==r);
+  n_neg_shift=0;
+  if(0==r) return true;
+
+  if(!factorizeMiddleMatrix()) {
+    nlp->log->printf(hovWarning, "hiopHessianLowRank: singular middle matrix of the compact representation\n");
+    return false;
+  }
+  int npos_Winv = countPositivePivots(_Mmid, r, _Mmid_ipiv);
+  if(npos_Winv<0) return false;
+  if(QN_UPDATE_SR1!=update_type) npos_Winv = r-npos_Winv;
+
+  //S'*Z and Y'*Z, both lxr column-major (Fortran), are computed in one buffer and reduced together
+  double *SZ=_buff1_kx2l, *YZ=_buff1_kx2l+l*r;
+  int n_local=St->get_local_size_n();
+  assert(Zt.get_local_size_n()==n_local);
+  if(n_local>0) {
+    char transA='T', transB='N';
+    double one=1., zero=0.;
+    DGEMM(&transA, &transB, &l, &r, &n_local, &one, St->local_data_const(), &n_local, 
+	  Zt.local_data_const(), &n_local, &zero, SZ, &l);
+    DGEMM(&transA, &transB, &l, &r, &n_local, &one, Yt->local_data_const(), &n_local, 
+	  Zt.local_data_const(), &n_local, &zero, YZ, &l);
+  } else {
+    for(int i=0; i<2*l*r; i++) _buff1_kx2l[i]=0.;
+  }
+#ifdef HIOP_USE_MPI
+  int ierr = MPI_Allreduce(_buff1_kx2l, _buff2_kx2l, 2*l*r, MPI_DOUBLE, MPI_SUM, nlp->get_comm());
+  assert(ierr==MPI_SUCCESS);
+  memcpy(_buff1_kx2l, _buff2_kx2l, 2*l*r*sizeof(double));
 #endif
-  hiopVector& rhs=new_2l_vec1(l);
-  rhs.copyFromStarting(0, rhs_s);
-  rhs.copyFromStarting(l, rhs_y);
-
-  DSYTRS(&uplo, &N, &one, V->local_data(), &lda, _V_ipiv_vec, rhs.local_data(), &N, &info);
-
-  if(info<0) nlp->log->printf(hovError, "hiopHessianLowRank::solveWithV error: %d argument to dsytrf has an illegal value\n", -info);
-  assert(info==0);
+  //(U'*Z)_{ij}=u_i'*z_j
+  auto UtZ = [&](const int& i, const int& j) -> double {
+    if(QN_UPDATE_SR1==update_type) return YZ[i+j*l]-sigma*SZ[i+j*l];
+    return i<l ? sigma*SZ[i+j*l] : YZ[i-l+j*l];
+  };
+  const double* L_mat=L->local_data_const();
+  const double* D_vec=D->local_data_const();
+  const double* StS_mat=StS->local_data_const();
+  //only the upper triangle (lower in Fortran) is formed
+  for(int i=0; i<r; i++) {
+    for(int j=i; j<r; j++) {
+      double w;
+      if(QN_UPDATE_SR1==update_type) {
+	w = middleSR1Entry(i,j);
+      } else if(j<l) {
+	w = -sigma*StS_mat[i*l_max+j];
+      } else if(i<l) {
+	w = -L_mat[i*l_max+j-l];
+      } else {
+	w = i==j ? D_vec[i-l] : 0.;
+      }
+      V[i*r+j] = w + 0.5*(UtZ(i,j)+UtZ(j,i));
+    }
+  }
 
-  //copy back the solution
-  rhs.copyToStarting(0,rhs_s);
-  rhs.copyToStarting(l,rhs_y);
+  char uplo='L';
+  int info;
+  DSYTRF(&uplo, &r, V, &r, _V_ipiv_vec, _V_work, &_V_lwork, &info);
+  if(info<0) {
+    nlp->log->printf(hovError, "hiopHessianLowRank::factorizeCapacitance error: %d argument to dsytrf has an illegal value\n", -info);
+    return false;
+  }
+  const int npos_C = 0==info ? countPositivePivots(V, r, _V_ipiv_vec) : -1;
+  if(npos_C<0) {
+    nlp->log->printf(hovWarning, "hiopHessianLowRank: singular capacitance matrix\n");
+    return false;
+  }
+  n_neg_shift = npos_C-npos_Winv;
+  return true;
+}
 
-#ifdef HIOP_DEEPCHECKS
-  nlp->log->write("solveWithV: SOL OUT 's' part: ", rhs_s, hovMatrices);
-  nlp->log->write("solveWithV: SOL OUT 'y' part: ", rhs_y, hovMatrices);
-
-  //residual calculation
-  double nrmrhs=rhs_saved->infnorm();
-  _Vmat->timesVec(1.0, *rhs_saved, -1.0, rhs);
-  double nrmres=rhs_saved->infnorm();
-  //nlp->log->printf(hovLinAlgScalars, "hiopHessianLowRank::solveWithV 1rhs: rel resid norm=%g\n", nrmres/(1+nrmrhs));
-  nlp->log->printf(hovScalars, "hiopHessianLowRank::solveWithV 1rhs: rel resid norm=%g\n", nrmres/(1+nrmrhs));
-  if(nrmres>1e-8)
-    nlp->log->printf(hovWarning, "hiopHessianLowRank::solveWithV large residual=%g\n", nrmres);
-  delete rhs_saved;
+void hiopHessianLowRank::solveCapacitance(const hiopVector& x, hiopVector& w)
+{
+  int l=St->m(), r=compact_rank();
+  assert(w.get_local_size()==r);
+  if(0==r) return;
+  //U'*x from [Y'*x; S'*x]
+  double *Ytx=_buff1_2l, *Stx=_buff1_2l+l;
+  matTimesVec_local(Ytx, 1.0, *Yt, x);
+  matTimesVec_local(Stx, 1.0, *St, x);
+#ifdef HIOP_USE_MPI
+  int ierr = MPI_Allreduce(_buff1_2l, _buff2_2l, 2*l, MPI_DOUBLE, MPI_SUM, nlp->get_comm());
+  assert(ierr==MPI_SUCCESS);
+  memcpy(_buff1_2l, _buff2_2l, 2*l*sizeof(double));
 #endif
-
+  double* wd=w.local_data();
+  for(int i=0; i<l; i++) {
+    if(QN_UPDATE_SR1==update_type) {
+      wd[i] = Ytx[i]-sigma*Stx[i];
+    } else {
+      wd[i]   = sigma*Stx[i];
+      wd[l+i] = Ytx[i];
+    }
+  }
+  char uplo='L';
+  int one=1, info;
+  DSYTRS(&uplo, &r, &one, V, &r, _V_ipiv_vec, wd, &r, &info);
+  if(info<0) nlp->log->printf(hovError, "hiopHessianLowRank::solveCapacitance error: %d argument to dsytrs has an illegal value\n", -info);
+  assert(info==0);
 }
 
-void hiopHessianLowRank::solveWithV(hiopMatrixDense& rhs)
+void hiopHessianLowRank::solveWithV(double* rhs, int nrhs)
 {
-  int N=V->n();
-  if(0==N) return;
+  const int l=St->m();
+  int N = QN_UPDATE_SR1==update_type ? l : 2*l;
+  if(0==N || 0==nrhs) return;
+  int ldb=2*l;
+
+  //for SR1, the products with U=[B0*S Y] are mapped to products with Psi=Y-B0*S: 
+  //[a;b] is replaced by [-z;z], with z=V^{-1}*(b-a)
+  if(QN_UPDATE_SR1==update_type) {
+    for(int k=0; k<nrhs; k++) {
+      double* ab=rhs+k*ldb;
+      for(int i=0; i<l; i++) ab[i] = ab[l+i]-ab[i];
+    }
+  }
 
 #ifdef HIOP_DEEPCHECKS
-  nlp->log->write("solveWithV: RHS IN: ", rhs, hovMatrices);
-  hiopMatrixDense* rhs_saved = rhs.new_copy();
+  std::vector<double> rhs_saved(rhs, rhs+ldb*nrhs);
 #endif
 
   //rhs is transpose in C++
 
   char uplo='L'; 
-  int lda=N, ldb=N, nrhs=rhs.m(), info;
-#ifdef HIOP_DEEPCHECKS
-  assert(N==rhs.n()); 
-#endif
-  DSYTRS(&uplo, &N, &nrhs, V->local_data(), &lda, _V_ipiv_vec, rhs.local_data(), &ldb, &info);
+  int lda=N, info;
+  DSYTRS(&uplo, &N, &nrhs, V, &lda, _V_ipiv_vec, rhs, &ldb, &info);
 
   if(info<0) nlp->log->printf(hovError, "hiopHessianLowRank::solveWithV error: %d argument to dsytrf has an illegal value\n", -info);
   assert(info==0);
 #ifdef HIOP_DEEPCHECKS
-  nlp->log->write("solveWithV: SOL OUT: ", rhs, hovMatrices);
-  
-  hiopMatrixDense& sol = rhs; //matrix of solutions
   /// TODO: get rid of these uses of specific hiopVector implementation
-  hiopVectorPar x(rhs.n()); //again, keep in mind rhs is transposed
-  hiopVectorPar r(rhs.n());
+  hiopVectorPar x(N);
+  hiopVectorPar r(N);
   double resnorm=0.0;
-  for(int k=0; k<rhs.m(); k++) {
-    rhs_saved->getRow(k, r);
-    sol.getRow(k,x);
-    double nrmrhs=r.infnorm();//nrmrhs=.0;
+  for(int k=0; k<nrhs; k++) {
+    r.copyFrom(rhs_saved.data()+k*ldb);
+    x.copyFrom(rhs+k*ldb);
+    double nrmrhs=r.infnorm();
     _Vmat->timesVec(1.0, r, -1.0, x);
     double nrmres=r.infnorm();
     if(nrmres>1e-8)
-      nlp->log->printf(hovWarning, "hiopHessianLowRank::solveWithV mult-rhs: rhs number %d has large resid norm=%g\n", k, nrmres);
+      nlp->log->printf(hovWarning, "hiopHessianLowRank::solveWithV: rhs number %d has large resid norm=%g\n", k, nrmres);
     if(nrmres/(nrmrhs+1)>resnorm) resnorm=nrmres/(nrmrhs+1);
   }
-  nlp->log->printf(hovLinAlgScalars, "hiopHessianLowRank::solveWithV mult-rhs: rel resid norm=%g\n", resnorm);
-  delete rhs_saved;
+  nlp->log->printf(hovLinAlgScalars, "hiopHessianLowRank::solveWithV %d rhs: rel resid norm=%g\n", nrhs, resnorm);
 #endif
+  if(QN_UPDATE_SR1==update_type) {
+    for(int k=0; k<nrhs; k++) {
+      double* ab=rhs+k*ldb;
+      for(int i=0; i<l; i++) {
+	ab[l+i] = ab[i];
+	ab[i] = -ab[i];
+      }
+    }
+  }
 
 }
 
-void hiopHessianLowRank::growL(const int& lmem_curr, const int& lmem_max, const hiopVector& YTs)
+/* L_{pq} = s_p^T y_q if the pair in slot p is newer than the pair in slot q, otherwise zero. 
+ * Here p,q = 0,1,...,l_curr-1 are slots (rows) in the circular buffers St and Yt. 
+ * The pair in 'slot' is the newest: its row in L is Y^T*s_new, less the entry of the pair it 
+ * replaced, and its column is zero. Only O(l) entries are touched.
+ */
+void hiopHessianLowRank::updateLD(const int& slot, const double* YTs, const double& sTy)
 {
-  int l=L->m();
 #ifdef HIOP_DEEPCHECKS
-  assert(l==L->n());
-  assert(lmem_curr==l);
-  assert(lmem_max>=l);
+  assert(slot>=0 && slot<l_curr);
+  assert(l_curr<=l_max);
 #endif
-  //newL = [   L     0]
-  //       [ Y^T*s   0]
-  hiopMatrixDense* newL = LinearAlgebraFactory::createMatrixDense(l+1,l+1);
-  assert(newL);
-  //copy from L to newL
-  newL->copyBlockFromMatrix(0,0, *L);
-
-  double* newL_mat=newL->local_data(); //doing the rest here
-  const double* YTs_vec=YTs.local_data_const();
-  //for(int j=0; j<l; j++) newL_mat[l][j] = YTs_vec[j];
-  for(int j=0; j<l; j++) newL_mat[l*(l+1)+j] = YTs_vec[j];
-
-  //and the zero entries of the last column
-  //for(int i=0; i<l+1; i++) newL_mat[i][l] = 0.0;
-  for(int i=0; i<l+1; i++) newL_mat[i*(l+1)+l] = 0.0;
+  double* L_mat=L->local_data();
+  for(int q=0; q<l_curr; q++) {
+    if(q==slot) continue;
+    L_mat[slot*l_max+q] = YTs[q];
+    L_mat[q*l_max+slot] = 0.0;
+  }
+  L_mat[slot*l_max+slot] = 0.0;
 
-  //swap the pointers
-  delete L;
-  L=newL;
+  D->local_data()[slot] = sTy;
 }
 
-void hiopHessianLowRank::growD(const int& lmem_curr, const int& lmem_max, const double& sTy)
+/* Same as above for S^T*S, which is symmetric: the row and column of 'slot' are S^T*s_new. */
+void hiopHessianLowRank::updateStS(const int& slot, const double* STs, const double& sTs)
 {
-  int l=D->get_size();
-  assert(l==lmem_curr);
-  assert(lmem_max>=l);
+  double* StS_mat=StS->local_data();
+  for(int q=0; q<l_curr; q++) {
+    if(q==slot) continue;
+    StS_mat[slot*l_max+q] = StS_mat[q*l_max+slot] = STs[q];
+  }
+  StS_mat[slot*l_max+slot] = sTs;
+}
 
-  hiopVector* Dnew=LinearAlgebraFactory::createVector(l+1);
-  double* Dnew_vec=Dnew->local_data();
-  memcpy(Dnew_vec, D->local_data_const(), l*sizeof(double));
-  Dnew_vec[l]=sTy;
+void hiopHessianLowRank::reset()
+{
+  resetMemory();
+  l_curr = -1;
+  sigma = sigma0;
+}
 
-  delete D;
-  D=Dnew;
+void hiopHessianLowRank::resetMemory()
+{
+  delete St;
+  delete Yt;
+  St = nlp->alloc_multivector_primal(0,l_max);
+  Yt = St->alloc_clone();
+  l_curr = 0;
+  l_oldest = 0;
+  if(l_max>0) {
+    L->setToZero();
+    D->setToZero();
+    if(StS) StS->setToZero();
+  }
+  matrixChanged = true;
 }
 
-/* L_{ij} = s_{i-1}^T y_{j-1}, if i>j, otherwise zero. Here i,j = 0,1,...,l_curr-1
- * L_new = lift and shift L to the left; replace last row with [Yts;0]
+/* Forms and factorizes (in _Mmid) the middle matrix of the compact representation of B, 
+ *  N = [S'*B0*S  L]  for damped BFGS (2lx2l)  or  M = D+L+L'-S'*B0*S  for SR1 (lxl)
+ *      [  L'    -D] 
+ * in slot order. Returns false if the matrix is singular. Only local data is involved.
  */
-void hiopHessianLowRank::updateL(const hiopVector& YTs, const double& sTy)
+bool hiopHessianLowRank::factorizeMiddleMatrix()
 {
-  int l=YTs.get_size();
-  assert(l==L->m());
-  assert(l==L->n());
-#ifdef HIOP_DEEPCHECKS
-  assert(l_curr==l);
-  assert(l_curr==l_max);
-#endif
-  const int lm1=l-1;
-  double* L_mat=L->local_data();
-  const double* yts_vec=YTs.local_data_const();
-  for(int i=1; i<lm1; i++) {
-    for(int j=0; j<i; j++) {
-      //L_mat[i][j] = L_mat[i+1][j+1];
-      L_mat[i*l+j] = L_mat[(i+1)*l+j+1];
+  const int l=St->m();
+  if(0==l) return true;
+  assert(_Mmid && StS);
+  const double* L_mat=L->local_data_const();
+  const double* D_vec=D->local_data_const();
+  const double* StS_mat=StS->local_data_const();
+  int N, info;
+  //only the upper triangle (lower in Fortran) is formed
+  if(QN_UPDATE_SR1==update_type) {
+    N=l;
+    for(int i=0; i<l; i++) {
+      for(int j=i; j<l; j++) {
+	_Mmid[i*N+j] = middleSR1Entry(i,j);
+      }
+    }
+  } else {
+    N=2*l;
+    for(int i=0; i<l; i++) {
+      for(int j=i; j<l; j++) {
+	_Mmid[i*N+j] = sigma*StS_mat[i*l_max+j];
+	_Mmid[(l+i)*N+l+j] = 0.;
+      }
+      for(int j=0; j<l; j++) {
+	_Mmid[i*N+l+j] = L_mat[i*l_max+j];
+      }
+      _Mmid[(l+i)*N+l+i] = -D_vec[i];
     }
   }
-      
-
-  //is this really needed?
-  //for(int i=0; i<lm1; i++)
-  //  L_mat[i][lm1]=0.0;
-
-  //first entry in YTs corresponds to y_to_be_discarded_since_it_is_the_oldest'* s_new and is discarded
-  for(int j=0; j<lm1; j++) {
-    //L_mat[lm1][j]=yts_vec[j+1];
-    L_mat[lm1*l+j]=yts_vec[j+1];
-    
-  }
-
-  //L_mat[lm1][lm1]=0.0;
-  L_mat[lm1*l+lm1]=0.0;
-}
-void hiopHessianLowRank::updateD(const double& sTy)
-{
-  int l=D->get_size();
-  double* D_vec = D->local_data();
-  for(int i=0; i<l-1; i++)
-    D_vec[i]=D_vec[i+1];
-  D_vec[l-1]=sTy;
+  char uplo='L';
+  //the workspace of V is large enough since N<=2*l_max
+  DSYTRF(&uplo, &N, _Mmid, &N, _Mmid_ipiv, _V_work, &_V_lwork, &info);
+  if(info<0)
+    nlp->log->printf(hovError, "hiopHessianLowRank::factorizeMiddleMatrix error: %d argument to dsytrf has an illegal value\n", -info);
+  return 0==info;
 }
 
-
-hiopVector&  hiopHessianLowRank::new_l_vec1(int l)
+/* entry (i,j) of M=D+L+L'-S'*B0*S */
+double hiopHessianLowRank::middleSR1Entry(const int& i, const int& j) const
 {
-  if(_l_vec1!=NULL && _l_vec1->get_size()==l) return *_l_vec1;
-  
-  if(_l_vec1!=NULL) {
-    delete _l_vec1;
-  }
-  _l_vec1= LinearAlgebraFactory::createVector(l);
-  return *_l_vec1;
+  const double* L_mat=L->local_data_const();
+  const double* StS_mat=StS->local_data_const();
+  const double m = i==j ? D->local_data_const()[i] : L_mat[i*l_max+j]+L_mat[j*l_max+i];
+  return m - sigma*StS_mat[i*l_max+j];
 }
-hiopVector&  hiopHessianLowRank::new_l_vec2(int l)
+
+void hiopHessianLowRank::solveWithMiddleMatrix(double* rhs)
 {
-  if(_l_vec2!=NULL && _l_vec2->get_size()==l) return *_l_vec2;
-  
-  if(_l_vec2!=NULL) {
-    delete _l_vec2;
-  }
-  _l_vec2= LinearAlgebraFactory::createVector(l);
-  return *_l_vec2;
+  int N = QN_UPDATE_SR1==update_type ? St->m() : 2*St->m();
+  if(0==N) return;
+  char uplo='L';
+  int one=1, info;
+  DSYTRS(&uplo, &N, &one, _Mmid, &N, _Mmid_ipiv, rhs, &N, &info);
+  if(info<0) nlp->log->printf(hovError, "hiopHessianLowRank::solveWithMiddleMatrix error: %d argument to dsytrs has an illegal value\n", -info);
+  assert(info==0);
 }
 
-hiopMatrixDense& hiopHessianLowRank::new_lxl_mat1(int l)
+/* Powell's damping: when s'*y < 0.2*s'*B*s, y_new is replaced by theta*y_new+(1-theta)*B*s_new with 
+ * theta=0.8*s'*B*s/(s'*B*s-s'*y), so that s'*y_new=0.2*s'*B*s>0. Here 
+ *   B*s = B0*s - [B0*S Y]*z,  z = N^{-1}*[S'*B0*s; Y'*s]
+ * YTs and STs are Y'*s_new and S'*s_new (reduced), sTs=s_new'*s_new. On return sTy and y_nrm2 
+ * correspond to the damped y_new.
+ */
+bool hiopHessianLowRank::dampSecantPair(const hiopVector& s_new, hiopVector& y_new, const double* YTs,
+					const double* STs, const double& sTs, double& sTy, double& y_nrm2)
 {
-  if(_lxl_mat1!=NULL) {
-    if( l==_lxl_mat1->m() ) {
-      return *_lxl_mat1;
-    } else {
-      delete _lxl_mat1; 
-      _lxl_mat1=NULL;
+  const int l=l_curr;
+  double sBs = sigma*sTs;
+  //the 3*l*l buffer is not used during updates
+  double* z=_buff1_lxlx3;
+  if(l>0) {
+    if(!factorizeMiddleMatrix()) {
+      nlp->log->printf(hovWarning, "hiopHessianLowRank: singular BFGS middle matrix... y_new is not damped\n");
+      return false;
+    }
+    for(int i=0; i<l; i++) {
+      z[i]   = sigma*STs[i];
+      z[l+i] = YTs[i];
+    }
+    solveWithMiddleMatrix(z);
+    for(int i=0; i<l; i++) {
+      sBs -= sigma*STs[i]*z[i] + YTs[i]*z[l+i];
     }
   }
-  _lxl_mat1 = LinearAlgebraFactory::createMatrixDense(l,l);
-  return *_lxl_mat1;
-}
-hiopMatrixDense& hiopHessianLowRank::new_kx2l_mat1(int k, int l)
-{
-  int twol=2*l;
-  if(NULL!=_kx2l_mat1) {
-    assert(_kx2l_mat1->m()==k);
-    if( twol==_kx2l_mat1->n() ) {
-      return *_kx2l_mat1;
-    } else {
-      delete _kx2l_mat1; 
-      _kx2l_mat1=NULL;
+  if(sBs<=0. || sTy>=0.2*sBs) {
+    return false;
+  }
+  const double theta = 0.8*sBs/(sBs-sTy);
+  y_new.scale(theta);
+  y_new.axpy((1-theta)*sigma, s_new);
+  if(l>0) {
+    for(int i=0; i<l; i++) {
+      z[i]   *= -(1-theta)*sigma;
+      z[l+i] *= -(1-theta);
     }
+    transMatTimesVec_local(1.0, y_new, 1.0, *St, z);
+    transMatTimesVec_local(1.0, y_new, 1.0, *Yt, z+l);
   }
-  _kx2l_mat1 = LinearAlgebraFactory::createMatrixDense(k,twol);
-  
-  return *_kx2l_mat1;
+  nlp->log->printf(hovLinAlgScalars, "hiopHessianLowRank: s^T*y=%12.6e < 0.2*s^T*B*s=%12.6e... "
+		   "damping y_new with theta=%12.6e\n", sTy, 0.2*sBs, theta);
+  sTy = theta*sTy + (1-theta)*sBs;
+  y_nrm2 = y_new.twonorm();
+  return true;
 }
-hiopMatrixDense& hiopHessianLowRank::new_kxl_mat1(int k, int l)
+
+/* The SR1 update is skipped when |s'*(y-B*s)| < r*||s||*||y-B*s||, with r=1e-8; see Nocedal and 
+ * Wright, "Numerical Optimization", 2nd ed., Section 6.2. Here 
+ *   B*s = B0*s + Psi*z,  Psi=Y-B0*S,  z = M^{-1}*(Y'*s-S'*B0*s)
+ * s'*(y-B*s) is also the Schur complement of M in the M with the new pair, which hence stays nonsingular.
+ */
+bool hiopHessianLowRank::isSR1PairAcceptable(const hiopVector& s_new, const hiopVector& y_new, const double* YTs,
+					     const double* STs, const double& sTs, const double& sTy)
 {
-  if(_kxl_mat1!=NULL) {
-    assert(_kxl_mat1->m()==k);
-    if( l==_kxl_mat1->n() ) {
-      return *_kxl_mat1;
-    } else {
-      delete _kxl_mat1; 
-      _kxl_mat1=NULL;
+  if(l_curr>0 && !factorizeMiddleMatrix()) {
+    //can only occur for a checkpointed memory
+    nlp->log->printf(hovWarning, "hiopHessianLowRank: the SR1 middle matrix is singular... "
+		     "dropping the %d secant pairs\n", l_curr);
+    resetMemory();
+  }
+  const int l=l_curr;
+  //r = y - B*s = y - B0*s - Psi*z
+  hiopVector& r = *_n_vec3;
+  r.copyFrom(y_new);
+  r.axpy(-sigma, s_new);
+  double sBs = sigma*sTs;
+  if(l>0) {
+    //the 3*l*l buffer is not used during updates; it holds z and Psi'*s
+    double *z=_buff1_lxlx3, *Psis=_buff1_lxlx3+l;
+    for(int i=0; i<l; i++) {
+      z[i] = Psis[i] = YTs[i]-sigma*STs[i];
+    }
+    solveWithMiddleMatrix(z);
+    for(int i=0; i<l; i++) {
+      sBs += Psis[i]*z[i];
     }
+    transMatTimesVec_local(1.0, r, -1.0,  *Yt, z);
+    transMatTimesVec_local(1.0, r, sigma, *St, z);
   }
-  _kxl_mat1 = LinearAlgebraFactory::createMatrixDense(k,l);
-  return *_kxl_mat1;
+  const double sTr = sTy-sBs, r_nrm2 = r.twonorm();
+  nlp->log->printf(hovLinAlgScalarsVerb, "hiopHessianLowRank: SR1 s^T*(y-B*s)=%12.6e ||y-B*s||=%12.6e\n", 
+		   sTr, r_nrm2);
+  return r_nrm2>0. && fabs(sTr)>=1e-8*sqrt(sTs)*r_nrm2;
 }
-hiopMatrixDense& hiopHessianLowRank::new_S1(const hiopMatrixDense& X, const hiopMatrixDense& St)
-{
-  //S1 is X*some_diag*S  (kxl). Here St=S^T is lxn and X is kxn (l BFGS memory size, k number of constraints)
-  long long k=X.m(), n=St.n(), l=St.m();
-#ifdef HIOP_DEEPCHECKS
-  assert(n==X.n());
-  if(_S1!=NULL) 
-    assert(_S1->m()==k);
-#endif
-  if(NULL!=_S1 && _S1->n()!=l) { delete _S1; _S1=NULL; }
-  
-  if(NULL==_S1) _S1=LinearAlgebraFactory::createMatrixDense(k,l);
 
-  return *_S1;
-}
-
-hiopMatrixDense& hiopHessianLowRank::new_Y1(const hiopMatrixDense& X, const hiopMatrixDense& Yt)
-{
-  //Y1 is X*somediag*Y (kxl). Here Yt=Y^T is lxn,  X is kxn
-  long long k=X.m(), n=Yt.n(), l=Yt.m();
 #ifdef HIOP_DEEPCHECKS
-  assert(X.n()==n);
-  if(_Y1!=NULL) assert(_Y1->m()==k);
-#endif
-
-  if(NULL!=_Y1 && _Y1->n()!=l) { delete _Y1; _Y1=NULL; }
-
-  if(NULL==_Y1) _Y1=LinearAlgebraFactory::createMatrixDense(k,l);
-  return *_Y1;
+/* local part of the dot product u'*v; the reduce is done by the caller */
+static double dotProduct_local(const hiopVector& u, const hiopVector& v)
+{
+  assert(u.get_local_size()==v.get_local_size());
+  const double *ud=u.local_data_const(), *vd=v.local_data_const();
+  double acc=0.;
+  for(long long i=0; i<u.get_local_size(); i++) {
+    acc += ud[i]*vd[i];
+  }
+  return acc;
 }
-#ifdef HIOP_DEEPCHECKS
+
 void hiopHessianLowRank::timesVecCmn(double beta, hiopVector& y, double alpha, const hiopVector& x, bool addLogTerm) 
 {
   long long n=St->n();
@@ -925,32 +1277,53 @@ void hiopHessianLowRank::timesVecCmn(double beta, hiopVector& y, double alpha, c
     nlp->log->write("y_in=", y, hovMatrices);
   }
 
-  hiopVectorPar *yk=dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
-  hiopVectorPar *sk=dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
-  //allocate and compute a_k and b_k
+  if(QN_UPDATE_SR1==update_type) {
+    timesVecSR1(beta, y, alpha, x, addLogTerm);
+    return;
+  }
+
+  //the temporaries are taken from the NLP's workspace and returned to it when 'scope' goes out of scope
+  hiopWorkspaceScope scope(nlp->workspace());
+  hiopVector *yk=&nlp->workspace().vector(*DhInv);
+  hiopVector *sk=&nlp->workspace().vector(*DhInv);
+  //compute a_k and b_k
   vector<hiopVector*> a(l_curr), b(l_curr);
   int n_local = Yt->get_local_size_n();
   for(int k=0; k<l_curr; k++) {
+    //the recursion goes over the pairs in chronological order, starting from the oldest slot
+    const int slot = (l_oldest+k) % l_curr;
     //bk=yk/sqrt(yk'*sk)
-    yk->copyFrom(Yt->local_data() + k*n_local);
-    sk->copyFrom(St->local_data() + k*n_local);
-    double skTyk=yk->dotProductWith(*sk);
+    yk->copyFrom(Yt->local_data() + slot*n_local);
+    sk->copyFrom(St->local_data() + slot*n_local);
+
+    //the dot products with sk, namely [sk'*yk, b_i'*sk, a_i'*sk : i<k], do not depend on each 
+    //other and are reduced at once
+    double* skdots = _buff1_2l;
+    skdots[0] = dotProduct_local(*sk, *yk);
+    for(int i=0; i<k; i++) {
+      skdots[1+2*i] = dotProduct_local(*b[i], *sk);
+      skdots[2+2*i] = dotProduct_local(*a[i], *sk);
+    }
+#ifdef HIOP_USE_MPI
+    int ierr = MPI_Allreduce(_buff1_2l, _buff2_2l, 2*k+1, MPI_DOUBLE, MPI_SUM, nlp->get_comm());
+    assert(ierr==MPI_SUCCESS);
+    skdots = _buff2_2l;
+#endif
+    double skTyk=skdots[0];
     assert(skTyk>0);
-    b[k]=dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
+    b[k]=&nlp->workspace().vector(*DhInv);
     b[k]->copyFrom(*yk);
     b[k]->scale(1/sqrt(skTyk));
 
-    a[k]=dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
+    a[k]=&nlp->workspace().vector(*DhInv);
 
     //compute ak by an inner loop
     a[k]->copyFrom(*sk);
     a[k]->scale(sigma);
 
     for(int i=0; i<k; i++) {
-      double biTsk = b[i]->dotProductWith(*sk);
-      a[k]->axpy(+biTsk, *b[i]);
-      double aiTsk = a[i]->dotProductWith(*sk);
-      a[k]->axpy(-aiTsk, *a[i]);
+      a[k]->axpy(+skdots[1+2*i], *b[i]);
+      a[k]->axpy(-skdots[2+2*i], *a[i]);
     }
     double skTak = a[k]->dotProductWith(*sk);
     a[k]->scale(1/sqrt(skTak));
@@ -965,26 +1338,80 @@ void hiopHessianLowRank::timesVecCmn(double beta, hiopVector& y, double alpha, c
 
   y.axpy(alpha*sigma, x); 
 
+  //[bk'*x, ak'*x : k=0,1,...,l_curr-1] are reduced at once
+  double* xdots = _buff1_2l;
   for(int k=0; k<l_curr; k++) {
-    double bkTx = b[k]->dotProductWith(x);
-    double akTx = a[k]->dotProductWith(x);
-    
-    y.axpy( alpha*bkTx, *b[k]);
-    y.axpy(-alpha*akTx, *a[k]);
+    xdots[2*k]   = dotProduct_local(*b[k], x);
+    xdots[2*k+1] = dotProduct_local(*a[k], x);
+  }
+#ifdef HIOP_USE_MPI
+  int ierr = MPI_Allreduce(_buff1_2l, _buff2_2l, 2*l_curr, MPI_DOUBLE, MPI_SUM, nlp->get_comm());
+  assert(ierr==MPI_SUCCESS);
+  xdots = _buff2_2l;
+#endif
+  for(int k=0; k<l_curr; k++) {
+    y.axpy( alpha*xdots[2*k],   *b[k]);
+    y.axpy(-alpha*xdots[2*k+1], *a[k]);
   }
 
   if(print) {
     nlp->log->write("y_out=", y, hovMatrices);
   }
+}
+/* SR1 counterpart of the above: B = B0 + sum{ uk*uk'/(uk'*sk) : k=0,1,...,l_curr-1 }, with 
+ * uk = yk - B_k*sk and B_k the approximation before the k-th (chronologically) pair is added.
+ */
+void hiopHessianLowRank::timesVecSR1(double beta, hiopVector& y, double alpha, const hiopVector& x, bool addLogTerm)
+{
+  vector<hiopVector*> u(l_curr);
+  vector<double> uTs(l_curr);
+  hiopWorkspaceScope scope(nlp->workspace());
+  hiopVector *sk=&nlp->workspace().vector(*DhInv);
+  int n_local = Yt->get_local_size_n();
+  for(int k=0; k<l_curr; k++) {
+    const int slot = (l_oldest+k) % l_curr;
+    sk->copyFrom(St->local_data() + slot*n_local);
+    u[k]=&nlp->workspace().vector(*DhInv);
+    u[k]->copyFrom(Yt->local_data() + slot*n_local);
+    u[k]->axpy(-sigma, *sk);
+
+    //[u_i'*sk : i<k] are reduced at once
+    double* skdots = _buff1_2l;
+    for(int i=0; i<k; i++) {
+      skdots[i] = dotProduct_local(*u[i], *sk);
+    }
+#ifdef HIOP_USE_MPI
+    int ierr = MPI_Allreduce(_buff1_2l, _buff2_2l, k, MPI_DOUBLE, MPI_SUM, nlp->get_comm());
+    assert(ierr==MPI_SUCCESS);
+    skdots = _buff2_2l;
+#endif
+    for(int i=0; i<k; i++) {
+      u[k]->axpy(-skdots[i]/uTs[i], *u[i]);
+    }
+    uTs[k] = u[k]->dotProductWith(*sk);
+    assert(uTs[k]!=0.);
+  }
 
-  for(vector<hiopVector*>::iterator it=a.begin(); it!=a.end(); ++it) 
-    delete *it;
-  for(vector<hiopVector*>::iterator it=b.begin(); it!=b.end(); ++it) 
-    delete *it;
+  y.scale(beta);
+  if(addLogTerm) 
+    y.axzpy(alpha,x,*_Dx);
+  y.axpy(alpha*sigma, x); 
 
-  delete yk;
-  delete sk;
+  double* xdots = _buff1_2l;
+  for(int k=0; k<l_curr; k++) {
+    xdots[k] = dotProduct_local(*u[k], x);
+  }
+#ifdef HIOP_USE_MPI
+  int ierr = MPI_Allreduce(_buff1_2l, _buff2_2l, l_curr, MPI_DOUBLE, MPI_SUM, nlp->get_comm());
+  assert(ierr==MPI_SUCCESS);
+  xdots = _buff2_2l;
+#endif
+  for(int k=0; k<l_curr; k++) {
+    y.axpy(alpha*xdots[k]/uTs[k], *u[k]);
+  }
+  nlp->log->write("y_out=", y, hovMatrices);
 }
+
 void hiopHessianLowRank::timesVec_noLogBarrierTerm(double beta, hiopVector& y, double alpha, const hiopVector&x)
 {
   this->timesVecCmn(beta, y, alpha, x, false);
@@ -1002,22 +1429,21 @@ void hiopHessianLowRank::timesVec(double beta, hiopVector& y, double alpha, cons
  *************************************************************************/
 
 /* symmetric multiplication W = beta*W + alpha*X*Diag*X^T 
- * W is kxk local, X is kxn distributed and Diag is n, distributed
+ * W is kxk local (row-major with leading dimension ldw), X is kxn distributed and Diag is n, distributed
  * The ops are perform locally. The reduce is done separately/externally to decrease comm
  */
 void hiopHessianLowRank::
-symmMatTimesDiagTimesMatTrans_local(double beta, hiopMatrixDense& W,
+symmMatTimesDiagTimesMatTrans_local(double beta, double* Wdata, int ldw,
 				    double alpha, const hiopMatrixDense& X,
 				    const hiopVector& d)
 {
-  long long k=W.m();
+  long long k=X.m();
   long long n=X.n();
   size_t n_local=X.get_local_size_n();
 
-  assert(X.m()==k);
+  assert(ldw>=k);
     
 #ifdef HIOP_DEEPCHECKS
-  assert(W.n()==k);
   assert(d.get_size()==n);
   assert(d.get_local_size()==n_local);
 #endif
@@ -1025,7 +1451,6 @@ symmMatTimesDiagTimesMatTrans_local(double beta, hiopMatrixDense& W,
   //#define chunk 512; //!opt
   const double *xi, *xj;
   double acc;
-  double *Wdata=W.local_data();
   const double *Xdata=X.local_data_const();
   const double* dd=d.local_data_const();
   for(int i=0; i<k; i++) {
@@ -1039,15 +1464,15 @@ symmMatTimesDiagTimesMatTrans_local(double beta, hiopMatrixDense& W,
       for(size_t p=0; p<n_local; p++)
 	acc += xi[p]*dd[p]*xj[p];
 
-      //Wdata[i][j]=Wdata[j][i]=beta*Wdata[i][j]+alpha*acc;
-      Wdata[i*k+j] = Wdata[j*k+i] = beta*Wdata[i*k+j]+alpha*acc;
+      //Wdata[i][j]=Wdata[j][i]=beta*Wdata[i][j]+alpha*acc; W is not referenced when beta is zero
+      Wdata[i*ldw+j] = Wdata[j*ldw+i] = (0.0==beta ? 0.0 : beta*Wdata[i*ldw+j]) + alpha*acc;
     }
   }
 }
 
-/* W=S*D*X^T, where S is lxn, D is diag nxn, and X is kxn */
+/* W=S*D*X^T, where S is lxn, D is diag nxn, and X is kxn; W is row-major with leading dimension ldw */
 void hiopHessianLowRank::
-matTimesDiagTimesMatTrans_local(hiopMatrixDense& W, const hiopMatrixDense& S, const hiopVector& d, const hiopMatrixDense& X)
+matTimesDiagTimesMatTrans_local(double* Wd, int ldw, const hiopMatrixDense& S, const hiopVector& d, const hiopMatrixDense& X)
 {
 #ifdef HIOP_DEEPCHECKS
   assert(S.n()==d.get_size());
@@ -1060,7 +1485,7 @@ matTimesDiagTimesMatTrans_local(hiopMatrixDense& W, const hiopMatrixDense& S, co
   double* Wdi;
   const double* Xdj;
   double acc;
-  double* Wd=W.local_data();
+  assert(ldw>=k);
   const double* Sd=S.local_data_const();
   const double* Xd=X.local_data_const();
   const double *diag=d.local_data_const();
@@ -1068,7 +1493,7 @@ matTimesDiagTimesMatTrans_local(hiopMatrixDense& W, const hiopMatrixDense& S, co
   for(int i=0;i<l; i++) {
     //Sdi=Sd[i]; Wdi=Wd[i];
     Sdi = Sd+i*n;
-    Wdi = Wd+i*W.get_local_size_n();
+    Wdi = Wd+i*ldw;
     
     for(int j=0; j<k; j++) {
       //Xdj=Xd[j];
@@ -1083,6 +1508,40 @@ matTimesDiagTimesMatTrans_local(hiopMatrixDense& W, const hiopMatrixDense& S, co
   }
 }
 
+/* y = alpha*Xt*x, where Xt is lxn distributed, x is n distributed, and y is l local
+ * Only the local products are computed; the reduce is done by the caller
+ */
+void hiopHessianLowRank::matTimesVec_local(double* y, double alpha, const hiopMatrixDense& Xt, const hiopVector& x)
+{
+  int l=Xt.m(), n_local=Xt.get_local_size_n();
+  assert(x.get_local_size()==n_local);
+  if(0==l) return;
+  if(0==n_local) {
+    for(int i=0; i<l; i++) y[i]=0.;
+    return;
+  }
+  //Xt is lxn_local row-major, which is n_local x l in Fortran
+  char trans='T'; int one=1; double zero=0.;
+  DGEMV(&trans, &n_local, &l, &alpha, Xt.local_data_const(), &n_local,
+	x.local_data_const(), &one, &zero, y, &one);
+}
+
+/* y = beta*y + alpha*Xt^T*x, where Xt is lxn distributed, x is l local, and y is n distributed */
+void hiopHessianLowRank::transMatTimesVec_local(double beta, hiopVector& y, double alpha,
+						const hiopMatrixDense& Xt, const double* x)
+{
+  int l=Xt.m(), n_local=Xt.get_local_size_n();
+  assert(y.get_local_size()==n_local);
+  if(0==l) {
+    if(0.0==beta) y.setToZero(); else y.scale(beta);
+    return;
+  }
+  if(0==n_local) return;
+  char trans='N'; int one=1;
+  DGEMV(&trans, &n_local, &l, &alpha, Xt.local_data_const(), &n_local,
+	x, &one, &beta, y.local_data(), &one);
+}
+
 /**************************************************************************
  * this code is going to be removed
  *************************************************************************/
@@ -1269,9 +1728,9 @@ update(const hiopIterate& it_curr, const hiopVector& grad_f_curr_,
   return true;
 }
 
-bool hiopHessianInvLowRank_obsolette::updateLogBarrierDiagonal(const hiopVector& Dx)
+bool hiopHessianInvLowRank_obsolette::updateLogBarrierDiagonal(const hiopVector& Dx, const double& delta_wx)
 {
-  H0->setToConstant(sigma);
+  H0->setToConstant(sigma+delta_wx);
   H0->axpy(1.0,Dx);
 #ifdef HIOP_DEEPCHECKS
   assert(H0->allPositive());
@@ -51,6 +51,7 @@
 
 #include "hiopNlpFormulation.hpp"
 #include "hiopIterate.hpp"
+#include "hiopCheckpoint.hpp"
 
 #include <cassert>
 
@@ -65,6 +66,15 @@ namespace hiop
  * in the compact representation of  Byrd, Nocedal, and Schnabel (1994)
  * Reference: Byrd, Nocedal, and Schnabel, "Representations of quasi-Newton matrices and
  * and there use in limited memory methods", Math. Programming 63 (1994), p. 129-156.
+ *
+ * The secant update is selected by the option 'Hessian':
+ *  - 'quasinewton_approx': BFGS, pairs with s'*y not sufficiently positive are skipped
+ *  - 'quasinewton_damped_bfgs': Powell-damped BFGS, y is replaced by theta*y+(1-theta)*Bk*s so 
+ * that s'*y>=0.2*s'*Bk*s, hence all pairs are taken and Bk remains positive definite
+ *  - 'quasinewton_lsr1': limited-memory SR1, Bk=B0 + Psi*M^{-1}*Psi' with Psi=Y-B0*S and 
+ * M=D+L+L'-S'*B0*S (same reference). Bk may be indefinite; the inertia of Dk+Bk is provided by 
+ * 'num_neg_eigenvalues' so that the KKT linear system can correct it.
+ * The damped BFGS and SR1 updates also maintain S'*S, which is needed to compute Bk*s_new.
  * 
  * M=[B0*Sk Yk] is nx2l, and N is 2lx2l, where n=dim(x) and l is the length of the memory of secant 
  * approximation. This class is for when n>>k (l=O(10)).
@@ -84,22 +94,68 @@ namespace hiop
  *  - DhInv:=(Dk+B0)^{-1}, thus Hk{-1}=DhInv-DhInv*U*V^{-1}*U'*DhInv with
  *  - U:=[B0*St' Yt'] and  V is defined above
  *  - 
+ *
+ * Storage: St and Yt are circular buffers with l_max rows preallocated. Pairs are appended until the
+ * memory is full; afterwards the oldest pair is overwritten in place, so an update costs O(n*l) 
+ * flops and moves only the new pair. L and D are kept in the same (slot) order as the rows of St 
+ * and Yt, and V is formed in this order; the compact representation is invariant to a symmetric 
+ * permutation of the pairs. All workspaces are sized from l_max and the number of constraints
+ * when the object is created, so updates and solves do not allocate.
  *  
  * Parallel computations: Dk, B0 are distributed vectors, M is distributed 
  * column-wise, and N is local (stored on all processors).
+ *
+ * For the MDS and sparse formulations, the solves with Hk are not used. Instead, the KKT linear 
+ * system (see hiopKKTLinSysCompressedXYcYd) factorizes the KKT matrix with B0 as the Hessian and 
+ * applies the low-rank part of Bk=B0+U*W*U' by the Sherman-Morrison-Woodbury formula, for which 
+ * this class provides U, the factorization of the capacitance matrix C=W^{-1}+U'*Z, and the solves 
+ * with it. Here U=[B0*S Y] and W=-N^{-1} for BFGS and U=Psi and W=M^{-1} for SR1.
  */
 class hiopHessianLowRank : public hiopMatrix
 {
 public:
-  hiopHessianLowRank(hiopNlpDenseConstraints* nlp_, int max_memory_length);
+  hiopHessianLowRank(hiopNlpFormulation* nlp_, int max_memory_length);
   virtual ~hiopHessianLowRank();
 
   /* return false if the update destroys hereditary positive definitness and the BFGS update is not taken*/
   virtual bool update(const hiopIterate& x_curr, const hiopVector& grad_f_curr,
 		      const hiopMatrix& Jac_c_curr, const hiopMatrix& Jac_d_curr);
 
-  /* updates the logBar diagonal term from the representation */
-  virtual bool updateLogBarrierDiagonal(const hiopVector& Dx);
+  /* updates the logBar diagonal term from the representation; the Hessian is additionally 
+   * perturbed by delta_wx*I (inertia correction) */
+  virtual bool updateLogBarrierDiagonal(const hiopVector& Dx, const double& delta_wx=0.);
+
+  /* drops the secant pairs and the previous iterate, so that the next 'update' is the first one */
+  void reset();
+
+  /* true for the updates that may produce an indefinite approximation (SR1) */
+  bool may_be_indefinite() const;
+  /* number of negative eigenvalues of Dk+Bk (always zero for BFGS); -1 if the compact 
+   * representation is singular */
+  int num_neg_eigenvalues();
+
+  /* Sherman-Morrison-Woodbury interface, see the class description */
+  inline double get_sigma() const { return sigma; }
+  /* number of columns r of U: 2l for BFGS and l for SR1 */
+  int compact_rank() const;
+  /* copies the j-th column of U into u */
+  void compact_column(const int& j, hiopVector& u);
+  /* forms and factorizes C=W^{-1}+U'*Z, where the r rows of Zt are the columns of Z, the x part 
+   * of K0^{-1}*[U;0] for a symmetric (KKT) matrix K0. Returns false if C or W^{-1} is singular; 
+   * otherwise, by Haynsworth's inertia additivity, K0+[U;0]*W*[U;0]' has n_neg_shift more negative 
+   * eigenvalues than K0, with n_neg_shift=n_pos(C)-n_pos(W^{-1}) */
+  bool factorizeCapacitance(const hiopMatrixDense& Zt, int& n_neg_shift);
+  /* w = C^{-1}*U'*x, with C factorized by the above; w is local of size r */
+  void solveCapacitance(const hiopVector& x, hiopVector& w);
+
+  /* appends the secant memory, sigma, and the previous iterate's x, gradient, and Jacobians
+   * to a checkpoint */
+  virtual void save_state(hiopCheckpoint& ckpt) const;
+  /* restores the state saved by 'save_state'; the arguments are used as templates to allocate
+   * the previous iterate's objects if not allocated yet */
+  virtual bool load_state(hiopCheckpoint& ckpt,
+                          const hiopIterate& it, const hiopVector& grad_f,
+                          const hiopMatrix& Jac_c, const hiopMatrix& Jac_d);
 
   /* solves this*x=res */
   virtual void solve(const hiopVector& rhs, hiopVector& x);
@@ -119,6 +175,8 @@ public:
   virtual void timesVec_noLogBarrierTerm(double beta, hiopVector& y, double alpha, const hiopVector&x);
   /* code shared by the above two methods*/
   virtual void timesVecCmn(double beta, hiopVector& y, double alpha, const hiopVector&x, bool addLogBarTerm);
+  /* SR1 recursion used by the above */
+  void timesVecSR1(double beta, hiopVector& y, double alpha, const hiopVector&x, bool addLogBarTerm);
 
   virtual void print(FILE* f, hiopOutVerbosity v, const char* msg) const;
 #endif
@@ -126,11 +184,13 @@ public:
 protected:
   int l_max; //max memory size
   int l_curr; //number of pairs currently stored
+  int l_oldest; //slot (row in St and Yt) of the oldest pair; 0 until the memory is full
   double sigma; //initial scaling factor of identity
   double sigma0; //default scaling factor of identity
   int sigma_update_strategy;
   double sigma_safe_min, sigma_safe_max; //min and max safety thresholds for sigma
-  hiopNlpDenseConstraints* nlp;
+  int update_type; //BFGS, damped BFGS, or SR1, see option 'Hessian'
+  hiopNlpFormulation* nlp;
 private:
   hiopVector* DhInv; //(B0+Dk)^{-1}
 #ifdef HIOP_DEEPCHECKS
@@ -143,43 +203,56 @@ private:
   // more exactly Bk=B0-[B0*St' Yt']*[St*B0*St'  L]*[St*B0]
   //                                 [  L'      -D] [Yt   ]                   
   hiopMatrixDense *St,*Yt; //we store the transpose to easily access columns in S and T
-  hiopMatrixDense *L;     //lower triangular from the compact representation
-  hiopVector* D;       //diag 
+  hiopMatrixDense *L;     //l_max x l_max, "lower triangular" in the chronological order of the slots
+  hiopVector* D;       //diag, l_max
   //these are matrices from the representation of the inverse
-  hiopMatrixDense* V;    
+  double* V; //2l x 2l (lxl for SR1, row-major), holds the factors after factorizeV
 #ifdef HIOP_DEEPCHECKS
   //copy of the matrix - needed to check the residual
    hiopMatrixDense* _Vmat; 
 #endif
-  void growL(const int& lmem_curr, const int& lmem_max, const hiopVector& YTs);
-  void growD(const int& l_curr, const int& l_max, const double& sTy);
-  void updateL(const hiopVector& STy, const double& sTy);
-  void updateD(const double& sTy);
+  //stores the row Y^T*s_new of L and the entry s_new^T*y_new of D for the new pair in 'slot'
+  void updateLD(const int& slot, const double* YTs, const double& sTy);
+  //S^T*S, l_max x l_max, in slot order; only for the damped BFGS and SR1 updates and for the 
+  //MDS and sparse formulations (NULL otherwise)
+  hiopMatrixDense* StS;
+  //stores the row and column S^T*s_new and the diagonal entry s_new^T*s_new of StS
+  void updateStS(const int& slot, const double* STs, const double& sTs);
+  //the middle matrix of the compact representation of Bk, namely 
+  // N=[S'*B0*S  L] for damped BFGS and M=D+L+L'-S'*B0*S for SR1; factorized in place 
+  //   [  L'    -D]
+  double* _Mmid; //2l x 2l max (row-major, leading dimension 2l, respectively l)
+  int* _Mmid_ipiv;
+  bool factorizeMiddleMatrix();
+  double middleSR1Entry(const int& i, const int& j) const;
+  void solveWithMiddleMatrix(double* rhs);
+  //Powell damping of y_new; returns true if y_new was modified
+  bool dampSecantPair(const hiopVector& s_new, hiopVector& y_new, const double* YTs, 
+		      const double* STs, const double& sTs, double& sTy, double& y_nrm2);
+  //SR1 safeguard |s'*(y-B*s)| >= r*||s||*||y-B*s||
+  bool isSR1PairAcceptable(const hiopVector& s_new, const hiopVector& y_new, const double* YTs, 
+			   const double* STs, const double& sTs, const double& sTy);
+  //drops all the secant pairs
+  void resetMemory();
+  //number of positive eigenvalues of V and M (SR1 only); -1 if singular
+  int _V_npos, _M_npos;
   //also stored are the iterate, gradient obj, and Jacobians at the previous optimization iteration
   hiopIterate *_it_prev;
   hiopVector *_grad_f_prev;
-  hiopMatrixDense *_Jac_c_prev, *_Jac_d_prev;
+  hiopMatrix *_Jac_c_prev, *_Jac_d_prev;
 
   //internal helpers
   void updateInternalBFGSRepresentation();
 
-  //internals buffers, mostly for MPIAll_reduce
-  double* _buff_kxk; // size = num_constraints^2 
-  double* _buff_2lxk; // size = 2 x q-Newton mem size x num_constraints
+  //internals buffers, preallocated for the max memory size; the '2' buffers are for MPI_Allreduce
+  //size = num_constraints x 2 x q-Newton mem size (+ num_constraints^2 with MPI, for the kxk reduction)
+  //for the dense formulation; for the MDS and sparse formulations, they hold [S;Y]*Z', which is 
+  //2l x 2l at most
+  double *_buff1_kx2l, *_buff2_kx2l;
   double *_buff1_lxlx3, *_buff2_lxlx3;
-  //auxiliary objects
-  hiopMatrixDense *_S1, *_Y1, *_lxl_mat1, *_kx2l_mat1, *_kxl_mat1; //preallocated matrices 
-  //holds X*D*S
-  hiopMatrixDense& new_S1(const hiopMatrixDense& X, const hiopMatrixDense& St);
-  //holds X*D*Y
-  hiopMatrixDense& new_Y1(const hiopMatrixDense& X, const hiopMatrixDense& Yt);
-  hiopMatrixDense& new_lxl_mat1 (int l);
-  hiopMatrixDense& new_kxl_mat1 (int k, int l);
-  hiopMatrixDense& new_kx2l_mat1(int k, int l);
-  
-  hiopVector *_l_vec1, *_l_vec2, *_n_vec1, *_n_vec2, *_2l_vec1;
-  hiopVector& new_l_vec1(int l);
-  hiopVector& new_l_vec2(int l);
+  double *_buff1_2l, *_buff2_2l;
+  //auxiliary objects; _n_vec3 is only for SR1
+  hiopVector *_n_vec1, *_n_vec2, *_n_vec3;
   inline hiopVector& new_n_vec1(long long n)
   {
 #ifdef HIOP_DEEPCHECKS
@@ -196,27 +269,26 @@ private:
 #endif
     return *_n_vec2;
   }
-  inline hiopVector& new_2l_vec1(int l) {
-    if(_2l_vec1!=NULL && _2l_vec1->get_size()==2*l) return *_2l_vec1;
-    if(_2l_vec1!=NULL) delete _2l_vec1;
-    _2l_vec1=LinearAlgebraFactory::createVector(2*l);
-    return *_2l_vec1;
-  }
 private:
-  //utilities
+  //utilities; W is a local row-major buffer with leading dimension ldw
   /* symmetric multiplication W = beta*W + alpha*X*Diag*X^T */
-  static void symmMatTimesDiagTimesMatTrans_local(double beta, hiopMatrixDense& W_,
+  static void symmMatTimesDiagTimesMatTrans_local(double beta, double* W, int ldw,
 					   double alpha, const hiopMatrixDense& X_,
 					   const hiopVector& d);
   /* W=S*Diag*X^T */
-  static void matTimesDiagTimesMatTrans_local(hiopMatrixDense& W, const hiopMatrixDense& S, 
+  static void matTimesDiagTimesMatTrans_local(double* W, int ldw, const hiopMatrixDense& S, 
 					      const hiopVector& d, const hiopMatrixDense& X);
+  /* y = alpha*Xt*x, with y local of size Xt.m(); the reduction is done by the caller */
+  static void matTimesVec_local(double* y, double alpha, const hiopMatrixDense& Xt, const hiopVector& x);
+  /* y = beta*y + alpha*Xt^T*x, with x local of size Xt.m() */
+  static void transMatTimesVec_local(double beta, hiopVector& y, double alpha, 
+				     const hiopMatrixDense& Xt, const double* x);
   /* members and utilities related to V matrix: factorization and solve */
-  hiopVector *_V_work_vec;
-  int _V_ipiv_size; int* _V_ipiv_vec;
+  double* _V_work; int _V_lwork;
+  int* _V_ipiv_vec;
   void factorizeV();
-  void solveWithV(hiopVector& rhs_s, hiopVector& rhs_y);
-  void solveWithV(hiopMatrixDense& rhs);
+  /* solves with V in place; rhs holds nrhs contiguous right-hand sides of size 2l */
+  void solveWithV(double* rhs, int nrhs);
 private:
   hiopHessianLowRank() {};
   hiopHessianLowRank(const hiopHessianLowRank&) {};
@@ -385,7 +457,7 @@ public:
   virtual bool update(const hiopIterate& x_curr, const hiopVector& grad_f_curr,
 		      const hiopMatrix& Jac_c_curr, const hiopMatrix& Jac_d_curr);
 
-  virtual bool updateLogBarrierDiagonal(const hiopVector& Dx);
+  virtual bool updateLogBarrierDiagonal(const hiopVector& Dx, const double& delta_wx=0.);
 
   /* ! 
    * these methods use quantities computed in symmetricTimesMat. They should be called
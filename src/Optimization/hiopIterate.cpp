@@ -49,6 +49,7 @@
 #include "hiopIterate.hpp"
 
 #include <cmath>
+#include <limits>
 #include <cassert>
 #include <cstdlib>
 namespace hiop
@@ -294,6 +295,37 @@ void hiopIterate::determineDualsBounds_d(const double& mu)
   vu->componentDiv_w_selectPattern(*sdu, nlp->get_idu());
 }
 
+double hiopIterate::avgComplementarity(bool with_d) const
+{
+  double compl_sum = zl->dotProductWith(*sxl) + zu->dotProductWith(*sxu);
+  long long n_compl = nlp->n_low() + nlp->n_upp();
+  if(with_d) {
+    compl_sum += vl->dotProductWith(*sdl) + vu->dotProductWith(*sdu);
+    n_compl += nlp->m_ineq_low() + nlp->m_ineq_upp();
+  }
+  if(0==n_compl) {
+    return 0.;
+  }
+  return compl_sum / n_compl;
+}
+
+void hiopIterate::pushDualsForWarmStart(const double& push)
+{
+  zl->component_max(push);
+  zl->selectPattern(nlp->get_ixl());
+  zu->component_max(push);
+  zu->selectPattern(nlp->get_ixu());
+
+  vl->copyFrom(*yd);
+  vl->scale(-1.);
+  vl->component_max(push);
+  vl->selectPattern(nlp->get_idl());
+
+  vu->copyFrom(*yd);
+  vu->component_max(push);
+  vu->selectPattern(nlp->get_idu());
+}
+
 bool hiopIterate::
 fractionToTheBdry(const hiopIterate& dir, const double& tau, double& alphaprimal, double& alphadual) const
 {
@@ -77,6 +77,19 @@ public:
    */
   virtual void determineDualsBounds_d(const double& mu);
 
+  /**
+   * Returns the average of the complementarity products zl.*sxl and zu.*sxu, and, if @p with_d 
+   * is true, also of vl.*sdl and vu.*sdu, over the bounds present in the problem. Assumes the 
+   * slacks were computed previously (see @determineSlacks). Returns 0. if there are no bounds.
+   */
+  virtual double avgComplementarity(bool with_d) const;
+
+  /**
+   * Prepares user provided duals for a warm start: zl and zu are pushed to be at least @p push,
+   * and vl and vu are computed from yd (vl-vu=-yd at a KKT point) and pushed similarly.
+   */
+  virtual void pushDualsForWarmStart(const double& push);
+
   /* max{a\in(0,1]| x+ad >=(1-tau)x} */
   bool fractionToTheBdry(const hiopIterate& dir, const double& tau,
 			 double& alphaprimal, double& alphadual) const;
@@ -49,6 +49,7 @@
 #include "hiopKKTLinSys.hpp"
 #include "hiopLinAlgFactory.hpp"
 #include "hiop_blasdefs.hpp"
+#include "hiopProfiler.hpp"
 
 #include <cmath>
 
@@ -68,7 +69,9 @@ double hiopKKTLinSys::errorKKT(const hiopResidual* resid, const hiopIterate* sol
   }
 
   double derr=1e20, aux;
-  hiopVector *RX=resid->rx->new_copy();
+  hiopWorkspaceScope scope(nlp_->workspace());
+  hiopVector *RX=&nlp_->workspace().vector(*resid->rx);
+  RX->copyFrom(*resid->rx);
 
   //RX=rx-H*dx-J'c*dyc-J'*dyd +dzl-dzu
   HessianTimesVec_noLogBarrierTerm(1.0, *RX, -1.0, *sol->x);
@@ -84,7 +87,8 @@ double hiopKKTLinSys::errorKKT(const hiopResidual* resid, const hiopIterate* sol
 
 
   //RD = rd - (dyd + dvl - dvu - delta_wd*dd)
-  hiopVector* RD = resid->rd->new_copy();
+  hiopVector* RD = &nlp_->workspace().vector(*resid->rd);
+  RD->copyFrom(*resid->rd);
   RD->axpy(+1., *sol->yd);
   RD->axpy(+1., *sol->vl);
   RD->axpy(-1., *sol->vu);
@@ -94,23 +98,23 @@ double hiopKKTLinSys::errorKKT(const hiopResidual* resid, const hiopIterate* sol
   nlp_->log->printf(hovLinAlgScalars, "  --- rd=%g\n", aux);
 
   //RYC = ryc - Jc*dx + delta_cc*dyc
-  hiopVector* RYC=resid->ryc->new_copy();
+  hiopVector* RYC=&nlp_->workspace().vector(*resid->ryc);
+  RYC->copyFrom(*resid->ryc);
   Jac_c_->timesVec(1.0, *RYC, -1.0, *sol->x);
   RYC->axpy(delta_cc, *sol->yc);
   aux=RYC->twonorm();
   derr=fmax(aux,derr);
   nlp_->log->printf(hovLinAlgScalars, "  --- ryc=%g\n", aux);
-  delete RYC;
 
   //RYD=ryd - Jd*dx + dd + delta_cd*dyd
-  hiopVector* RYD=resid->ryd->new_copy();
+  hiopVector* RYD=&nlp_->workspace().vector(*resid->ryd);
+  RYD->copyFrom(*resid->ryd);
   Jac_d_->timesVec(1.0, *RYD, -1.0, *sol->x);
   RYD->axpy(1.0, *sol->d);
   RYD->axpy(delta_cd, *sol->yd);
   aux=RYD->infnorm();
   derr=fmax(aux,derr);
   nlp_->log->printf(hovLinAlgScalars, "  --- ryd=%g\n", aux);
-  delete RYD;
 
   //RXL=rxl+x-sxl
   RX->copyFrom(*resid->rxl);
@@ -161,7 +165,6 @@ double hiopKKTLinSys::errorKKT(const hiopResidual* resid, const hiopIterate* sol
   aux=RX->twonorm();
   derr=fmax(aux,derr);
   nlp_->log->printf(hovLinAlgScalars, "  --- rszu=%g\n", aux);
-  delete RX; RX=NULL;
 
   //complementarity residuals checks: rsvl - Sdl dvl - Vl dsdl
   RD->copyFrom(*resid->rsvl);
@@ -177,7 +180,6 @@ double hiopKKTLinSys::errorKKT(const hiopResidual* resid, const hiopIterate* sol
   aux=RD->twonorm();
   derr=fmax(aux,derr);
   nlp_->log->printf(hovLinAlgScalars, "  --- rsvu=%g\n", aux);
-  delete RD;
 
   return derr;
 }
@@ -191,6 +193,7 @@ int hiopKKTLinSysCurvCheck::factorizeWithCurvCheck()
 
 bool hiopKKTLinSysCurvCheck::factorize()
 {
+  HIOP_PROFILE_SCOPE("kkt_factorize");
   assert(nlp_);
 
   // factorization + inertia correction if needed
@@ -264,7 +267,8 @@ bool hiopKKTLinSysCurvCheck::factorize()
  * [    Jd          0   -Dd^{-1}] [dyd]   [ ryd_tilde]
  */
 hiopKKTLinSysCompressedXYcYd::hiopKKTLinSysCompressedXYcYd(hiopNlpFormulation* nlp)
-  : hiopKKTLinSysCompressed(nlp)
+  : hiopKKTLinSysCompressed(nlp),
+    hess_lowrank_(NULL), Zx_(NULL), Zyc_(NULL), Zyd_(NULL), lowrank_w_(NULL)
 {
   Dd_inv_ = dynamic_cast<hiopVector*>(nlp_->alloc_dual_ineq_vec());
   assert(Dd_inv_ != NULL);
@@ -276,6 +280,10 @@ hiopKKTLinSysCompressedXYcYd::~hiopKKTLinSysCompressedXYcYd()
 {
   delete Dd_inv_;
   delete ryd_tilde_;
+  delete Zx_;
+  delete Zyc_;
+  delete Zyd_;
+  delete lowrank_w_;
 }
 
 bool hiopKKTLinSysCompressedXYcYd::update(const hiopIterate* iter,
@@ -283,6 +291,7 @@ bool hiopKKTLinSysCompressedXYcYd::update(const hiopIterate* iter,
                                           const hiopMatrix* Jac_c, const hiopMatrix* Jac_d,
                                           hiopMatrix* Hess)
 {
+  HIOP_PROFILE_SCOPE("kkt_update");
   nlp_->runStats.tmSolverInternal.start();
   nlp_->runStats.kkt.tmUpdateInit.start();
 
@@ -300,6 +309,10 @@ bool hiopKKTLinSysCompressedXYcYd::update(const hiopIterate* iter,
   Dx_->setToZero();
   Dx_->axdzpy_w_pattern(1.0, *iter_->zl, *iter_->sxl, nlp_->get_ixl());
   Dx_->axdzpy_w_pattern(1.0, *iter_->zu, *iter_->sxu, nlp_->get_ixu());
+  if(hess_lowrank_) {
+    //B0=sigma*I of the quasi-Newton Hessian is factorized with the barrier diagonal
+    Dx_->addConstant(hess_lowrank_->get_sigma());
+  }
   nlp_->log->write("Dx in KKT", *Dx_, hovMatrices);
 
   // Dd=(Sdl)^{-1}Vu + (Sdu)^{-1}Vu is computed in the IC loop since we need to
@@ -317,6 +330,7 @@ bool hiopKKTLinSysCompressedXYcYd::update(const hiopIterate* iter,
 bool hiopKKTLinSysCompressedXYcYd::computeDirections(const hiopResidual* resid, 
 						     hiopIterate* dir)
 {
+  HIOP_PROFILE_SCOPE("kkt_solve");
   nlp_->runStats.tmSolverInternal.start();
   nlp_->runStats.kkt.tmSolveRhsManip.start();
 
@@ -380,9 +394,13 @@ bool hiopKKTLinSysCompressedXYcYd::computeDirections(const hiopResidual* resid,
   ryd_tilde_->axzpy(1.0, ryd2, *Dd_inv_);
 
 #ifdef HIOP_DEEPCHECKS
-  hiopVector* rx_tilde_save=rx_tilde_->new_copy();
-  hiopVector* ryc_save=r.ryc->new_copy();
-  hiopVector* ryd_tilde_save=ryd_tilde_->new_copy();
+  hiopWorkspaceScope scope(nlp_->workspace());
+  hiopVector* rx_tilde_save=&nlp_->workspace().vector(*rx_tilde_);
+  hiopVector* ryc_save=&nlp_->workspace().vector(*r.ryc);
+  hiopVector* ryd_tilde_save=&nlp_->workspace().vector(*ryd_tilde_);
+  rx_tilde_save->copyFrom(*rx_tilde_);
+  ryc_save->copyFrom(*r.ryc);
+  ryd_tilde_save->copyFrom(*ryd_tilde_);
 #endif
 
   nlp_->runStats.kkt.tmSolveRhsManip.stop();
@@ -390,7 +408,7 @@ bool hiopKKTLinSysCompressedXYcYd::computeDirections(const hiopResidual* resid,
    * solve the compressed system
    * (be aware that rx_tilde is reused/modified inside this function)
    ***********************************************************************/
-  bool sol_ok = solveCompressed(*rx_tilde_, *r.ryc, *ryd_tilde_, *dir->x, *dir->yc, *dir->yd);
+  bool sol_ok = solveCompressedLowRank(*rx_tilde_, *r.ryc, *ryd_tilde_, *dir->x, *dir->yc, *dir->yd);
 
   nlp_->runStats.kkt.tmSolveRhsManip.start();
   //recover dir->d = (D)^{-1}*(dir->yd + ryd2)
@@ -402,9 +420,6 @@ bool hiopKKTLinSysCompressedXYcYd::computeDirections(const hiopResidual* resid,
 
 #ifdef HIOP_DEEPCHECKS
   errorCompressedLinsys(*rx_tilde_save,*ryc_save,*ryd_tilde_save, *dir->x, *dir->yc, *dir->yd);
-  delete rx_tilde_save;
-  delete ryc_save;
-  delete ryd_tilde_save;
 #endif
 
   if(false==sol_ok) {
@@ -507,6 +522,11 @@ errorCompressedLinsys(const hiopVector& rx, const hiopVector& ryc, const hiopVec
   Hess_->timesVec(1.0, *RX, -1.0, dx);
   RX->axzpy(-1.0, *Dx_, dx);
   RX->axpy(-delta_wx, dx);
+  if(hess_lowrank_) {
+    //sigma is also in Dx
+    hess_lowrank_->timesVec_noLogBarrierTerm(1.0, *RX, -1.0, dx);
+    RX->axpy(hess_lowrank_->get_sigma(), dx);
+  }
 
   Jac_c_->transTimesVec(1.0, *RX, -1.0, dyc);
   Jac_d_->transTimesVec(1.0, *RX, -1.0, dyd);
@@ -537,6 +557,82 @@ errorCompressedLinsys(const hiopVector& rx, const hiopVector& ryc, const hiopVec
 }
 #endif
 
+int hiopKKTLinSysCompressedXYcYd::factorizeWithCurvCheck()
+{
+  return factorizeLowRankCorrection(hiopKKTLinSysCurvCheck::factorizeWithCurvCheck());
+}
+
+int hiopKKTLinSysCompressedXYcYd::factorizeLowRankCorrection(int n_neg_eig_K0)
+{
+  if(NULL==hess_lowrank_ || n_neg_eig_K0<0) {
+    return n_neg_eig_K0;
+  }
+  const int r = hess_lowrank_->compact_rank();
+  if(0==r) {
+    return n_neg_eig_K0;
+  }
+  const int neq = Jac_c_->m(), nineq = Jac_d_->m();
+  //the rank grows with the secant memory, after which the same storage is used
+  if(NULL==Zx_ || Zx_->m()!=r) {
+    delete Zx_;
+    delete Zyc_;
+    delete Zyd_;
+    delete lowrank_w_;
+    Zx_  = nlp_->alloc_multivector_primal(r);
+    Zyc_ = LinearAlgebraFactory::createMatrixDense(r, neq);
+    Zyd_ = LinearAlgebraFactory::createMatrixDense(r, nineq);
+    lowrank_w_ = LinearAlgebraFactory::createVector(r);
+  }
+
+  //Z=K0^{-1}*[U;0;0], one column of U at a time; the solution's buffers of the KKT are used and
+  //'solveCompressed' may modify its right-hand side, which hence is reset for each solve
+  hiopWorkspaceScope scope(nlp_->workspace());
+  hiopVector* u   = &nlp_->workspace().vector(*Dx_);
+  hiopVector* zx  = &nlp_->workspace().vector(*Dx_);
+  hiopVector* ryc = &nlp_->workspace().vector(*iter_->yc);
+  hiopVector* ryd = &nlp_->workspace().vector(*iter_->yd);
+  hiopVector* zyc = &nlp_->workspace().vector(*iter_->yc);
+  hiopVector* zyd = &nlp_->workspace().vector(*iter_->yd);
+  bool bret = true;
+  for(int j=0; j<r && bret; j++) {
+    hess_lowrank_->compact_column(j, *u);
+    ryc->setToZero();
+    ryd->setToZero();
+    bret = solveCompressed(*u, *ryc, *ryd, *zx, *zyc, *zyd);
+    Zx_->replaceRow(j, *zx);
+    Zyc_->replaceRow(j, *zyc);
+    Zyd_->replaceRow(j, *zyd);
+  }
+
+  int n_neg_shift;
+  if(!bret || !hess_lowrank_->factorizeCapacitance(*Zx_, n_neg_shift)) {
+    nlp_->log->printf(hovWarning, "linsys: the low-rank correction of the quasi-Newton Hessian failed\n");
+    return -1;
+  }
+  nlp_->log->printf(hovScalars, "linsys: low-rank correction of rank %d adds %d negative eigenvalues\n",
+                    r, n_neg_shift);
+  return n_neg_eig_K0+n_neg_shift;
+}
+
+bool hiopKKTLinSysCompressedXYcYd::
+solveCompressedLowRank(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
+                       hiopVector& dx, hiopVector& dyc, hiopVector& dyd)
+{
+  if(!solveCompressed(rx, ryc, ryd, dx, dyc, dyd)) {
+    return false;
+  }
+  if(NULL==hess_lowrank_ || 0==hess_lowrank_->compact_rank()) {
+    return true;
+  }
+  assert(Zx_ && Zx_->m()==hess_lowrank_->compact_rank());
+  //d = d0 - Z*C^{-1}*U'*dx0
+  hess_lowrank_->solveCapacitance(dx, *lowrank_w_);
+  Zx_->transTimesVec(1.0, dx, -1.0, *lowrank_w_);
+  Zyc_->transTimesVec(1.0, dyc, -1.0, *lowrank_w_);
+  Zyd_->transTimesVec(1.0, dyd, -1.0, *lowrank_w_);
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////
 // hiopKKTLinSysCompressedXDYcYd
@@ -575,6 +671,7 @@ bool hiopKKTLinSysCompressedXDYcYd::update( const hiopIterate* iter,
                                             const hiopMatrix* Jac_c, const hiopMatrix* Jac_d,
                                             hiopMatrix* Hess)
 {
+  HIOP_PROFILE_SCOPE("kkt_update");
   nlp_->runStats.tmSolverInternal.start();
 
   iter_ = iter;
@@ -613,6 +710,7 @@ bool hiopKKTLinSysCompressedXDYcYd::update( const hiopIterate* iter,
 bool hiopKKTLinSysCompressedXDYcYd::computeDirections(const hiopResidual* resid, 
 						      hiopIterate* dir)
 {
+  HIOP_PROFILE_SCOPE("kkt_solve");
   nlp_->runStats.tmSolverInternal.start();
   nlp_->runStats.kkt.tmSolveRhsManip.start();
 
@@ -664,10 +762,15 @@ bool hiopKKTLinSysCompressedXDYcYd::computeDirections(const hiopResidual* resid,
   nlp_->log->write("Dd (in computeDirections)", *Dd_, hovMatrices);
 
 #ifdef HIOP_DEEPCHECKS
-  hiopVector* rx_tilde_save = rx_tilde_->new_copy();
-  hiopVector* rd_tilde_save = rd_tilde_->new_copy();
-  hiopVector* ryc_save = r.ryc->new_copy();
-  hiopVector* ryd_save = r.ryd->new_copy();
+  hiopWorkspaceScope scope(nlp_->workspace());
+  hiopVector* rx_tilde_save = &nlp_->workspace().vector(*rx_tilde_);
+  hiopVector* rd_tilde_save = &nlp_->workspace().vector(*rd_tilde_);
+  hiopVector* ryc_save = &nlp_->workspace().vector(*r.ryc);
+  hiopVector* ryd_save = &nlp_->workspace().vector(*r.ryd);
+  rx_tilde_save->copyFrom(*rx_tilde_);
+  rd_tilde_save->copyFrom(*rd_tilde_);
+  ryc_save->copyFrom(*r.ryc);
+  ryd_save->copyFrom(*r.ryd);
 #endif
 
   nlp_->runStats.kkt.tmSolveRhsManip.stop();
@@ -684,10 +787,6 @@ bool hiopKKTLinSysCompressedXDYcYd::computeDirections(const hiopResidual* resid,
 			  *dir->x, *dir->d, *dir->yc, *dir->yd);
   if(derr>1e-8)
     nlp_->log->printf(hovWarning, "solve compressed high absolute resid norm (=%12.5e)\n", derr);
-  delete rx_tilde_save;
-  delete ryc_save;
-  delete rd_tilde_save;
-  delete ryd_save;
 #endif
 
   nlp_->runStats.kkt.tmSolveRhsManip.start();
@@ -846,6 +945,8 @@ hiopKKTLinSysLowRank::hiopKKTLinSysLowRank(hiopNlpFormulation* nlp)
 
   _kxn_mat = nlpD->alloc_multivector_primal(nlpD->m()); //!opt
   N = LinearAlgebraFactory::createMatrixDense(nlpD->m(),nlpD->m());
+  N_copy_ = N->alloc_clone();
+  N_current_ = reuse_N_ = false;
 #ifdef HIOP_DEEPCHECKS
   Nmat=N->alloc_clone();
 #endif
@@ -855,6 +956,7 @@ hiopKKTLinSysLowRank::hiopKKTLinSysLowRank(hiopNlpFormulation* nlp)
 hiopKKTLinSysLowRank::~hiopKKTLinSysLowRank()
 {
   if(N)         delete N;
+  if(N_copy_)   delete N_copy_;
 #ifdef HIOP_DEEPCHECKS
   if(Nmat)      delete Nmat;
 #endif
@@ -868,13 +970,16 @@ update(const hiopIterate* iter,
        const hiopMatrixDense* Jac_c, const hiopMatrixDense* Jac_d,
        hiopHessianLowRank* Hess)
 {
+  HIOP_PROFILE_SCOPE("kkt_update");
   nlp_->runStats.tmSolverInternal.start();
+  nlp_->runStats.kkt.tmUpdateInit.start();
 
   iter_=iter;
   grad_f_ = dynamic_cast<const hiopVector*>(grad_f);
   Jac_c_ = Jac_c; Jac_d_ = Jac_d;
   //Hess = dynamic_cast<hiopHessianInvLowRank*>(Hess_);
   Hess_=HessLowRank=Hess;
+  N_current_ = false;
 
   //compute the diagonals
   //Dx=(Sxl)^{-1}Zl + (Sxu)^{-1}Zu
@@ -883,10 +988,22 @@ update(const hiopIterate* iter,
   Dx_->axdzpy_w_pattern(1.0, *iter_->zu, *iter_->sxu, nlp_->get_ixu());
   nlp_->log->write("Dx in KKT", *Dx_, hovMatrices);
 
-  HessLowRank->updateLogBarrierDiagonal(*Dx_);
+  double delta_wx=0., delta_wd=0.;
+  if(HessLowRank->may_be_indefinite()) {
+    //the reduced matrix N is factorized by Cholesky, which requires H+Dx to be positive definite; 
+    //this is enforced by the inertia correction (perturbation delta_w*I) of the Newton linear systems.
+    //The compressed system does not support the dual regularization delta_c.
+    if(!correctInertia(delta_wx, delta_wd)) {
+      nlp_->runStats.kkt.tmUpdateInit.stop();
+      nlp_->runStats.tmSolverInternal.stop();
+      return false;
+    }
+  } else {
+    HessLowRank->updateLogBarrierDiagonal(*Dx_);
+  }
 
-  //Dd=(Sdl)^{-1}Vu + (Sdu)^{-1}Vu
-  Dd_inv_->setToZero();
+  //Dd=(Sdl)^{-1}Vu + (Sdu)^{-1}Vu + delta_wd*I
+  Dd_inv_->setToConstant(delta_wd);
   Dd_inv_->axdzpy_w_pattern(1.0, *iter_->vl, *iter_->sdl, nlp_->get_idl());
   Dd_inv_->axdzpy_w_pattern(1.0, *iter_->vu, *iter_->sdu, nlp_->get_idu());
 #ifdef HIOP_DEEPCHECKS
@@ -894,6 +1011,7 @@ update(const hiopIterate* iter,
 #endif
   Dd_inv_->invert();
 
+  nlp_->runStats.kkt.tmUpdateInit.stop();
   nlp_->runStats.tmSolverInternal.stop();
 
   nlp_->log->write("Dd_inv in KKT", *Dd_inv_, hovMatrices);
@@ -901,6 +1019,47 @@ update(const hiopIterate* iter,
 }
 
 
+bool hiopKKTLinSysLowRank::correctInertia(double& delta_wx, double& delta_wd)
+{
+  if(NULL==perturb_calc_) {
+    nlp_->log->printf(hovError, "hiopKKTLinSysLowRank: inertia correction requires a perturbation "
+		      "calculator\n");
+    return false;
+  }
+  const int max_refactorization = 10;
+  int num_refactorization = 0;
+
+  double delta_cc, delta_cd;
+  if(!perturb_calc_->compute_initial_deltas(delta_wx, delta_wd, delta_cc, delta_cd)) {
+    nlp_->log->printf(hovWarning, "linsys: IC perturbation on new linsys failed.\n");
+    return false;
+  }
+
+  while(true) {
+    HessLowRank->updateLogBarrierDiagonal(*Dx_, delta_wx);
+    int n_neg_eig = HessLowRank->num_neg_eigenvalues();
+    nlp_->log->printf(hovScalars, "linsys: delta_w=%12.5e (ic %d) negative eigenvalues %d\n",
+		      delta_wx, num_refactorization, n_neg_eig);
+    //a singular representation (n_neg_eig<0) is also corrected by a perturbation
+    if(0==n_neg_eig) {
+      break;
+    }
+    if(num_refactorization>=max_refactorization) {
+      nlp_->log->printf(hovError,
+			"Reached max number (%d) of refactorization within an outer iteration.\n",
+			max_refactorization);
+      return false;
+    }
+    if(!perturb_calc_->compute_perturb_wrong_inertia(delta_wx, delta_wd, delta_cc, delta_cd)) {
+      nlp_->log->printf(hovWarning, "linsys: computing inertia perturbation failed.\n");
+      return false;
+    }
+    num_refactorization++;
+    nlp_->runStats.kkt.nUpdateICCorr++;
+  }
+  return true;
+}
+
 /* Solves the system corresponding to directions for x, yc, and yd, namely
  * [ H_BFGS + Dx   Jc^T  Jd^T   ] [ dx]   [ rx  ]
  * [    Jc          0     0     ] [dyc] = [ ryc ]
@@ -918,6 +1077,7 @@ bool hiopKKTLinSysLowRank::
 solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
 		hiopVector& dx, hiopVector& dyc, hiopVector& dyd)
 {
+  HIOP_PROFILE_SCOPE("kkt_solve_compressed");
 #ifdef HIOP_DEEPCHECKS
   //some outputing
   nlp_->log->write("KKT Low rank: solve compressed RHS", hovIteration);
@@ -929,17 +1089,27 @@ solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
 #endif
 
   hiopMatrixDense& J = *_kxn_mat;
-  const hiopMatrixDense* Jac_c_de = dynamic_cast<const hiopMatrixDense*>(Jac_c_); assert(Jac_c_de);
-  const hiopMatrixDense* Jac_d_de = dynamic_cast<const hiopMatrixDense*>(Jac_d_); assert(Jac_d_de);
-  J.copyRowsFrom(*Jac_c_de, nlp_->m_eq(), 0); //!opt
-  J.copyRowsFrom(*Jac_d_de, nlp_->m_ineq(), nlp_->m_eq());//!opt
+  nlp_->runStats.kkt.tmUpdateLinsys.start();
+  if(reuse_N_ && N_current_) {
+    //J and N have not changed since the last solve; only restore N since it was factorized in place
+    N->copyFrom(*N_copy_);
+  } else {
+    const hiopMatrixDense* Jac_c_de = dynamic_cast<const hiopMatrixDense*>(Jac_c_); assert(Jac_c_de);
+    const hiopMatrixDense* Jac_d_de = dynamic_cast<const hiopMatrixDense*>(Jac_d_); assert(Jac_d_de);
+    J.copyRowsFrom(*Jac_c_de, nlp_->m_eq(), 0); //!opt
+    J.copyRowsFrom(*Jac_d_de, nlp_->m_ineq(), nlp_->m_eq());//!opt
 
-  //N =  J*(Hess\J')
-  //Hess->symmetricTimesMat(0.0, *N, 1.0, J);
-  HessLowRank->symMatTimesInverseTimesMatTrans(0.0, *N, 1.0, J);
+    //N =  J*(Hess\J')
+    //Hess->symmetricTimesMat(0.0, *N, 1.0, J);
+    HessLowRank->symMatTimesInverseTimesMatTrans(0.0, *N, 1.0, J);
 
-  //subdiag of N += 1., Dd_inv
-  N->addSubDiagonal(1., nlp_->m_eq(), *Dd_inv_);
+    //subdiag of N += 1., Dd_inv
+    N->addSubDiagonal(1., nlp_->m_eq(), *Dd_inv_);
+
+    N_copy_->copyFrom(*N);
+    N_current_ = true;
+  }
+  nlp_->runStats.kkt.tmUpdateLinsys.stop();
 #ifdef HIOP_DEEPCHECKS
   assert(J.isfinite());
   nlp_->log->write("solveCompressed: N is", *N, hovMatrices);
@@ -950,6 +1120,7 @@ solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
 
   //compute the rhs of the lin sys involving N
   //  1. first compute (H+Dx)^{-1} rx_tilde and store it temporarily in dx
+  nlp_->runStats.kkt.tmSolveRhsManip.start();
   HessLowRank->solve(rx, dx);
 #ifdef HIOP_DEEPCHECKS
   assert(rx.isfinite_local() && "Something bad happened: nan or inf value");
@@ -962,6 +1133,7 @@ solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
   rhs.copyFromStarting(0, ryc);
   rhs.copyFromStarting(nlp_->m_eq(), ryd);
   J.timesVec(-1.0, rhs, 1.0, dx);
+  nlp_->runStats.kkt.tmSolveRhsManip.stop();
 
 #ifdef HIOP_DEEPCHECKS
   nlp_->log->write("solveCompressed: dx sol is", dx, hovMatrices);
@@ -971,10 +1143,13 @@ solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
 #endif
 
   //
-  //solve N * dyc_dyd = rhs
+  //solve N * dyc_dyd = rhs; the factorization and the triangular solves are done by the same
+  //LAPACK call (dposvx), so they are both accounted as factorization time
   //
+  nlp_->runStats.kkt.tmUpdateInnerFact.start();
   int ierr = solveWithRefin(*N,rhs);
   //int ierr = solve(*N,rhs);
+  nlp_->runStats.kkt.tmUpdateInnerFact.stop();
 
   hiopVector& dyc_dyd= rhs;
   dyc_dyd.copyToStarting(0,           dyc);
@@ -982,9 +1157,11 @@ solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
 
   //now solve for dx = - (H+Dx)^{-1}*(Jc^T*dyc+Jd^T*dyd - rx)
   //first rx = -(Jc^T*dyc+Jd^T*dyd - rx)
+  nlp_->runStats.kkt.tmSolveRhsManip.start();
   J.transTimesVec(1.0, rx, -1.0, dyc_dyd);
   //then dx = (H+Dx)^{-1} rx
   HessLowRank->solve(rx, dx);
+  nlp_->runStats.kkt.tmSolveRhsManip.stop();
 
 #ifdef HIOP_DEEPCHECKS
   //some outputing
@@ -996,6 +1173,14 @@ solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
   return ierr==0;
 }
 
+bool hiopKKTLinSysLowRank::computeDirectionsSolveOnly(const hiopResidual* resid, hiopIterate* dir)
+{
+  reuse_N_ = true;
+  bool bret = computeDirections(resid, dir);
+  reuse_N_ = false;
+  return bret;
+}
+
 int hiopKKTLinSysLowRank::solveWithRefin(hiopMatrixDense& M, hiopVector& rhs)
 {
   // 1. Solve dposvx (solve + equilibrating + iterative refinement + forward and backward error estimates)
@@ -1333,6 +1518,7 @@ bool hiopKKTLinSysFull::update( const hiopIterate* iter,
                                 const hiopMatrix* Jac_c, const hiopMatrix* Jac_d,
                                 hiopMatrix* Hess)
 {
+  HIOP_PROFILE_SCOPE("kkt_update");
   
   iter_ = iter;
   grad_f_ = dynamic_cast<const hiopVectorPar*>(grad_f);
@@ -1354,6 +1540,7 @@ bool hiopKKTLinSysFull::update( const hiopIterate* iter,
 bool hiopKKTLinSysFull::computeDirections(const hiopResidual* resid,
 						      hiopIterate* dir)
 {
+  HIOP_PROFILE_SCOPE("kkt_solve");
   nlp_->runStats.tmSolverInternal.start();
 
   const hiopResidual &r=*resid;
@@ -84,6 +84,32 @@ public:
    * with the factors, then computes the "full-space" directions */
   virtual bool computeDirections(const hiopResidual* resid, hiopIterate* direction) = 0;
 
+  /* computes the search directions for a new residual using only solves with the factors
+   * computed by the last 'update', for example for the second-order correction rhs.
+   * Classes whose 'computeDirections' also (re)does matrix-dependent work should override
+   * this method and skip that work; the default is sufficient for the KKT classes that
+   * perform only rhs manipulation and triangular solves in 'computeDirections' */
+  virtual bool computeDirectionsSolveOnly(const hiopResidual* resid, hiopIterate* direction)
+  {
+    return computeDirections(resid, direction);
+  }
+
+  /* solves, with the linear solver of this KKT system, the augmented system of the LSQ-based
+   * update of the duals yc and yd (see hiopDualsLsqUpdateLinsysAugSparse), which is the KKT
+   * system with identity Hessian and slack blocks and no IC perturbations. Its pattern is the 
+   * pattern of the KKT system, so the ordering and the symbolic factorization of the linear 
+   * solver are shared; the numerical factorization is overwritten and is recomputed by the next
+   * 'update'. 'rx' and 'rd' are the rhs in the x and slack spaces and 'Hess' provides only the
+   * sparsity pattern of the Hessian block. Only available when 'supportsLsqDuals' is true */
+  virtual bool solveLsqDuals(const hiopVector& rx, const hiopVector& rd,
+                             const hiopMatrix& Jac_c, const hiopMatrix& Jac_d, const hiopMatrix& Hess,
+                             hiopVector& yc, hiopVector& yd)
+  {
+    assert(false && "the LSQ duals system is not supported by this KKT linear system");
+    return false;
+  }
+  virtual bool supportsLsqDuals() const { return false; }
+
   virtual void set_PD_perturb_calc(hiopPDPerturbation* p)
   {
     perturb_calc_ = p;
@@ -222,6 +248,23 @@ public:
   virtual bool solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
                                hiopVector& dx, hiopVector& dyc, hiopVector& dyd) = 0;
 
+  /**
+   * Sets the limited-memory quasi-Newton Hessian Bk=sigma*I+U*W*U' to be used instead of the 
+   * Hessian passed to 'update' (which is then zero); nullptr, the default, disables it.
+   *
+   * The derived classes factorize, as usual, the compressed matrix K0, in which the Hessian is 
+   * only sigma*I (added to Dx). The low-rank term is applied by the Sherman-Morrison-Woodbury 
+   * formula: Z=K0^{-1}*[U;0;0] is computed by r=rank(U) solves and the rxr capacitance matrix 
+   * C=W^{-1}+U'*Zx is factorized (see 'factorizeLowRankCorrection'); the solves then compute 
+   * d = d0 - Z*C^{-1}*U'*dx0, where d0=[dx0;dyc0;dyd0] is the solution with K0.
+   */
+  inline void set_hess_lowrank(hiopHessianLowRank* hess_lowrank)
+  {
+    hess_lowrank_ = hess_lowrank;
+  }
+
+  virtual int factorizeWithCurvCheck();
+
 #ifdef HIOP_DEEPCHECKS
   virtual double errorCompressedLinsys(const hiopVector& rx,
 				       const hiopVector& ryc,
@@ -229,11 +272,33 @@ public:
 				       const hiopVector& dx,
 				       const hiopVector& dyc,
 				       const hiopVector& dyd);
+protected:
+  virtual void HessianTimesVec_noLogBarrierTerm(double beta, hiopVector& y,
+						double alpha, const hiopVector&x)
+  {
+    Hess_->timesVec(beta, y, alpha, x);
+    if(hess_lowrank_) {
+      hess_lowrank_->timesVec_noLogBarrierTerm(1.0, y, alpha, x);
+    }
+  }
 #endif
 
 protected:
+  /* Computes Z and factorizes C when a low-rank Hessian is set. Returns the number of negative 
+   * eigenvalues of the KKT matrix given 'n_neg_eig_K0', the one of K0, or -1 if K0 or C are 
+   * singular */
+  int factorizeLowRankCorrection(int n_neg_eig_K0);
+  /* 'solveCompressed' followed by the low-rank correction, if any */
+  bool solveCompressedLowRank(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
+                              hiopVector& dx, hiopVector& dyc, hiopVector& dyd);
+
   hiopVector *Dd_inv_;
   hiopVector *ryd_tilde_;
+
+  hiopHessianLowRank* hess_lowrank_;
+  //Z=K0^{-1}*[U;0;0] stored by rows (one per column of U), split in the x, yc, and yd parts
+  hiopMatrixDense *Zx_, *Zyc_, *Zyd_;
+  hiopVector *lowrank_w_; //holds C^{-1}*U'*dx0
 };
 
 /* Provides the functionality for reducing the KKT linear system to the
@@ -307,7 +372,7 @@ public:
       assert(false);
       return false;
     }
-    return update(iter, grad_f_, Jac_c_, Jac_d_, Hess_);
+    return update(iter, grad_f, Jac_c_, Jac_d_, Hess_);
   }
 
   virtual bool update(const hiopIterate* iter,
@@ -318,6 +383,9 @@ public:
   virtual bool updateMatrix(const double& delta_wx, const double& delta_wd,
                             const double& delta_cc, const double& delta_cd) {assert(false && "not yet implemented");return false;}
 
+  /* reuses the reduced matrix N formed by the last 'solveCompressed' since the last 'update' */
+  virtual bool computeDirectionsSolveOnly(const hiopResidual* resid, hiopIterate* direction);
+
   /* Solves the system corresponding to directions for x, yc, and yd, namely
    * [ H_BFGS + Dx   Jc^T  Jd^T   ] [ dx]   [ rx_tilde ]
    * [    Jc          0     0     ] [dyc] = [   ryc    ]
@@ -351,10 +419,17 @@ protected:
 #endif
 
 private:
+  /* updates the log barrier diagonal of the Hessian, perturbed by delta_wx*I as needed so that 
+   * H+Dx+delta_wx*I is positive definite (for quasi-Newton updates that may be indefinite) */
+  bool correctInertia(double& delta_wx, double& delta_wd);
+
   hiopNlpDenseConstraints* nlpD;
   hiopHessianLowRank* HessLowRank;
 
   hiopMatrixDense* N; //the kxk reduced matrix
+  hiopMatrixDense* N_copy_; //copy of N as formed, since N is overwritten by the factorization
+  bool N_current_;          //N_copy_ corresponds to the matrices passed to the last 'update'
+  bool reuse_N_;            //'solveCompressed' should use N_copy_ instead of forming N
 #ifdef HIOP_DEEPCHECKS
   hiopMatrixDense* Nmat; //a copy of the above to compute the residual
 #endif
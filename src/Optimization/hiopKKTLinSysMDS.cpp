@@ -48,6 +48,7 @@
 
 #include "hiopKKTLinSysMDS.hpp"
 #include "hiopLinSolverIndefDenseLapack.hpp"
+#include "hiopProfiler.hpp"
 
 #ifdef HIOP_USE_MAGMA
 #include "hiopLinSolverIndefDenseMagma.hpp"
@@ -106,7 +107,8 @@ namespace hiop
       nlp_->log->printf(hovWarning,
                 "KKT_MDS_XYcYd linsys: Detected negative eigenvalues in (1,1) sparse block.\n");
     }
-    return n_neg_eig;
+    //inertia of the KKT with the quasi-Newton Hessian, if any
+    return factorizeLowRankCorrection(n_neg_eig);
   }
 
   bool hiopKKTLinSysCompressedMDSXYcYd::update(const hiopIterate* iter, 
@@ -115,6 +117,7 @@ namespace hiop
                                                const hiopMatrix* Jac_d,
                                                hiopMatrix* Hess)
   {
+    HIOP_PROFILE_SCOPE("kkt_update");
     if(!nlpMDS_) { assert(false); return false; }
    
     nlp_->runStats.tmSolverInternal.start();
@@ -154,6 +157,10 @@ namespace hiop
     Dx_->setToZero();
     Dx_->axdzpy_w_pattern(1.0, *iter->zl, *iter->sxl, nlp_->get_ixl());
     Dx_->axdzpy_w_pattern(1.0, *iter->zu, *iter->sxu, nlp_->get_ixu());
+    if(hess_lowrank_) {
+      //B0=sigma*I of the quasi-Newton Hessian is factorized with the barrier diagonal
+      Dx_->addConstant(hess_lowrank_->get_sigma());
+    }
     nlp_->log->write("Dx in KKT", *Dx_, hovMatrices);
 
     nlp_->runStats.kkt.tmUpdateInit.stop();
@@ -300,6 +307,7 @@ namespace hiop
   solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
                   hiopVector& dx, hiopVector& dyc, hiopVector& dyd)
   {
+    HIOP_PROFILE_SCOPE("kkt_solve_compressed");
     hiopLinSolverIndefDense* linSys = dynamic_cast<hiopLinSolverIndefDense*> (linSys_);
 
     if(!nlpMDS_)   { assert(false); return false; }
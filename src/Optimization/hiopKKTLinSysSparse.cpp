@@ -242,6 +242,74 @@ namespace hiop
     return true;
   }
 
+  bool hiopKKTLinSysCompressedSparseXYcYd::
+  solveLsqDuals(const hiopVector& rx, const hiopVector& rd,
+                const hiopMatrix& Jac_c, const hiopMatrix& Jac_d, const hiopMatrix& Hess,
+                hiopVector& yc, hiopVector& yd)
+  {
+    const hiopMatrixSparse* HessSp = dynamic_cast<const hiopMatrixSymSparseTriplet*>(&Hess);
+    if(!HessSp) { assert(false); return false; }
+
+    const hiopMatrixSparse* Jac_cSp = dynamic_cast<const hiopMatrixSparseTriplet*>(&Jac_c);
+    if(!Jac_cSp) { assert(false); return false; }
+
+    const hiopMatrixSparse* Jac_dSp = dynamic_cast<const hiopMatrixSparseTriplet*>(&Jac_d);
+    if(!Jac_dSp) { assert(false); return false; }
+
+    long long nx = HessSp->n(), neq=Jac_cSp->m(), nineq=Jac_dSp->m();
+    int nnz = HessSp->numberOfNonzeros() + Jac_cSp->numberOfNonzeros() + Jac_dSp->numberOfNonzeros();
+    nnz += nx + neq + nineq;
+
+    linSys_ = determineAndCreateLinsys(nx, neq, nineq, nnz);
+
+    hiopLinSolverIndefSparse* linSys = dynamic_cast<hiopLinSolverIndefSparse*> (linSys_);
+    assert(linSys);
+
+    hiopMatrixSparseTriplet& Msys = linSys->sysMatrix();
+    {
+      Msys.setToZero();
+
+      // the triplets are placed exactly as in 'updateMatrix' since the symbolic factorization
+      // is shared; the Hessian contributes only its pattern
+      long long dest_nnz_st{0};
+      Msys.copyRowsBlockFrom(*HessSp,  0,   nx,     0,      dest_nnz_st);
+      for(int k=0; k<HessSp->numberOfNonzeros(); k++) {
+        Msys.M()[dest_nnz_st+k] = 0.;
+      }
+      dest_nnz_st += HessSp->numberOfNonzeros();
+      Msys.copyRowsBlockFrom(*Jac_cSp, 0,   neq,    nx,     dest_nnz_st);
+      dest_nnz_st += Jac_cSp->numberOfNonzeros();
+      Msys.copyRowsBlockFrom(*Jac_dSp, 0,   nineq,  nx+neq, dest_nnz_st);
+      dest_nnz_st += Jac_dSp->numberOfNonzeros();
+
+      Msys.setSubDiagonalTo(0,      nx,     1.,  dest_nnz_st); dest_nnz_st += nx;
+      Msys.setSubDiagonalTo(nx,     neq,    0.,  dest_nnz_st); dest_nnz_st += neq;
+      Msys.setSubDiagonalTo(nx+neq, nineq, -1.,  dest_nnz_st); dest_nnz_st += nineq;
+
+      nlp_->log->write("LSQ duals with KKT_SPARSE_XYcYd linsys:", Msys, hovMatrices);
+    }
+
+    int ret_val = linSys->matrixChanged();
+    if(ret_val<0) {
+      nlp_->log->printf(hovWarning, "KKT_SPARSE_XYcYd linsys: error %d in the factorization of the "
+                        "LSQ duals system.\n", ret_val);
+      return false;
+    }
+
+    if(rhs_ == NULL) rhs_ = LinearAlgebraFactory::createVector(nx+neq+nineq);
+    rhs_->setToZero();
+    rhs_->copyFromStarting(0, rx);
+    rhs_->copyFromStarting(nx+neq, rd);
+
+    if(!linSys_->solve(*rhs_)) {
+      nlp_->log->printf(hovWarning, "KKT_SPARSE_XYcYd linsys: error in the solve of the LSQ duals system.\n");
+      return false;
+    }
+    rhs_->startingAtCopyToStartingAt(nx,     yc, 0);
+    rhs_->startingAtCopyToStartingAt(nx+neq, yd, 0);
+    return true;
+  }
+
   hiopLinSolverIndefSparse*
   hiopKKTLinSysCompressedSparseXYcYd::determineAndCreateLinsys(int nx, int neq, int nineq, int nnz)
   {
@@ -466,6 +534,74 @@ namespace hiop
     return true;
   }
 
+  bool hiopKKTLinSysCompressedSparseXDYcYd::
+  solveLsqDuals(const hiopVector& rx, const hiopVector& rd,
+                const hiopMatrix& Jac_c, const hiopMatrix& Jac_d, const hiopMatrix& Hess,
+                hiopVector& yc, hiopVector& yd)
+  {
+    const hiopMatrixSparse* HessSp = dynamic_cast<const hiopMatrixSymSparseTriplet*>(&Hess);
+    if(!HessSp) { assert(false); return false; }
+
+    const hiopMatrixSparse* Jac_cSp = dynamic_cast<const hiopMatrixSparseTriplet*>(&Jac_c);
+    if(!Jac_cSp) { assert(false); return false; }
+
+    const hiopMatrixSparse* Jac_dSp = dynamic_cast<const hiopMatrixSparseTriplet*>(&Jac_d);
+    if(!Jac_dSp) { assert(false); return false; }
+
+    long long nx = HessSp->n(), nd=Jac_dSp->m(), neq=Jac_cSp->m(), nineq=Jac_dSp->m();
+    int nnz = HessSp->numberOfNonzeros() + Jac_cSp->numberOfNonzeros() + Jac_dSp->numberOfNonzeros() + nd + nx + nd + neq + nineq;
+
+    linSys_ = determineAndCreateLinsys(nx, neq, nineq, nnz);
+
+    hiopLinSolverIndefSparse* linSys = dynamic_cast<hiopLinSolverIndefSparse*> (linSys_);
+    assert(linSys);
+
+    hiopMatrixSparseTriplet& Msys = linSys->sysMatrix();
+    {
+      Msys.setToZero();
+
+      // the triplets are placed exactly as in 'updateMatrix' since the symbolic factorization
+      // is shared; the Hessian contributes only its pattern
+      long long dest_nnz_st{0};
+      Msys.copyRowsBlockFrom(*HessSp,  0,   nx,     0,          dest_nnz_st);
+      for(int k=0; k<HessSp->numberOfNonzeros(); k++) {
+        Msys.M()[dest_nnz_st+k] = 0.;
+      }
+      dest_nnz_st += HessSp->numberOfNonzeros();
+      Msys.copyRowsBlockFrom(*Jac_cSp, 0,   neq,    nx+nd,      dest_nnz_st); dest_nnz_st += Jac_cSp->numberOfNonzeros();
+      Msys.copyRowsBlockFrom(*Jac_dSp, 0,   nineq,  nx+nd+neq,  dest_nnz_st); dest_nnz_st += Jac_dSp->numberOfNonzeros();
+
+      Msys.copyDiagMatrixToSubblock(-1., nx+nd+neq, nx, dest_nnz_st, nineq); dest_nnz_st += nineq;
+
+      Msys.setSubDiagonalTo(0,         nx,    1., dest_nnz_st); dest_nnz_st += nx;
+      Msys.setSubDiagonalTo(nx,        nd,    1., dest_nnz_st); dest_nnz_st += nd;
+      Msys.setSubDiagonalTo(nx+nd,     neq,   0., dest_nnz_st); dest_nnz_st += neq;
+      Msys.setSubDiagonalTo(nx+nd+neq, nineq, 0., dest_nnz_st); dest_nnz_st += nineq;
+
+      nlp_->log->write("LSQ duals with KKT_SPARSE_XDYcYd linsys:", Msys, hovMatrices);
+    }
+
+    int ret_val = linSys->matrixChanged();
+    if(ret_val<0) {
+      nlp_->log->printf(hovWarning, "KKT_SPARSE_XDYcYd linsys: error %d in the factorization of the "
+                        "LSQ duals system.\n", ret_val);
+      return false;
+    }
+
+    if(rhs_ == NULL) rhs_ = LinearAlgebraFactory::createVector(nx+nd+neq+nineq);
+    rhs_->setToZero();
+    rhs_->copyFromStarting(0, rx);
+    rhs_->copyFromStarting(nx, rd);
+
+    if(!linSys_->solve(*rhs_)) {
+      nlp_->log->printf(hovWarning, "KKT_SPARSE_XDYcYd linsys: error in the solve of the LSQ duals system.\n");
+      return false;
+    }
+    rhs_->startingAtCopyToStartingAt(nx+nd,     yc, 0);
+    rhs_->startingAtCopyToStartingAt(nx+nd+neq, yd, 0);
+    return true;
+  }
+
   hiopLinSolverIndefSparse*
   hiopKKTLinSysCompressedSparseXDYcYd::determineAndCreateLinsys(int nx, int neq, int nineq, int nnz)
   {
@@ -84,6 +84,16 @@ public:
   virtual bool solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
                                hiopVector& dx, hiopVector& dyc, hiopVector& dyd);
 
+  /* solves the LSQ duals system in the XYcYd form
+   * [  I    Jc^T  Jd^T ] [ dx]   [ rx ]
+   * [  Jc    0     0   ] [ yc] = [ 0  ]
+   * [  Jd    0    -I   ] [ yd]   [ rd ]
+   * with the linear solver of this KKT system (see hiopKKTLinSys::solveLsqDuals) */
+  virtual bool solveLsqDuals(const hiopVector& rx, const hiopVector& rd,
+                             const hiopMatrix& Jac_c, const hiopMatrix& Jac_d, const hiopMatrix& Hess,
+                             hiopVector& yc, hiopVector& yd);
+  virtual bool supportsLsqDuals() const { return true; }
+
 protected:
   hiopVector *rhs_; //[rx_tilde, ryc_tilde, ryd_tilde]
 
@@ -144,6 +154,17 @@ public:
   virtual bool solveCompressed(hiopVector& rx, hiopVector& rd, hiopVector& ryc, hiopVector& ryd,
                                hiopVector& dx, hiopVector& dd, hiopVector& dyc, hiopVector& dyd);
 
+  /* solves the LSQ duals system
+   * [  I    0    Jc^T  Jd^T ] [ dx]   [ rx ]
+   * [  0    I     0     -I  ] [ dd]   [ rd ]
+   * [  Jc   0     0      0  ] [ yc] = [ 0  ]
+   * [  Jd  -I     0      0  ] [ yd]   [ 0  ]
+   * with the linear solver of this KKT system (see hiopKKTLinSys::solveLsqDuals) */
+  virtual bool solveLsqDuals(const hiopVector& rx, const hiopVector& rd,
+                             const hiopMatrix& Jac_c, const hiopMatrix& Jac_d, const hiopMatrix& Hess,
+                             hiopVector& yc, hiopVector& yd);
+  virtual bool supportsLsqDuals() const { return true; }
+
 protected:
   hiopVector *rhs_; //[rx_tilde, rd_tilde, ryc, ryd]
 
@@ -52,6 +52,7 @@
 #include "hiopLinAlgFactory.hpp"
 #include "hiopLogger.hpp"
 #include "hiopDualsUpdater.hpp"
+#include "hiopProfiler.hpp"
 
 #ifdef HIOP_USE_MPI
 #include "mpi.h"
@@ -62,6 +63,7 @@
 #include <stdlib.h>     /* exit, EXIT_FAILURE */
 
 #include <cassert>
+#include <algorithm>
 namespace hiop
 {
 
@@ -129,6 +131,11 @@ hiopNlpFormulation::hiopNlpFormulation(hiopInterfaceBase& interface_)
   cons_Jac_ = NULL;
   cons_lambdas_ = nullptr;
   nlp_scaling = nullptr;
+  relax_bounds_ = nullptr;
+  scale_obj_user_ = 1.;
+  quasi_newton_hessian_ = false;
+  scale_c_user_ = nullptr;
+  scale_d_user_ = nullptr;
 }
 
 hiopNlpFormulation::~hiopNlpFormulation()
@@ -166,11 +173,18 @@ hiopNlpFormulation::~hiopNlpFormulation()
   delete cons_body_;
   delete cons_Jac_;
   delete cons_lambdas_;
+  delete scale_c_user_;
+  delete scale_d_user_;
 //  if(nlp_scaling) delete nlp_scaling;  // deleted inside nlp_transformations
 }
 
 bool hiopNlpFormulation::finalizeInitialization()
 {
+  //'Hessian' defaults to a quasi-Newton value, which is ignored by the formulations that provide 
+  //the Hessian (MDS and sparse) unless set explicitly by the user
+  quasi_newton_hessian_ = "analytical_exact"!=options->GetString("Hessian") && 
+    options->is_user_defined("Hessian");
+
   //check if there was a change in the user options that requires reinitialization of 'this'
   bool doinit = false; 
   if(strFixedVars != options->GetString("fixed_var")) {
@@ -195,6 +209,9 @@ bool hiopNlpFormulation::finalizeInitialization()
 
   nlp_transformations.clear();
   nlp_transformations.setUserNlpNumVars(n_vars);
+  //were deleted by the above 'clear'
+  nlp_scaling = nullptr;
+  relax_bounds_ = nullptr;
 
   if(xl) delete xl;
   if(xu) delete xu;
@@ -460,10 +477,10 @@ bool hiopNlpFormulation::finalizeInitialization()
 
   // relax bounds
   if(options->GetNumeric("bound_relax_perturb") > 0.0) {
-    auto* relax_bounds = new hiopBoundsRelaxer(*xl, *xu, *dl, *du);
-    relax_bounds->setup();
-    relax_bounds->relax(options->GetNumeric("bound_relax_perturb"), *xl, *xu, *dl, *du);
-    nlp_transformations.append(relax_bounds);
+    relax_bounds_ = new hiopBoundsRelaxer(*xl, *xu, *dl, *du);
+    relax_bounds_->setup();
+    relax_bounds_->relax(options->GetNumeric("bound_relax_perturb"), *xl, *xu, *dl, *du);
+    nlp_transformations.append(relax_bounds_);
   }
 
   // Copy data from host mirror to the memory space
@@ -496,15 +513,28 @@ bool hiopNlpFormulation::apply_scaling(hiopVector& c, hiopVector& d, hiopVector&
   if("none" == options->GetString("scaling_type")) {
     return false;
   }
-  
-  const double max_grad = options->GetNumeric("scaling_max_grad");
 
-  if(gradf.infnorm() < max_grad && Jac_c.max_abs_value() < max_grad && Jac_d.max_abs_value() < max_grad)
-  {
+  //repeated solve of the same NLP: the scaling is already part of the NLP transformations (and 
+  //was applied to the evaluations done by the caller) and is reused
+  if(nlp_scaling) {
     return false;
   }
   
-  nlp_scaling = new hiopNLPObjGradScaling(max_grad, c, d, gradf, Jac_c, Jac_d, cons_eq_mapping_, cons_ineq_mapping_);
+  if(scale_c_user_ && scale_d_user_ &&
+     scale_c_user_->get_size()==n_cons_eq && scale_d_user_->get_size()==n_cons_ineq) {
+    nlp_scaling = new hiopNLPObjGradScaling(scale_obj_user_, *scale_c_user_, *scale_d_user_, gradf,
+                                            cons_eq_mapping_, cons_ineq_mapping_);
+  } else {
+    const double max_grad = options->GetNumeric("scaling_max_grad");
+
+    if(gradf.infnorm() < max_grad && Jac_c.max_abs_value() < max_grad && Jac_d.max_abs_value() < max_grad)
+    {
+      return false;
+    }
+  
+    nlp_scaling = new hiopNLPObjGradScaling(max_grad, c, d, gradf, Jac_c, Jac_d,
+                                            cons_eq_mapping_, cons_ineq_mapping_);
+  }
   
   // FIXME NY: scale the constraint lb and ub  
   c_rhs = nlp_scaling->apply_to_cons_eq(*c_rhs, n_cons_eq);
@@ -520,6 +550,135 @@ bool hiopNlpFormulation::apply_scaling(hiopVector& c, hiopVector& d, hiopVector&
 }
 
 
+bool hiopNlpFormulation::reload_bounds_data()
+{
+  //transformations other than the scaling depend on the bounds and would need to be rebuilt
+  const size_t n_trans_bounds = nlp_transformations.size() - (nlp_scaling ? 1 : 0) - (relax_bounds_ ? 1 : 0);
+  bool same_struct = (NULL!=xl && NULL!=c_rhs && 0==n_trans_bounds);
+
+  long long n_vars_user=-1, n_cons_user=-1;
+  if(same_struct) {
+    bool bret = interface_base.get_prob_sizes(n_vars_user, n_cons_user); assert(bret);
+    same_struct = (n_vars_user==n_vars && n_cons_user==n_cons);
+  }
+
+  hiopVector* xl_new = NULL, *xu_new = NULL;
+  if(same_struct) {
+    xl_new = xl->alloc_clone();
+    xu_new = xu->alloc_clone();
+    const int nlocal = xl->get_local_size();
+    double* xl_vec = xl_new->local_data_host();
+    double* xu_vec = xu_new->local_data_host();
+    hiopInterfaceBase::NonlinearityType* vt = new hiopInterfaceBase::NonlinearityType[nlocal];
+    bool bret = interface_base.get_vars_info(n_vars, xl_vec, xu_vec, vt); assert(bret);
+    delete[] vt;
+
+    const double* ixl_vec = ixl->local_data_host();
+    const double* ixu_vec = ixu->local_data_host();
+    for(int i=0; i<nlocal && same_struct; i++) {
+      if((xl_vec[i]>-1e20) != (ixl_vec[i]==1.) || (xu_vec[i]<1e20) != (ixu_vec[i]==1.)) {
+        same_struct = false;
+      }
+      //a variable that became fixed requires the fixed variables treatment
+      if(fabs(xl_vec[i]-xu_vec[i])<= dFixedVarsTol*fmax(1.,fabs(xu_vec[i]))) {
+        same_struct = false;
+      }
+    }
+#ifdef HIOP_USE_MPI
+    int loc_ok = same_struct ? 1 : 0, glob_ok = 0;
+    int ierr = MPI_Allreduce(&loc_ok, &glob_ok, 1, MPI_INT, MPI_MIN, comm); assert(MPI_SUCCESS==ierr);
+    same_struct = (glob_ok==1);
+#endif
+  }
+
+  hiopVector* gl = NULL, *gu = NULL;
+  if(same_struct) {
+    gl = LinearAlgebraFactory::createVector(n_cons); 
+    gu = LinearAlgebraFactory::createVector(n_cons);
+    double *gl_vec=gl->local_data_host(), *gu_vec=gu->local_data_host();
+    hiopInterfaceBase::NonlinearityType* cons_type = new hiopInterfaceBase::NonlinearityType[n_cons];
+    bool bret = interface_base.get_cons_info(n_cons, gl_vec, gu_vec, cons_type); assert(bret);
+    delete[] cons_type;
+
+    const double* idl_vec = idl->local_data_host();
+    const double* idu_vec = idu->local_data_host();
+    int it_eq=0, it_ineq=0;
+    for(int i=0; i<n_cons && same_struct; i++) {
+      if(gl_vec[i]==gu_vec[i]) {
+        same_struct = (it_eq<n_cons_eq && cons_eq_mapping_[it_eq]==i);
+        it_eq++;
+      } else {
+        same_struct = (it_ineq<n_cons_ineq && cons_ineq_mapping_[it_ineq]==i) &&
+          (gl_vec[i]>-1e20) == (idl_vec[it_ineq]==1.) && (gu_vec[i]<1e20) == (idu_vec[it_ineq]==1.);
+        it_ineq++;
+      }
+    }
+  }
+
+  if(!same_struct) {
+    log->printf(hovWarning, "The structure of the problem changed; a full re-initialization will be done.\n");
+    //forces 'finalizeInitialization' to redo the setup of 'this'
+    strFixedVars.clear();
+    delete xl_new; delete xu_new;
+    delete gl; delete gu;
+    return false;
+  }
+
+  xl->copyFrom(*xl_new);
+  xu->copyFrom(*xu_new);
+  delete xl_new; delete xu_new;
+  xl->copyToDev(); xu->copyToDev();
+
+  const double *gl_vec=gl->local_data_host(), *gu_vec=gu->local_data_host();
+  double *c_rhsvec=c_rhs->local_data_host();
+  double *dlvec=dl->local_data_host(), *duvec=du->local_data_host();
+  for(int i=0; i<n_cons_eq; i++) {
+    c_rhsvec[i] = gl_vec[cons_eq_mapping_[i]];
+  }
+  for(int i=0; i<n_cons_ineq; i++) {
+    dlvec[i] = gl_vec[cons_ineq_mapping_[i]];
+    duvec[i] = gu_vec[cons_ineq_mapping_[i]];
+  }
+  delete gl; delete gu;
+  c_rhs->copyToDev();
+  dl->copyToDev(); du->copyToDev();
+
+  if(relax_bounds_) {
+    relax_bounds_->set_original_bounds(*xl, *xu, *dl, *du);
+    relax_bounds_->relax(options->GetNumeric("bound_relax_perturb"), *xl, *xu, *dl, *du);
+  }
+
+  //the scaling computed by the previous solve is kept and applied to the new data
+  if(nlp_scaling) {
+    nlp_scaling->apply_to_cons_eq(*c_rhs, n_cons_eq);
+    nlp_scaling->apply_to_cons_ineq(*dl, n_cons_ineq);
+    nlp_scaling->apply_to_cons_ineq(*du, n_cons_ineq);
+  }
+  return true;
+}
+
+bool hiopNlpFormulation::get_scaling_factors(double& scale_obj, hiopVector& scale_c, hiopVector& scale_d) const
+{
+  if(NULL == nlp_scaling) {
+    return false;
+  }
+  scale_obj = nlp_scaling->get_obj_scale();
+  scale_c.copyFrom(nlp_scaling->get_cons_eq_scale());
+  scale_d.copyFrom(nlp_scaling->get_cons_ineq_scale());
+  return true;
+}
+
+void hiopNlpFormulation::set_scaling_factors(const double& scale_obj,
+                                             const hiopVector& scale_c,
+                                             const hiopVector& scale_d)
+{
+  delete scale_c_user_;
+  delete scale_d_user_;
+  scale_obj_user_ = scale_obj;
+  scale_c_user_ = scale_c.new_copy();
+  scale_d_user_ = scale_d.new_copy();
+}
+
 hiopVector* hiopNlpFormulation::alloc_primal_vec() const
 {
   return xl->alloc_clone();
@@ -544,8 +703,35 @@ hiopVector* hiopNlpFormulation::alloc_dual_vec() const
   return ret;
 }
 
+hiopMatrixDense* hiopNlpFormulation::alloc_multivector_primal(int nrows, int maxrows/*=-1*/) const
+{
+  hiopMatrixDense* M;
+#ifdef HIOP_USE_MPI
+  //long long* vec_distrib=new long long[num_ranks+1];
+  //if(true==interface.get_vecdistrib_info(n_vars,vec_distrib)) 
+  if(vec_distrib)
+  {
+    M = LinearAlgebraFactory::createMatrixDense(nrows, n_vars, vec_distrib, comm, maxrows);
+  } else {
+    //the if is not really needed, but let's keep it clear, costs only a comparison
+    if(-1==maxrows)
+      M = LinearAlgebraFactory::createMatrixDense(nrows, n_vars);   
+    else
+      M = LinearAlgebraFactory::createMatrixDense(nrows, n_vars, NULL, MPI_COMM_SELF, maxrows);
+  }
+#else
+  //the if is not really needed, but let's keep it clear, costs only a comparison
+  if(-1==maxrows)
+    M = LinearAlgebraFactory::createMatrixDense(nrows, n_vars);   
+  else
+    M = LinearAlgebraFactory::createMatrixDense(nrows, n_vars, NULL, MPI_COMM_SELF, maxrows);
+#endif
+  return M;
+}
+
 bool hiopNlpFormulation::eval_f(hiopVector& x, bool new_x, double& f)
 {
+  HIOP_PROFILE_SCOPE("nlp_eval_f");
   hiopVector* xx = nlp_transformations.apply_inv_to_x(x, new_x);
 
   runStats.tmEvalObj.start();
@@ -558,8 +744,9 @@ bool hiopNlpFormulation::eval_f(hiopVector& x, bool new_x, double& f)
 
 bool hiopNlpFormulation::eval_grad_f(hiopVector& x, bool new_x, hiopVector& gradf)
 {
+  HIOP_PROFILE_SCOPE("nlp_eval_grad_f");
   hiopVector* xx = nlp_transformations.apply_inv_to_x(x, new_x);
-  hiopVector* gradff = nlp_transformations.apply_inv_to_grad_obj(gradf);
+  hiopVector* gradff = nlp_transformations.user_buffer_grad_obj(gradf);
   bool bret; 
   runStats.tmEvalGrad_f.start();
   bret = interface_base.eval_grad_f(nlp_transformations.n_pre(), xx->local_data_const(), new_x, gradff->local_data());
@@ -622,6 +809,7 @@ bool hiopNlpFormulation::get_starting_point(hiopVector& x0_for_hiop,
 
 bool hiopNlpFormulation::eval_c(hiopVector& x, bool new_x, hiopVector& c)
 {
+  HIOP_PROFILE_SCOPE("nlp_eval_c");
   hiopVector* xx = nlp_transformations.apply_inv_to_x(x, new_x);
   hiopVector* cc = &c;
   // nlp_transformations.apply_inv_to_cons_eq(c, n_cons_eq);  // NOT required
@@ -641,6 +829,7 @@ bool hiopNlpFormulation::eval_c(hiopVector& x, bool new_x, hiopVector& c)
 }
 bool hiopNlpFormulation::eval_d(hiopVector& x, bool new_x, hiopVector& d)
 {
+  HIOP_PROFILE_SCOPE("nlp_eval_d");
   hiopVector* xx = nlp_transformations.apply_inv_to_x(x, new_x);
   hiopVector* dd = &d;
   // nlp_transformations.apply_inv_to_cons_ineq(d, n_cons_ineq);  // NOT required for now
@@ -658,6 +847,7 @@ bool hiopNlpFormulation::eval_d(hiopVector& x, bool new_x, hiopVector& d)
 
 bool hiopNlpFormulation::eval_c_d(hiopVector& x, bool new_x, hiopVector& c, hiopVector& d)
 {
+  HIOP_PROFILE_SCOPE("nlp_eval_c_d");
   bool do_eval_c = true;
   if(-1 == cons_eval_type_) {
     assert(cons_body_ == nullptr);
@@ -723,6 +913,7 @@ bool hiopNlpFormulation::eval_c_d(hiopVector& x, bool new_x, hiopVector& c, hiop
 
 bool hiopNlpFormulation::eval_Jac_c_d(hiopVector& x, bool new_x, hiopMatrix& Jac_c, hiopMatrix& Jac_d)
 {
+  HIOP_PROFILE_SCOPE("nlp_eval_Jac_c_d");
   bool do_eval_Jac_c = true;
   if(-1 == cons_eval_type_) {
     assert(cons_body_ == nullptr);
@@ -952,6 +1143,7 @@ hiopDualsLsqUpdate* hiopNlpDenseConstraints::alloc_duals_lsq_updater()
 
 bool hiopNlpDenseConstraints::eval_Jac_c(hiopVector& x, bool new_x, double* Jac_c)
 {
+  HIOP_PROFILE_SCOPE("nlp_eval_Jac_c");
 #if 0
   hiopVector* x_user  = nlp_transformations.apply_inv_to_x(x, new_x);
   double* Jac_c_user = nlp_transformations.apply_inv_to_jacob_eq(Jac_c, n_cons_eq);
@@ -970,6 +1162,7 @@ bool hiopNlpDenseConstraints::eval_Jac_c(hiopVector& x, bool new_x, double* Jac_
 }
 bool hiopNlpDenseConstraints::eval_Jac_d(hiopVector& x, bool new_x, double* Jac_d)
 {
+  HIOP_PROFILE_SCOPE("nlp_eval_Jac_d");
 #if 0
   hiopVector* x_user  = nlp_transformations.apply_inv_to_x(x, new_x);
   double* Jac_d_user = nlp_transformations.apply_inv_to_jacob_ineq(Jac_d, n_cons_ineq);
@@ -999,7 +1192,7 @@ bool hiopNlpDenseConstraints::eval_Jac_c_d_interface_impl(hiopVector& x, bool ne
 
   hiopVector* x_user = nlp_transformations.apply_inv_to_x(x, new_x);
   double* Jac_consde = cons_Jac_de->local_data();
-  hiopMatrix* Jac_user = nlp_transformations.apply_inv_to_jacob_cons(*cons_Jac_, n_cons);
+  hiopMatrix* Jac_user = nlp_transformations.user_buffer_jacob_cons(*cons_Jac_, n_cons);
 
   hiopMatrixDense* cons_Jac_user_de = dynamic_cast<hiopMatrixDense*>(Jac_user);
   if(cons_Jac_user_de == NULL) {
@@ -1012,6 +1205,9 @@ bool hiopNlpDenseConstraints::eval_Jac_c_d_interface_impl(hiopVector& x, bool ne
 				      x_user->local_data_const(), new_x,
 				      cons_Jac_user_de->local_data());
   
+  //removes the fixed variables and scales the rows of the Jacobian of all constraints, which is then
+  //split below; the transformations of the Jacobians of the equalities and inequalities are not used
+  //since these work with the buffers passed to their 'user_buffer_xxx' counterparts
   cons_Jac_ = nlp_transformations.apply_to_jacob_cons(*Jac_user, n_cons);
   
   hiopMatrixDense* Jac_cde = dynamic_cast<hiopMatrixDense*>(&Jac_c);
@@ -1026,10 +1222,6 @@ bool hiopNlpDenseConstraints::eval_Jac_c_d_interface_impl(hiopVector& x, bool ne
 
   Jac_cde->copyRowsFrom(*cons_Jac_, cons_eq_mapping_, n_cons_eq);
   Jac_dde->copyRowsFrom(*cons_Jac_, cons_ineq_mapping_, n_cons_ineq);
-  
-  // scale Jacobian matrices
-  Jac_c = *(nlp_transformations.apply_inv_to_jacob_eq(Jac_c, n_cons_eq));
-  Jac_d = *(nlp_transformations.apply_inv_to_jacob_ineq(Jac_d, n_cons_ineq));
 
   runStats.tmEvalJac_con.stop();
   runStats.nEvalJac_con_eq++;
@@ -1040,6 +1232,7 @@ bool hiopNlpDenseConstraints::eval_Jac_c_d_interface_impl(hiopVector& x, bool ne
 
 bool hiopNlpDenseConstraints::eval_Jac_c(hiopVector& x, bool new_x, hiopMatrix& Jac_c)
 {
+  HIOP_PROFILE_SCOPE("nlp_eval_Jac_c");
   hiopMatrixDense* Jac_cde = dynamic_cast<hiopMatrixDense*>(&Jac_c);
   if(Jac_cde==NULL) {
     log->printf(hovError, "[internal error] hiopNlpDenseConstraints NLP works only with dense matrices\n");
@@ -1048,7 +1241,7 @@ bool hiopNlpDenseConstraints::eval_Jac_c(hiopVector& x, bool new_x, hiopMatrix&
     // old code
 //    return this->eval_Jac_c(x, new_x, Jac_cde->local_data());
     hiopVector* x_user = nlp_transformations.apply_inv_to_x(x, new_x);
-    hiopMatrix* Jac_c_user = nlp_transformations.apply_inv_to_jacob_eq(Jac_c, n_cons_eq);
+    hiopMatrix* Jac_c_user = nlp_transformations.user_buffer_jacob_eq(Jac_c, n_cons_eq);
     if(Jac_c_user==nullptr) {
       log->printf(hovError, "[internal error] hiopFixedVarsRemover works only with dense matrices\n");
       return false;
@@ -1073,6 +1266,7 @@ bool hiopNlpDenseConstraints::eval_Jac_c(hiopVector& x, bool new_x, hiopMatrix&
 
 bool hiopNlpDenseConstraints::eval_Jac_d(hiopVector& x, bool new_x, hiopMatrix& Jac_d)
 {
+  HIOP_PROFILE_SCOPE("nlp_eval_Jac_d");
   hiopMatrixDense* Jac_dde = dynamic_cast<hiopMatrixDense*>(&Jac_d);
   if(Jac_dde==NULL) {
     log->printf(hovError, "[internal error] hiopNlpDenseConstraints NLP works only with dense matrices\n");
@@ -1082,7 +1276,7 @@ bool hiopNlpDenseConstraints::eval_Jac_d(hiopVector& x, bool new_x, hiopMatrix&
 //    return this->eval_Jac_d(x, new_x, Jac_dde->local_data());
 
     hiopVector* x_user = nlp_transformations.apply_inv_to_x(x, new_x);
-    hiopMatrix* Jac_d_user = nlp_transformations.apply_inv_to_jacob_ineq(Jac_d, n_cons_ineq);
+    hiopMatrix* Jac_d_user = nlp_transformations.user_buffer_jacob_ineq(Jac_d, n_cons_ineq);
     if(Jac_d_user==nullptr) {
       log->printf(hovError, "[internal error] hiopFixedVarsRemover works only with dense matrices\n");
       return false;
@@ -1125,30 +1319,85 @@ hiopMatrix* hiopNlpDenseConstraints::alloc_Hess_Lagr()
   return new hiopHessianLowRank(this, this->options->GetInteger("secant_memory_len"));
 }
 
-hiopMatrixDense* hiopNlpDenseConstraints::alloc_multivector_primal(int nrows, int maxrows/*=-1*/) const
+/* ***********************************************************************************
+ *    hiopSparseStructure class implementation 
+ * ***********************************************************************************
+ */
+void hiopSparseStructure::reset()
 {
-  hiopMatrixDense* M;
-#ifdef HIOP_USE_MPI
-  //long long* vec_distrib=new long long[num_ranks+1];
-  //if(true==interface.get_vecdistrib_info(n_vars,vec_distrib)) 
-  if(vec_distrib)
-  {
-    M = LinearAlgebraFactory::createMatrixDense(nrows, n_vars, vec_distrib, comm, maxrows);
-  } else {
-    //the if is not really needed, but let's keep it clear, costs only a comparison
-    if(-1==maxrows)
-      M = LinearAlgebraFactory::createMatrixDense(nrows, n_vars);   
-    else
-      M = LinearAlgebraFactory::createMatrixDense(nrows, n_vars, NULL, MPI_COMM_SELF, maxrows);
+  frozen_ = false;
+  perm_.clear();
+  buf_.clear();
+  irow_.clear();
+  jcol_.clear();
+}
+
+bool hiopSparseStructure::freeze(hiopLogger* log, const char* name,
+                                 int nrows, int ncols, int nnz, int* irow, int* jcol, double* values,
+                                 bool on_host)
+{
+  assert(!frozen_);
+  reset();
+  if(!on_host) {
+    //the indexes are requested at each evaluation
+    return true;
   }
-#else
-  //the if is not really needed, but let's keep it clear, costs only a comparison
-  if(-1==maxrows)
-    M = LinearAlgebraFactory::createMatrixDense(nrows, n_vars);   
-  else
-    M = LinearAlgebraFactory::createMatrixDense(nrows, n_vars, NULL, MPI_COMM_SELF, maxrows);
-#endif
-  return M;
+  frozen_ = true;
+  if(0==nnz) {
+    return true;
+  }
+  assert(irow && jcol);
+
+  bool is_sorted = true;
+  for(int k=0; k<nnz; k++) {
+    if(irow[k]<0 || irow[k]>=nrows || jcol[k]<0 || jcol[k]>=ncols) {
+      log->printf(hovError,
+                  "%s: nonzero %d has (i,j)=(%d,%d) outside of the %dx%d block\n",
+                  name, k, irow[k], jcol[k], nrows, ncols);
+      frozen_ = false;
+      return false;
+    }
+    if(k>0 && (irow[k]<irow[k-1] || (irow[k]==irow[k-1] && jcol[k]<jcol[k-1]))) {
+      is_sorted = false;
+    }
+  }
+  if(is_sorted) {
+    irow_.assign(irow, irow+nnz);
+    jcol_.assign(jcol, jcol+nnz);
+    return true;
+  }
+
+  //sort (i,j) row-major and remember the permutation for the values
+  perm_.resize(nnz);
+  for(int k=0; k<nnz; k++) {
+    perm_[k] = k;
+  }
+  std::sort(perm_.begin(), perm_.end(),
+            [&](const int& a, const int& b)
+            {
+              return irow[a]<irow[b] || (irow[a]==irow[b] && jcol[a]<jcol[b]);
+            });
+
+  std::vector<int> idx_user(irow, irow+nnz);
+  for(int k=0; k<nnz; k++) {
+    irow[k] = idx_user[perm_[k]];
+  }
+  idx_user.assign(jcol, jcol+nnz);
+  for(int k=0; k<nnz; k++) {
+    jcol[k] = idx_user[perm_[k]];
+  }
+  buf_.resize(nnz);
+  if(values) {
+    buf_.assign(values, values+nnz);
+    apply(values);
+  }
+  irow_.assign(irow, irow+nnz);
+  jcol_.assign(jcol, jcol+nnz);
+
+  log->printf(hovScalars,
+              "%s: user (i,j) indexes are not row-major ordered; values will be permuted\n",
+              name);
+  return true;
 }
 
 /* ***********************************************************************************
@@ -1173,6 +1422,7 @@ hiopDualsLsqUpdate* hiopNlpMDS::alloc_duals_lsq_updater()
 
 bool hiopNlpMDS::eval_Jac_c(hiopVector& x, bool new_x, hiopMatrix& Jac_c)
 {
+  HIOP_PROFILE_SCOPE("nlp_eval_Jac_c");
   hiopMatrixMDS* pJac_c = dynamic_cast<hiopMatrixMDS*>(&Jac_c);
   assert(pJac_c);
   if(pJac_c) {
@@ -1185,12 +1435,28 @@ bool hiopNlpMDS::eval_Jac_c(hiopVector& x, bool new_x, hiopMatrix& Jac_c)
     runStats.tmEvalJac_con.start();
     
     int nnz = pJac_c->sp_nnz();
-    bool bret = interface.eval_Jac_cons(n_vars, n_cons, 
-					n_cons_eq, cons_eq_mapping_, 
-					x_user->local_data_const(), new_x,
-					pJac_c->n_sp(), pJac_c->n_de(), 
-					nnz, pJac_c->sp_irow(), pJac_c->sp_jcol(), pJac_c->sp_M(),
-					pJac_c->de_local_data());
+    bool bret = true;
+    if(!jac_c_struct_.is_frozen()) {
+      //first evaluation: indexes and values in one call
+      bret = interface.eval_Jac_cons(n_vars, n_cons, 
+                                     n_cons_eq, cons_eq_mapping_, 
+                                     x_user->local_data_const(), new_x,
+                                     pJac_c->n_sp(), pJac_c->n_de(), 
+                                     nnz, pJac_c->sp_irow(), pJac_c->sp_jcol(), pJac_c->sp_M(),
+                                     pJac_c->de_local_data());
+      bret = bret && jac_c_struct_.freeze(log, "Jacobian of equalities (sparse block)",
+                                          n_cons_eq, pJac_c->n_sp(), nnz,
+                                          pJac_c->sp_irow(), pJac_c->sp_jcol(), pJac_c->sp_M(),
+                                          "default"==options->GetString("mem_space"));
+    } else {
+      bret = interface.eval_Jac_cons(n_vars, n_cons, 
+                                     n_cons_eq, cons_eq_mapping_, 
+                                     x_user->local_data_const(), new_x,
+                                     pJac_c->n_sp(), pJac_c->n_de(), 
+                                     nnz, NULL, NULL, jac_c_struct_.values_buffer(pJac_c->sp_M()),
+                                     pJac_c->de_local_data());
+      jac_c_struct_.apply(pJac_c->sp_M());
+    }
 
     // scale the matrix
     Jac_c = *(nlp_transformations.apply_to_jacob_eq(Jac_c, n_cons_eq));
@@ -1205,6 +1471,7 @@ bool hiopNlpMDS::eval_Jac_c(hiopVector& x, bool new_x, hiopMatrix& Jac_c)
 
 bool hiopNlpMDS::eval_Jac_d(hiopVector& x, bool new_x, hiopMatrix& Jac_d)
 {
+  HIOP_PROFILE_SCOPE("nlp_eval_Jac_d");
   hiopMatrixMDS* pJac_d = dynamic_cast<hiopMatrixMDS*>(&Jac_d);
   assert(pJac_d);
   if(pJac_d) {
@@ -1217,12 +1484,28 @@ bool hiopNlpMDS::eval_Jac_d(hiopVector& x, bool new_x, hiopMatrix& Jac_d)
     runStats.tmEvalJac_con.start();
   
     int nnz = pJac_d->sp_nnz();
-    bool bret =  interface.eval_Jac_cons(n_vars, n_cons, 
-					 n_cons_ineq, cons_ineq_mapping_, 
-					 x_user->local_data_const(), new_x,
-					 pJac_d->n_sp(), pJac_d->n_de(), 
-					 nnz, pJac_d->sp_irow(), pJac_d->sp_jcol(), pJac_d->sp_M(),
-					 pJac_d->de_local_data());
+    bool bret = true;
+    if(!jac_d_struct_.is_frozen()) {
+      //first evaluation: indexes and values in one call
+      bret = interface.eval_Jac_cons(n_vars, n_cons, 
+                                     n_cons_ineq, cons_ineq_mapping_, 
+                                     x_user->local_data_const(), new_x,
+                                     pJac_d->n_sp(), pJac_d->n_de(), 
+                                     nnz, pJac_d->sp_irow(), pJac_d->sp_jcol(), pJac_d->sp_M(),
+                                     pJac_d->de_local_data());
+      bret = bret && jac_d_struct_.freeze(log, "Jacobian of inequalities (sparse block)",
+                                          n_cons_ineq, pJac_d->n_sp(), nnz,
+                                          pJac_d->sp_irow(), pJac_d->sp_jcol(), pJac_d->sp_M(),
+                                          "default"==options->GetString("mem_space"));
+    } else {
+      bret = interface.eval_Jac_cons(n_vars, n_cons, 
+                                     n_cons_ineq, cons_ineq_mapping_, 
+                                     x_user->local_data_const(), new_x,
+                                     pJac_d->n_sp(), pJac_d->n_de(), 
+                                     nnz, NULL, NULL, jac_d_struct_.values_buffer(pJac_d->sp_M()),
+                                     pJac_d->de_local_data());
+      jac_d_struct_.apply(pJac_d->sp_M());
+    }
 
     // scale the matrix
     Jac_d = *(nlp_transformations.apply_to_jacob_ineq(Jac_d, n_cons_ineq));
@@ -1259,11 +1542,26 @@ bool hiopNlpMDS::eval_Jac_c_d_interface_impl(hiopVector& x,
     runStats.tmEvalJac_con.start();
   
     int nnz = cons_Jac->sp_nnz();
-    bool bret = interface.eval_Jac_cons(n_vars, n_cons, 
-					x_user->local_data_const(), new_x,
-					pJac_d->n_sp(), pJac_d->n_de(), 
-					nnz, cons_Jac->sp_irow(), cons_Jac->sp_jcol(), cons_Jac->sp_M(),
-					cons_Jac->de_local_data());
+    bool bret = true;
+    if(!jac_cons_struct_.is_frozen()) {
+      //first evaluation: indexes and values in one call
+      bret = interface.eval_Jac_cons(n_vars, n_cons, 
+                                     x_user->local_data_const(), new_x,
+                                     pJac_d->n_sp(), pJac_d->n_de(), 
+                                     nnz, cons_Jac->sp_irow(), cons_Jac->sp_jcol(), cons_Jac->sp_M(),
+                                     cons_Jac->de_local_data());
+      bret = bret && jac_cons_struct_.freeze(log, "Jacobian of constraints (sparse block)",
+                                             n_cons, cons_Jac->n_sp(), nnz,
+                                             cons_Jac->sp_irow(), cons_Jac->sp_jcol(), cons_Jac->sp_M(),
+                                             "default"==options->GetString("mem_space"));
+    } else {
+      bret = interface.eval_Jac_cons(n_vars, n_cons, 
+                                     x_user->local_data_const(), new_x,
+                                     pJac_d->n_sp(), pJac_d->n_de(), 
+                                     nnz, NULL, NULL, jac_cons_struct_.values_buffer(cons_Jac->sp_M()),
+                                     cons_Jac->de_local_data());
+      jac_cons_struct_.apply(cons_Jac->sp_M());
+    }
     
     //copy back to Jac_c and Jac_d
     pJac_c->copyRowsFrom(*cons_Jac, cons_eq_mapping_, n_cons_eq);
@@ -1288,6 +1586,11 @@ bool hiopNlpMDS::eval_Hess_Lagr(const hiopVector& x, bool new_x, const double& o
 			      const hiopVector& lambda_eq, const hiopVector& lambda_ineq, bool new_lambdas,
 			      hiopMatrix& Hess_L)
 {
+  HIOP_PROFILE_SCOPE("nlp_eval_Hess_Lagr");
+  if(quasi_newton_hessian()) {
+    //silently ignore the call since we're in the quasi-Newton case
+    return true;
+  }
   hiopMatrixSymBlockDiagMDS* pHessL = dynamic_cast<hiopMatrixSymBlockDiagMDS*>(&Hess_L);
   assert(pHessL);
 
@@ -1313,12 +1616,28 @@ bool hiopNlpMDS::eval_Hess_Lagr(const hiopVector& x, bool new_x, const double& o
 
     int nnzHSS = pHessL->sp_nnz(), nnzHSD = 0;
     
-    bret = interface.eval_Hess_Lagr(n_vars, n_cons, x.local_data_const(), new_x, 
-				    obj_factor_with_scale, _buf_lambda->local_data(), new_lambdas, 
-				    pHessL->n_sp(), pHessL->n_de(),
-				    nnzHSS, pHessL->sp_irow(), pHessL->sp_jcol(), pHessL->sp_M(),
-				    pHessL->de_local_data(),
-				    nnzHSD, NULL, NULL, NULL);
+    bret = true;
+    if(!hess_struct_.is_frozen()) {
+      //first evaluation: indexes and values in one call
+      bret = interface.eval_Hess_Lagr(n_vars, n_cons, x.local_data_const(), new_x, 
+                                      obj_factor_with_scale, _buf_lambda->local_data(), new_lambdas, 
+                                      pHessL->n_sp(), pHessL->n_de(),
+                                      nnzHSS, pHessL->sp_irow(), pHessL->sp_jcol(), pHessL->sp_M(),
+                                      pHessL->de_local_data(),
+                                      nnzHSD, NULL, NULL, NULL);
+      bret = bret && hess_struct_.freeze(log, "Hessian of the Lagrangian (sparse block)",
+                                         pHessL->n_sp(), pHessL->n_sp(), nnzHSS,
+                                         pHessL->sp_irow(), pHessL->sp_jcol(), pHessL->sp_M(),
+                                         "default"==options->GetString("mem_space"));
+    } else {
+      bret = interface.eval_Hess_Lagr(n_vars, n_cons, x.local_data_const(), new_x, 
+                                      obj_factor_with_scale, _buf_lambda->local_data(), new_lambdas, 
+                                      pHessL->n_sp(), pHessL->n_de(),
+                                      nnzHSS, NULL, NULL, hess_struct_.values_buffer(pHessL->sp_M()),
+                                      pHessL->de_local_data(),
+                                      nnzHSD, NULL, NULL, NULL);
+      hess_struct_.apply(pHessL->sp_M());
+    }
     assert(nnzHSD==0);
     assert(nnzHSS==pHessL->sp_nnz());
     
@@ -1341,6 +1660,12 @@ bool hiopNlpMDS::finalizeInitialization()
     return false;
   }
   assert(0==nnz_sparse_Hess_Lagr_SD);
+  //the indexes are requested again at the first evaluation of each solve, in case the
+  //derivative matrices were recreated by the solver
+  jac_c_struct_.reset();
+  jac_d_struct_.reset();
+  jac_cons_struct_.reset();
+  hess_struct_.reset();
   return hiopNlpFormulation::finalizeInitialization();
 }
 
@@ -1355,6 +1680,7 @@ hiopDualsLsqUpdate* hiopNlpSparse::alloc_duals_lsq_updater()
 
 bool hiopNlpSparse::eval_Jac_c(hiopVector& x, bool new_x, hiopMatrix& Jac_c)
 {
+  HIOP_PROFILE_SCOPE("nlp_eval_Jac_c");
   hiopMatrixSparseTriplet* pJac_c = dynamic_cast<hiopMatrixSparseTriplet*>(&Jac_c);
   assert(pJac_c);
   if(pJac_c) {
@@ -1363,10 +1689,24 @@ bool hiopNlpSparse::eval_Jac_c(hiopVector& x, bool new_x, hiopMatrix& Jac_c)
     runStats.tmEvalJac_con.start();
 
     int nnz = pJac_c->numberOfNonzeros();
-    bool bret = interface.eval_Jac_cons(n_vars, n_cons,
-                                      n_cons_eq, cons_eq_mapping_,
-                                      x_user->local_data_const(), new_x,
-                                      nnz, pJac_c->i_row(), pJac_c->j_col(), pJac_c->M());
+    bool bret = true;
+    if(!jac_c_struct_.is_frozen()) {
+      //first evaluation: indexes and values in one call
+      bret = interface.eval_Jac_cons(n_vars, n_cons,
+                                     n_cons_eq, cons_eq_mapping_,
+                                     x_user->local_data_const(), new_x,
+                                     nnz, pJac_c->i_row(), pJac_c->j_col(), pJac_c->M());
+      bret = bret && jac_c_struct_.freeze(log, "Jacobian of equalities",
+                                          n_cons_eq, n_vars, nnz,
+                                          pJac_c->i_row(), pJac_c->j_col(), pJac_c->M(),
+                                          "default"==options->GetString("mem_space"));
+    } else {
+      bret = interface.eval_Jac_cons(n_vars, n_cons,
+                                     n_cons_eq, cons_eq_mapping_,
+                                     x_user->local_data_const(), new_x,
+                                     nnz, nullptr, nullptr, jac_c_struct_.values_buffer(pJac_c->M()));
+      jac_c_struct_.apply(pJac_c->M());
+    }
 
     // scale the matrix
     Jac_c = *(nlp_transformations.apply_to_jacob_eq(Jac_c, n_cons_eq));
@@ -1381,6 +1721,7 @@ bool hiopNlpSparse::eval_Jac_c(hiopVector& x, bool new_x, hiopMatrix& Jac_c)
 
 bool hiopNlpSparse::eval_Jac_d(hiopVector& x, bool new_x, hiopMatrix& Jac_d)
 {
+  HIOP_PROFILE_SCOPE("nlp_eval_Jac_d");
   hiopMatrixSparseTriplet* pJac_d = dynamic_cast<hiopMatrixSparseTriplet*>(&Jac_d);
   assert(pJac_d);
   if(pJac_d) {
@@ -1389,10 +1730,24 @@ bool hiopNlpSparse::eval_Jac_d(hiopVector& x, bool new_x, hiopMatrix& Jac_d)
     runStats.tmEvalJac_con.start();
 
     int nnz = pJac_d->numberOfNonzeros();
-    bool bret =  interface.eval_Jac_cons(n_vars, n_cons,
-                                       n_cons_ineq, cons_ineq_mapping_,
-                                       x_user->local_data_const(), new_x,
-                                       nnz, pJac_d->i_row(), pJac_d->j_col(), pJac_d->M());
+    bool bret = true;
+    if(!jac_d_struct_.is_frozen()) {
+      //first evaluation: indexes and values in one call
+      bret = interface.eval_Jac_cons(n_vars, n_cons,
+                                     n_cons_ineq, cons_ineq_mapping_,
+                                     x_user->local_data_const(), new_x,
+                                     nnz, pJac_d->i_row(), pJac_d->j_col(), pJac_d->M());
+      bret = bret && jac_d_struct_.freeze(log, "Jacobian of inequalities",
+                                          n_cons_ineq, n_vars, nnz,
+                                          pJac_d->i_row(), pJac_d->j_col(), pJac_d->M(),
+                                          "default"==options->GetString("mem_space"));
+    } else {
+      bret = interface.eval_Jac_cons(n_vars, n_cons,
+                                     n_cons_ineq, cons_ineq_mapping_,
+                                     x_user->local_data_const(), new_x,
+                                     nnz, nullptr, nullptr, jac_d_struct_.values_buffer(pJac_d->M()));
+      jac_d_struct_.apply(pJac_d->M());
+    }
 
     // scale the matrix
     Jac_d = *(nlp_transformations.apply_to_jacob_ineq(Jac_d, n_cons_ineq));
@@ -1425,18 +1780,22 @@ bool hiopNlpSparse::eval_Jac_c_d_interface_impl(hiopVector& x,
     runStats.tmEvalJac_con.start();
 
     int nnz = cons_Jac->numberOfNonzeros();
-    bool bret=false;
-    if(0==num_jac_eval_)
-    {
+    bool bret = true;
+    if(!jac_cons_struct_.is_frozen()) {
+      //first evaluation: indexes and values in one call
       bret = interface.eval_Jac_cons(n_vars, n_cons,
                                      x_user->local_data_const(), new_x,
-                                     nnz, cons_Jac->i_row(), cons_Jac->j_col(), nullptr);
-      num_jac_eval_++;
+                                     nnz, cons_Jac->i_row(), cons_Jac->j_col(), cons_Jac->M());
+      bret = bret && jac_cons_struct_.freeze(log, "Jacobian of constraints",
+                                             n_cons, n_vars, nnz,
+                                             cons_Jac->i_row(), cons_Jac->j_col(), cons_Jac->M(),
+                                             "default"==options->GetString("mem_space"));
+    } else {
+      bret = interface.eval_Jac_cons(n_vars, n_cons,
+                                     x_user->local_data_const(), new_x,
+                                     nnz, nullptr, nullptr, jac_cons_struct_.values_buffer(cons_Jac->M()));
+      jac_cons_struct_.apply(cons_Jac->M());
     }
-    
-    bret = interface.eval_Jac_cons(n_vars, n_cons,
-                                   x_user->local_data_const(), new_x,
-                                   nnz, nullptr, nullptr, cons_Jac->M());
 
     //copy back to Jac_c and Jac_d
     pJac_c->copyRowsFrom(*cons_Jac, cons_eq_mapping_, n_cons_eq);
@@ -1461,6 +1820,11 @@ bool hiopNlpSparse::eval_Hess_Lagr(const hiopVector&  x, bool new_x, const doubl
                             const hiopVector& lambda_eq, const hiopVector& lambda_ineq, bool new_lambdas,
                             hiopMatrix& Hess_L)
 {
+  HIOP_PROFILE_SCOPE("nlp_eval_Hess_Lagr");
+  if(quasi_newton_hessian()) {
+    //silently ignore the call since we're in the quasi-Newton case
+    return true;
+  }
   hiopMatrixSparseTriplet* pHessL = dynamic_cast<hiopMatrixSparseTriplet*>(&Hess_L);
   assert(pHessL);
   
@@ -1494,19 +1858,24 @@ bool hiopNlpSparse::eval_Hess_Lagr(const hiopVector&  x, bool new_x, const doubl
 
     int nnzHSS = pHessL->numberOfNonzeros(), nnzHSD = 0;
 
-    if(0==num_hess_eval_)
-    {
+    bret = true;
+    if(!hess_struct_.is_frozen()) {
+      //first evaluation: indexes and values in one call
+      bret = interface.eval_Hess_Lagr(n_vars, n_cons,
+                                      x.local_data_const(), new_x, obj_factor_with_scale,
+                                      _buf_lambda->local_data(), new_lambdas,
+                                      nnzHSS, pHessL->i_row(), pHessL->j_col(), pHessL->M());
+      bret = bret && hess_struct_.freeze(log, "Hessian of the Lagrangian",
+                                         n_vars, n_vars, nnzHSS,
+                                         pHessL->i_row(), pHessL->j_col(), pHessL->M(),
+                                         "default"==options->GetString("mem_space"));
+    } else {
       bret = interface.eval_Hess_Lagr(n_vars, n_cons,
                                       x.local_data_const(), new_x, obj_factor_with_scale,
                                       _buf_lambda->local_data(), new_lambdas,
-                                      nnzHSS, pHessL->i_row(), pHessL->j_col(), nullptr);
-      num_hess_eval_++;
+                                      nnzHSS, nullptr, nullptr, hess_struct_.values_buffer(pHessL->M()));
+      hess_struct_.apply(pHessL->M());
     }
-
-    bret = interface.eval_Hess_Lagr(n_vars, n_cons,
-                                    x.local_data_const(), new_x, obj_factor_with_scale,
-                                    _buf_lambda->local_data(), new_lambdas,
-                                    nnzHSS, nullptr, nullptr, pHessL->M());
     assert(nnzHSS==pHessL->numberOfNonzeros());
 
   } else {
@@ -1519,6 +1888,42 @@ bool hiopNlpSparse::eval_Hess_Lagr(const hiopVector&  x, bool new_x, const doubl
   return bret;
 }
 
+bool hiopNlpSparse::eval_Hess_Lagr_struct(const hiopVector& x, hiopMatrix& Hess_L)
+{
+  if(quasi_newton_hessian() || hess_struct_.is_frozen()) {
+    return true;
+  }
+  hiopMatrixSparseTriplet* pHessL = dynamic_cast<hiopMatrixSparseTriplet*>(&Hess_L);
+  assert(pHessL);
+  if(NULL==pHessL) {
+    return false;
+  }
+  
+  runStats.tmEvalHessL.start();
+
+  if(n_cons != _buf_lambda->get_size()) {
+    delete _buf_lambda;
+    _buf_lambda = LinearAlgebraFactory::createVector(n_cons);
+  }
+  _buf_lambda->setToZero();
+
+  int nnzHSS = pHessL->numberOfNonzeros();
+  //structure phase: indexes only
+  bool bret = interface.eval_Hess_Lagr(n_vars, n_cons,
+                                       x.local_data_const(), true, get_obj_scale(),
+                                       _buf_lambda->local_data(), true,
+                                       nnzHSS, pHessL->i_row(), pHessL->j_col(), nullptr);
+  bret = bret && hess_struct_.freeze(log, "Hessian of the Lagrangian",
+                                     n_vars, n_vars, nnzHSS,
+                                     pHessL->i_row(), pHessL->j_col(), nullptr,
+                                     "default"==options->GetString("mem_space"));
+  assert(nnzHSS==pHessL->numberOfNonzeros());
+  pHessL->setToZero();
+
+  runStats.tmEvalHessL.stop();
+  return bret;
+}
+
 bool hiopNlpSparse::finalizeInitialization()
 {
   int nx = 0;
@@ -1528,6 +1933,11 @@ bool hiopNlpSparse::finalizeInitialization()
     return false;
   }
   assert(nx == n_vars);
+  //the indexes are requested again at the first evaluation of each solve (see hiopNlpMDS)
+  jac_c_struct_.reset();
+  jac_d_struct_.reset();
+  jac_cons_struct_.reset();
+  hess_struct_.reset();
   return hiopNlpFormulation::finalizeInitialization();
 }
 
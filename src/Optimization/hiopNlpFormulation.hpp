@@ -68,10 +68,13 @@
 #include "hiopNlpTransforms.hpp"
 
 #include "hiopRunStats.hpp"
+#include "hiopWorkspace.hpp"
 #include "hiopLogger.hpp"
 #include "hiopOptions.hpp"
 
 #include <cstring>
+#include <vector>
+#include <algorithm>
 
 namespace hiop
 {
@@ -102,6 +105,28 @@ public:
   virtual bool apply_scaling(hiopVector& c, hiopVector& d, hiopVector& gradf, 
                              hiopMatrix& Jac_c, hiopMatrix& Jac_d);
 
+  /** 
+   * Returns the gradient-based scaling factors computed (and used) by the last solve. These can
+   * be saved by the user and passed back via @set_scaling_factors for subsequent solves of the same 
+   * model. Returns false if no scaling was applied.
+   */
+  bool get_scaling_factors(double& scale_obj, hiopVector& scale_c, hiopVector& scale_d) const;
+  /**
+   * Provides precomputed scaling factors to be used by the next solve instead of computing them 
+   * from the derivatives at the starting point. Ignored when 'scaling_type' is 'none'.
+   */
+  void set_scaling_factors(const double& scale_obj, const hiopVector& scale_c, const hiopVector& scale_d);
+
+  /**
+   * Reloads the variable bounds and the constraints' bounds/right-hand side from the user's
+   * interface, for repeated solves of a problem with the same structure. The existing storage and
+   * scaling are reused. Returns false if the structure changed, i.e., the sizes, the eq/ineq split
+   * of the constraints, or the finite/infinite bounds pattern, or if fixed variables or bounds 
+   * relaxation transformations are in use; in this case 'this' is marked so that the next call to
+   * @finalizeInitialization performs a full re-initialization.
+   */
+  virtual bool reload_bounds_data();
+
   /**
    * Wrappers for the interface calls. 
    * Can be overridden for specialized formulations required by the algorithm.
@@ -116,6 +141,10 @@ public:
   virtual bool eval_Jac_c(hiopVector& x, bool new_x, hiopMatrix& Jac_c)=0;
   virtual bool eval_Jac_d(hiopVector& x, bool new_x, hiopMatrix& Jac_d)=0;
   virtual bool eval_Jac_c_d(hiopVector& x, bool new_x, hiopMatrix& Jac_c, hiopMatrix& Jac_d);
+
+  /* true when the equalities and inequalities are evaluated by separate calls to the user's 
+   * (subset form of) eval_cons; known only after the first call to eval_c_d */
+  inline bool cons_eval_separately() const { return 0==cons_eval_type_; }
 protected:
   //calls specific hiopInterfaceXXX::eval_Jac_cons and deals with specializations of hiopMatrix arguments
   virtual bool eval_Jac_c_d_interface_impl(hiopVector& x, bool new_x, hiopMatrix& Jac_c, hiopMatrix& Jac_d) = 0;
@@ -146,6 +175,21 @@ public:
   virtual hiopMatrix* alloc_Jac_cons() = 0;
   virtual hiopMatrix* alloc_Hess_Lagr() = 0;
 
+  /* this is in general for a dense matrix with n_vars cols and a small number of 
+   * 'nrows' rows. The second argument indicates how much total memory should the
+   * matrix (pre)allocate.
+   */
+  virtual hiopMatrixDense* alloc_multivector_primal(int nrows, int max_rows=-1) const;
+
+  /**
+   * True when the Hessian of the Lagrangian is approximated by the limited-memory secant updates
+   * of hiopHessianLowRank instead of being evaluated by the user. In this case, 'alloc_Hess_Lagr'
+   * returns an empty (zero) Hessian and 'eval_Hess_Lagr' does not call the user's interface. For
+   * the MDS and sparse formulations this is the case only when the option 'Hessian' is set 
+   * explicitly to one of the quasi-Newton values. Decided from the options by 'finalizeInitialization'.
+   */
+  virtual bool quasi_newton_hessian() const { return quasi_newton_hessian_; }
+
   virtual
   void user_callback_solution(hiopSolveStatus status,
 			      const hiopVector& x,
@@ -229,6 +273,9 @@ public:
   hiopLogger* log;
   hiopRunStats runStats;
   hiopOptions* options;
+
+  /// Arena of the temporaries used by the solver's kernels; reset at each iteration
+  inline hiopWorkspace& workspace() { return workspace_; }
   //prints a summary of the problem
   virtual void print(FILE* f=NULL, const char* msg=NULL, int rank=-1) const;
 #ifdef HIOP_USE_MPI
@@ -256,6 +303,8 @@ protected:
 
   hiopVector *dl, *du,  *idl, *idu; //these will be local
   hiopInterfaceBase::NonlinearityType* cons_ineq_type;
+
+  hiopWorkspace workspace_;
   
   // keep track of the constraints indexes in the original, user's formulation
   long long *cons_eq_mapping_, *cons_ineq_mapping_; 
@@ -270,6 +319,16 @@ protected:
   //internal NLP transformations (currently gradient scaling implemented)
   hiopNLPObjGradScaling *nlp_scaling;
 
+  //bounds relaxation transformation; owned by 'nlp_transformations', NULL if not used
+  hiopBoundsRelaxer* relax_bounds_;
+
+  //scaling factors provided by the user via 'set_scaling_factors'; NULL if none were provided
+  double scale_obj_user_;
+  hiopVector *scale_c_user_, *scale_d_user_;
+
+  //see 'quasi_newton_hessian'; set by 'finalizeInitialization' since the option may change between solves
+  bool quasi_newton_hessian_;
+
 #ifdef HIOP_USE_MPI
   //inter-process distribution of vectors
   long long* vec_distrib;
@@ -352,11 +411,8 @@ public:
   //returns hiopHessianLowRank which (fakely) inherits from hiopMatrix
   virtual hiopMatrix* alloc_Hess_Lagr();
 
-  /* this is in general for a dense matrix with n_vars cols and a small number of 
-   * 'nrows' rows. The second argument indicates how much total memory should the
-   * matrix (pre)allocate.
-   */
-  virtual hiopMatrixDense* alloc_multivector_primal(int nrows, int max_rows=-1) const;
+  //the dense formulation supports only the quasi-Newton Hessian
+  virtual bool quasi_newton_hessian() const { return true; }
 
 private:
   /* interface implemented and provided by the user */
@@ -365,6 +421,82 @@ private:
 
 
 
+/* *************************************************************************
+ * Sparsity structure of a sparse derivative block (Jacobian or Hessian) as
+ * provided by the user.
+ *
+ * The (i,j) indexes are requested from the user only once per solve, during 
+ * the first evaluation, which also returns the values. The indexes are then
+ * validated and, when not in the row-major order expected by
+ * hiopMatrixSparseTriplet, sorted in place ("frozen"). The sorting permutation
+ * is kept so that the subsequent, values-only evaluations can be mapped into
+ * the canonical order. The sorted indexes are also kept and copied, once, into
+ * the derivative matrices created after the first evaluation (see 'alloc_Jac_c'
+ * and siblings); the copies of a matrix (new_copy) carry its indexes.
+ *
+ * When the derivative matrices are not on host memory (option 'mem_space' other
+ * than 'default'), the structure is not frozen and the indexes are requested 
+ * at each evaluation.
+ *
+ * Duplicate (i,j) entries are not merged: the number of nonzeros is the one 
+ * reported by the user, with which the triplet matrices are preallocated.
+ * *************************************************************************
+ */
+class hiopSparseStructure
+{
+public:
+  hiopSparseStructure()
+    : frozen_(false)
+  {}
+  virtual ~hiopSparseStructure()
+  {}
+
+  inline bool is_frozen() const { return frozen_; }
+
+  /** Drops the structure so that the indexes are requested again by the next evaluation */
+  void reset();
+
+  /** 
+   * Validates and sorts the (i,j) indexes of a block of size 'nrows'x'ncols', together with
+   * the 'values' (if not NULL). Returns false (and logs an error) if any index is out of 
+   * range. When 'on_host' is false, the arrays are not accessed and the structure is not
+   * frozen.
+   */
+  bool freeze(hiopLogger* log, const char* name,
+              int nrows, int ncols, int nnz, int* irow, int* jcol, double* values, bool on_host);
+
+  /** Copies the frozen indexes, if any, into the arrays of a newly created matrix */
+  inline void copy_indexes(int* irow, int* jcol) const
+  {
+    std::copy(irow_.begin(), irow_.end(), irow);
+    std::copy(jcol_.begin(), jcol_.end(), jcol);
+  }
+
+  /** Returns the array in which the user should write the values: 'M' itself when the 
+   * user's order is canonical, an internal buffer otherwise. */
+  inline double* values_buffer(double* M)
+  {
+    return perm_.empty() ? M : buf_.data();
+  }
+
+  /** Moves the values from the internal buffer (if used) into 'M' in canonical order */
+  inline void apply(double* M) const
+  {
+    const int nnz = perm_.size();
+    for(int k=0; k<nnz; k++) {
+      M[k] = buf_[perm_[k]];
+    }
+  }
+private:
+  bool frozen_;
+  //perm_[k] is the position in user's order of the k-th nonzero in canonical order; empty
+  //if user's order is already canonical
+  std::vector<int> perm_;
+  std::vector<double> buf_;
+  //frozen (i,j) indexes in canonical order; empty when not frozen
+  std::vector<int> irow_, jcol_;
+};
+
 /* *************************************************************************
  * Class is for general NLPs that have mixed sparse-dense (MDS) derivatives
  * blocks. 
@@ -406,22 +538,36 @@ public:
   virtual hiopMatrix* alloc_Jac_c() 
   {
     assert(n_vars == nx_sparse+nx_dense);
-    return new hiopMatrixMDS(n_cons_eq, nx_sparse, nx_dense, nnz_sparse_Jaceq);
+    hiopMatrixMDS* J = new hiopMatrixMDS(n_cons_eq, nx_sparse, nx_dense, nnz_sparse_Jaceq);
+    jac_c_struct_.copy_indexes(J->sp_irow(), J->sp_jcol());
+    return J;
   }
   virtual hiopMatrix* alloc_Jac_d() 
   {
     assert(n_vars == nx_sparse+nx_dense);
-    return new hiopMatrixMDS(n_cons_ineq, nx_sparse, nx_dense, nnz_sparse_Jacineq);
+    hiopMatrixMDS* J = new hiopMatrixMDS(n_cons_ineq, nx_sparse, nx_dense, nnz_sparse_Jacineq);
+    jac_d_struct_.copy_indexes(J->sp_irow(), J->sp_jcol());
+    return J;
   }
   virtual hiopMatrix* alloc_Jac_cons()
   {
     assert(n_vars == nx_sparse+nx_dense);
-    return new hiopMatrixMDS(n_cons, nx_sparse, nx_dense, nnz_sparse_Jaceq+nnz_sparse_Jacineq);
+    hiopMatrixMDS* J = new hiopMatrixMDS(n_cons, nx_sparse, nx_dense, nnz_sparse_Jaceq+nnz_sparse_Jacineq);
+    jac_cons_struct_.copy_indexes(J->sp_irow(), J->sp_jcol());
+    return J;
   }
   virtual hiopMatrix* alloc_Hess_Lagr()
   {
     assert(0==nnz_sparse_Hess_Lagr_SD);
-    return new hiopMatrixSymBlockDiagMDS(nx_sparse, nx_dense, nnz_sparse_Hess_Lagr_SS);
+    if(quasi_newton_hessian()) {
+      //the quasi-Newton Hessian is applied by the KKT linear system; this one stays zero
+      hiopMatrix* H = new hiopMatrixSymBlockDiagMDS(nx_sparse, nx_dense, 0);
+      H->setToZero();
+      return H;
+    }
+    hiopMatrixSymBlockDiagMDS* H = new hiopMatrixSymBlockDiagMDS(nx_sparse, nx_dense, nnz_sparse_Hess_Lagr_SS);
+    hess_struct_.copy_indexes(H->sp_irow(), H->sp_jcol());
+    return H;
   }
   virtual long long nx_sp() const { return nx_sparse; }
   virtual long long nx_de() const { return nx_dense; }
@@ -431,6 +577,9 @@ private:
   int nnz_sparse_Jaceq, nnz_sparse_Jacineq;
   int nnz_sparse_Hess_Lagr_SS, nnz_sparse_Hess_Lagr_SD;
 
+  //sparsity structures of the sparse blocks; indexes are requested only once from the user
+  hiopSparseStructure jac_c_struct_, jac_d_struct_, jac_cons_struct_, hess_struct_;
+
   hiopVector* _buf_lambda;
 };
 
@@ -445,8 +594,7 @@ public:
   // TODO: notsure we need this
 
   hiopNlpSparse(hiopInterfaceSparse& interface_)
-    : hiopNlpFormulation(interface_), interface(interface_),
-      num_jac_eval_{0}, num_hess_eval_{0}
+    : hiopNlpFormulation(interface_), interface(interface_)
   {
     _buf_lambda = LinearAlgebraFactory::createVector(0);
   }
@@ -472,24 +620,46 @@ public:
                             const hiopVector& lambda_ineq,
                             bool new_lambdas,
                             hiopMatrix& Hess_L);
+
+  /**
+   * Requests from the user, if not done already, the sparsity structure of the Hessian of the
+   * Lagrangian and sets the indexes of 'Hess_L'; the values are set to zero. Used when the 
+   * pattern is needed before the first evaluation of the Hessian, for example, by the LSQ duals
+   * initialization that shares the linear solver of the KKT system.
+   */
+  bool eval_Hess_Lagr_struct(const hiopVector& x, hiopMatrix& Hess_L);
+
   /* Allocates the LSQ duals update class. */
   virtual hiopDualsLsqUpdate* alloc_duals_lsq_updater();
   
   virtual hiopMatrix* alloc_Jac_c()
   {
-    return new hiopMatrixSparseTriplet(n_cons_eq, n_vars, m_nnz_sparse_Jaceq);
+    hiopMatrixSparseTriplet* J = new hiopMatrixSparseTriplet(n_cons_eq, n_vars, m_nnz_sparse_Jaceq);
+    jac_c_struct_.copy_indexes(J->i_row(), J->j_col());
+    return J;
   }
   virtual hiopMatrix* alloc_Jac_d()
   {
-    return new hiopMatrixSparseTriplet(n_cons_ineq, n_vars, m_nnz_sparse_Jacineq);
+    hiopMatrixSparseTriplet* J = new hiopMatrixSparseTriplet(n_cons_ineq, n_vars, m_nnz_sparse_Jacineq);
+    jac_d_struct_.copy_indexes(J->i_row(), J->j_col());
+    return J;
   }
   virtual hiopMatrix* alloc_Jac_cons()
   {
-    return new hiopMatrixSparseTriplet(n_cons, n_vars, m_nnz_sparse_Jaceq + m_nnz_sparse_Jacineq);
+    hiopMatrixSparseTriplet* J =
+      new hiopMatrixSparseTriplet(n_cons, n_vars, m_nnz_sparse_Jaceq + m_nnz_sparse_Jacineq);
+    jac_cons_struct_.copy_indexes(J->i_row(), J->j_col());
+    return J;
   }
   virtual hiopMatrix* alloc_Hess_Lagr()
   {
-    return new hiopMatrixSymSparseTriplet(n_vars, m_nnz_sparse_Hess_Lagr);
+    if(quasi_newton_hessian()) {
+      //the quasi-Newton Hessian is applied by the KKT linear system; this one stays empty
+      return new hiopMatrixSymSparseTriplet(n_vars, 0);
+    }
+    hiopMatrixSymSparseTriplet* H = new hiopMatrixSymSparseTriplet(n_vars, m_nnz_sparse_Hess_Lagr);
+    hess_struct_.copy_indexes(H->i_row(), H->j_col());
+    return H;
   }
   virtual long long nx() const { return n_vars; }
 
@@ -506,8 +676,9 @@ private:
   hiopInterfaceSparse& interface;
   int m_nnz_sparse_Jaceq, m_nnz_sparse_Jacineq;
   int m_nnz_sparse_Hess_Lagr;
-  int num_jac_eval_;
-  int num_hess_eval_;
+
+  //sparsity structures of the sparse blocks; indexes are requested only once from the user
+  hiopSparseStructure jac_c_struct_, jac_d_struct_, jac_cons_struct_, hess_struct_;
 
   hiopVector* _buf_lambda;
 };
@@ -58,6 +58,7 @@
 #include "hiopLinAlgFactory.hpp"
 
 #include <cmath>
+#include <cstring>
 namespace hiop
 {
 
@@ -68,9 +69,10 @@ hiopFixedVarsRemover(const hiopVector& xl,
                      const long long& numFixedVars,
                      const long long& numFixedVars_local)
   : n_fixed_vars_local(numFixedVars_local), fixedVarTol(fixedVarTol_),
-    Jacc_fs(NULL), Jacd_fs(NULL),
+    Jacc_fs(NULL), Jacd_fs(NULL), Jaccons_fs(NULL),
+    Jacc_rs_ref(NULL), Jacd_rs_ref(NULL), Jaccons_rs_ref(NULL),
     fs2rs_idx_map(xl.get_local_size()),
-    x_rs_ref_(nullptr), Jacc_rs_ref(NULL), Jacd_rs_ref(NULL)
+    x_rs_ref_(nullptr)
 {
   xl_fs = xl.new_copy();
   xu_fs = xu.new_copy();
@@ -89,6 +91,7 @@ hiopFixedVarsRemover::~hiopFixedVarsRemover()
   delete grad_fs;
   if(Jacc_fs) delete Jacc_fs;
   if(Jacd_fs) delete Jacd_fs;
+  if(Jaccons_fs) delete Jaccons_fs;
 };
 
 #ifdef HIOP_USE_MPI
@@ -148,16 +151,24 @@ bool hiopFixedVarsRemover::setupDecisionVectorPart()
 
   /* build the map from full-space to reduced-space */
   int it_rs=0; 
+  free_runs_.clear();
+  fixed_idxs_.clear();
   for(int i=0;i<n_fs_local; i++) {
     //if(xl_vec[i]==xu_vec[i]) {
     if(fabs(xl_vec[i]-xu_vec[i])<= fixedVarTol*fmax(1.,fabs(xu_vec[i]))) {
       fs2rs_idx_map[i]=-1;
+      fixed_idxs_.push_back(i);
     } else {
       fs2rs_idx_map[i]=it_rs;
+      if(free_runs_.empty() || free_runs_.back().fs_start+free_runs_.back().len != i) {
+        free_runs_.push_back({i, it_rs, 0});
+      }
+      free_runs_.back().len++;
       it_rs++;
     }
   }
   assert(it_rs+n_fixed_vars_local==n_fs_local);
+  assert(fixed_idxs_.size()==(size_t)n_fixed_vars_local);
 
   return true;
 };
@@ -166,21 +177,23 @@ bool hiopFixedVarsRemover::setupConstraintsPart(const int& neq, const int& nineq
 {
   assert(Jacc_fs==NULL && "should not be allocated at this point");
   assert(Jacd_fs==NULL && "should not be allocated at this point");
+  assert(Jaccons_fs==NULL && "should not be allocated at this point");
+
+  //the full-space Jacobians are allocated by the first evaluation, which decides whether the
+  //equalities and inequalities are evaluated separately or in one call
+  return true;
+}
 
+hiopMatrixDense* hiopFixedVarsRemover::alloc_Jac_fs(const int& m_in)
+{
 #ifdef HIOP_USE_MPI
-  if(fs_vec_distrib.size())
-  {
-    Jacc_fs = LinearAlgebraFactory::createMatrixDense(neq,   n_fs, fs_vec_distrib.data(), comm);
-    Jacd_fs = LinearAlgebraFactory::createMatrixDense(nineq, n_fs, fs_vec_distrib.data(), comm);
-  } else {
-    Jacc_fs = LinearAlgebraFactory::createMatrixDense(neq,   n_fs, NULL, comm);
-    Jacd_fs = LinearAlgebraFactory::createMatrixDense(nineq, n_fs, NULL, comm);
+  if(fs_vec_distrib.size()) {
+    return LinearAlgebraFactory::createMatrixDense(m_in, n_fs, fs_vec_distrib.data(), comm);
   }
+  return LinearAlgebraFactory::createMatrixDense(m_in, n_fs, NULL, comm);
 #else
-  Jacc_fs = LinearAlgebraFactory::createMatrixDense(neq,   n_fs);
-  Jacd_fs = LinearAlgebraFactory::createMatrixDense(nineq, n_fs);
+  return LinearAlgebraFactory::createMatrixDense(m_in, n_fs);
 #endif
-  return true;
 }
 
 /* "copies" a full space vector/array to a reduced space vector/array */
@@ -205,17 +218,14 @@ copyFsToRs(const hiopInterfaceBase::NonlinearityType* fs, hiopInterfaceBase::Non
 /* from rs to fs */
 void hiopFixedVarsRemover::apply_inv_to_vector(const hiopVector* vec_rs, hiopVector* vec_fs)
 {
-  double* xl_fs_arr = xl_fs->local_data();
+  const double* xl_fs_arr = xl_fs->local_data_const();
   const double* vec_rs_arr = vec_rs->local_data_const();
   double* vec_fs_arr = vec_fs->local_data();
-  int rs_idx;
-  for(int i=0; i<fs2rs_idx_map.size(); i++) {
-    rs_idx = fs2rs_idx_map[i];
-    if(rs_idx<0) {
-      vec_fs_arr[i] = xl_fs_arr[i];
-    } else {
-      vec_fs_arr[i] = vec_rs_arr[rs_idx];
-    }
+  for(const IdxRun& run : free_runs_) {
+    memcpy(vec_fs_arr+run.fs_start, vec_rs_arr+run.rs_start, run.len*sizeof(double));
+  }
+  for(const int& i : fixed_idxs_) {
+    vec_fs_arr[i] = xl_fs_arr[i];
   }
 }
 
@@ -224,33 +234,26 @@ void hiopFixedVarsRemover::apply_to_vector(const hiopVector* vec_fs, hiopVector*
 {
   double* vec_rs_arr = vec_rs->local_data();
   const double* vec_fs_arr = vec_fs->local_data_const();
-  int rs_idx;
-  for(int i=0; i<fs2rs_idx_map.size(); i++) {
-    rs_idx = fs2rs_idx_map[i];
-    if(rs_idx>=0) {
-      vec_rs_arr[rs_idx]=vec_fs_arr[i];
-    }
+  for(const IdxRun& run : free_runs_) {
+    memcpy(vec_rs_arr+run.rs_start, vec_fs_arr+run.fs_start, run.len*sizeof(double));
   }
 }
 
 /* from rs to fs */
 void hiopFixedVarsRemover::applyToMatrix(const double* M_rs, const int& m_in, double* M_fs)
 {
-  int rs_idx;
   const int nfs = fs2rs_idx_map.size();
   assert(nfs == fs_n_local());
   const int nrs = rs_n_local();
 
   for(int i=0; i<m_in; i++) {
-    for(int j=0; j<nfs; j++) {
-      rs_idx = fs2rs_idx_map[j];
-      if(rs_idx<0) {
-  	//M_fs[i][j] = 0.; //really no need to initialize this, these entries will be later ignored
-        M_fs[i*nfs+j] = 0.;
-      } else {
-  	//M_fs[i][j] = M_rs[i][rs_idx];
-        M_fs[i*nfs+j] = M_rs[i*nrs+rs_idx];
-      }
+    for(const IdxRun& run : free_runs_) {
+      //M_fs[i][fs_start:fs_start+len] = M_rs[i][rs_start:rs_start+len]
+      memcpy(M_fs+i*nfs+run.fs_start, M_rs+i*nrs+run.rs_start, run.len*sizeof(double));
+    }
+    for(const int& j : fixed_idxs_) {
+      //really no need to initialize this, these entries will be later ignored
+      M_fs[i*nfs+j] = 0.;
     }
   }
 }
@@ -258,17 +261,14 @@ void hiopFixedVarsRemover::applyToMatrix(const double* M_rs, const int& m_in, do
 /* from fs to rs */
 void hiopFixedVarsRemover::applyInvToMatrix(const double* M_fs, const int& m_in, double* M_rs)
 {
-  int rs_idx;
   const int nfs = fs2rs_idx_map.size();
   assert(nfs == fs_n_local());
   const int nrs = rs_n_local();
 
   for(int i=0; i<m_in; i++) {
-    for(int j=0; j<fs2rs_idx_map.size(); j++) {  
-      rs_idx = fs2rs_idx_map[j];
-      if(rs_idx>=0) {
-  	M_rs[i*nrs+rs_idx] = M_fs[i*nfs+j];
-      }
+    for(const IdxRun& run : free_runs_) {
+      //M_rs[i][rs_start:rs_start+len] = M_fs[i][fs_start:fs_start+len]
+      memcpy(M_rs+i*nrs+run.rs_start, M_fs+i*nfs+run.fs_start, run.len*sizeof(double));
     }
   }
 }
@@ -343,6 +343,15 @@ hiopBoundsRelaxer::~hiopBoundsRelaxer()
   }
 }
 
+void hiopBoundsRelaxer::
+set_original_bounds(const hiopVector& xl, const hiopVector& xu, const hiopVector& dl, const hiopVector& du)
+{
+  xl_ori->copyFrom(xl);
+  xu_ori->copyFrom(xu);
+  dl_ori->copyFrom(dl);
+  du_ori->copyFrom(du);
+}
+
 void hiopBoundsRelaxer::
 relax(const double& bound_relax_perturb, hiopVector& xl, hiopVector& xu, hiopVector& dl, hiopVector& du)
 {
@@ -380,8 +389,8 @@ hiopNLPObjGradScaling::hiopNLPObjGradScaling(const double max_grad,
                                              long long *cons_eq_mapping, 
                                              long long *cons_ineq_mapping)
       : n_vars(gradf.get_size()), n_vars_local(gradf.get_local_size()),
-        scale_factor_obj(1.),
-        n_eq(c.get_size()), n_ineq(d.get_size())
+        n_eq(c.get_size()), n_ineq(d.get_size()),
+        scale_factor_obj(1.)
 {
   scale_factor_obj = max_grad/gradf.infnorm();
   if(scale_factor_obj>1.)
@@ -415,6 +424,32 @@ hiopNLPObjGradScaling::hiopNLPObjGradScaling(const double max_grad,
   }
 }
 
+hiopNLPObjGradScaling::hiopNLPObjGradScaling(const double& scale_obj,
+                                             const hiopVector& scale_c,
+                                             const hiopVector& scale_d,
+                                             const hiopVector& gradf,
+                                             long long *cons_eq_mapping, 
+                                             long long *cons_ineq_mapping)
+      : n_vars(gradf.get_size()), n_vars_local(gradf.get_local_size()),
+        n_eq(scale_c.get_size()), n_ineq(scale_d.get_size()),
+        scale_factor_obj(scale_obj)
+{
+  scale_factor_c = scale_c.new_copy();
+  scale_factor_d = scale_d.new_copy();
+  scale_factor_cd = LinearAlgebraFactory::createVector(n_eq + n_ineq);
+
+  const double* eq_arr = scale_factor_c->local_data_const();
+  const double* ineq_arr = scale_factor_d->local_data_const();
+  double* scale_factor_cd_arr = scale_factor_cd->local_data();
+
+  for(int i=0; i<n_eq; ++i) {
+    scale_factor_cd_arr[cons_eq_mapping[i]] = eq_arr[i];
+  }
+  for(int i=0; i<n_ineq; ++i) {
+    scale_factor_cd_arr[cons_ineq_mapping[i]] = ineq_arr[i];
+  }
+}
+
 hiopNLPObjGradScaling::~hiopNLPObjGradScaling()
 {
   if(scale_factor_c) delete scale_factor_c;
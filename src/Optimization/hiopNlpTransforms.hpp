@@ -124,6 +124,14 @@ public:
   virtual inline hiopMatrix* apply_inv_to_jacob_cons      (hiopMatrix& Jac_in, const int& m_in) { return &Jac_in; }
   virtual inline hiopMatrix* apply_to_jacob_cons  (hiopMatrix& Jac_in, const int& m_in) { return &Jac_in; } 
 
+  //the following return the buffers, as seen by the user, in which the user's callbacks write the
+  //derivatives. Unlike the apply_inv_to_xxx methods, the content of the argument is not transformed
+  //since the callbacks overwrite these buffers; the apply_to_xxx methods are to be called afterwards
+  virtual inline hiopVector* user_buffer_grad_obj         (hiopVector& grad_in) { return &grad_in; }
+  virtual inline hiopMatrix* user_buffer_jacob_eq         (hiopMatrix& Jac_in, const int& m_in) { return &Jac_in; }
+  virtual inline hiopMatrix* user_buffer_jacob_ineq       (hiopMatrix& Jac_in, const int& m_in) { return &Jac_in; }
+  virtual inline hiopMatrix* user_buffer_jacob_cons       (hiopMatrix& Jac_in, const int& m_in) { return &Jac_in; }
+
   virtual inline hiopMatrix* apply_inv_to_larg_hess       (hiopMatrix& Hess_in, const int& m_in) { return &Hess_in; }
   virtual inline hiopMatrix* apply_to_larg_hess   (hiopMatrix& Hess_in, const int& m_in) { return &Hess_in; }
   
@@ -177,7 +185,7 @@ public:
   inline hiopVector* apply_to_x(hiopVector& x_fs_in) 
   { 
     assert(x_rs_ref_!=NULL); assert(x_fs_in.local_data()==x_fs->local_data());
-    apply_inv_to_vector(&x_fs_in, x_rs_ref_);
+    apply_to_vector(&x_fs_in, x_rs_ref_);
     return x_rs_ref_; 
   }
   
@@ -197,6 +205,13 @@ public:
     apply_inv_to_vector(&grad_in, grad_fs);
     return grad_fs;
   }
+  /* the full-space gradient is an output buffer for the user's evaluation, so the reduced-space 
+   * values are not gathered into it; only the reference to the reduced-space buffer is kept */
+  inline hiopVector* user_buffer_grad_obj(hiopVector& grad_in)
+  {
+    grad_rs_ref = &grad_in;
+    return grad_fs;
+  }
   /* from fs to rs */
   inline hiopVector* apply_to_grad_obj(hiopVector& grad_in)
   {
@@ -206,14 +221,26 @@ public:
   }
   /* from rs to fs */
   inline hiopMatrix* apply_inv_to_jacob_eq(hiopMatrix& Jac_in, const int& m_in)
+  {
+    hiopMatrix* Jac_fs = user_buffer_jacob_eq(Jac_in, m_in);
+    if(Jac_fs) {
+      applyToMatrix(Jacc_rs_ref->local_data(), m_in, Jacc_fs->local_data());
+    }
+    return Jac_fs;
+  }
+  /* as for the gradient, the full-space Jacobian is only an output buffer for the user's 
+   * evaluation and no gather from the reduced-space Jacobian is done */
+  inline hiopMatrix* user_buffer_jacob_eq(hiopMatrix& Jac_in, const int& m_in)
   {
     hiopMatrixDense* Jac_de = dynamic_cast<hiopMatrixDense*>(&Jac_in);
     if(Jac_de==nullptr) {
       return nullptr;
     }
     Jacc_rs_ref = Jac_de;
+    if(NULL==Jacc_fs) {
+      Jacc_fs = alloc_Jac_fs(m_in);
+    }
     assert(Jacc_fs->m()==m_in);
-    applyToMatrix(Jac_de->local_data(), m_in, Jacc_fs->local_data());
     return Jacc_fs;
   }
   inline hiopMatrix* apply_to_jacob_eq(hiopMatrix&  Jac_in, const int& m_in)
@@ -227,14 +254,24 @@ public:
     return Jacc_rs_ref;
   }
   inline hiopMatrix* apply_inv_to_jacob_ineq(hiopMatrix& Jac_in, const int& m_in)
+  {
+    hiopMatrix* Jac_fs = user_buffer_jacob_ineq(Jac_in, m_in);
+    if(Jac_fs) {
+      applyToMatrix(Jacd_rs_ref->local_data(), m_in, Jacd_fs->local_data());
+    }
+    return Jac_fs;
+  }
+  inline hiopMatrix* user_buffer_jacob_ineq(hiopMatrix& Jac_in, const int& m_in)
   {
     hiopMatrixDense* Jac_de = dynamic_cast<hiopMatrixDense*>(&Jac_in);
     if(Jac_de==NULL) {
       return nullptr;
     }
     Jacd_rs_ref = Jac_de;
+    if(NULL==Jacd_fs) {
+      Jacd_fs = alloc_Jac_fs(m_in);
+    }
     assert(Jacd_fs->m()==m_in);
-    applyToMatrix(Jac_de->local_data(), m_in, Jacd_fs->local_data());
     return Jacd_fs;    
   }
   inline hiopMatrix* apply_to_jacob_ineq(hiopMatrix& Jac_in, const int& m_in)
@@ -247,6 +284,45 @@ public:
     applyInvToMatrix(Jac_de->local_data(), m_in, Jacd_rs_ref->local_data());
     return Jacd_rs_ref;
   }
+  /* same as above for the Jacobian of all the constraints (one-call Jacobian evaluations) */
+  inline hiopMatrix* apply_inv_to_jacob_cons(hiopMatrix& Jac_in, const int& m_in)
+  {
+    hiopMatrix* Jac_fs = user_buffer_jacob_cons(Jac_in, m_in);
+    if(Jac_fs) {
+      applyToMatrix(Jaccons_rs_ref->local_data(), m_in, Jaccons_fs->local_data());
+    }
+    return Jac_fs;
+  }
+  inline hiopMatrix* user_buffer_jacob_cons(hiopMatrix& Jac_in, const int& m_in)
+  {
+    hiopMatrixDense* Jac_de = dynamic_cast<hiopMatrixDense*>(&Jac_in);
+    if(Jac_de==NULL) {
+      return nullptr;
+    }
+    Jaccons_rs_ref = Jac_de;
+    if(NULL==Jaccons_fs) {
+      //the one-call evaluation is used only when the evaluations of the equalities and inequalities
+      //are not provided (see hiopNlpFormulation::eval_Jac_c_d); their buffers are released so that
+      //a single full-space Jacobian of all the constraints is kept
+      delete Jacc_fs;
+      Jacc_fs = NULL;
+      delete Jacd_fs;
+      Jacd_fs = NULL;
+      Jaccons_fs = alloc_Jac_fs(m_in);
+    }
+    assert(Jaccons_fs->m()==m_in);
+    return Jaccons_fs;
+  }
+  inline hiopMatrix* apply_to_jacob_cons(hiopMatrix& Jac_in, const int& m_in)
+  {
+    hiopMatrixDense* Jac_de = dynamic_cast<hiopMatrixDense*>(&Jac_in);
+    if(Jac_de==NULL) {
+      return nullptr;
+    }
+    assert(Jaccons_fs->m()==m_in);
+    applyInvToMatrix(Jac_de->local_data(), m_in, Jaccons_rs_ref->local_data());
+    return Jaccons_rs_ref;
+  }
 
   /** methods not inherited from parent class */
   bool setupDecisionVectorPart();
@@ -276,6 +352,9 @@ protected:
   
   void applyToMatrix   (const double* M_rs, const int& m_in, double* M_fs);
   void applyInvToMatrix(const double* M_fs, const int& m_in, double* M_rs);
+
+  /* allocates a full-space Jacobian with 'm_in' rows, distributed as the full-space vectors */
+  hiopMatrixDense* alloc_Jac_fs(const int& m_in);
 protected:
   long long n_fixed_vars_local;
   long long n_fixed_vars;
@@ -287,17 +366,33 @@ protected:
 
   //working buffer used to hold the full-space (user's) vector of decision variables and other optimiz objects
   hiopVector*x_fs, *grad_fs;
-  //working buffers for the full-space Jacobians
-  hiopMatrixDense *Jacc_fs, *Jacd_fs;
+  //working buffers for the full-space Jacobians, allocated at the first evaluation; only the
+  //equalities and inequalities ones or only the one of all the constraints are kept
+  hiopMatrixDense *Jacc_fs, *Jacd_fs, *Jaccons_fs;
   
   hiopMatrixDense *Jacc_rs_ref;
   hiopMatrixDense *Jacd_rs_ref;
+  hiopMatrixDense *Jaccons_rs_ref;
 
   //a copy of the lower and upper bounds provided by user
   hiopVector*xl_fs, *xu_fs;
   //indexes corresponding to fixed variables (local indexes)
   std::vector<int> fs2rs_idx_map;
 
+  /* Index view of the (local) full-space vectors built by 'setupDecisionVectorPart': the free 
+   * variables are stored as contiguous runs of full-space indexes [fs_start, fs_start+len) that 
+   * map to [rs_start, rs_start+len) in the reduced space. Transfers between spaces are done 
+   * run by run (memcpy) and do not visit the fixed variables, which are kept separately.
+   */
+  struct IdxRun
+  {
+    int fs_start;
+    int rs_start;
+    int len;
+  };
+  std::vector<IdxRun> free_runs_;
+  std::vector<int> fixed_idxs_;
+
   //references to reduced-space buffers - returned in applyInvXXX
   hiopVector* x_rs_ref_;
   hiopVector* grad_rs_ref;
@@ -351,6 +446,13 @@ public:
                         hiopMatrix& Jac_d, 
                         long long *cons_eq_mapping, 
                         long long *cons_ineq_mapping);
+  /* uses scaling factors previously computed (for example by an earlier solve of the same NLP) */
+  hiopNLPObjGradScaling(const double& scale_obj,
+                        const hiopVector& scale_c,
+                        const hiopVector& scale_d,
+                        const hiopVector& gradf,
+                        long long *cons_eq_mapping, 
+                        long long *cons_ineq_mapping);
   ~hiopNLPObjGradScaling();
 public:
   /** inherited from the parent class */
@@ -370,13 +472,20 @@ public:
 
   /// @brief return the scaling fact for objective
   inline double get_obj_scale() const {return scale_factor_obj;}
+  /// @brief return the scaling factors for equality and inequality constraints
+  inline const hiopVector& get_cons_eq_scale() const {return *scale_factor_c;}
+  inline const hiopVector& get_cons_ineq_scale() const {return *scale_factor_d;}
 
   /* from scaled to unscaled objective*/
   inline double apply_inv_to_obj(double& f_in) { return f_in/scale_factor_obj;}
   /* from unscaled to scaled objective*/
   inline double apply_to_obj(double& f_in) { return scale_factor_obj*f_in;}
 
-  /* from scaled to unscaled*/
+  /* from scaled to unscaled
+   * Note: the evaluations of the gradient and of the Jacobians do not call the inverse scaling
+   * since their buffers are overwritten by the user (see user_buffer_grad_obj in the parent),
+   * which saves a pass over the entries at each evaluation.
+   */
   inline hiopVector* apply_inv_to_grad_obj(hiopVector& grad_in)
   {
     grad_in.scale(1./scale_factor_obj);
@@ -469,6 +578,22 @@ public:
     Jac_in.scale_row(*scale_factor_d, false);
     return &Jac_in;
   }
+
+  /* from scaled to unscaled*/
+  inline hiopMatrix* apply_inv_to_jacob_cons(hiopMatrix& Jac_in, const int& m_in)
+  {
+    assert(n_ineq+n_eq==m_in);
+    Jac_in.scale_row(*scale_factor_cd, true);
+    return &Jac_in;
+  }
+
+  /* from unscaled to scaled*/
+  inline hiopMatrix* apply_to_jacob_cons(hiopMatrix& Jac_in, const int& m_in)
+  {
+    assert(n_ineq+n_eq==m_in);
+    Jac_in.scale_row(*scale_factor_cd, false);
+    return &Jac_in;
+  }
 #if 0
 protected: 
   void applyToArray   (const double* vec_rs, double* vec_fs);
@@ -514,6 +639,11 @@ public:
              hiopVector& dl,
              hiopVector& du);
 
+  /// Updates the (unrelaxed) bounds, for example, when the user changed them between solves
+  void set_original_bounds(const hiopVector& xl,
+                           const hiopVector& xu,
+                           const hiopVector& dl,
+                           const hiopVector& du);
 private:
   hiopVector* xl_ori;
   hiopVector* xu_ori;
@@ -541,6 +671,7 @@ public:
   inline void setUserNlpNumVars(const long long& n_vars) { n_vars_usernlp = n_vars; }
   inline void setUserNlpNumLocalVars(const long long& n_vars) { n_vars_local_usernlp = n_vars; }
   inline void append(hiopNlpTransformation* t) { list_trans_.push_back(t); }
+  inline size_t size() const { return list_trans_.size(); }
   inline void clear() { 
     std::list<hiopNlpTransformation*>::iterator it;
     for(it=list_trans_.begin(); it!=list_trans_.end(); it++)
@@ -658,6 +789,15 @@ public:
     return ret;
   }
 
+  hiopVector* user_buffer_grad_obj(hiopVector& grad_in) 
+  {
+    hiopVector* ret = &grad_in;
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it) {
+      ret = (*it)->user_buffer_grad_obj(*ret);
+    }
+    return ret;
+  }
+
   hiopVector* apply_to_grad_obj(hiopVector& grad_in) 
   {
     hiopVector* ret = &grad_in;
@@ -730,6 +870,15 @@ public:
     return ret;
   }
 
+  hiopMatrix* user_buffer_jacob_eq(hiopMatrix& Jac_in, const int& m_in)
+  {
+    hiopMatrix* ret = &Jac_in;
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it) {
+      ret = (*it)->user_buffer_jacob_eq(*ret, m_in);
+    }
+    return ret;
+  }
+
   hiopMatrix* apply_to_jacob_eq(hiopMatrix& Jac_in, const int& m_in)
   {
     hiopMatrix* ret = &Jac_in;
@@ -748,6 +897,15 @@ public:
     return ret;
   }
 
+  hiopMatrix* user_buffer_jacob_ineq(hiopMatrix& Jac_in, const int& m_in)
+  {
+    hiopMatrix* ret = &Jac_in;
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it) {
+      ret = (*it)->user_buffer_jacob_ineq(*ret, m_in);
+    }
+    return ret;
+  }
+
   hiopMatrix* apply_to_jacob_ineq(hiopMatrix& Jac_in, const int& m_in)
   {
     hiopMatrix* ret = &Jac_in;
@@ -757,6 +915,33 @@ public:
     return ret;
   }
 
+  hiopMatrix* apply_inv_to_jacob_cons(hiopMatrix& Jac_in, const int& m_in)
+  {
+    hiopMatrix* ret = &Jac_in;
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it) {
+      ret = (*it)->apply_inv_to_jacob_cons(*ret, m_in);
+    }
+    return ret;
+  }
+
+  hiopMatrix* user_buffer_jacob_cons(hiopMatrix& Jac_in, const int& m_in)
+  {
+    hiopMatrix* ret = &Jac_in;
+    for(std::list<hiopNlpTransformation*>::reverse_iterator it=list_trans_.rbegin(); it!=list_trans_.rend(); ++it) {
+      ret = (*it)->user_buffer_jacob_cons(*ret, m_in);
+    }
+    return ret;
+  }
+
+  hiopMatrix* apply_to_jacob_cons(hiopMatrix& Jac_in, const int& m_in)
+  {
+    hiopMatrix* ret = &Jac_in;
+    for(std::list<hiopNlpTransformation*>::iterator it=list_trans_.begin(); it!=list_trans_.end(); ++it) {
+      ret = (*it)->apply_to_jacob_cons(*ret, m_in);
+    }
+    return ret;
+  }
+
 
 private:
   std::list<hiopNlpTransformation*> list_trans_;
@@ -1,6 +1,8 @@
 #ifndef HIOP_PERTURB_PD_LINSSYS
 #define HIOP_PERTURB_PD_LINSSYS
 
+#include "hiopCheckpoint.hpp"
+
 namespace hiop
 {
 
@@ -72,6 +74,39 @@ public:
     mu_ = mu;
   }
 
+  /** Appends the current and last perturbations and the degeneracy state to a checkpoint. */
+  inline void save_state(hiopCheckpoint& ckpt) const
+  {
+    const double deltas[8] = {delta_wx_curr_, delta_wd_curr_, delta_cc_curr_, delta_cd_curr_,
+                              delta_wx_last_, delta_wd_last_, delta_cc_last_, delta_cd_last_};
+    ckpt.append(deltas, 8);
+    ckpt.append(static_cast<int>(hess_degenerate_));
+    ckpt.append(static_cast<int>(jac_degenerate_));
+    ckpt.append(num_degen_iters_);
+    ckpt.append(static_cast<int>(deltas_test_type_));
+    ckpt.append(mu_);
+  }
+
+  /** Restores the state saved by @save_state; to be called after @initialize. */
+  inline bool load_state(hiopCheckpoint& ckpt)
+  {
+    double deltas[8];
+    int hess_degen, jac_degen, test_type;
+    if(!ckpt.extract(deltas, 8) ||
+       !ckpt.extract(hess_degen) || !ckpt.extract(jac_degen) ||
+       !ckpt.extract(num_degen_iters_) || !ckpt.extract(test_type) || !ckpt.extract(mu_)) {
+      return false;
+    }
+    delta_wx_curr_ = deltas[0]; delta_wd_curr_ = deltas[1];
+    delta_cc_curr_ = deltas[2]; delta_cd_curr_ = deltas[3];
+    delta_wx_last_ = deltas[4]; delta_wd_last_ = deltas[5];
+    delta_cc_last_ = deltas[6]; delta_cd_last_ = deltas[7];
+    hess_degenerate_ = static_cast<DegeneracyType>(hess_degen);
+    jac_degenerate_ = static_cast<DegeneracyType>(jac_degen);
+    deltas_test_type_ = static_cast<DeltasTestType>(test_type);
+    return true;
+  }
+
   /** Called when a new linear system is attempted to be factorized 
    */
   bool compute_initial_deltas(double& delta_wx, double& delta_wd,
@@ -95,6 +95,16 @@ hiopResidual::~hiopResidual()
   if(rsvu) delete rsvu;
 }
 
+double hiopResidual::compute_nlp_infeasib_eq_onenorm(const hiopVector& c)
+{
+  nlp->runStats.tmSolverInternal.start();
+  ryc->copyFrom(nlp->get_crhs());
+  ryc->axpy(-1.0,c);
+  double nrmOne_infeasib = ryc->onenorm();
+  nlp->runStats.tmSolverInternal.stop();
+  return nrmOne_infeasib;
+}
+
 double hiopResidual::compute_nlp_infeasib_onenorm (const hiopIterate& it, 
 			       const hiopVector& c, 
 			       const hiopVector& d)
@@ -575,6 +585,29 @@ void hiopResidual::update_soc(const hiopIterate& it,
 
 }
 
+void hiopResidual::update_soc_feasib(const hiopVector& c_soc, const hiopVector& d_soc)
+{
+  nlp->runStats.tmSolverInternal.start();
+
+  //ryc for soc: \alpha*c + c_trial
+  ryc->copyFrom(c_soc);
+  //ryd for soc: \alpha*(slack-d_soc) + (slack_trial-c_trial)
+  ryd->copyFrom(d_soc);
+
+  //the bounds residuals do not contribute to the feasibility norms (see 'update_soc')
+  nrmInf_nlp_feasib = fmax(ryc->infnorm_local(), ryd->infnorm_local());
+  nrmOne_nlp_feasib = ryc->onenorm() + ryd->onenorm();
+#ifdef HIOP_USE_MPI
+  double aux_g;
+  int ierr = MPI_Allreduce(&nrmInf_nlp_feasib, &aux_g, 1, MPI_DOUBLE, MPI_MAX, nlp->get_comm());
+  assert(MPI_SUCCESS==ierr);
+  nrmInf_nlp_feasib = aux_g;
+#endif
+  nrmInf_bar_feasib = nrmInf_nlp_feasib;
+  nrmOne_bar_feasib = nrmOne_nlp_feasib;
+
+  nlp->runStats.tmSolverInternal.stop();
+}
 
 };
 
@@ -93,6 +93,15 @@ public:
                           const hiopMatrix& jac_d,
                           const hiopLogBarProblem& logprob);
 
+  /**
+   * @brief Refreshes only ryc and ryd, and the cached feasibility norms, for a new pair 
+   * `c_soc` and `d_soc` of second-order-correction infeasibilities.
+   *
+   * @pre `update_soc` was called at the same iterate and barrier parameter. The other 
+   *      residuals do not depend on `c_soc` and `d_soc` and are kept.
+   */
+  virtual void update_soc_feasib(const hiopVector& c_soc, const hiopVector& d_soc);
+
   /* Return the Nlp and Log-bar errors computed at the previous update call. */
   inline void getNlpErrors(double& optim, double& feas, double& comple) const
   { optim=nrmInf_nlp_optim; feas=nrmInf_nlp_feasib; comple=nrmInf_nlp_complem;};
@@ -115,6 +124,10 @@ public:
                                        const hiopVector& c_eval,
                                        const hiopVector& d_eval);
 
+  /* one norm of the infeasibility of the equalities, which is a lower bound for the quantity 
+   * returned by the above method. Modifies ryc. */
+  double compute_nlp_infeasib_eq_onenorm(const hiopVector& c_eval);
+
   /* residual printing function - calls hiopVector::print
    * prints up to max_elems (by default all), on rank 'rank' (by default on all) */
   virtual void print(FILE*, const char* msg=NULL, int max_elems=-1, int rank=-1) const;
@@ -115,6 +115,15 @@ void hiopOptions::registerOptions()
 		    "Linear reduction coefficient for mu (default 0.2) (eqn (7) in Filt-IPM paper)");
   registerNumOption("theta_mu", 1.5,  1.0,   2.0,
 		    "Exponential reduction coefficient for mu (default 1.5) (eqn (7) in Filt-IPM paper)");
+  {
+    vector<string> range(2); range[0] = "monotone"; range[1] = "adaptive";
+    registerStrOption("mu_strategy", "monotone", range,
+		      "Update of the log-barrier parameter: 'monotone' decreases mu (using 'kappa_mu' and "
+                      "'theta_mu') when the log-barrier problem is solved to 'kappa_eps'*mu; 'adaptive' "
+                      "chooses mu at each iteration by Mehrotra probing, that is, from the complementarity "
+                      "obtained along the affine-scaling direction computed with the current factorization "
+                      "of the KKT system. Only used by the Newton solver (default monotone)");
+  }
   registerNumOption("eta_phi", 1e-8, 0, 0.01, "Parameter of (suff. decrease) in Armijo Rule");
   registerNumOption("tolerance", 1e-8, 1e-14, 1e-1,
 		    "Absolute error tolerance for the NLP (default 1e-8)");
@@ -161,6 +170,15 @@ void hiopOptions::registerOptions()
 
   }
 
+  {
+    vector<string> range(2); range[0] = "no"; range[1] = "yes";
+    registerStrOption("warm_start", "no", range,
+		      "Warm start from the primal-dual point provided by the user via 'get_starting_point' "
+                      "with 'duals_avail' set to true: the initial mu and the bound push are chosen based on "
+                      "the complementarity of this point and no LSQ initialization of the duals is done. "
+                      "Ignored if the user does not provide duals (default no)");
+  }
+
   registerIntOption("max_iter", 3000, 1, 1e6, "Max number of iterations (default 3000)");
 
   registerNumOption("acceptable_tolerance", 1e-6, 1e-14, 1e-1,
@@ -169,6 +187,17 @@ void hiopOptions::registerOptions()
   registerIntOption("acceptable_iterations", 10, 1, 1e6,
 		    "Number of iterations of acceptable tolerance after which HiOp terminates (default 10)");
 
+  {
+    vector<string> range(2); range[0] = "no"; range[1] = "yes";
+    registerStrOption("early_termination", "no", range,
+		      "Terminate with status Slow_Convergence when the convergence rate of the NLP error and "
+		      "of mu over the last 'early_termination_window' iterations predicts that 'tolerance' "
+		      "is not reached within 'max_iter' iterations; the best iterate is returned (default no)");
+  }
+  registerIntOption("early_termination_window", 20, 2, 1e6,
+		    "Number of iterations over which the convergence rate is estimated for "
+		    "'early_termination' (default 20)");
+
   registerNumOption("sigma0", 1., 0., 1e+7,
 		    "Initial value of the initial multiplier of the identity in the secant "
 		    "approximation (default 1.)");
@@ -240,12 +269,31 @@ void hiopOptions::registerOptions()
 		      "Factor to decrease the constraint violation in second order correction.");
   }
 
+  // feasibility restoration
+  {
+    vector<string> range(2); range[0]="yes"; range[1]="no";
+    registerStrOption("feasibility_restoration", "yes", range,
+		      "Whether the Newton filter IPM enters a feasibility restoration phase when the line "
+		      "search fails (default yes). Available only for MDS problems; for other formulations "
+		      "the restoration is not used and a warning is issued if it is requested explicitly.");
+
+    registerNumOption("resto_penalty_parameter", 1000., 1e-8, 1e+20,
+		      "Penalty of the elastic variables (the constraints violation) in the objective of the "
+		      "feasibility restoration problem (default 1000)");
+  }
+
   //optimization method used
   {
-    vector<string> range(2); range[0]="quasinewton_approx"; range[1]="analytical_exact";
+    vector<string> range(4);
+    range[0]="quasinewton_approx"; range[1]="quasinewton_damped_bfgs"; range[2]="quasinewton_lsr1";
+    range[3]="analytical_exact";
     registerStrOption("Hessian", "quasinewton_approx", range,
 		      "Type of Hessian used with the filter IPM: 'quasinewton_approx' built internally "
-		      "by HiOp (default option) or 'analytical_exact' provided by the user");
+		      "by HiOp with limited-memory BFGS updates (default option), 'quasinewton_damped_bfgs' "
+		      "with Powell-damped BFGS updates, 'quasinewton_lsr1' with limited-memory SR1 updates "
+		      "(possibly indefinite, corrected as needed by inertia correction), or 'analytical_exact' "
+		      "provided by the user. For MDS and sparse problems, the quasi-Newton Hessians are used "
+		      "only when requested explicitly; otherwise the user's Hessian is used.");
   }
   //linear algebra
   {
@@ -316,6 +364,26 @@ void hiopOptions::registerOptions()
 		      "turn on/off performance timers and reporting of the computational constituents of the "
 		      "KKT solve process");
   }
+  // structured per-iteration trace
+  {
+    vector<string> range(3); range[0]="no"; range[1]="csv"; range[2]="binary";
+    registerStrOption("trace", range[0], range,
+		      "Write one record per iteration with the iteration output and the run statistics "
+		      "timers to 'trace_file'; the file is written in the background (default 'no')");
+    registerStrOption("trace_file", "hiop_trace", vector<string>(),
+		      "Trace file; the extension '.csv' or '.bin' is appended (default 'hiop_trace')");
+  }
+  // hierarchical profiler
+  {
+    vector<string> range(2); range[0]="no"; range[1]="yes";
+    registerStrOption("profile", range[0], range,
+		      "Time the regions of the solver (iterations, KKT updates and solves, linear solvers, "
+		      "and NLP evaluations), log their call tree, and write a Chrome-trace to "
+		      "'profile_file' (default 'no')");
+    registerStrOption("profile_file", "hiop_profile.json", vector<string>(),
+		      "Chrome-trace file of the profiler; under MPI, the rank is appended to the name "
+		      "(default 'hiop_profile.json')");
+  }
 
   //other options
   {
@@ -324,6 +392,21 @@ void hiopOptions::registerOptions()
 		      "write internal KKT linear system (matrix, rhs, sol) to file (default 'no')");
   }
 
+  // checkpointing of the state of the algorithm
+  {
+    vector<string> range(2); range[0]="no"; range[1]="yes";
+    registerStrOption("checkpoint_save", range[0], range,
+		      "Save the state of the algorithm to 'checkpoint_file' every 'checkpoint_save_N' "
+		      "iterations; the file is written in the background (default 'no')");
+    registerIntOption("checkpoint_save_N", 10, 1, 1e6,
+		      "Number of iterations between checkpoints (default 10)");
+    registerStrOption("checkpoint_file", "hiop_state.ckpt", vector<string>(),
+		      "Checkpoint file; under MPI, the rank is appended to the name (default "
+		      "'hiop_state.ckpt')");
+    registerStrOption("checkpoint_load_on_start", range[0], range,
+		      "Resume the solve from the state saved in 'checkpoint_file' (default 'no')");
+  }
+
   // memory space selection
   {
 #ifdef HIOP_USE_RAJA
@@ -339,6 +422,13 @@ void hiopOptions::registerOptions()
     registerStrOption("mem_space", range[0], range,
     "Determines the memory space in which future linear algebra objects will be created");
   }
+  {
+    registerNumOption("memory_budget", 0., 0., 1e+20,
+                      "Memory (in MB) available on each rank to the linear algebra objects of HiOp; when "
+                      "exceeded by the estimated footprint, lower-memory variants are used: no copies of the "
+                      "Jacobians at the trial point are kept and 'KKTLinsys=XYcYd' replaces the larger "
+                      "sparse systems. A value of 0 (default) means no budget.");
+  }
 }
 
 void hiopOptions::registerNumOption(const std::string& name, double defaultValue,
@@ -377,7 +467,7 @@ void hiopOptions::ensureConsistence()
     }
   }
 
-  if(GetString("Hessian")=="quasinewton_approx") {
+  if(GetString("Hessian")!="analytical_exact") {
     string strKKT = GetString("KKTLinsys");
     if(strKKT=="xycyd" || strKKT=="xdycyd" || strKKT=="full") {
       if(is_user_defined("Hessian")) {
@@ -730,6 +820,12 @@ bool hiopOptions::SetStringValue (const char* name,  const char* value, const bo
 	option->specifiedInFile=true;
 
       string strValue(value);
+      //options with an empty range, such as file names, accept any value, case-sensitive
+      if(option->range.empty()) {
+        option->val = strValue;
+        ensureConsistence();
+        return true;
+      }
       transform(strValue.begin(), strValue.end(), strValue.begin(), ::tolower);
       //see if it is in the range (of supported values)
       bool inrange=false;
@@ -793,6 +889,10 @@ void hiopOptions::OptionInt::print(FILE* f) const
 
 void hiopOptions::OptionStr::print(FILE* f) const
 {
+  if(range.empty()) {
+    fprintf(f, "%s \t# (string) [%s]", val.c_str(), descr.c_str());
+    return;
+  }
   stringstream ssRange; ssRange << " ";
   for(int i=0; i<range.size(); i++) ssRange << range[i] << " ";
   fprintf(f, "%s \t# (string) one of [%s] [%s]", val.c_str(), ssRange.str().c_str(), descr.c_str());
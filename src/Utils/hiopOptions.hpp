@@ -85,6 +85,10 @@ public:
     ensureConsistence();
   }
   virtual void print(FILE* file, const char* msg=NULL) const;
+
+  //Returns true if an option was set or not by the user (via file or at runtime)
+  //or false if the option was not or cannot be found
+  virtual bool is_user_defined(const char* option_name);
 protected:
   /* internal use only */
 
@@ -102,10 +106,6 @@ protected:
   virtual bool set_val(const char* name, const int& value);
   virtual bool set_val(const char* name, const char* value);
 
-  //Returns true if an option was set or not by the user (via file or at runtime)
-  //or false if the option was not or cannot be found
-  virtual bool is_user_defined(const char* option_name);
-  
   void log_printf(hiopOutVerbosity v, const char* format, ...);
 
   struct Option { // option entry
@@ -0,0 +1,341 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+/**
+ * @file hiopProfiler.cpp
+ *
+ * Hierarchical profiler with scoped regions and Chrome-trace output.
+ *
+ */
+
+#include "hiopProfiler.hpp"
+
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+
+#ifdef HIOP_USE_PERF_EVENT
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace hiop
+{
+
+/* number of hardware counters per region: CPU cycles and instructions */
+static const int num_hw_counters = 2;
+
+struct hiopProfiler::Node
+{
+  Node(const char* name_, Node* parent_)
+    : name(name_), parent(parent_), calls(0), incl(0.)
+  {
+    for(int i=0; i<num_hw_counters; i++) {
+      hw[i] = 0;
+    }
+  }
+  const char* name;
+  Node* parent;
+  std::vector<std::unique_ptr<Node> > children;
+  long long calls;
+  double incl;
+  long long hw[num_hw_counters];
+};
+
+struct hiopProfiler::ThreadData
+{
+  struct Frame
+  {
+    std::chrono::steady_clock::time_point start;
+    long long hw[num_hw_counters];
+  };
+  struct Event
+  {
+    const char* name;
+    double ts, dur; //in microseconds
+    long long hw[num_hw_counters];
+  };
+
+  ThreadData(int tid_)
+    : tid(tid_), root("root", nullptr), curr(&root), dropped(0)
+  {
+    for(int i=0; i<num_hw_counters; i++) {
+      perf_fd[i] = -1;
+    }
+  }
+  ~ThreadData()
+  {
+#ifdef HIOP_USE_PERF_EVENT
+    for(int i=0; i<num_hw_counters; i++) {
+      if(perf_fd[i]>=0) {
+        close(perf_fd[i]);
+      }
+    }
+#endif
+  }
+  void reset()
+  {
+    root.children.clear();
+    root.calls = 0;
+    root.incl = 0.;
+    curr = &root;
+    stack.clear();
+    events.clear();
+    dropped = 0;
+  }
+
+  int tid;
+  Node root;
+  Node* curr;
+  std::vector<Frame> stack;
+  std::vector<Event> events;
+  size_t dropped;
+  int perf_fd[num_hw_counters];
+};
+
+std::atomic<bool> hiopProfiler::enabled_(false);
+const size_t hiopProfiler::max_events_per_thread = 1000000;
+
+/* the data of all the threads that entered a region; the data of a thread outlives it so
+ * that it can be reported */
+static std::mutex prof_mutex;
+static std::vector<std::unique_ptr<hiopProfiler::ThreadData> > prof_threads;
+static std::chrono::steady_clock::time_point prof_t0 = std::chrono::steady_clock::now();
+static thread_local hiopProfiler::ThreadData* prof_this_thread = nullptr;
+
+#ifdef HIOP_USE_PERF_EVENT
+static int open_hw_counter(unsigned long long config)
+{
+  perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  //this thread, any CPU
+  return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+}
+#endif
+
+static inline void read_hw_counters(const int* fd, long long* values)
+{
+  for(int i=0; i<num_hw_counters; i++) {
+    values[i] = -1;
+#ifdef HIOP_USE_PERF_EVENT
+    long long v;
+    if(fd[i]>=0 && sizeof(v)==read(fd[i], &v, sizeof(v))) {
+      values[i] = v;
+    }
+#endif
+  }
+}
+
+hiopProfiler::ThreadData* hiopProfiler::thread_data()
+{
+  if(nullptr==prof_this_thread) {
+    std::lock_guard<std::mutex> lock(prof_mutex);
+    prof_threads.emplace_back(new ThreadData(static_cast<int>(prof_threads.size())));
+    prof_this_thread = prof_threads.back().get();
+#ifdef HIOP_USE_PERF_EVENT
+    prof_this_thread->perf_fd[0] = open_hw_counter(PERF_COUNT_HW_CPU_CYCLES);
+    prof_this_thread->perf_fd[1] = open_hw_counter(PERF_COUNT_HW_INSTRUCTIONS);
+#endif
+  }
+  return prof_this_thread;
+}
+
+void hiopProfiler::enter(ThreadData* td, const char* name)
+{
+  Node* node = nullptr;
+  for(auto& child : td->curr->children) {
+    if(child->name==name || 0==strcmp(child->name, name)) {
+      node = child.get();
+      break;
+    }
+  }
+  if(nullptr==node) {
+    td->curr->children.emplace_back(new Node(name, td->curr));
+    node = td->curr->children.back().get();
+  }
+  td->curr = node;
+
+  td->stack.emplace_back();
+  ThreadData::Frame& frame = td->stack.back();
+  read_hw_counters(td->perf_fd, frame.hw);
+  frame.start = std::chrono::steady_clock::now();
+}
+
+void hiopProfiler::leave(ThreadData* td)
+{
+  const auto stop = std::chrono::steady_clock::now();
+  //the data was discarded by 'start' while this region was active
+  if(td->stack.empty()) {
+    return;
+  }
+  long long hw[num_hw_counters];
+  read_hw_counters(td->perf_fd, hw);
+
+  const ThreadData::Frame& frame = td->stack.back();
+  const double elapsed = std::chrono::duration<double>(stop-frame.start).count();
+  Node* node = td->curr;
+  node->calls++;
+  node->incl += elapsed;
+  for(int i=0; i<num_hw_counters; i++) {
+    hw[i] = (hw[i]>=0 && frame.hw[i]>=0) ? hw[i]-frame.hw[i] : -1;
+    node->hw[i] = (hw[i]>=0 && node->hw[i]>=0) ? node->hw[i]+hw[i] : -1;
+  }
+
+  if(td->events.size()<max_events_per_thread) {
+    ThreadData::Event ev;
+    ev.name = node->name;
+    ev.ts = std::chrono::duration<double, std::micro>(frame.start-prof_t0).count();
+    ev.dur = 1e6*elapsed;
+    for(int i=0; i<num_hw_counters; i++) {
+      ev.hw[i] = hw[i];
+    }
+    td->events.push_back(ev);
+  } else {
+    td->dropped++;
+  }
+
+  td->stack.pop_back();
+  td->curr = node->parent;
+}
+
+void hiopProfiler::start()
+{
+  std::lock_guard<std::mutex> lock(prof_mutex);
+  for(auto& td : prof_threads) {
+    td->reset();
+  }
+  prof_t0 = std::chrono::steady_clock::now();
+  enabled_.store(true);
+}
+
+void hiopProfiler::stop()
+{
+  enabled_.store(false);
+}
+
+bool hiopProfiler::write_chrome_trace(const std::string& file_name, int pid)
+{
+  FILE* f = fopen(file_name.c_str(), "w");
+  if(NULL==f) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(prof_mutex);
+  fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  bool first = true;
+  for(auto& td : prof_threads) {
+    for(const ThreadData::Event& ev : td->events) {
+      fprintf(f, "%s{\"name\":\"%s\",\"cat\":\"hiop\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d",
+              first ? "" : ",\n", ev.name, ev.ts, ev.dur, pid, td->tid);
+      if(ev.hw[0]>=0 || ev.hw[1]>=0) {
+        fprintf(f, ",\"args\":{\"cycles\":%lld,\"instructions\":%lld}", ev.hw[0], ev.hw[1]);
+      }
+      fprintf(f, "}");
+      first = false;
+    }
+  }
+  fprintf(f, "\n]}\n");
+  return 0==fclose(f);
+}
+
+static void summary_of_node(const hiopProfiler::Node& node, int depth, std::stringstream& ss)
+{
+  double incl_children = 0.;
+  for(auto& child : node.children) {
+    incl_children += child->incl;
+  }
+  ss << std::setw(2*depth) << "" << std::left << std::setw(36-2*depth) << node.name << std::right
+     << std::setw(10) << node.calls
+     << std::setw(12) << node.incl
+     << std::setw(12) << node.incl-incl_children;
+  if(node.hw[0]>=0 && node.hw[1]>=0 && node.calls>0) {
+    ss << std::setw(16) << node.hw[0] << std::setw(16) << node.hw[1];
+  }
+  ss << std::endl;
+  for(auto& child : node.children) {
+    summary_of_node(*child, depth+1, ss);
+  }
+}
+
+std::string hiopProfiler::get_summary()
+{
+  std::lock_guard<std::mutex> lock(prof_mutex);
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(4);
+  for(auto& td : prof_threads) {
+    if(td->root.children.empty()) {
+      continue;
+    }
+    ss << "Profile of thread " << td->tid << std::endl;
+    ss << std::left << std::setw(36) << "region" << std::right << std::setw(10) << "calls"
+       << std::setw(12) << "incl(s)" << std::setw(12) << "excl(s)";
+#ifdef HIOP_USE_PERF_EVENT
+    ss << std::setw(16) << "cycles" << std::setw(16) << "instructions";
+#endif
+    ss << std::endl;
+    for(auto& child : td->root.children) {
+      summary_of_node(*child, 0, ss);
+    }
+    if(td->dropped>0) {
+      ss << "(" << td->dropped << " events not recorded in the trace)" << std::endl;
+    }
+  }
+  return ss.str();
+}
+
+} //end namespace
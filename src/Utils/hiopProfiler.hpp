@@ -0,0 +1,145 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+/**
+ * @file hiopProfiler.hpp
+ *
+ * Hierarchical profiler with scoped regions and Chrome-trace output.
+ *
+ */
+
+#ifndef HIOP_PROFILER
+#define HIOP_PROFILER
+
+#include "hiop_defs.hpp"
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+
+namespace hiop
+{
+
+/* *************************************************************************
+ * Low-overhead hierarchical profiler. Code regions are timed by creating a 
+ * hiopProfileScope (or with the macro HIOP_PROFILE_SCOPE) at the beginning of 
+ * the region; the region ends when the scope object is destroyed. Region names
+ * must be string literals (only the pointers are stored).
+ *
+ * Each thread records its own call tree, in which a region is identified by 
+ * its name and its parent region, with the number of calls and the inclusive 
+ * time; the exclusive time is the inclusive time minus that of the children.
+ * Each call is also recorded as an event for the Chrome-trace output 
+ * (chrome://tracing, Perfetto), up to 'max_events_per_thread' events.
+ *
+ * When built with HIOP_USE_PERF_EVENT (Linux only), the CPU cycles and the 
+ * instructions of each region are also collected through perf_event.
+ *
+ * The profiler is disabled by default, in which case a scope costs one load 
+ * and test of a flag. The algorithm enables it with the option 'profile'.
+ * *************************************************************************
+ */
+class hiopProfiler
+{
+public:
+  static inline bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+  /* discards the recorded data of all threads and enables/disables the recording */
+  static void start();
+  static void stop();
+
+  /* Chrome-trace JSON with one "complete" event per call; 'pid' is used to tell the ranks 
+   * apart. Returns false if the file could not be written. */
+  static bool write_chrome_trace(const std::string& file_name, int pid=0);
+  /* the call trees as text, with calls and inclusive/exclusive times in seconds */
+  static std::string get_summary();
+
+  static const size_t max_events_per_thread;
+
+  /* used by hiopProfileScope */
+  struct Node;
+  struct ThreadData;
+  static ThreadData* thread_data();
+  static void enter(ThreadData* td, const char* name);
+  static void leave(ThreadData* td);
+private:
+  static std::atomic<bool> enabled_;
+};
+
+/* times the enclosing scope as a region of the profiler */
+class hiopProfileScope
+{
+public:
+  explicit hiopProfileScope(const char* name)
+    : td_(nullptr)
+  {
+    if(hiopProfiler::enabled()) {
+      td_ = hiopProfiler::thread_data();
+      hiopProfiler::enter(td_, name);
+    }
+  }
+  ~hiopProfileScope()
+  {
+    if(td_) {
+      hiopProfiler::leave(td_);
+    }
+  }
+private:
+  hiopProfileScope(const hiopProfileScope&) = delete;
+  hiopProfileScope& operator=(const hiopProfileScope&) = delete;
+  hiopProfiler::ThreadData* td_;
+};
+
+#define HIOP_PROFILE_CONCAT_(a, b) a##b
+#define HIOP_PROFILE_CONCAT(a, b) HIOP_PROFILE_CONCAT_(a, b)
+#define HIOP_PROFILE_SCOPE(name) \
+  hiop::hiopProfileScope HIOP_PROFILE_CONCAT(hiop_profile_scope_, __LINE__)(name)
+
+} //end namespace
+#endif
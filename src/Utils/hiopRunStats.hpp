@@ -50,14 +50,14 @@
 #define HIOP_RUNSTATS
 
 #include "hiopTimer.hpp"
+#include "hiopMemStats.hpp"
 
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <cstddef>
 
-#ifdef HIOP_USE_MPI
-#include "mpi.h"  
-#endif
+#include "hiopMPI.hpp"
 namespace hiop
 {
 
@@ -225,7 +225,6 @@ public:
   }
 };
 
-
 class hiopRunStats
 {
 public:
@@ -250,6 +249,8 @@ public:
 
   hiopRunKKTSolStats kkt;
   hiopLinSolStats linsolv;
+  //snapshot of the memory tracked by LinearAlgebraFactory, taken at the end of the optimization
+  hiopMemStats mem;
   inline virtual void initialize() {
     tmOptimizTotal = tmSolverInternal = tmSearchDir = tmStartingPoint = tmMultUpdate = tmComm = tmInit = 0.;
     tmEvalObj = tmEvalGrad_f = tmEvalCons = tmEvalJac_con = tmEvalHessL = 0.;    
@@ -317,6 +318,8 @@ public:
        << " eq cons " << nEvalCons_eq << " ineq cons " << nEvalCons_ineq 
        << " eq Jac " << nEvalJac_con_eq << " ineq Jac " << nEvalJac_con_ineq << std::endl;
 
+    ss << mem.get_summary();
+
     return ss.str();
   }
 private:
@@ -0,0 +1,202 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+/**
+ * @file hiopTrace.cpp
+ *
+ * Per-iteration trace of the solver in CSV or binary format, written in the background.
+ *
+ */
+
+#include "hiopTrace.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <cstdint>
+
+namespace hiop
+{
+
+const char* hiopTraceWriter::column_names[] = {
+  "iter", "objective", "inf_pr", "inf_du", "mu", "alpha_du", "alpha_pr", "ls_trials", "ls_status", "soc",
+  "wall_time",
+  //hiopRunStats (cumulative)
+  "tm_solver_internal", "tm_search_dir", "tm_starting_point", "tm_mult_update", "tm_comm", "tm_init",
+  "tm_eval_obj", "tm_eval_grad_f", "tm_eval_cons", "tm_eval_jac_con", "tm_eval_hess_l",
+  "n_eval_obj", "n_eval_grad_f", "n_eval_cons_eq", "n_eval_cons_ineq", "n_eval_jac_con_eq",
+  "n_eval_jac_con_ineq", "n_eval_hess_l",
+  //hiopRunKKTSolStats (last iteration)
+  "kkt_tm_iter", "kkt_tm_update_init", "kkt_tm_update_linsys", "kkt_tm_fact", "kkt_n_inertia_corr",
+  "kkt_tm_solve_rhs_manip", "kkt_tm_solve_triangular",
+  //hiopLinSolStats (last linear solve)
+  "linsol_tm_fact", "linsol_tm_inertia", "linsol_tm_triu_solves", "linsol_tm_device_transfer",
+  "linsol_flops_fact", "linsol_flops_triu_solves"
+};
+const int hiopTraceWriter::num_columns = sizeof(hiopTraceWriter::column_names)/sizeof(const char*);
+
+/* number of records after which the buffer is handed to the background writer */
+static const size_t trace_records_per_write = 256;
+
+hiopTraceWriter::hiopTraceWriter(const std::string& file_name, Format format)
+  : file_name_(file_name), format_(format), file_(NULL), curr_(0), writer_ok_(true), all_ok_(true),
+    tm_start_(std::chrono::steady_clock::now())
+{
+  file_ = fopen(file_name_.c_str(), format_==binary ? "wb" : "w");
+  if(NULL==file_) {
+    return;
+  }
+  if(format_==binary) {
+    const char magic[8] = {'H','I','O','P','T','R','C','1'};
+    const int32_t ncols = num_columns;
+    fwrite(magic, 1, sizeof(magic), file_);
+    fwrite(&ncols, sizeof(ncols), 1, file_);
+    for(int i=0; i<num_columns; i++) {
+      fwrite(column_names[i], 1, strlen(column_names[i])+1, file_);
+    }
+  } else {
+    for(int i=0; i<num_columns; i++) {
+      fprintf(file_, i==0 ? "%s" : ",%s", column_names[i]);
+    }
+    fprintf(file_, "\n");
+  }
+  buffers_[0].reserve(trace_records_per_write*num_columns);
+  buffers_[1].reserve(trace_records_per_write*num_columns);
+}
+
+hiopTraceWriter::~hiopTraceWriter()
+{
+  flush();
+  if(file_) {
+    fclose(file_);
+  }
+}
+
+void hiopTraceWriter::record(int iter, double obj, double inf_pr, double inf_du, double mu,
+                             double alpha_du, double alpha_pr, int ls_trials, int ls_status, int use_soc,
+                             const hiopRunStats& stats)
+{
+  if(NULL==file_) {
+    return;
+  }
+  const std::chrono::duration<double> wall = std::chrono::steady_clock::now()-tm_start_;
+  const hiopRunKKTSolStats& kkt = stats.kkt;
+  const hiopLinSolStats& ls = stats.linsolv;
+  const double rec[] = {
+    (double)iter, obj, inf_pr, inf_du, mu, alpha_du, alpha_pr, (double)ls_trials, (double)ls_status,
+    (double)use_soc,
+    wall.count(),
+    stats.tmSolverInternal.getElapsedTime(), stats.tmSearchDir.getElapsedTime(),
+    stats.tmStartingPoint.getElapsedTime(), stats.tmMultUpdate.getElapsedTime(),
+    stats.tmComm.getElapsedTime(), stats.tmInit.getElapsedTime(),
+    stats.tmEvalObj.getElapsedTime(), stats.tmEvalGrad_f.getElapsedTime(), stats.tmEvalCons.getElapsedTime(),
+    stats.tmEvalJac_con.getElapsedTime(), stats.tmEvalHessL.getElapsedTime(),
+    (double)stats.nEvalObj, (double)stats.nEvalGrad_f, (double)stats.nEvalCons_eq,
+    (double)stats.nEvalCons_ineq, (double)stats.nEvalJac_con_eq, (double)stats.nEvalJac_con_ineq,
+    (double)stats.nEvalHessL,
+    kkt.tmTotalPerIter.getElapsedTime(), kkt.tmUpdateInit.getElapsedTime(),
+    kkt.tmUpdateLinsys.getElapsedTime(), kkt.tmUpdateInnerFact.getElapsedTime(), (double)kkt.nUpdateICCorr,
+    kkt.tmSolveRhsManip.getElapsedTime(), kkt.tmSolveTriangular.getElapsedTime(),
+    ls.tmFactTime.getElapsedTime(), ls.tmInertiaComp.getElapsedTime(), ls.tmTriuSolves.getElapsedTime(),
+    ls.tmDeviceTransfer.getElapsedTime(), ls.flopsFact, ls.flopsTriuSolves
+  };
+  static_assert(sizeof(rec)/sizeof(double)==sizeof(column_names)/sizeof(const char*),
+                "the trace record and the column names do not match");
+
+  std::vector<double>& buff = buffers_[curr_];
+  buff.insert(buff.end(), rec, rec+num_columns);
+  if(buff.size()>=trace_records_per_write*num_columns) {
+    commit();
+  }
+}
+
+void hiopTraceWriter::write_records(const std::vector<double>* records, FILE* f, Format format, bool* ok)
+{
+  if(format==binary) {
+    *ok = records->size()==fwrite(records->data(), sizeof(double), records->size(), f);
+  } else {
+    *ok = true;
+    const double* rec = records->data();
+    for(size_t r=0; r<records->size()/num_columns; r++, rec+=num_columns) {
+      for(int i=0; i<num_columns; i++) {
+        fprintf(f, i==0 ? "%.17g" : ",%.17g", rec[i]);
+      }
+      *ok = fprintf(f, "\n")>0 && *ok;
+    }
+  }
+  *ok = 0==fflush(f) && *ok;
+}
+
+void hiopTraceWriter::commit()
+{
+  //the previous write uses the other buffer
+  if(writer_.joinable()) {
+    writer_.join();
+  }
+  all_ok_ = all_ok_ && writer_ok_;
+  writer_ = std::thread(write_records, &buffers_[curr_], file_, format_, &writer_ok_);
+  curr_ = 1-curr_;
+  buffers_[curr_].clear();
+}
+
+bool hiopTraceWriter::flush()
+{
+  if(NULL==file_) {
+    return false;
+  }
+  if(!buffers_[curr_].empty()) {
+    commit();
+  }
+  if(writer_.joinable()) {
+    writer_.join();
+  }
+  all_ok_ = all_ok_ && writer_ok_;
+  return all_ok_;
+}
+
+} //end namespace
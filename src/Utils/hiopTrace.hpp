@@ -0,0 +1,136 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+/**
+ * @file hiopTrace.hpp
+ *
+ * Per-iteration trace of the solver in CSV or binary format, written in the background.
+ *
+ */
+
+#ifndef HIOP_TRACE
+#define HIOP_TRACE
+
+#include "hiopMPI.hpp"
+#include "hiopRunStats.hpp"
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+
+namespace hiop
+{
+
+/* *************************************************************************
+ * Structured trace of the iterations, intended to be ingested by tools instead
+ * of the text output of the logger. Each iteration produces one record with 
+ * the columns listed in 'column_names': the iteration scalars shown by the 
+ * logger, the wall time since the start of the trace, and the timers and 
+ * counters of hiopRunStats, hiopRunKKTSolStats (last iteration), and 
+ * hiopLinSolStats (last linear solve). The timers of hiopRunStats are 
+ * cumulative.
+ *
+ * Formats
+ *  - csv: a header line with the column names followed by one line per record
+ *  - binary: the 8 bytes "HIOPTRC1", the number of columns (int32), the column 
+ *    names as null-terminated strings, followed by the records, each of them 
+ *    an array of 'num_columns' doubles (in the byte order of the machine)
+ *
+ * The records are accumulated in memory and a full buffer is written to file
+ * on a background thread while the records of the next iterations go to a 
+ * second buffer; the formatting of the CSV lines is also done by the writer.
+ * *************************************************************************
+ */
+class hiopTraceWriter
+{
+public:
+  enum Format { csv=0, binary };
+
+  /* opens (and truncates) the file; check 'is_open' for errors */
+  hiopTraceWriter(const std::string& file_name, Format format);
+  /* writes the remaining records and closes the file */
+  virtual ~hiopTraceWriter();
+
+  inline bool is_open() const { return file_!=NULL; }
+  inline const std::string& file_name() const { return file_name_; }
+
+  /* appends the record of one iteration; 'ls_status' is the code of the step type 
+   * used by the iteration output (-1 none, 1 's', 2 'h', 3 'f', 4 'r' for a point obtained
+   * by the feasibility restoration) */
+  void record(int iter, double obj, double inf_pr, double inf_du, double mu,
+              double alpha_du, double alpha_pr, int ls_trials, int ls_status, int use_soc,
+              const hiopRunStats& stats);
+
+  /* writes the buffered records and waits for the write to complete; returns false 
+   * if any of the writes failed */
+  bool flush();
+
+  static const char* column_names[];
+  static const int num_columns;
+private:
+  /* hands the current buffer to the background writer */
+  void commit();
+  static void write_records(const std::vector<double>* records, FILE* f, Format format, bool* ok);
+private:
+  std::string file_name_;
+  Format format_;
+  FILE* file_;
+  /* two buffers used in turns; 'curr_' is the one being filled */
+  std::vector<double> buffers_[2];
+  int curr_;
+  std::thread writer_;
+  bool writer_ok_;
+  bool all_ok_;
+  std::chrono::steady_clock::time_point tm_start_;
+};
+
+} //end namespace
+#endif
@@ -0,0 +1,734 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+/**
+ * @file benchLinAlg.cpp
+ *
+ * Microbenchmarks for the linear algebra kernels used by the IPM: hiopVector
+ * operations, dense and sparse matrix products, the sparse-into-dense updates
+ * used by the MDS KKT systems, and the factorization/solve of each linear
+ * solver backend compiled in.
+ *
+ * For each kernel the minimum wall time over a number of repetitions is
+ * reported together with the achieved memory bandwidth (GB/s) and floating
+ * point rate (GFLOP/s). The byte and flop counts are the nominal ones of the
+ * kernel (compulsory traffic, no cache reuse), so they are meant to compare
+ * runs against each other rather than against the peak of the machine.
+ *
+ * Results can be written as JSON with '-json file'. A previously written JSON
+ * file can be passed with '-baseline file'; a kernel that is slower than the
+ * baseline by more than the relative tolerance ('-tolerance', default 0.25)
+ * is reported as a regression and the executable returns a nonzero code.
+ */
+
+#include <hiopVector.hpp>
+#include <hiopMatrixDense.hpp>
+#include <hiopMatrixSparse.hpp>
+#include <hiopLinAlgFactory.hpp>
+#include <hiopInterface.hpp>
+#include <hiopNlpFormulation.hpp>
+#include <hiopLinSolverIndefDenseLapack.hpp>
+
+#ifdef HIOP_USE_MAGMA
+#include <hiopLinSolverIndefDenseMagma.hpp>
+#endif
+#ifdef HIOP_SPARSE
+#ifdef HIOP_USE_COINHSL
+#include <hiopLinSolverIndefSparseMA57.hpp>
+#endif
+#ifdef HIOP_USE_STRUMPACK
+#include <hiopLinSolverSparseSTRUMPACK.hpp>
+#endif
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+#include <cmath>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <fstream>
+#include <sstream>
+
+using namespace hiop;
+
+namespace {
+
+struct BenchResult
+{
+  std::string name;
+  long long size;
+  double density;
+  double time;   // seconds, min over repetitions
+  double bytes;  // nominal bytes moved by one call
+  double flops;  // nominal floating point operations of one call
+
+  double gbps() const { return time>0 ? bytes/time*1e-9 : 0.; }
+  double gflops() const { return time>0 ? flops/time*1e-9 : 0.; }
+  std::string key() const
+  {
+    char buf[256];
+    snprintf(buf, 256, "%s/%lld/%g", name.c_str(), size, density);
+    return buf;
+  }
+};
+
+/// volatile sink for the scalar results of the reductions so they are not optimized away
+volatile double g_sink = 0.;
+
+int g_reps = 10;
+std::vector<BenchResult> g_results;
+
+/**
+ * Times @p kernel over g_reps repetitions (after one warm-up call) and records the minimum.
+ * @p prepare is called before each repetition, outside the timed region, to restore the
+ * inputs the kernel overwrites.
+ */
+void run_bench(const std::string& name, long long size, double density,
+               double bytes, double flops,
+               const std::function<void()>& prepare,
+               const std::function<void()>& kernel)
+{
+  double tmin = 1e+20;
+  for(int r=0; r<=g_reps; r++) {
+    prepare();
+    auto t0 = std::chrono::steady_clock::now();
+    kernel();
+    auto t1 = std::chrono::steady_clock::now();
+    if(r>0) {
+      tmin = std::min(tmin, std::chrono::duration<double>(t1-t0).count());
+    }
+  }
+  BenchResult res = {name, size, density, tmin, bytes, flops};
+  printf("%-48s %9lld %8.2g %12.4e s %9.3f GB/s %9.3f GFLOP/s\n",
+         name.c_str(), size, density, res.time, res.gbps(), res.gflops());
+  g_results.push_back(res);
+}
+
+void fill_uniform(double* a, long long n, std::mt19937& gen, double lo, double hi)
+{
+  std::uniform_real_distribution<double> dist(lo, hi);
+  for(long long i=0; i<n; i++) {
+    a[i] = dist(gen);
+  }
+}
+
+/// Minimal NLP needed to construct the linear solvers (options, logger and run statistics)
+class BenchNlp : public hiopInterfaceDenseConstraints
+{
+public:
+  bool get_prob_sizes(long long& n, long long& m) { n=1; m=0; return true; }
+  bool get_vars_info(const long long& n, double *xlow, double* xupp, NonlinearityType* type)
+  {
+    xlow[0]=-1e20; xupp[0]=1e20; type[0]=hiopNonlinear;
+    return true;
+  }
+  bool get_cons_info(const long long& m, double* clow, double* cupp, NonlinearityType* type)
+  {
+    return true;
+  }
+  bool eval_f(const long long& n, const double* x, bool new_x, double& obj_value)
+  {
+    obj_value = x[0]*x[0];
+    return true;
+  }
+  bool eval_grad_f(const long long& n, const double* x, bool new_x, double* gradf)
+  {
+    gradf[0] = 2*x[0];
+    return true;
+  }
+  bool eval_cons(const long long& n, const long long& m,
+                 const long long& num_cons, const long long* idx_cons,
+                 const double* x, bool new_x, double* cons)
+  {
+    return true;
+  }
+  bool eval_Jac_cons(const long long& n, const long long& m,
+                     const long long& num_cons, const long long* idx_cons,
+                     const double* x, bool new_x, double* Jac)
+  {
+    return true;
+  }
+  bool get_MPI_comm(MPI_Comm& comm_out) { comm_out=MPI_COMM_SELF; return true; }
+};
+
+void bench_vector(long long n, std::mt19937& gen)
+{
+  hiopVector* x  = LinearAlgebraFactory::createVector(n);
+  hiopVector* y  = LinearAlgebraFactory::createVector(n);
+  hiopVector* z  = LinearAlgebraFactory::createVector(n);
+  hiopVector* ix = LinearAlgebraFactory::createVector(n);
+  hiopVector* iy = LinearAlgebraFactory::createVector(n);
+  hiopVector* lo = LinearAlgebraFactory::createVector(n);
+  std::vector<double> x0(n), y0(n), z0(n), buf(n);
+
+  fill_uniform(x0.data(), n, gen, 0.9, 1.1);
+  fill_uniform(y0.data(), n, gen, 0.9, 1.1);
+  fill_uniform(z0.data(), n, gen, 0.9, 1.1);
+  for(long long i=0; i<n; i++) {
+    //signed directions for the fraction-to-the-boundary kernels
+    z0[i] = (i%3==0) ? -z0[i] : z0[i];
+  }
+  //selection patterns: 'ix' selects 3/4 of the entries, 'iy' half of them
+  double* ixd = ix->local_data();
+  double* iyd = iy->local_data();
+  for(long long i=0; i<n; i++) {
+    ixd[i] = (i%4==3) ? 0. : 1.;
+    iyd[i] = (i%2==0) ? 0. : 1.;
+  }
+  lo->setToConstant(0.5);
+
+  const double b = 8.*n;
+  auto prep = [&]() {
+    x->copyFrom(x0.data());
+    y->copyFrom(y0.data());
+    z->copyFrom(z0.data());
+  };
+  auto bench = [&](const char* op, double streams, double flops_per_elem, const std::function<void()>& k) {
+    run_bench(std::string("vector.")+op, n, 1., streams*b, flops_per_elem*n, prep, k);
+  };
+
+  bench("setToZero", 1, 0, [&]() { x->setToZero(); });
+  bench("setToConstant", 1, 0, [&]() { x->setToConstant(2.); });
+  bench("setToConstant_w_patternSelect", 2, 0, [&]() { x->setToConstant_w_patternSelect(2., *ix); });
+  bench("copyFrom", 2, 0, [&]() { x->copyFrom(*y); });
+  bench("copyFrom_array", 2, 0, [&]() { x->copyFrom(buf.data()); });
+  bench("copyTo", 2, 0, [&]() { x->copyTo(buf.data()); });
+  bench("copyFromStarting", 2, 0, [&]() { x->copyFromStarting(0, *y); });
+  bench("copyToStarting", 2, 0, [&]() { x->copyToStarting(*y, 0); });
+  bench("copyToStartingAt_w_pattern", 3, 0, [&]() { x->copyToStartingAt_w_pattern(*y, 0, *ix); });
+  bench("startingAtCopyFromStartingAt", 2, 0, [&]() { x->startingAtCopyFromStartingAt(0, *y, 0); });
+  bench("startingAtCopyToStartingAt", 2, 0, [&]() { x->startingAtCopyToStartingAt(0, *y, 0); });
+  bench("twonorm", 1, 2, [&]() { g_sink = x->twonorm(); });
+  bench("infnorm", 1, 1, [&]() { g_sink = x->infnorm(); });
+  bench("onenorm", 1, 1, [&]() { g_sink = x->onenorm(); });
+  bench("componentMult", 3, 1, [&]() { x->componentMult(*y); });
+  bench("componentDiv", 3, 1, [&]() { x->componentDiv(*y); });
+  bench("componentDiv_w_selectPattern", 4, 1, [&]() { x->componentDiv_w_selectPattern(*y, *ix); });
+  bench("component_min_const", 2, 1, [&]() { x->component_min(1.); });
+  bench("component_min", 3, 1, [&]() { x->component_min(*y); });
+  bench("component_max_const", 2, 1, [&]() { x->component_max(1.); });
+  bench("component_max", 3, 1, [&]() { x->component_max(*y); });
+  bench("component_abs", 2, 1, [&]() { z->component_abs(); });
+  bench("component_sgn", 2, 1, [&]() { z->component_sgn(); });
+  bench("scale", 2, 1, [&]() { x->scale(1.0001); });
+  bench("axpy", 3, 2, [&]() { x->axpy(1e-3, *y); });
+  bench("axzpy", 4, 3, [&]() { x->axzpy(1e-3, *y, *z); });
+  bench("axdzpy", 4, 3, [&]() { x->axdzpy(1e-3, *y, *z); });
+  bench("axdzpy_w_pattern", 5, 3, [&]() { x->axdzpy_w_pattern(1e-3, *y, *z, *ix); });
+  bench("addConstant", 2, 1, [&]() { x->addConstant(1e-3); });
+  bench("addConstant_w_patternSelect", 3, 1, [&]() { x->addConstant_w_patternSelect(1e-3, *ix); });
+  bench("dotProductWith", 2, 2, [&]() { g_sink = x->dotProductWith(*y); });
+  bench("negate", 2, 1, [&]() { x->negate(); });
+  bench("invert", 2, 1, [&]() { x->invert(); });
+  bench("logBarrier_local", 2, 2, [&]() { g_sink = x->logBarrier_local(*ix); });
+  bench("addLogBarrierGrad", 4, 2, [&]() { x->addLogBarrierGrad(1e-3, *y, *ix); });
+  bench("linearDampingTerm_local", 3, 1, [&]() { g_sink = x->linearDampingTerm_local(*ix, *iy, 1e-3, 1e-5); });
+  bench("addLinearDampingTerm", 4, 2, [&]() { x->addLinearDampingTerm(*ix, *iy, 1.0, 1e-3); });
+  bench("allPositive", 1, 0, [&]() { g_sink = x->allPositive(); });
+  bench("allPositive_w_patternSelect", 2, 0, [&]() { g_sink = x->allPositive_w_patternSelect(*ix); });
+  bench("min", 1, 0, [&]() { g_sink = x->min(); });
+  bench("min_w_pattern", 2, 0, [&]() { g_sink = x->min_w_pattern(*ix); });
+  bench("projectIntoBounds_local", 5, 4, [&]() { x->projectIntoBounds_local(*lo, *ix, *y, *iy, 1e-2, 1e-2); });
+  bench("fractionToTheBdry_local", 2, 2, [&]() { g_sink = x->fractionToTheBdry_local(*z, 0.99); });
+  bench("fractionToTheBdry_w_pattern_local", 3, 2,
+        [&]() { g_sink = x->fractionToTheBdry_w_pattern_local(*z, 0.99, *ix); });
+  bench("selectPattern", 3, 0, [&]() { x->selectPattern(*ix); });
+  //the check stops at the first mismatch, so time it on a vector that matches the pattern
+  run_bench("vector.matchesPattern", n, 1., 2*b, 0.,
+            [&]() { x->copyFrom(x0.data()); x->selectPattern(*ix); },
+            [&]() { g_sink = x->matchesPattern(*ix); });
+  bench("adjustDuals_plh", 4, 4, [&]() { x->adjustDuals_plh(*y, *ix, 1e-3, 1e10); });
+  bench("isnan_local", 1, 0, [&]() { g_sink = x->isnan_local(); });
+  bench("isinf_local", 1, 0, [&]() { g_sink = x->isinf_local(); });
+  bench("isfinite_local", 1, 0, [&]() { g_sink = x->isfinite_local(); });
+  bench("numOfElemsLessThan", 1, 0, [&]() { g_sink = x->numOfElemsLessThan(1.); });
+  bench("numOfElemsAbsLessThan", 1, 0, [&]() { g_sink = x->numOfElemsAbsLessThan(1.); });
+
+  delete x;
+  delete y;
+  delete z;
+  delete ix;
+  delete iy;
+  delete lo;
+}
+
+void bench_dense(long long n, std::mt19937& gen)
+{
+  hiopMatrixDense* A = LinearAlgebraFactory::createMatrixDense(n, n);
+  hiopMatrixDense* X = LinearAlgebraFactory::createMatrixDense(n, n);
+  hiopMatrixDense* W = LinearAlgebraFactory::createMatrixDense(n, n);
+  hiopVector* x = LinearAlgebraFactory::createVector(n);
+  hiopVector* y = LinearAlgebraFactory::createVector(n);
+  fill_uniform(A->local_data(), n*n, gen, -1., 1.);
+  fill_uniform(X->local_data(), n*n, gen, -1., 1.);
+  fill_uniform(x->local_data(), n, gen, -1., 1.);
+
+  const double nn = (double)n*n;
+  auto prep_vec = [&]() { y->setToZero(); };
+  auto prep_mat = [&]() { W->setToZero(); };
+
+  run_bench("dense.timesVec", n, 1., 8*(nn+2*n), 2*nn, prep_vec,
+            [&]() { A->timesVec(0., *y, 1., *x); });
+  run_bench("dense.transTimesVec", n, 1., 8*(nn+2*n), 2*nn, prep_vec,
+            [&]() { A->transTimesVec(0., *y, 1., *x); });
+  run_bench("dense.timesMat", n, 1., 3*8*nn, 2*nn*n, prep_mat,
+            [&]() { A->timesMat(0., *W, 1., *X); });
+  run_bench("dense.transTimesMat", n, 1., 3*8*nn, 2*nn*n, prep_mat,
+            [&]() { A->transTimesMat(0., *W, 1., *X); });
+  run_bench("dense.timesMatTrans", n, 1., 3*8*nn, 2*nn*n, prep_mat,
+            [&]() { A->timesMatTrans(0., *W, 1., *X); });
+
+  delete A;
+  delete X;
+  delete W;
+  delete x;
+  delete y;
+}
+
+/// Fills a (m x n) sparse triplet matrix with a random pattern of density @p dens, sorted by rows
+void fill_sparse(hiopMatrixSparse& M, int m, int n, double dens, std::mt19937& gen)
+{
+  int nnz = M.numberOfNonzeros();
+  int per_row = nnz/m;
+  std::vector<int> cols(n);
+  for(int j=0; j<n; j++) {
+    cols[j]=j;
+  }
+  int* irow = M.i_row();
+  int* jcol = M.j_col();
+  double* vals = M.M();
+  int it = 0;
+  for(int i=0; i<m; i++) {
+    //partial Fisher-Yates shuffle to pick 'per_row' distinct columns
+    for(int k=0; k<per_row; k++) {
+      std::uniform_int_distribution<int> dist(k, n-1);
+      std::swap(cols[k], cols[dist(gen)]);
+    }
+    std::sort(cols.begin(), cols.begin()+per_row);
+    for(int k=0; k<per_row; k++, it++) {
+      irow[it] = i;
+      jcol[it] = cols[k];
+    }
+  }
+  assert(it==nnz);
+  fill_uniform(vals, nnz, gen, -1., 1.);
+}
+
+void bench_sparse(int m, int n, double dens, std::mt19937& gen)
+{
+  const int per_row = std::max(1, (int)(dens*n));
+  const int nnz = m*per_row;
+  hiopMatrixSparse* A = LinearAlgebraFactory::createMatrixSparse(m, n, nnz);
+  hiopMatrixSparse* B = LinearAlgebraFactory::createMatrixSparse(m, n, nnz);
+  hiopMatrixSparse* C = LinearAlgebraFactory::createMatrixSparse(m, n, nnz);
+  fill_sparse(*A, m, n, dens, gen);
+  fill_sparse(*B, m, n, dens, gen);
+  fill_sparse(*C, m, n, dens, gen);
+
+  hiopVector* xn = LinearAlgebraFactory::createVector(n);
+  hiopVector* xm = LinearAlgebraFactory::createVector(m);
+  hiopVector* D  = LinearAlgebraFactory::createVector(n);
+  fill_uniform(xn->local_data(), n, gen, -1., 1.);
+  fill_uniform(xm->local_data(), m, gen, -1., 1.);
+  fill_uniform(D->local_data(), n, gen, 1., 2.);
+  hiopMatrixDense* W = LinearAlgebraFactory::createMatrixDense(2*m, 2*m);
+
+  //triplet storage: 8 bytes per value plus two 4 bytes indexes
+  const double bnnz = 16.*nnz;
+  auto prep_none = []() {};
+  auto prep_W = [&]() { W->setToZero(); };
+
+  run_bench("sparse.timesVec", m, dens, bnnz+8.*(n+2*m), 2.*nnz, [&]() { xm->setToZero(); },
+            [&]() { A->timesVec(0., *xm, 1., *xn); });
+  run_bench("sparse.transTimesVec", m, dens, bnnz+8.*(m+2*n), 2.*nnz, [&]() { xn->setToZero(); },
+            [&]() { A->transTimesVec(0., *xn, 1., *xm); });
+
+  // row-by-row merges of the patterns: every pair of rows (i,j) reads both rows and, on average,
+  // finds dens*per_row common columns, each costing one division, two products and one addition
+  const double pairs_sym = 0.5*m*(m+1.), pairs = (double)m*m;
+  run_bench("sparse.addMDinvMtransToDiagBlockOfSymDeMatUTri", m, dens,
+            pairs_sym*2*bnnz/m + 8.*(n+pairs_sym), 4.*pairs_sym*dens*per_row, prep_W,
+            [&]() { A->addMDinvMtransToDiagBlockOfSymDeMatUTri(0, 1., *D, *W); });
+  run_bench("sparse.addMDinvNtransToSymDeMatUTri", m, dens,
+            pairs*2*bnnz/m + 8.*(n+pairs), 4.*pairs*dens*per_row, prep_W,
+            [&]() { A->addMDinvNtransToSymDeMatUTri(0, m, 1., *D, *B, *W); });
+  run_bench("sparse.copyRowsBlockFrom", m, dens, 2*bnnz, 0., prep_none,
+            [&]() { C->copyRowsBlockFrom(*A, 0, m, 0, 0); });
+
+  delete A;
+  delete B;
+  delete C;
+  delete xn;
+  delete xm;
+  delete D;
+  delete W;
+}
+
+/// Symmetric indefinite dense matrix (diagonal entries of alternating sign dominate)
+void fill_sym_indef(hiopMatrixDense& M, int n, std::mt19937& gen)
+{
+  double* a = M.local_data();
+  fill_uniform(a, (long long)n*n, gen, -1., 1.);
+  for(int i=0; i<n; i++) {
+    for(int j=0; j<i; j++) {
+      a[i*n+j] = a[j*n+i];
+    }
+    a[i*n+i] = (i%2 ? -1. : 1.)*n;
+  }
+}
+
+void bench_linsol_dense(const std::string& name, hiopLinSolverIndefDense& linsol,
+                        int n, std::mt19937& gen)
+{
+  hiopMatrixDense* A0 = LinearAlgebraFactory::createMatrixDense(n, n);
+  fill_sym_indef(*A0, n, gen);
+  hiopVector* rhs0 = LinearAlgebraFactory::createVector(n);
+  hiopVector* rhs = LinearAlgebraFactory::createVector(n);
+  fill_uniform(rhs0->local_data(), n, gen, -1., 1.);
+
+  const double nn = (double)n*n;
+  run_bench("linsol."+name+".factorize", n, 1., 2*8*nn, nn*n/3.,
+            [&]() { linsol.sysMatrix().copyFrom(*A0); },
+            [&]() { linsol.matrixChanged(); });
+  run_bench("linsol."+name+".solve", n, 1., 8*(nn+2*n), 2*nn,
+            [&]() { rhs->copyFrom(*rhs0); },
+            [&]() { linsol.solve(*rhs); });
+
+  delete A0;
+  delete rhs0;
+  delete rhs;
+}
+
+#ifdef HIOP_SPARSE
+/**
+ * Benchmarks a sparse symmetric indefinite solver on a banded matrix of half-bandwidth
+ * @p bw (upper triangle stored by rows). The flop counts are those of a banded LDL^T.
+ */
+template<class LINSOL>
+void bench_linsol_sparse(const std::string& name, int n, int bw, hiopNlpFormulation* nlp,
+                         std::mt19937& gen)
+{
+  int nnz = 0;
+  for(int i=0; i<n; i++) {
+    nnz += std::min(bw+1, n-i);
+  }
+  LINSOL linsol(n, nnz, nlp);
+  auto& M = linsol.sysMatrix();
+  int* irow = M.i_row();
+  int* jcol = M.j_col();
+  int it = 0;
+  for(int i=0; i<n; i++) {
+    for(int j=i; j<=std::min(i+bw, n-1); j++, it++) {
+      irow[it] = i;
+      jcol[it] = j;
+    }
+  }
+  std::vector<double> vals0(nnz);
+  fill_uniform(vals0.data(), nnz, gen, -1., 1.);
+  for(int i=0, k=0; i<n; k+=std::min(bw+1, n-i), i++) {
+    vals0[k] = (i%2 ? -1. : 1.)*(2*bw+2);
+  }
+  hiopVector* rhs0 = LinearAlgebraFactory::createVector(n);
+  hiopVector* rhs = LinearAlgebraFactory::createVector(n);
+  fill_uniform(rhs0->local_data(), n, gen, -1., 1.);
+
+  const double dens = (double)nnz/n/n;
+  run_bench("linsol."+name+".factorize", n, dens, 16.*nnz, (double)n*bw*bw, 
+            [&]() { memcpy(M.M(), vals0.data(), nnz*sizeof(double)); },
+            [&]() { linsol.matrixChanged(); });
+  run_bench("linsol."+name+".solve", n, dens, 16.*nnz*2+16.*n, 4.*n*bw,
+            [&]() { rhs->copyFrom(*rhs0); },
+            [&]() { linsol.solve(*rhs); });
+
+  delete rhs0;
+  delete rhs;
+}
+#endif
+
+void bench_linsol(int n, std::mt19937& gen)
+{
+  BenchNlp nlp_interface;
+  hiopNlpDenseConstraints nlp(nlp_interface);
+  nlp.options->SetIntegerValue("verbosity_level", 0);
+
+  {
+    hiopLinSolverIndefDenseLapack linsol(n, &nlp);
+    bench_linsol_dense("lapack", linsol, n, gen);
+  }
+#ifdef HIOP_USE_MAGMA
+  {
+    hiopLinSolverIndefDenseMagmaBuKa linsol(n, &nlp);
+    bench_linsol_dense("magma_buka", linsol, n, gen);
+  }
+  {
+    hiopLinSolverIndefDenseMagmaNopiv linsol(n, &nlp);
+    bench_linsol_dense("magma_nopiv", linsol, n, gen);
+  }
+#endif
+#ifdef HIOP_SPARSE
+  const int ns = 20*n, bw = 20;
+#ifdef HIOP_USE_COINHSL
+  bench_linsol_sparse<hiopLinSolverIndefSparseMA57>("ma57", ns, bw, &nlp, gen);
+#endif
+#ifdef HIOP_USE_STRUMPACK
+  bench_linsol_sparse<hiopLinSolverIndefSparseSTRUMPACK>("strumpack", ns, bw, &nlp, gen);
+#endif
+#endif
+}
+
+bool write_json(const char* file_name)
+{
+  FILE* f = fopen(file_name, "w");
+  if(NULL==f) {
+    printf("[error] could not open '%s' for writing\n", file_name);
+    return false;
+  }
+  fprintf(f, "{\n\"hiop_version\": \"%s\",\n\"repetitions\": %d,\n\"benchmarks\": [\n",
+          HIOP_VERSION, g_reps);
+  for(size_t i=0; i<g_results.size(); i++) {
+    const BenchResult& r = g_results[i];
+    //one benchmark per line so that the file can be read back without a JSON parser
+    fprintf(f, "{\"name\": \"%s\", \"size\": %lld, \"density\": %.6g, \"time\": %.6e, "
+            "\"gbps\": %.6g, \"gflops\": %.6g}%s\n",
+            r.name.c_str(), r.size, r.density, r.time, r.gbps(), r.gflops(),
+            i+1<g_results.size() ? "," : "");
+  }
+  fprintf(f, "]\n}\n");
+  fclose(f);
+  return true;
+}
+
+/// Extracts the value of "field" from a line written by write_json
+bool json_field(const std::string& line, const char* field, std::string& value)
+{
+  std::string key = std::string("\"") + field + "\":";
+  size_t pos = line.find(key);
+  if(pos==std::string::npos) {
+    return false;
+  }
+  pos += key.size();
+  while(pos<line.size() && line[pos]==' ') {
+    pos++;
+  }
+  if(pos<line.size() && line[pos]=='"') {
+    size_t end = line.find('"', pos+1);
+    if(end==std::string::npos) {
+      return false;
+    }
+    value = line.substr(pos+1, end-pos-1);
+  } else {
+    size_t end = line.find_first_of(",}", pos);
+    value = line.substr(pos, end-pos);
+  }
+  return true;
+}
+
+/// Returns the number of kernels slower than the baseline by more than a factor 1+tol, or -1 on error
+int compare_to_baseline(const char* file_name, double tol)
+{
+  std::ifstream in(file_name);
+  if(!in) {
+    printf("[error] could not open baseline '%s'\n", file_name);
+    return -1;
+  }
+  std::map<std::string, double> base;
+  std::string line, name, size, density, time;
+  while(std::getline(in, line)) {
+    if(json_field(line, "name", name) && json_field(line, "size", size) &&
+       json_field(line, "density", density) && json_field(line, "time", time)) {
+      BenchResult r = {name, atoll(size.c_str()), atof(density.c_str()), 0., 0., 0.};
+      base[r.key()] = atof(time.c_str());
+    }
+  }
+
+  int num_regressions = 0, num_compared = 0;
+  printf("\nComparison against baseline '%s' (tolerance %.0f%%)\n", file_name, 100*tol);
+  for(const BenchResult& r : g_results) {
+    auto it = base.find(r.key());
+    if(it==base.end() || it->second<=0.) {
+      continue;
+    }
+    num_compared++;
+    double ratio = r.time/it->second;
+    if(ratio > 1.+tol) {
+      num_regressions++;
+      printf("  REGRESSION %-52s %12.4e s vs %12.4e s (x%.2f)\n",
+             r.key().c_str(), r.time, it->second, ratio);
+    } else if(ratio < 1./(1.+tol)) {
+      printf("  improved   %-52s %12.4e s vs %12.4e s (x%.2f)\n",
+             r.key().c_str(), r.time, it->second, ratio);
+    }
+  }
+  printf("%d kernels compared, %d regressions\n", num_compared, num_regressions);
+  return num_regressions;
+}
+
+void usage(const char* exe)
+{
+  printf("Usage: %s [-quick] [-reps r] [-vec n1,n2,...] [-dense n1,...] [-sparse m1,...] "
+         "[-density d1,...] [-linsol n1,...] [-json out.json] [-baseline base.json] [-tolerance t]\n", exe);
+  printf("  -quick      small sizes and few repetitions (smoke test)\n");
+  printf("  -reps       number of timed repetitions per kernel, the minimum time is reported [10]\n");
+  printf("  -vec        vector sizes [100000,10000000]\n");
+  printf("  -dense      dense matrix dimensions [256,1024]\n");
+  printf("  -sparse     number of rows of the sparse matrices (columns are 10x) [1000]\n");
+  printf("  -density    densities of the sparse matrices [0.001,0.01]\n");
+  printf("  -linsol     dimensions of the dense linear systems [500,2000]\n");
+  printf("  -json       write the results to this file\n");
+  printf("  -baseline   compare against the results of a previous '-json' run\n");
+  printf("  -tolerance  relative slowdown tolerated before reporting a regression [0.25]\n");
+}
+
+template<class T>
+std::vector<T> parse_list(const char* s)
+{
+  std::vector<T> v;
+  std::stringstream ss(s);
+  std::string item;
+  while(std::getline(ss, item, ',')) {
+    v.push_back((T)atof(item.c_str()));
+  }
+  return v;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+#ifdef HIOP_USE_MPI
+  int ierr = MPI_Init(&argc, &argv);
+  assert(MPI_SUCCESS==ierr);
+#endif
+
+  std::vector<long long> vec_sizes = {100000, 10000000};
+  std::vector<long long> dense_sizes = {256, 1024};
+  std::vector<int> sparse_rows = {1000};
+  std::vector<double> densities = {0.001, 0.01};
+  std::vector<int> linsol_sizes = {500, 2000};
+  const char* json_file = NULL;
+  const char* baseline_file = NULL;
+  double tol = 0.25;
+
+  for(int i=1; i<argc; i++) {
+    bool has_val = i+1<argc;
+    if(0==strcmp(argv[i], "-quick")) {
+      g_reps = 3;
+      vec_sizes = {10000};
+      dense_sizes = {64};
+      sparse_rows = {100};
+      densities = {0.01};
+      linsol_sizes = {64};
+    } else if(0==strcmp(argv[i], "-reps") && has_val) {
+      g_reps = std::max(1, atoi(argv[++i]));
+    } else if(0==strcmp(argv[i], "-vec") && has_val) {
+      vec_sizes = parse_list<long long>(argv[++i]);
+    } else if(0==strcmp(argv[i], "-dense") && has_val) {
+      dense_sizes = parse_list<long long>(argv[++i]);
+    } else if(0==strcmp(argv[i], "-sparse") && has_val) {
+      sparse_rows = parse_list<int>(argv[++i]);
+    } else if(0==strcmp(argv[i], "-density") && has_val) {
+      densities = parse_list<double>(argv[++i]);
+    } else if(0==strcmp(argv[i], "-linsol") && has_val) {
+      linsol_sizes = parse_list<int>(argv[++i]);
+    } else if(0==strcmp(argv[i], "-json") && has_val) {
+      json_file = argv[++i];
+    } else if(0==strcmp(argv[i], "-baseline") && has_val) {
+      baseline_file = argv[++i];
+    } else if(0==strcmp(argv[i], "-tolerance") && has_val) {
+      tol = atof(argv[++i]);
+    } else {
+      usage(argv[0]);
+#ifdef HIOP_USE_MPI
+      MPI_Finalize();
+#endif
+      return 1;
+    }
+  }
+
+  std::mt19937 gen(1234);
+  printf("%-48s %9s %8s %14s %14s %17s\n", "kernel", "size", "density", "time", "bandwidth", "flop rate");
+
+  for(auto n : vec_sizes) {
+    bench_vector(n, gen);
+  }
+  for(auto n : dense_sizes) {
+    bench_dense(n, gen);
+  }
+  for(auto m : sparse_rows) {
+    for(auto d : densities) {
+      bench_sparse(m, 10*m, d, gen);
+    }
+  }
+  for(auto n : linsol_sizes) {
+    bench_linsol(n, gen);
+  }
+
+  int ret = 0;
+  if(json_file && !write_json(json_file)) {
+    ret = 1;
+  }
+  if(baseline_file) {
+    int num_regressions = compare_to_baseline(baseline_file, tol);
+    if(num_regressions != 0) {
+      ret = 1;
+    }
+  }
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return ret;
+}